@@ -9,16 +9,23 @@ class Makefile ( object ) :
         self.cxxflags = cxxflags
 
     def __repr__( self ) :
-        output =  "# {}\n\n".format( self.__class__.__name__ )
+        output =  "# {}\n".format( self.__class__.__name__ )
+        output += "# Generated by Build.py: change Build.py and run it again rather than editing this file.\n\n"
         output += "{:10} = {}\n".format( "CXX"       , self.cxx      ) if self.cxx else ""
         output += "{:10} = {}\n".format( "CXXFLAGS"  , self.cxxflags )
         output += "\n"
         output += "none :\n\n"
         output += "test :\n"
         output += "\tcd testing && touch *.cc && make all && ./test-c3\n\n"
+        output += "mpitest :\n"
+        output += "\tcd testing && touch *.cc && make run-mpi\n\n"
+        output += ".PHONY : benchmark\n"
+        output += "benchmark :\n"
+        output += "\tcd benchmark && make all\n\n"
         output += "distclean :\n"
         output += "\tcd app/decam && make realclean\n"
         output += "\tcd testing && make deepclean\n"
+        output += "\tcd benchmark && make realclean\n"
         return output
 
 class EdisonMakefile ( Makefile ) :
@@ -29,7 +36,7 @@ class EdisonMakefile ( Makefile ) :
 
     def __init__( self, cxx = None, cxxflags = None ) :
         cxx      = cxx      or "CC"
-        cxxflags = cxxflags or "-std=c++11 -fast -no-ipo"
+        cxxflags = cxxflags or "-std=c++11 -fast -no-ipo -no-fma"
         super( EdisonMakefile, self ).__init__( cxx, cxxflags )
 
 class CoriMakefile ( Makefile ) :
@@ -40,7 +47,7 @@ class CoriMakefile ( Makefile ) :
 
     def __init__( self, cxx = None, cxxflags = None ) :
         cxx      = cxx      or "CC"
-        cxxflags = cxxflags or "-std=c++11 -fast -no-ipo"
+        cxxflags = cxxflags or "-std=c++11 -fast -no-ipo -no-fma"
         super( CoriMakefile, self ).__init__( cxx, cxxflags )
 
 class ClangMakefile ( Makefile ) :
@@ -59,7 +66,7 @@ class TravisMakefile ( Makefile ) :
 
     @classmethod
     def is_match( cls ) :
-        return len( filter( lambda x : x.startswith( "TRAVIS_" ), os.environ.keys() ) ) > 0
+        return any( key.startswith( "TRAVIS_" ) for key in os.environ )
 
     def __init__( self, cxx = None, cxxflags = None ) :
         cxxflags = cxxflags or "-std=c++11 -O3"
@@ -72,7 +79,7 @@ class MakefileFactory ( object ) :
 
     def create( self, makefile_type = None, **kwargs ) :
         if makefile_type is None :
-            for key, makefile_class in self.registry.iteritems() :
+            for key, makefile_class in self.registry.items() :
                 if not makefile_class.is_match() :
                     continue
                 makefile_type = key
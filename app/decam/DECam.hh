@@ -19,6 +19,13 @@ namespace DECam
     
     };
 
+    /// Bits set in the flags plane of processed frames.
+
+    enum Flag : unsigned short
+    {
+        SATURATED = 0x1     ///< Raw pixel at or above the saturation level of its amplifier.
+    };
+
 }
 
 const std::vector< std::string > DECam::Traits::frames( { "S1", "S2", "S3", "N1", "N2", "N3", "S8", "S9", "S14", "S15", "S20", "S25", "N8", "N9", "N14", "N15",
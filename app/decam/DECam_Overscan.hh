@@ -7,6 +7,9 @@
 #include "C3_Application.hh"
 #include "C3_Column.hh"
 #include "C3_Context.hh"
+#include "C3_Flag.hh"
+#include "C3_ForEach.hh"
+#include "C3_MaskedFrame.hh"
 #include "C3_View.hh"
 
 #include "DECam.hh"
@@ -75,9 +78,7 @@ inline void DECam::Overscan< Context >::process( const YAML::Node& task )
     auto datasec_ncolumns = datasec[ 1 ] - datasec[ 0 ] + 1;
     auto datasec_nrows    = datasec[ 3 ] - datasec[ 2 ] + 1;
 
-    C3::Frame< data_type > output( datasec_ncolumns, datasec_nrows );
-    C3::Frame< data_type > invvar( datasec_ncolumns, datasec_nrows );
-    C3::Frame< flag_type > flags ( datasec_ncolumns, datasec_nrows );
+    C3::MaskedFrame< data_type, flag_type > output( datasec_ncolumns, datasec_nrows );
 
     // Iterate over amplifier.
 
@@ -91,11 +92,11 @@ inline void DECam::Overscan< Context >::process( const YAML::Node& task )
         auto section = my_task[ "datasec" + amp ].as< std::vector< int > >();
         C3::View< data_type >  input_data = C3::View< data_type >::iraf_style(  input, section[ 0 ], section[ 1 ], section[ 2 ], section[ 3 ] );
 
-        C3::View< data_type > output_data( output, input_data.ncolumns(), input_data.nrows(), 
+        C3::View< data_type > output_data( output.data()  , input_data.ncolumns(), input_data.nrows(), 
                 section[ 0 ] - datasec[ 0 ], section[ 2 ] - datasec[ 2 ]  );
-        C3::View< data_type > invvar_data( invvar, input_data.ncolumns(), input_data.nrows(), 
+        C3::View< data_type > invvar_data( output.invvar(), input_data.ncolumns(), input_data.nrows(), 
                 section[ 0 ] - datasec[ 0 ], section[ 2 ] - datasec[ 2 ]  );
-        C3::View< flag_type >  flags_data(  flags, input_data.ncolumns(), input_data.nrows(), 
+        C3::View< flag_type >  flags_data( output.flags() , input_data.ncolumns(), input_data.nrows(), 
                 section[ 0 ] - datasec[ 0 ], section[ 2 ] - datasec[ 2 ]  );
 
         // Input overscan section.
@@ -117,6 +118,9 @@ inline void DECam::Overscan< Context >::process( const YAML::Node& task )
         C3::Block< data_type > weights( overscan.ncolumns() );
         C3::Block< data_type > buffer ( overscan.ncolumns() );
 
+        C3::Column< data_type > row_bias  ( overscan.nrows() );
+        C3::Column< data_type > row_invvar( overscan.nrows() );
+
         for( auto k = 0; k < overscan.nrows(); ++ k )
         {
 
@@ -162,15 +166,27 @@ inline void DECam::Overscan< Context >::process( const YAML::Node& task )
             }
             wvar = wvar / ( wsum - w2sum / wsum );
 
-            // Commit subtracted bias and multiply by gain.
+            row_bias  ( k ) = wmean;
+            row_invvar( k ) = 1.0 / ( rdnoise2 + gain2 * wvar );
+
+        }
+
+        // Commit subtracted bias and multiply by gain, data and inverse variance in one pass.
 
-            for( auto j = 0; j < output_data.ncolumns(); ++ j ) 
+        C3::for_each( [ = ]( data_type& output, data_type& invvar, const data_type input, const data_type bias, 
+                    const data_type row_invvar )
             {
-                output_data( j, k ) = gain * ( input_data( j, k ) - wmean );
-                invvar_data( j, k ) = 1.0 / ( rdnoise2 + gain2 * wvar );
-                flags_data ( j, k ) = 0;
-            }
+                output = gain * ( input - bias );
+                invvar = row_invvar;
+            }, output_data, invvar_data, input_data, row_bias, row_invvar );
+
+        // Flag saturated pixels, if the task gives a saturation level for the amplifier.
 
+        flags_data = flag_type( 0 );
+        if( my_task[ "saturate" + amp ] )
+        {
+            auto saturate = my_task[ "saturate" + amp ].as< data_type >();
+            C3::flag( flags_data, DECam::SATURATED, C3::greater_equal( input_data, saturate ) );
         }
 
     }
@@ -178,6 +194,6 @@ inline void DECam::Overscan< Context >::process( const YAML::Node& task )
     // Write the output.
 
     auto output_path = config[ "output_root" ].as< std::string >() + task[ "output" ].as< std::string >();
-    context.template save< float >( output, invvar, flags, output_path );
+    context.template save< float >( output, output_path );
 
 }
@@ -0,0 +1,89 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "C3_Frame.hh"
+#include "C3_Quantile.hh"
+#include "C3_Reduce.hh"
+#include "C3_Row.hh"
+#include "C3_Simd.hh"
+
+// Compare reductions of a frame's columns into a row: gathering each column
+// and reducing it on its own, as reductions into rows did before, against
+// C3::reduce, which walks rows a band of columns at a time.
+//
+//      column-reduce-benchmark [ncolumns [nrows]]
+//
+// Defaults are one DECam amplifier.
+
+namespace
+{
+
+    using Clock = std::chrono::steady_clock;
+
+    template< class Function >
+    double seconds( Function function, const int repeats = 3 )
+    {
+        double best = 0.0;
+        for( int r = 0; r < repeats; ++r )
+        {
+            const auto start = Clock::now();
+            function();
+            const double elapsed = std::chrono::duration< double >( Clock::now() - start ).count();
+            if( r == 0 || elapsed < best ) best = elapsed;
+        }
+        return best;
+    }
+
+    void report( const std::string& label, const double elapsed, const double npixels )
+    {
+        std::cout << std::left << std::setw( 36 ) << label << std::right << std::fixed << std::setprecision( 4 )
+            << std::setw( 10 ) << elapsed << " s" << std::setw( 10 ) << std::setprecision( 1 )
+            << npixels / elapsed / 1.0e6 << " Mpixel/s" << std::endl;
+    }
+
+    template< class Operator >
+    void compare( const std::string& name, const C3::Frame< float >& frame, Operator op )
+    {
+        C3::Row< double > row( frame.ncolumns() );
+        const double npixels = double( frame.ncolumns() ) * frame.nrows();
+
+        report( name + ", gathered", seconds( [ & ]()
+            {
+                std::vector< float > column( frame.nrows() );
+                for( C3::size_type j = 0; j < frame.ncolumns(); ++j )
+                {
+                    for( C3::size_type k = 0; k < frame.nrows(); ++k ) column[ k ] = frame( j, k );
+                    op( row( j ), column.data(), column.data() + column.size() );
+                }
+            } ), npixels );
+        report( name + ", C3::reduce", seconds( [ & ]() { C3::reduce( row, frame, op ); } ), npixels );
+    }
+
+}
+
+int main( int argc, char* argv[] )
+{
+
+    const C3::size_type ncolumns = argc > 1 ? atoi( argv[ 1 ] ) : 1024;
+    const C3::size_type nrows    = argc > 2 ? atoi( argv[ 2 ] ) : 4146;
+
+    std::cout << ncolumns << " x " << nrows << " pixels, " << C3::isa_string( C3::isa() ) << std::endl;
+
+    C3::Frame< float > frame( ncolumns, nrows, C3::RowPitch::ALIGNED );
+    for( C3::size_type k = 0; k < nrows; ++k )
+    {
+        for( C3::size_type j = 0; j < ncolumns; ++j ) frame( j, k ) = float( ( 7919 * j + 104729 * k ) % 40000 );
+    }
+
+    compare( "sum", frame, C3::Sum() );
+    compare( "variance", frame, C3::Variance() );
+    compare( "max", frame, C3::Max() );
+    compare( "median", frame, C3::Median() );
+
+    return 0;
+
+}
@@ -0,0 +1,101 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "C3_Frame.hh"
+#include "C3_Math.hh"
+#include "C3_Simd.hh"
+
+// Compare math functions over a frame: a plain loop over the std:: functions
+// against C3 expressions, scalar and vectorized.
+//
+//      math-benchmark [ncolumns [nrows]]
+//
+// Defaults are one DECam amplifier in floats, some 17 MB, so each pass goes
+// through memory as a pipeline step would.
+
+namespace
+{
+
+    using Clock = std::chrono::steady_clock;
+
+    template< class Function >
+    double seconds( Function function, const int repeats = 5 )
+    {
+        double best = 0.0;
+        for( int r = 0; r < repeats; ++r )
+        {
+            const auto start = Clock::now();
+            function();
+            const double elapsed = std::chrono::duration< double >( Clock::now() - start ).count();
+            if( r == 0 || elapsed < best ) best = elapsed;
+        }
+        return best;
+    }
+
+    void report( const char* label, const double elapsed, const double npixels )
+    {
+        std::cout << std::left << std::setw( 36 ) << label << std::right << std::fixed << std::setprecision( 4 )
+            << std::setw( 10 ) << elapsed << " s" << std::setw( 10 ) << std::setprecision( 1 )
+            << npixels / elapsed / 1.0e6 << " Mpixel/s" << std::endl;
+    }
+
+    // One function three ways.
+
+    template< class T, class Expression, class Reference >
+    void compare( const char* name, C3::Frame< T >& output, const C3::Frame< T >& input, Expression expression,
+            Reference reference )
+    {
+        const double npixels = double( input.ncolumns() ) * input.nrows();
+        const std::string label( name );
+
+        report( ( label + ", std:: loop" ).c_str(), seconds( [ & ]()
+            {
+                for( C3::size_type k = 0; k < input.nrows(); ++k )
+                {
+                    for( C3::size_type j = 0; j < input.ncolumns(); ++j ) output( j, k ) = reference( input( j, k ) );
+                }
+            } ), npixels );
+
+        const auto isa = C3::isa();
+        C3::select_isa( C3::Isa::SCALAR );
+        report( ( label + ", expression (scalar)" ).c_str(), seconds( [ & ]() { output = expression( input ); } ),
+                npixels );
+        C3::select_isa( isa );
+        report( ( label + ", expression" ).c_str(), seconds( [ & ]() { output = expression( input ); } ), npixels );
+    }
+
+}
+
+int main( int argc, char* argv[] )
+{
+
+    const C3::size_type ncolumns = argc > 1 ? atoi( argv[ 1 ] ) : 1024;
+    const C3::size_type nrows    = argc > 2 ? atoi( argv[ 2 ] ) : 4146;
+
+    C3::Frame< float > input( ncolumns, nrows );
+    C3::Frame< float > output( ncolumns, nrows );
+    for( C3::size_type k = 0; k < nrows; ++k )
+    {
+        for( C3::size_type j = 0; j < ncolumns; ++j ) input( j, k ) = 1.0f + 0.001f * ( j + k );
+    }
+
+    std::cout << ncolumns << " x " << nrows << " floats, " << C3::isa_string( C3::isa() ) << std::endl;
+
+    using Input = const C3::Frame< float >&;
+
+    compare( "sqrt", output, input, []( Input x ) { return C3::sqrt( x ); }, []( float x ) { return std::sqrt( x ); } );
+    compare( "log" , output, input, []( Input x ) { return C3::log ( x ); }, []( float x ) { return std::log ( x ); } );
+    compare( "exp" , output, input, []( Input x ) { return C3::exp ( x ); }, []( float x ) { return std::exp ( x ); } );
+    compare( "1 / sqrt", output, input, []( Input x ) { return C3::reciprocal( C3::sqrt( x ) ); },
+            []( float x ) { return 1.0f / std::sqrt( x ); } );
+    compare( "clamp", output, input, []( Input x ) { return C3::clamp( x, 1.5f, 3.0f ); },
+            []( float x ) { return std::min( std::max( x, 1.5f ), 3.0f ); } );
+
+    return 0;
+
+}
@@ -0,0 +1,117 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "C3_Frame.hh"
+#include "C3_Quantile.hh"
+#include "C3_Simd.hh"
+#include "C3_Stack.hh"
+
+// Compare per-pixel medians of an interleaved stack: copying and sorting each
+// pixel's frames against C3::Median, scalar and vectorized, for stacks of a
+// few frames to a few dozen.  Then the median of one large frame of raw
+// unsigned shorts, sorting against counting selection.
+//
+//      median-benchmark [ncolumns [nrows]]
+//
+// Defaults are one DECam amplifier.
+
+namespace
+{
+
+    using Clock = std::chrono::steady_clock;
+
+    template< class Function >
+    double seconds( Function function, const int repeats = 3 )
+    {
+        double best = 0.0;
+        for( int r = 0; r < repeats; ++r )
+        {
+            const auto start = Clock::now();
+            function();
+            const double elapsed = std::chrono::duration< double >( Clock::now() - start ).count();
+            if( r == 0 || elapsed < best ) best = elapsed;
+        }
+        return best;
+    }
+
+    void report( const std::string& label, const double elapsed, const double npixels )
+    {
+        std::cout << std::left << std::setw( 36 ) << label << std::right << std::fixed << std::setprecision( 4 )
+            << std::setw( 10 ) << elapsed << " s" << std::setw( 10 ) << std::setprecision( 1 )
+            << npixels / elapsed / 1.0e6 << " Mpixel/s" << std::endl;
+    }
+
+    void compare( const C3::size_type nframes, const C3::size_type ncolumns, const C3::size_type nrows )
+    {
+        C3::Stack< float > stack( nframes, ncolumns, nrows, C3::StackLayout::INTERLEAVED );
+        for( C3::size_type k = 0; k < nrows; ++k )
+        {
+            for( C3::size_type j = 0; j < ncolumns; ++j )
+            {
+                for( C3::size_type i = 0; i < nframes; ++i ) stack( i, j, k ) = float( ( 7919 * ( i + j ) + k ) % 997 );
+            }
+        }
+        C3::Frame< float > median( ncolumns, nrows );
+        const double npixels = double( ncolumns ) * nrows;
+        const std::string label = std::to_string( nframes ) + " frames";
+
+        report( label + ", copy and std::sort", seconds( [ & ]()
+            {
+                std::vector< float > pixels( nframes );
+                for( C3::size_type k = 0; k < nrows; ++k )
+                {
+                    for( C3::size_type j = 0; j < ncolumns; ++j )
+                    {
+                        const float* src = stack.data() + stack.offset( 0, j, k );
+                        std::copy( src, src + nframes, pixels.begin() );
+                        std::sort( pixels.begin(), pixels.end() );
+                        median( j, k ) = nframes % 2 ? pixels[ nframes / 2 ]
+                            : 0.5f * ( pixels[ nframes / 2 - 1 ] + pixels[ nframes / 2 ] );
+                    }
+                }
+            } ), npixels );
+
+        const auto isa = C3::isa();
+        C3::select_isa( C3::Isa::SCALAR );
+        report( label + ", C3::Median (scalar)", seconds( [ & ]() { C3::reduce( median, stack, C3::Median() ); } ),
+                npixels );
+        C3::select_isa( isa );
+        report( label + ", C3::Median", seconds( [ & ]() { C3::reduce( median, stack, C3::Median() ); } ), npixels );
+    }
+
+}
+
+int main( int argc, char* argv[] )
+{
+
+    const C3::size_type ncolumns = argc > 1 ? atoi( argv[ 1 ] ) : 1024;
+    const C3::size_type nrows    = argc > 2 ? atoi( argv[ 2 ] ) : 4146;
+
+    std::cout << ncolumns << " x " << nrows << " pixels, " << C3::isa_string( C3::isa() ) << std::endl;
+
+    for( C3::size_type nframes : { 3, 5, 8, 11, 15, 25, 50 } ) compare( nframes, ncolumns, nrows );
+
+    C3::Frame< unsigned short > raw( ncolumns, nrows );
+    for( C3::size_type k = 0; k < nrows; ++k )
+    {
+        for( C3::size_type j = 0; j < ncolumns; ++j ) raw( j, k ) = 1000 + ( 7919 * j + 104729 * k ) % 40000;
+    }
+    const double npixels = double( ncolumns ) * nrows;
+    unsigned short result = 0;
+
+    report( "frame, copy and std::sort", seconds( [ & ]()
+        {
+            std::vector< unsigned short > pixels( raw.data(), raw.data() + raw.size() );
+            std::sort( pixels.begin(), pixels.end() );
+            result = pixels[ pixels.size() / 2 ];
+        } ), npixels );
+    report( "frame, C3::Median", seconds( [ & ]() { result = C3::reduce( raw, C3::Median() ); } ), npixels );
+
+    return result == 0;
+
+}
@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "C3_Block.hh"
+#include "C3_Column.hh"
+#include "C3_Frame.hh"
+#include "C3_SigmaClip.hh"
+#include "C3_View.hh"
+
+// Compare overscan levels of a DECam amplifier: the loop of
+// DECam::Overscan::process, two full sorts per row for a median and a
+// median absolute deviation and then one 3-sigma cut, against
+// C3::ClippedMean clipping once and clipping to convergence.
+//
+//      sigma-clip-benchmark [ncolumns [nrows]]
+//
+// Defaults are one DECam overscan strip of a 2160 x 4146 raw frame.
+
+namespace
+{
+
+    using Clock = std::chrono::steady_clock;
+
+    template< class Function >
+    double seconds( Function function, const int repeats = 5 )
+    {
+        double best = 0.0;
+        for( int r = 0; r < repeats; ++r )
+        {
+            const auto start = Clock::now();
+            function();
+            const double elapsed = std::chrono::duration< double >( Clock::now() - start ).count();
+            if( r == 0 || elapsed < best ) best = elapsed;
+        }
+        return best;
+    }
+
+    void report( const std::string& label, const double elapsed, const double npixels )
+    {
+        std::cout << std::left << std::setw( 36 ) << label << std::right << std::fixed << std::setprecision( 4 )
+            << std::setw( 10 ) << elapsed << " s" << std::setw( 10 ) << std::setprecision( 1 )
+            << npixels / elapsed / 1.0e6 << " Mpixel/s" << std::endl;
+    }
+
+}
+
+int main( int argc, char* argv[] )
+{
+
+    const C3::size_type ncolumns = argc > 1 ? atoi( argv[ 1 ] ) : 50;
+    const C3::size_type nrows    = argc > 2 ? atoi( argv[ 2 ] ) : 4096;
+
+    std::cout << ncolumns << " x " << nrows << " overscan pixels" << std::endl;
+
+    // Overscan strip of a raw frame, bias level with noise and a few hot
+    // pixels.
+
+    C3::Frame< double > raw( ncolumns + 10, nrows + 50 );
+    for( C3::size_type k = 0; k < raw.nrows(); ++k )
+    {
+        for( C3::size_type j = 0; j < raw.ncolumns(); ++j )
+        {
+            const auto n = ( 7919 * j + 104729 * k ) % 1009;
+            raw( j, k ) = n % 97 == 0 ? 6.0e4 : 2400.0 + 0.01 * k + 0.02 * double( n % 401 );
+        }
+    }
+    C3::View< double > overscan( raw, ncolumns, nrows, 6, 0 );
+    const double npixels = double( ncolumns ) * nrows;
+
+    C3::Column< double > row_bias( nrows );
+    report( "Overscan::process loop", seconds( [ & ]()
+        {
+            C3::Block< double > weights( overscan.ncolumns() );
+            C3::Block< double > buffer ( overscan.ncolumns() );
+            for( C3::size_type k = 0; k < overscan.nrows(); ++k )
+            {
+                for( C3::size_type j = 0; j < overscan.ncolumns(); ++j ) buffer[ j ] = overscan( j, k );
+                std::sort( buffer.begin(), buffer.end() );
+                auto median = buffer[ buffer.size() / 2 ];
+                for( C3::size_type j = 0; j < overscan.ncolumns(); ++j )
+                {
+                    buffer[ j ] = std::abs( buffer[ j ] - median );
+                }
+                std::sort( buffer.begin(), buffer.end() );
+                auto nmad = 1.4826 * buffer[ buffer.size() / 2 ];
+                for( C3::size_type j = 0; j < overscan.ncolumns(); ++j )
+                {
+                    weights[ j ] = std::abs( overscan( j, k ) - median ) < 3.0 * nmad;
+                }
+                auto wmean = 0.0, wsum = 0.0;
+                for( C3::size_type j = 0; j < overscan.ncolumns(); ++j )
+                {
+                    wmean += weights[ j ] * overscan( j, k );
+                    wsum  += weights[ j ];
+                }
+                row_bias( k ) = wmean / wsum;
+            }
+        } ), npixels );
+
+    C3::Column< double > clipped( nrows );
+    report( "C3::ClippedMean, one pass",
+            seconds( [ & ]() { C3::reduce( clipped, overscan, C3::ClippedMean( 3.0, 1 ) ); } ), npixels );
+    report( "C3::ClippedMean, converged",
+            seconds( [ & ]() { C3::reduce( clipped, overscan, C3::ClippedMean() ); } ), npixels );
+    report( "C3::ClippedMedian, converged",
+            seconds( [ & ]() { C3::reduce( clipped, overscan, C3::ClippedMedian() ); } ), npixels );
+
+    double difference = 0.0;
+    C3::reduce( clipped, overscan, C3::ClippedMean() );
+    for( C3::size_type k = 0; k < nrows; ++k )
+    {
+        difference = std::max( difference, std::fabs( clipped( k ) - row_bias( k ) ) );
+    }
+    std::cout << "Largest difference in level        " << std::scientific << difference << std::endl;
+
+    return 0;
+
+}
@@ -0,0 +1,92 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "C3_Frame.hh"
+#include "C3_Insert.hh"
+#include "C3_Simd.hh"
+#include "C3_Stack.hh"
+
+// Compare ways of filling a stack from a list of frames.
+//
+//      stack-insert-benchmark [nframes [ncolumns [nrows]]]
+//
+// Defaults are 100 frames of one DECam amplifier (1024 x 4146 would be the
+// real thing; use a shorter strip so it fits on a laptop).
+
+namespace
+{
+
+    using Clock = std::chrono::steady_clock;
+
+    template< class Function >
+    double seconds( Function function, const int repeats = 3 )
+    {
+        double best = 0.0;
+        for( int r = 0; r < repeats; ++r )
+        {
+            const auto start = Clock::now();
+            function();
+            const double elapsed = std::chrono::duration< double >( Clock::now() - start ).count();
+            if( r == 0 || elapsed < best ) best = elapsed;
+        }
+        return best;
+    }
+
+    void report( const char* label, const double elapsed, const double npixels )
+    {
+        std::cout << std::left << std::setw( 36 ) << label << std::right << std::fixed << std::setprecision( 4 ) 
+            << std::setw( 10 ) << elapsed << " s" << std::setw( 10 ) << std::setprecision( 1 ) 
+            << npixels / elapsed / 1.0e6 << " Mpixel/s" << std::endl;
+    }
+
+}
+
+int main( int argc, char* argv[] )
+{
+
+    const C3::size_type nframes  = argc > 1 ? atoi( argv[ 1 ] ) : 100;
+    const C3::size_type ncolumns = argc > 2 ? atoi( argv[ 2 ] ) : 1024;
+    const C3::size_type nrows    = argc > 3 ? atoi( argv[ 3 ] ) : 512;
+    const double npixels = double( nframes ) * ncolumns * nrows;
+
+    std::vector< C3::Frame< float > > frames;
+    for( C3::size_type i = 0; i < nframes; ++i ) frames.emplace_back( ncolumns, nrows, float( i ) );
+
+    std::cout << nframes << " frames of " << ncolumns << " x " << nrows << " floats, " 
+        << C3::isa_string( C3::isa() ) << std::endl;
+
+    C3::Stack< float > interleaved( nframes, ncolumns, nrows, 0.0f );
+    C3::Stack< float > planar( nframes, ncolumns, nrows, 0.0f, C3::StackLayout::PLANAR );
+
+    // Frame by frame: one store every nframes pixels.
+
+    report( "interleaved, frame by frame", seconds( [ & ]()
+        {
+            for( C3::size_type i = 0; i < nframes; ++i )
+            {
+                const auto& frame = frames[ i ];
+                for( C3::size_type k = 0; k < nrows; ++k )
+                {
+                    for( C3::size_type j = 0; j < ncolumns; ++j ) interleaved( i, j, k ) = frame( j, k );
+                }
+            }
+        } ), npixels );
+
+    // Batched transpose, scalar and vector.
+
+    const auto isa = C3::isa();
+    C3::select_isa( C3::Isa::SCALAR );
+    report( "interleaved, insert (scalar)", seconds( [ & ]() { C3::insert( interleaved, frames ); } ), npixels );
+    C3::select_isa( isa );
+    report( "interleaved, insert", seconds( [ & ]() { C3::insert( interleaved, frames ); } ), npixels );
+
+    // For reference: no transpose at all.
+
+    report( "planar, insert", seconds( [ & ]() { C3::insert( planar, frames ); } ), npixels );
+
+    return 0;
+
+}
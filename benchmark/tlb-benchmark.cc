@@ -0,0 +1,181 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "C3_Column.hh"
+#include "C3_Frame.hh"
+#include "C3_Memory.hh"
+#include "C3_Operator.hh"
+#include "C3_Row.hh"
+
+// Compare TLB misses of frame sweeps over ordinary and huge pages.
+//
+//      tlb-benchmark [ncolumns [nrows]]
+//
+// Defaults are one DECam CCD in doubles, some 70 MB per frame.  Each page
+// setting gets four frames, like a task's input, output, invvar and flags,
+// and runs two sweeps over them: an overscan-style expression row by row,
+// and a column walk, which touches a new 4 kB page at every pixel.
+//
+// Data TLB load misses come from perf_event_open(2); where that is not
+// allowed (see /proc/sys/kernel/perf_event_paranoid) only times are shown.
+// AnonHugePages says how much of the process the kernel actually put on
+// transparent huge pages; zero means they are off or were not available.
+
+namespace
+{
+
+    using Clock = std::chrono::steady_clock;
+
+    // Data TLB load miss counter for this process, -1 if none.
+
+    class TlbCounter
+    {
+
+        public :
+
+            TlbCounter()
+            {
+                perf_event_attr attr;
+                std::memset( &attr, 0, sizeof( attr ) );
+                attr.size           = sizeof( attr );
+                attr.type           = PERF_TYPE_HW_CACHE;
+                attr.config         = PERF_COUNT_HW_CACHE_DTLB | ( PERF_COUNT_HW_CACHE_OP_READ << 8 )
+                    | ( PERF_COUNT_HW_CACHE_RESULT_MISS << 16 );
+                attr.disabled       = 1;
+                attr.exclude_kernel = 1;
+                attr.exclude_hv     = 1;
+                attr.inherit        = 1;
+                _fd = syscall( SYS_perf_event_open, &attr, 0, -1, -1, 0 );
+            }
+
+            ~TlbCounter() { if( _fd >= 0 ) close( _fd ); }
+
+            void start()
+            {
+                if( _fd < 0 ) return;
+                ioctl( _fd, PERF_EVENT_IOC_RESET, 0 );
+                ioctl( _fd, PERF_EVENT_IOC_ENABLE, 0 );
+            }
+
+            long long stop()
+            {
+                if( _fd < 0 ) return -1;
+                ioctl( _fd, PERF_EVENT_IOC_DISABLE, 0 );
+                long long count = 0;
+                return read( _fd, &count, sizeof( count ) ) == sizeof( count ) ? count : -1;
+            }
+
+        private :
+
+            int _fd;
+
+    };
+
+    // Transparent huge page total of this process in kB.
+
+    long anon_huge_pages()
+    {
+        std::ifstream stream( "/proc/self/smaps_rollup" );
+        std::string key;
+        long value = 0;
+        while( stream >> key )
+        {
+            if( key == "AnonHugePages:" && stream >> value ) return value;
+            stream.ignore( 256, '\n' );
+        }
+        return 0;
+    }
+
+    template< class Function >
+    void report( const char* label, TlbCounter& counter, Function function, const double npixels )
+    {
+        function(); // Warm up.
+        const auto start = Clock::now();
+        counter.start();
+        function();
+        const auto misses = counter.stop();
+        const double elapsed = std::chrono::duration< double >( Clock::now() - start ).count();
+        std::cout << "    " << std::left << std::setw( 16 ) << label << std::right << std::fixed << std::setprecision( 4 )
+            << std::setw( 10 ) << elapsed << " s" << std::setw( 10 ) << std::setprecision( 1 )
+            << npixels / elapsed / 1.0e6 << " Mpixel/s";
+        if( misses >= 0 ) std::cout << std::setw( 14 ) << misses << " dTLB misses";
+        std::cout << std::endl;
+    }
+
+    // Four frames from the selected resource, then both sweeps.
+
+    void sweeps( const char* label, C3::MemoryResource& resource, const C3::size_type ncolumns,
+            const C3::size_type nrows )
+    {
+
+        const double npixels = double( ncolumns ) * nrows;
+        TlbCounter counter;
+
+        auto& previous = C3::select_memory_resource( &resource );
+        const auto before = anon_huge_pages();
+        {
+            C3::Frame< double > input ( ncolumns, nrows, 1.0 );
+            C3::Frame< double > output( ncolumns, nrows, 0.0 );
+            C3::Frame< double > invvar( ncolumns, nrows, 0.0 );
+            C3::Frame< double > flags ( ncolumns, nrows, 0.0 );
+            C3::select_memory_resource( &previous );
+
+            C3::Column< double > bias( nrows, 0.5 );
+            C3::Row< double > gain( ncolumns, 4.3 );
+
+            std::cout << label << ", AnonHugePages " << anon_huge_pages() - before << " kB" << std::endl;
+
+            report( "row sweep", counter, [ & ]()
+                {
+                    output = gain * ( input - bias );
+                    invvar = output + flags;
+                }, 2.0 * npixels );
+
+            report( "column sweep", counter, [ & ]()
+                {
+                    for( C3::size_type j = 0; j < ncolumns; ++j )
+                    {
+                        double sum = 0.0;
+                        for( C3::size_type k = 0; k < nrows; ++k ) sum += input( j, k );
+                        output( j, 0 ) = sum;
+                    }
+                }, npixels );
+        }
+
+    }
+
+}
+
+int main( int argc, char* argv[] )
+{
+
+    const C3::size_type ncolumns = argc > 1 ? atoi( argv[ 1 ] ) : 2160;
+    const C3::size_type nrows    = argc > 2 ? atoi( argv[ 2 ] ) : 4146;
+
+    std::cout << "4 frames of " << ncolumns << " x " << nrows << " doubles" << std::endl;
+
+    C3::AlignedResource aligned;
+    sweeps( "ordinary pages", aligned, ncolumns, nrows );
+
+    C3::HugePageResource transparent( C3::HugePageResource::TRANSPARENT );
+    sweeps( "transparent huge pages", transparent, ncolumns, nrows );
+
+    C3::HugePageResource reserved( C3::HugePageResource::RESERVED );
+    sweeps( "reserved huge pages", reserved, ncolumns, nrows );
+    auto statistics = reserved.statistics();
+    if( statistics.reserved == 0 ) std::cout << "    (no reserved huge pages, fell back)" << std::endl;
+
+    return 0;
+
+}
@@ -26,6 +26,18 @@ namespace C3
     template< class T > class Frame;
     template< class T > class Stack;
     template< class T > class View;
+    template< class T > class StackView;
+
+    // Stack pixel arrangement, defined here for the assignment kernels (see C3_Stack.hh).
+
+    enum class StackLayout
+    {
+        INTERLEAVED, PLANAR, TILED
+    };
+
+    // Expression forward declaration.
+
+    template< class Node > class Expression;
 
 }
 
@@ -0,0 +1,113 @@
+#ifndef C3_ACCUMULATOR_HH
+#define C3_ACCUMULATOR_HH
+
+#include <type_traits>
+
+#include "C3.hh"
+#include "C3_Frame.hh"
+
+namespace C3
+{
+
+    template< class T, class F > class MaskedFrame;
+
+    /// @class Accumulator
+    /// @brief Per-pixel statistics of frames added one at a time.
+    ///
+    /// Combining a calibration set with reduce() needs every exposure in a
+    /// Stack at once.  An accumulator takes the exposures one after another
+    /// instead, into the same frame buffer if need be, and keeps running
+    /// statistics for every pixel, so memory stays a few frames however many
+    /// exposures are combined:
+    ///
+    ///     C3::Accumulator< double > bias( ncolumns, nrows );
+    ///     C3::Frame< float > frame( ncolumns, nrows );
+    ///     for( const auto& path : paths )
+    ///     {
+    ///         C3::FitsLoader( path ).load( frame, "IMAGE" );   // Or Parallel::load().
+    ///         bias.add( frame );
+    ///     }
+    ///     auto sigma = C3::sqrt( bias.variance() );
+    ///
+    /// Means and variances are updated with Welford's recurrence, which does
+    /// not lose precision to large means the way sums of squares do.  Every
+    /// statistic is exact, up to rounding, and the same as from the whole
+    /// stack at once.  Each frame is one fused pass over all of them with
+    /// C3::for_each(), threaded and vectorized.
+    ///
+    /// Masked frames leave out pixels with any flag set or with no inverse
+    /// variance, so counts differ from pixel to pixel, and weight the mean
+    /// of the pixels they keep by inverse variance.  Plain frames weight
+    /// every pixel by one.  Pixels nothing was added to have count, mean,
+    /// weight and weighted mean zero, a NaN variance, and min and max of plus
+    /// and minus infinity.
+    ///
+    /// For approximate quantiles in constant memory see C3_QuantileSketch.hh.
+
+    template< class T >
+    class Accumulator
+    {
+
+        static_assert( std::is_floating_point< T >::value, "Accumulator needs a floating-point value type." );
+
+        public :    // Public methods.
+
+            /// Constructor, nothing added.
+            Accumulator( const size_type ncolumns, const size_type nrows ) noexcept;
+
+            /// Add every pixel of a frame with unit weight.
+            template< class U >
+            Accumulator& add( const Frame< U >& frame );
+
+            /// Add unflagged pixels of a masked frame with inverse-variance weights.
+            template< class U, class F >
+            Accumulator& add( const MaskedFrame< U, F >& frame );
+
+            /// Number of columns and rows.
+            ///@{
+            size_type ncolumns() const { return _count.ncolumns(); }
+            size_type nrows()    const { return _count.nrows();    }
+            ///@}
+
+            /// Number of frames added.
+            size_type nframes() const { return _nframes; }
+
+            /// Number of pixels combined.
+            const Frame< T >& count() const { return _count; }
+
+            /// Arithmetic mean.
+            const Frame< T >& mean() const { return _mean; }
+
+            /// Sample variance, normalized by one less than the count.
+            Frame< T > variance() const;
+
+            /// Smallest and largest pixels.
+            ///@{
+            const Frame< T >& min() const { return _min; }
+            const Frame< T >& max() const { return _max; }
+            ///@}
+
+            /// Sum of weights, the inverse variance of the weighted mean.
+            const Frame< T >& weight() const { return _weight; }
+
+            /// Weighted mean.
+            const Frame< T >& weighted_mean() const { return _wmean; }
+
+        private :   // Private data members.
+
+            size_type   _nframes;   ///< Frames added.
+            Frame< T >  _count;     ///< Pixels combined.
+            Frame< T >  _mean;      ///< Running mean.
+            Frame< T >  _m2;        ///< Running sum of squared deviations from the mean.
+            Frame< T >  _min;       ///< Running minimum.
+            Frame< T >  _max;       ///< Running maximum.
+            Frame< T >  _weight;    ///< Running sum of weights.
+            Frame< T >  _wmean;     ///< Running weighted mean.
+
+    };
+
+}
+
+#include "inline/C3_Accumulator.hh"
+
+#endif
@@ -14,15 +14,16 @@ namespace C3
     /// a C3::assign() call.  For each source container or pixel listed on a given row, columns list destination 
     /// containers that can be assigned to.
     ///
-    ///                 To
-    ///                 Block   Column  Row     Frame   View    Stack
-    ///     From Pixel  YES     YES     YES     YES     YES     YES
-    ///          Block  YES     
-    ///          Column         YES             YES     YES
-    ///          Row                    YES     YES     YES
-    ///          Frame                          YES     YES     YES
-    ///          View                           YES     YES     YES
-    ///          Stack                                          YES
+    ///                     To
+    ///                     Block   Column  Row     Frame   View    Stack   StackView
+    ///     From Pixel      YES     YES     YES     YES     YES     YES     YES
+    ///          Block      YES     
+    ///          Column             YES             YES     YES
+    ///          Row                        YES     YES     YES
+    ///          Frame                              YES     YES     YES     YES
+    ///          View                               YES     YES     YES     YES
+    ///          Stack                                              YES     YES
+    ///          StackView                                          YES     YES
     ///
     /// The first thing to note is that a pixel source can be assigned to any destination container.  The second thing
     /// to note is that a given container can always be assigned to the same kind container.  In all cases, the value 
@@ -37,6 +38,9 @@ namespace C3
     /// the same number of rows.  A mismatch results in a run-time assertion failure, unless the NDEBUG macro has been
     /// defined at compile time.  
     ///
+    /// An Expression (see C3_Expression.hh) can be assigned to any destination container.  It is evaluated in a single
+    /// pass, and each container in it must be allowed as a source for the destination by the table above.
+    ///
     /// @{
 
     /// Directly map the contents of a source container or pixel to a destination container.
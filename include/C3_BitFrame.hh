@@ -0,0 +1,97 @@
+#ifndef C3_BIT_FRAME_HH
+#define C3_BIT_FRAME_HH
+
+#include <cstdint>
+
+#include "C3.hh"
+#include "C3_Block.hh"
+#include "C3_Frame.hh"
+
+namespace C3
+{
+
+    /// @class BitFrame
+    /// @brief Frame of one-bit pixels, packed 64 to a word.
+    ///
+    /// A mask that only says yes or no per pixel takes one sixteenth of the
+    /// memory of a plane of 16-bit flags, so it is cheap to keep around, send
+    /// between processes or combine over many exposures.  Bits are packed
+    /// along rows, least significant bit first, and each row starts on a new
+    /// word, so rows can be handled independently.  Padding bits at the end of
+    /// a row are always clear.
+    ///
+    /// Bit frames are not pixel containers and do not take part in assignment
+    /// or expressions.  They go to and from a plane of flags with pack() and
+    /// unpack():
+    ///
+    ///     C3::BitFrame saturated( ncolumns, nrows );
+    ///     C3::pack( saturated, output.flags(), SATURATED );     // Any of the bits set.
+    ///     ...
+    ///     C3::unpack( output.flags(), saturated, SATURATED );   // OR the bits back in.
+
+    class BitFrame
+    {
+
+        public :    // Public types.
+
+            using word_type = std::uint64_t;
+
+            /// Bits per word.
+            static const size_type word_bits = 64;
+
+        public :    // Public methods.
+
+            /// Constructor, all bits clear.
+            BitFrame( const size_type ncolumns, const size_type nrows );
+
+            /// Initializing constructor.
+            BitFrame( const size_type ncolumns, const size_type nrows, const bool value );
+
+            /// Number of columns and rows.
+            ///@{
+            size_type ncolumns() const { return _ncolumns; }
+            size_type nrows()    const { return _nrows;    }
+            ///@}
+
+            /// Words per row.
+            size_type pitch() const { return _pitch; }
+
+            /// Packed words, row by row.
+            ///@{
+                  word_type* data()       { return _words.data(); }
+            const word_type* data() const { return _words.data(); }
+            ///@}
+
+            /// Bit access.
+            ///@{
+            bool operator() ( const size_type j, const size_type k ) const;
+            void set  ( const size_type j, const size_type k );
+            void reset( const size_type j, const size_type k );
+            ///@}
+
+            /// Number of bits set.
+            size_type count() const;
+
+        private :   // Private data members.
+
+            size_type           _ncolumns;  ///< Total columns.
+            size_type           _nrows;     ///< Total rows.
+            size_type           _pitch;     ///< Words per row.
+            Block< word_type >  _words;     ///< Packed bits.
+
+    };
+
+    /// Set each bit of a bit frame where any of the given bits are set in a plane of flags.  The two must have the
+    /// same shape.
+    template< class F >
+    BitFrame& pack( BitFrame& dest, const Frame< F >& flags, const F bits );
+
+    /// OR the given bits into a plane of flags wherever a bit frame is set.  The two must have the same shape.
+    template< class F >
+    Frame< F >& unpack( Frame< F >& flags, const BitFrame& src, const F bits );
+
+}
+
+#include "inline/C3_BitFrame.hh"
+
+#endif
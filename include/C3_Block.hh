@@ -2,6 +2,7 @@
 #define C3_BLOCK_HH
 
 #include "C3.hh"
+#include "C3_Memory.hh"
 
 namespace C3
 {
@@ -43,6 +44,24 @@ namespace C3
     ///
     /// Other types like std::list are not obviously good alternatives, so we
     /// do not bother considering them.  So native C++ array block it is.
+    ///
+    /// Storage is aligned to C3::alignment bytes rather than whatever new[]
+    /// happens to return.  Together with the ALIGNED row pitch of Frame, this
+    /// lets vector kernels work on whole cache lines.
+    ///
+    /// Storage comes from the memory resource selected at construction (see
+    /// C3_Memory.hh), by default plain aligned system allocation.  Contexts
+    /// select a BufferPool so that blocks built for every task reuse the
+    /// storage of blocks destroyed at the end of the previous one.  Cubes
+    /// too big for memory can live in a MappedResource instead.
+    ///
+    /// A block can also adopt pixels that already live somewhere else, such
+    /// as a CFITSIO memory file, an MPI receive buffer or a shared-memory
+    /// segment.  An adopting block does not own its pixels: it never frees
+    /// them, and they must outlive it.  Everything else, from accessors to
+    /// assignment and expression kernels, works on it as on any other block
+    /// with no copy.  Copies and value type conversions of an adopting block
+    /// own their pixels as usual.
 
     template< class T >
     class Block
@@ -51,19 +70,22 @@ namespace C3
         public :    // Public methods.
 
             /// Constructor.
-            explicit Block( const size_type size ) noexcept;
+            explicit Block( const size_type size );
 
             /// Initializing constructor.
-            Block( const size_type size, const T pixel ) noexcept;
+            Block( const size_type size, const T pixel );
+
+            /// Adopting constructor, wraps size pixels at data without copying or taking ownership.
+            Block( T* data, const size_type size ) noexcept;
 
             /// Copy constructor.
-            Block( const Block& block ) noexcept;
+            Block( const Block& block );
 
             /// Move constructor.
             Block( Block&& block ) noexcept;
 
             /// Copy assignment.
-            Block& operator = ( const Block& block ) noexcept;
+            Block& operator = ( const Block& block );
 
             /// Move assignment.
             Block& operator = ( Block&& block ) noexcept;
@@ -74,6 +96,9 @@ namespace C3
             /// Total elements.
             size_type size() const { return _size; }
 
+            /// True unless the block adopted its pixels.
+            bool owner() const { return _resource != nullptr; }
+
             /// Native C++ array access.
             /// @{
                   T* data()       { return _data; }
@@ -95,9 +120,13 @@ namespace C3
             /// Pixel assignment.
             Block& operator = ( const T pixel ) noexcept;
 
+            /// Expression assignment.
+            template< class Node >
+            Block& operator = ( const Expression< Node >& src );
+
             /// Value type conversion.
             template< class U > 
-            operator Block< U >() const noexcept;
+            operator Block< U >() const;
 
             /// Array subscript access.
             /// @{
@@ -105,10 +134,27 @@ namespace C3
             T  operator [] ( const size_type pos ) const { return _data[ pos ]; }
             /// @}
 
+        protected : // Protected types and methods.
+
+            /// Constructor tag for derived containers that first-touch their own pixels.
+            struct Untouched {};
+
+            /// Constructor that never touches pixels.
+            Block( const size_type size, Untouched );
+
+        private :   // Private methods.
+
+            /// Storage for size pixels from the memory resource, first-touched in bands if asked, and its release.
+            ///@{
+            T* _allocate( const size_type size, const bool touch = false );
+            void _deallocate();
+            ///@}
+
         private :   // Private data members.
 
-            size_type   _size;  ///< Total elements.
-            T*          _data;  ///< Content.
+            size_type       _size;      ///< Total elements.
+            MemoryResource* _resource;  ///< Source of storage, null if adopted.
+            T*              _data;      ///< Content.
 
     };
 
@@ -16,10 +16,13 @@ namespace C3
         public :    // Public methods.
         
             /// Constructor.
-            explicit Column( const size_type nrows ) noexcept;
+            explicit Column( const size_type nrows );
         
             /// Initializing constructor.
-            Column( const size_type nrows, const T pixel ) noexcept;
+            Column( const size_type nrows, const T pixel );
+
+            /// Adopting constructor, wraps pixels at data without copying or taking ownership.
+            Column( T* data, const size_type nrows ) noexcept;
 
             /// Number of rows.
             size_type nrows() const { return this->size(); }
@@ -33,9 +36,13 @@ namespace C3
             /// Pixel assignment.
             Column& operator = ( const T pixel ) noexcept;
 
+            /// Expression assignment.
+            template< class Node >
+            Column& operator = ( const Expression< Node >& src );
+
             /// Value type conversion.
             template< class U >
-            operator Column< U >() const noexcept;
+            operator Column< U >() const;
 
     };
 
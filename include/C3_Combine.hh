@@ -0,0 +1,66 @@
+#ifndef C3_COMBINE_HH
+#define C3_COMBINE_HH
+
+#include "C3.hh"
+
+/// @file
+
+namespace C3
+{
+
+    /// Combine frames pixel by pixel a band of rows at a time, for sets of frames too large to stack in memory.
+    ///
+    /// For each band of rows, the same rows of every input frame are loaded into an INTERLEAVED stack of the band,
+    /// which is reduced into a band of the output (see C3_Reduce.hh) and stored before the next band.  Band height is
+    /// the most rows whose buffers fit in a memory budget, in bytes (see combine_rows()).  Loads are double-buffered:
+    /// the next band loads on a thread of its own while the current one is reduced and stored, so reading overlaps
+    /// computing.
+    ///
+    /// Loading and storing are up to the caller.  With FITS files, one HDU of each input combines into one HDU of
+    /// the output like this:
+    ///
+    ///     C3::FitsCreator creator( "master-zero.fits" );
+    ///     long naxes[ 2 ] = { long( ncolumns ), long( nrows ) };
+    ///     creator.create< float >( "IMAGE", 2, naxes );
+    ///     C3::combine< float, float >( paths.size(), ncolumns, nrows, budget,
+    ///         [ & ]( C3::Frame< float >& rows, const C3::size_type i, const C3::size_type first_row )
+    ///             {
+    ///                 C3::FitsLoader( paths[ i ] ).load_rows( rows, "IMAGE", first_row );
+    ///             },
+    ///         [ & ]( C3::Frame< float >& rows, const C3::size_type first_row )
+    ///             {
+    ///                 creator.store_rows( rows, first_row );
+    ///             },
+    ///         C3::Median() );
+    ///
+    /// Each input is opened once per band, so no more than one input file is open at a time.  Loads run concurrently
+    /// with stores and with each other's threaded kernels, so with CFITSIO it must be built thread-safe
+    /// (--enable-reentrant).  An exception from a load is rethrown from combine().
+    ///
+    /// @param  nframes  Number of input frames.
+    /// @param  ncolumns Number of columns of every frame.
+    /// @param  nrows    Number of rows of every frame.
+    /// @param  budget   Bytes the band buffers may take.
+    /// @param  load     Function load( rows, i, first_row ) filling packed frame rows, one band, with the rows of input
+    ///                  frame i from first_row on.
+    /// @param  store    Function store( rows, first_row ) taking packed frame rows, one band of the output, from
+    ///                  first_row on.
+    /// @param  op       Reduction operator object.
+
+    template< class T, class U, class Load, class Store, class Operator >
+    void combine( const size_type nframes, const size_type ncolumns, const size_type nrows, const size_type budget,
+            Load load, Store store, Operator op );
+
+    /// Rows per band for combine() within a memory budget in bytes, at least one and at most nrows.  The budget
+    /// covers two stacks of the band with value type U, a batch of input bands waiting to go into one of them, and
+    /// the output band with value type T.
+
+    template< class T, class U >
+    size_type combine_rows( const size_type nframes, const size_type ncolumns, const size_type nrows,
+            const size_type budget );
+
+}
+
+#include "inline/C3_Combine.hh"
+
+#endif
@@ -4,7 +4,8 @@
 namespace C3
 {
 
-    /// Check if two pixel containers have allowed congruence.
+    /// Check if two pixel containers have allowed congruence.  Stacks are only congruent with the same layout, but a
+    /// StackView need only match the shape of a Stack or another StackView.
     template< class T, class U > 
     bool congruent( const T& lhs, const U& rhs );
 
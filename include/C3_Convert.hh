@@ -0,0 +1,58 @@
+#ifndef C3_CONVERT_HH
+#define C3_CONVERT_HH
+
+#include "C3.hh"
+
+/// @file
+
+namespace C3
+{
+
+    /// @defgroup conversion
+    /// @brief Convert runs of pixels between value types, optionally through a linear scale.
+    ///
+    /// Raw detector pixels come as 16- or 32-bit integers, C3 works on float or double frames, and output goes back
+    /// to disk as float or integers.  The kernels here do those conversions in one vectorized pass per run of pixels,
+    /// for any pair of value types, under the instruction set in use (see C3_Simd.hh).  Container conversion
+    /// operators and assignment between containers of different value types use them, as do FitsLoader and
+    /// FitsCreator, which apply the BSCALE and BZERO of an HDU in the same pass instead of leaving them to CFITSIO.
+    ///
+    /// @{
+
+    /// Convert pixels as static_cast does: floating-point values truncate toward zero on conversion to integers.
+    ///
+    /// @param  dest  Destination pixels.
+    /// @param  src   Source pixels.
+    /// @param  count Number of pixels.
+
+    template< class T, class U >
+    void convert( T* dest, const U* src, const size_type count );
+
+    /// Convert pixels through a linear scale, dest = src * scale + zero, in the FITS sense of BSCALE and BZERO.
+    ///
+    /// Raw FITS pixels convert to physical values with the HDU's BSCALE and BZERO, and physical values back to raw
+    /// ones with 1 / BSCALE and -BZERO / BSCALE.  Arithmetic is in float where float holds both value types exactly,
+    /// and in double otherwise.  Integer destinations are rounded to nearest and saturate at the limits of their
+    /// value type, as CFITSIO does when it writes scaled data.
+    ///
+    /// @par Example
+    /// Unsigned 16-bit pixels stored as signed ones with BZERO = 32768:
+    ///
+    ///     C3::convert( frame.data(), raw.data(), raw.size(), 1.0, 32768.0 );
+    ///
+    /// @param  dest  Destination pixels.
+    /// @param  src   Source pixels.
+    /// @param  count Number of pixels.
+    /// @param  scale Multiplier.
+    /// @param  zero  Offset added after scaling.
+
+    template< class T, class U >
+    void convert( T* dest, const U* src, const size_type count, const double scale, const double zero );
+
+    /// @}
+
+}
+
+#include "inline/C3_Convert.hh"
+
+#endif
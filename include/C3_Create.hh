@@ -1,23 +1,31 @@
 #ifndef C3_CREATE_HH
 #define C3_CREATE_HH
 
+#include "C3_TypeTraits.hh"
+
 /// @file
 
 namespace C3
 {
 
+    /// Kind of container created from a prototype: the same kind, except that a View creates a Frame and a StackView
+    /// creates a Stack.
+
+    template< class Container > struct Created                   { using type = Container;  };
+    template< class T >         struct Created< View< T > >      { using type = Frame< T >; };
+    template< class T >         struct Created< StackView< T > > { using type = Stack< T >; };
+
     /// From prototype instance with same value type.
 
     template< class Container >
-    Container create( const Container& src );
+    typename Created< Container >::type create( const Container& src );
 
     /// From prototype instance with possibly different value type.
 
     template< class T, template< class > class Container, class U >
-    Container< T > create( const Container< U >& src );
+    typename Created< Container< T > >::type create( const Container< U >& src );
 
     // New containers resulting from unary operators or binary operators may be implemented here too.
-    // Note in docs that creating from a view creates a frame not a view.
 
 }
 
@@ -0,0 +1,152 @@
+#ifndef C3_DISTRIBUTED_HH
+#define C3_DISTRIBUTED_HH
+
+#include <functional>
+#include <vector>
+
+#include <mpi.h>
+
+#include "C3.hh"
+#include "C3_Communicator.hh"
+
+/// @file
+
+namespace C3
+{
+
+    template< class T > class Frame;
+    template< class T, class F > class MaskedFrame;
+
+    struct Sum;
+    struct Mean;
+    struct WeightedMean;
+
+    /// @class MpiRequest
+    /// @brief Distributed reduction in progress.
+    ///
+    /// Returned by the nonblocking reductions below.  The reduction completes, and its result is written into the
+    /// frame it was started on, when wait() returns or test() returns true.  The frame is read when the reduction
+    /// starts, so it may be reused until then, but it must outlive the request.  Dropping a request that has not
+    /// completed, by destroying it or assigning another over it, waits for the MPI requests in progress and nothing
+    /// more: the frame is not written, and the rest of a combine, which gathers across the communicator, never
+    /// happens.  A process unwinding from an exception thus leaves no collective call for the others to wait on.
+
+    class MpiRequest
+    {
+
+        public :    // Public methods.
+
+            /// Constructor, nothing in progress.
+            MpiRequest() noexcept = default;
+
+            /// Constructor, for MPI requests and what to do once they complete.
+            MpiRequest( std::vector< MPI_Request >&& requests, std::function< void() >&& finish ) noexcept;
+
+            /// Move constructor and assignment.
+            ///@{
+            MpiRequest( MpiRequest&& other ) noexcept;
+            MpiRequest& operator = ( MpiRequest&& other ) noexcept;
+            ///@}
+
+            /// Destructor.
+            ~MpiRequest();
+
+            /// True if still in progress.
+            bool pending() const { return ! _requests.empty(); }
+
+            /// Complete if the MPI requests have, true if complete.
+            bool test();
+
+            /// Complete, waiting for the MPI requests.
+            void wait();
+
+        private :   // Private methods.
+
+            /// Run the finishing step and release everything.
+            void _finish_requests();
+
+            /// Wait for the MPI requests without the finishing step, and release everything.
+            void _discard() noexcept;
+
+        private :   // Private data members.
+
+            std::vector< MPI_Request >  _requests;  ///< MPI requests in progress.
+            std::function< void() >     _finish;    ///< Writes the result once the requests complete.
+
+    };
+
+    /// @defgroup distributed
+    /// @brief Reduce frames across the MPI processes of a communicator.
+    ///
+    /// A master bias or flat combines the same frame of every exposure in a night, and each exposure lane of the
+    /// Parallel context handles different exposures.  The processes handling the same frame in every lane share a
+    /// communicator (see Parallel::cross_lane_comm()), and each contributes the frame it built from its exposures:
+    ///
+    ///     C3::Frame< float > zero( ncolumns, nrows );
+    ///     ...                                                     // Mean of this lane's zero exposures.
+    ///     auto request = C3::mpi_iallreduce( zero, context.cross_lane_comm(), C3::Mean() );
+    ///     ...                                                     // Other work meanwhile.
+    ///     request.wait();                                         // Mean of every lane's.
+    ///
+    /// Sums and means go through MPI_Reduce or MPI_Allreduce with MPI_SUM, so the order of additions, and the last
+    /// bits of the result, are up to the MPI library.  Weighted means of masked frames go through a custom operation
+    /// combining mean and weight pairs: a pixel with any flag set or no inverse variance contributes nothing, the
+    /// result's inverse variance is the sum of the rest, and its flags are those set in every input.
+    ///
+    /// Medians and other reductions without an MPI operation are combined by redistribution instead: each process
+    /// sends every other process its share of the frame's rows, reduces the band of rows it receives from all of
+    /// them as a stack with any reduction operator (see C3_Reduce.hh), and the bands are gathered back.  Each pixel
+    /// crosses the network twice whatever the number of processes, and the reduction is shared among them.
+    ///
+    /// Every process of the communicator calls the same reduction with frames of the same shape.  The blocking
+    /// forms are the nonblocking ones waited for at once.
+    ///
+    /// @{
+
+    /// Sum or Mean of frames onto the root process only.  Other processes' frames are left alone.
+    template< class T, class Operator >
+    void mpi_reduce( Frame< T >& frame, const Communicator& comm, const int root, Operator op );
+
+    /// Sum or Mean of frames onto every process.
+    template< class T, class Operator >
+    void mpi_allreduce( Frame< T >& frame, const Communicator& comm, Operator op );
+
+    /// Nonblocking sum or mean of frames onto the root process only.
+    template< class T, class Operator >
+    MpiRequest mpi_ireduce( Frame< T >& frame, const Communicator& comm, const int root, Operator op );
+
+    /// Nonblocking sum or mean of frames onto every process.
+    template< class T, class Operator >
+    MpiRequest mpi_iallreduce( Frame< T >& frame, const Communicator& comm, Operator op );
+
+    /// Weighted mean of masked frames, blocking and nonblocking, onto the root process only or every process.
+    ///@{
+    template< class T, class F >
+    void mpi_reduce( MaskedFrame< T, F >& frame, const Communicator& comm, const int root, WeightedMean op );
+
+    template< class T, class F >
+    void mpi_allreduce( MaskedFrame< T, F >& frame, const Communicator& comm, WeightedMean op );
+
+    template< class T, class F >
+    MpiRequest mpi_ireduce( MaskedFrame< T, F >& frame, const Communicator& comm, const int root, WeightedMean op );
+
+    template< class T, class F >
+    MpiRequest mpi_iallreduce( MaskedFrame< T, F >& frame, const Communicator& comm, WeightedMean op );
+    ///@}
+
+    /// Frames combined onto every process by redistribution, with any reduction operator, for example C3::Median.
+    template< class T, class Operator >
+    void mpi_combine( Frame< T >& frame, const Communicator& comm, Operator op );
+
+    /// Nonblocking combine.  Rows are exchanged in the background; the reduction and the gathering of the result
+    /// happen in wait() or the test() that completes.
+    template< class T, class Operator >
+    MpiRequest mpi_icombine( Frame< T >& frame, const Communicator& comm, Operator op );
+
+    /// @}
+
+}
+
+#include "inline/C3_Distributed.hh"
+
+#endif
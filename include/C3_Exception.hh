@@ -1,6 +1,7 @@
 #ifndef C3_EXCEPTION_HH
 #define C3_EXCEPTION_HH
 
+#include <sstream>
 #include <stdexcept>
 
 namespace C3
@@ -0,0 +1,96 @@
+#ifndef C3_EXPRESSION_HH
+#define C3_EXPRESSION_HH
+
+#include "C3_TypeTraits.hh"
+
+/// @file
+
+namespace C3
+{
+
+    /// @class Expression
+    /// @brief Lazily evaluated pixel arithmetic over containers and pixels.
+    ///
+    /// Arithmetic operators (+, -, *, / and unary minus) and math functions
+    /// (see C3_Math.hh) applied to containers do not compute anything.  They return an Expression that records the
+    /// operation tree, holding containers by reference and pixels by value.
+    /// The tree is evaluated pixel by pixel in a single fused loop when it is
+    /// assigned to a destination container through C3::assign() (or =, +=,
+    /// -=, *=, /=).  No temporary containers are created, so
+    ///
+    ///     output = gain * ( input - bias ) / flat;
+    ///
+    /// reads each input once and writes the output once.
+    ///
+    /// Operands of an expression must be congruent with the destination in
+    /// the sense of CongruenceTraits, which means Row and Column operands
+    /// broadcast over Frame and View destinations just as they do in plain
+    /// assignment, and Frame or View operands broadcast over the frames of a
+    /// Stack or StackView destination.  Mismatches break an assertion at
+    /// assignment.
+    ///
+    /// Since containers are held by reference, an Expression must not outlive
+    /// the containers it refers to.  Normally expressions are temporaries that
+    /// are assigned right away, so this is not an issue, but beware of storing
+    /// one with auto.
+
+    template< class Node >
+    class Expression
+    {
+
+        public :    // Public methods.
+
+            /// Constructor.
+            explicit Expression( const Node& node ) : _node( node ) {}
+
+            /// Operation tree.
+            const Node& node() const { return _node; }
+
+        private :   // Private data members.
+
+            Node    _node;  ///< Operation tree.
+
+    };
+
+    /// Arithmetic operator objects used by expressions.  Unlike std::plus and
+    /// friends these take operands of different value types and return the
+    /// usual arithmetic promotion of them.
+    /// @{
+
+    struct Plus
+    {
+        template< class T, class U >
+        auto operator() ( const T lhs, const U rhs ) const -> decltype( lhs + rhs ) { return lhs + rhs; }
+    };
+
+    struct Minus
+    {
+        template< class T, class U >
+        auto operator() ( const T lhs, const U rhs ) const -> decltype( lhs - rhs ) { return lhs - rhs; }
+    };
+
+    struct Multiplies
+    {
+        template< class T, class U >
+        auto operator() ( const T lhs, const U rhs ) const -> decltype( lhs * rhs ) { return lhs * rhs; }
+    };
+
+    struct Divides
+    {
+        template< class T, class U >
+        auto operator() ( const T lhs, const U rhs ) const -> decltype( lhs / rhs ) { return lhs / rhs; }
+    };
+
+    struct Negate
+    {
+        template< class T >
+        auto operator() ( const T src ) const -> decltype( -src ) { return -src; }
+    };
+
+    /// @}
+
+}
+
+#include "inline/C3_Expression.hh"
+
+#endif
@@ -1,12 +1,17 @@
 #ifndef C3_FITS_CREATOR_HH
 #define C3_FITS_CREATOR_HH
 
+#include <type_traits>
+
+#include "C3.hh"
 #include "C3_FitsResource.hh"
 
 namespace C3
 {
 
     template< class T > class Block;
+    template< class T > class Frame;
+    template< class T, class F > class MaskedFrame;
 
     /// @class FitsCreator
     /// @brief Populate a FITS file with data from Blocks.
@@ -25,6 +30,48 @@ namespace C3
             /// Create HDU and store unconverted data in it.
             template< class T, class U > void create( Block< U >& block, const std::string& extname, const int naxis, long* naxes );
 
+            /// Create HDU and store unconverted frame in it, respecting its row pitch.
+            template< class T > void create( Frame< T >& frame, const std::string& extname, const int naxis, long* naxes );
+
+            /// Create HDU and store converted frame in it, respecting its row pitch.
+            template< class T, class U > void create( Frame< U >& frame, const std::string& extname, const int naxis, long* naxes );
+
+            /// Create HDUs named extname, extname + "_INVVAR" and extname + "_FLAGS" and store unconverted masked frame
+            /// planes in them.
+            template< class T, class F > void create( MaskedFrame< T, F >& frame, const std::string& extname, 
+                    const int naxis, long* naxes );
+
+            /// Create HDUs named extname, extname + "_INVVAR" and extname + "_FLAGS" and store masked frame planes in
+            /// them, converting data and inverse variance.
+            template< class T, class U, class F > void create( MaskedFrame< U, F >& frame, const std::string& extname,
+                    const int naxis, long* naxes );
+
+            /// Create HDU of value type T without storing data, to be stored a band of rows at a time.
+            template< class T > void create( const std::string& extname, const int naxis, long* naxes );
+
+            /// Store unconverted frame as rows from first_row on of the current HDU, respecting its row pitch.
+            template< class T > void store_rows( Frame< T >& frame, const size_type first_row );
+
+            /// Store converted frame as rows from first_row on of the current HDU, respecting its row pitch.
+            template< class T, class U > void store_rows( Frame< U >& frame, const size_type first_row );
+
+        private :   // Private methods.
+
+            /// Write pixels to the current HDU as value type T, converting with the conversion kernels (see
+            /// C3_Convert.hh) rather than CFITSIO.
+            template< class T, class U > void _write( U* src, const long long first, const size_type count );
+
+            /// Write pixels already of the HDU value type.
+            template< class T, class U > void _write( U* src, const long long first, const size_type count,
+                    std::true_type );
+
+            /// Write pixels converted in chunks.
+            template< class T, class U > void _write( U* src, const long long first, const size_type count,
+                    std::false_type );
+
+            /// Set EXTNAME keyword of current HDU.
+            void _write_extname( const std::string& extname );
+
     };
 
 }
@@ -1,11 +1,14 @@
 #ifndef C3_FITS_LOADER_HH
 #define C3_FITS_LOADER_HH
 
+#include "C3.hh"
 #include "C3_FitsResource.hh"
 
 namespace C3
 {
 
+    template< class T, class F > class MaskedFrame;
+
     /// @class FitsLoader
     /// @brief Populate a Block with data from a FITS file.
 
@@ -23,9 +26,48 @@ namespace C3
             /// Load data into pre-allocated block from previously selected HDU.
             template< class T > Block< T >& load( Block< T >& block );
 
+            /// Select HDU and load data into pre-allocated frame, respecting its row pitch.
+            template< class T > Frame< T >& load( Frame< T >& frame, const std::string& extname );
+
+            /// Load data into pre-allocated frame from previously selected HDU, respecting its row pitch.
+            template< class T > Frame< T >& load( Frame< T >& frame );
+
+            /// Select HDU and load rows from first_row on into pre-allocated frame, as many as it has, respecting its
+            /// row pitch.  The HDU must have as many columns as the frame.
+            template< class T > Frame< T >& load_rows( Frame< T >& frame, const std::string& extname,
+                    const size_type first_row );
+
+            /// Load rows from first_row on into pre-allocated frame from previously selected HDU.
+            template< class T > Frame< T >& load_rows( Frame< T >& frame, const size_type first_row );
+
+            /// Load data, inverse variance and flags planes into pre-allocated masked frame from HDUs named extname,
+            /// extname + "_INVVAR" and extname + "_FLAGS".
+            template< class T, class F > MaskedFrame< T, F >& load( MaskedFrame< T, F >& frame, const std::string& extname );
+
             /// Select HDU.
             void select( const std::string& extname );
 
+            /// Number of columns and rows of the selected HDU.
+            ///@{
+            size_type ncolumns();
+            size_type nrows();
+            ///@}
+
+        private :   // Private methods.
+
+            /// Read pixels of the current HDU into a floating-point destination, applying BSCALE and BZERO with the
+            /// conversion kernels (see C3_Convert.hh), or let CFITSIO convert into any other.
+            template< class T > void _read( T* dest, const long long first, const size_type count );
+
+            /// Read raw pixels of value type R and convert them.
+            template< class R, class T > void _read( T* dest, const long long first, const size_type count,
+                    const double scale, const double zero );
+
+            /// Length of one of the first two axes of the current HDU, one if it has fewer.
+            size_type _axis( const int axis );
+
+            /// Read a scaling keyword of the current HDU, or its default if absent.
+            double _read_scaling( const char* keyword, const double default_value );
 
     };
 
@@ -0,0 +1,107 @@
+#ifndef C3_FLAG_HH
+#define C3_FLAG_HH
+
+#include "C3_Expression.hh"
+
+/// @file
+
+namespace C3
+{
+
+    /// Comparison operator objects used by expressions.  Like the arithmetic operator objects (see C3_Expression.hh)
+    /// these take pixels of different value types, compared after the usual arithmetic promotion.
+    /// @{
+
+    struct Less
+    {
+        template< class T, class U > bool operator () ( const T lhs, const U rhs ) const;
+    };
+
+    struct LessEqual
+    {
+        template< class T, class U > bool operator () ( const T lhs, const U rhs ) const;
+    };
+
+    struct Greater
+    {
+        template< class T, class U > bool operator () ( const T lhs, const U rhs ) const;
+    };
+
+    struct GreaterEqual
+    {
+        template< class T, class U > bool operator () ( const T lhs, const U rhs ) const;
+    };
+
+    struct Equal
+    {
+        template< class T, class U > bool operator () ( const T lhs, const U rhs ) const;
+    };
+
+    struct NotEqual
+    {
+        template< class T, class U > bool operator () ( const T lhs, const U rhs ) const;
+    };
+
+    /// @}
+
+    /// Comparisons over containers.
+    ///
+    /// These return an Expression of bool pixels, one per pixel compared.  Operands must be containers or
+    /// expressions, except that one of the two may be a pixel, so a threshold can be one value or a whole map of
+    /// them.  They are named rather than overloaded operators so that comparing containers never silently builds an
+    /// expression where a bool was meant.
+    ///
+    /// @{
+
+    /// Pixels less than, lsrc < rsrc.
+    template< class T, class U >
+    typename _BinaryExpression< Less, T, U >::type less( const T& lsrc, const U& rsrc );
+
+    /// Pixels less than or equal, lsrc <= rsrc.
+    template< class T, class U >
+    typename _BinaryExpression< LessEqual, T, U >::type less_equal( const T& lsrc, const U& rsrc );
+
+    /// Pixels greater than, lsrc > rsrc.
+    template< class T, class U >
+    typename _BinaryExpression< Greater, T, U >::type greater( const T& lsrc, const U& rsrc );
+
+    /// Pixels greater than or equal, lsrc >= rsrc.
+    template< class T, class U >
+    typename _BinaryExpression< GreaterEqual, T, U >::type greater_equal( const T& lsrc, const U& rsrc );
+
+    /// Pixels equal, lsrc == rsrc.
+    template< class T, class U >
+    typename _BinaryExpression< Equal, T, U >::type equal( const T& lsrc, const U& rsrc );
+
+    /// Pixels not equal, lsrc != rsrc.
+    template< class T, class U >
+    typename _BinaryExpression< NotEqual, T, U >::type not_equal( const T& lsrc, const U& rsrc );
+
+    /// @}
+
+    /// Set bits in a flags container wherever a condition holds.
+    ///
+    /// The condition is a comparison as above, or any expression or container whose pixels convert to bool, and must
+    /// be congruent with the flags container in the sense of assignment (see C3_Assign.hh).  Bits are OR-ed into the
+    /// flags, which are otherwise left alone, so successive calls accumulate:
+    ///
+    ///     C3::flag( output.flags(), SATURATED, C3::greater_equal( input, saturation ) );
+    ///     C3::flag( output.flags(), BAD_PIXEL, C3::not_equal( bad_pixel_mask, 0 ) );
+    ///     C3::flag( output.flags(), COSMIC_RAY, C3::greater( C3::abs( residual ), 5.0f * sigma ) );
+    ///
+    /// The comparison and the OR happen in the one fused pass of expression assignment, without branches, so the
+    /// loop vectorizes for each instruction set (see C3_Simd.hh) and writes every flag once.
+    ///
+    /// @param  flags     Destination flags container, of an unsigned integer value type.
+    /// @param  bits      Bits to set.
+    /// @param  condition Expression or container, true where the bits are to be set.
+    /// @return Flags container, can be ignored.
+
+    template< class Flags, class Condition >
+    Flags& flag( Flags& flags, const typename ValueType< Flags >::type bits, const Condition& condition );
+
+}
+
+#include "inline/C3_Flag.hh"
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef C3_FOR_EACH_HH
+#define C3_FOR_EACH_HH
+
+/// @file
+
+namespace C3
+{
+
+    /// Apply a function to corresponding pixels of several containers in one fused pass.
+    ///
+    /// The function is called once per pixel position with a reference to the pixel of each container, in argument
+    /// order, so a single walk over memory can read some containers and write others.
+    ///
+    /// @par Example
+    /// Subtract a per-row bias, then write the output, its inverse variance and its flags together:
+    ///
+    ///     C3::for_each( [ = ]( double& output, double& invvar, unsigned short& flags, const double input,
+    ///                          const double bias )
+    ///         {
+    ///             output = gain * ( input - bias );
+    ///             invvar = input > saturation ? 0.0 : weight;
+    ///             flags  = input > saturation ? SATURATED : 0;
+    ///         }, output, invvar, flags, input, bias );
+    ///
+    /// The first container sets the traversal: a Block, Row or Column is one line, and a Frame or View is a line
+    /// per row.  Every other container must be congruent with the first (see C3_Congruent.hh).  Containers of the
+    /// same traversal, for instance Views and Frames of one shape, are walked in step whatever their row pitch or
+    /// column step, and their pixels are passed by reference.  A Row or Column with a Frame or View first is
+    /// broadcast over the rows or columns, as in assignment, and its pixels are passed by const reference.  Stacks
+    /// are not supported.  A mismatch in shape breaks an assertion, unless NDEBUG is defined.
+    ///
+    /// Lines are split into bands over threads (see C3_Threads.hh), and each line is a loop compiled for the
+    /// instruction set in use (see C3_Simd.hh), so the function is inlined and vectorized where it can be.  It is
+    /// called concurrently from several threads, and must not depend on the order of calls.
+    ///
+    /// @param  op         Function object taking one pixel of each container.
+    /// @param  container  First container, setting the traversal.
+    /// @param  containers Further containers.
+
+    template< class Function, class Container, class... Containers >
+    void for_each( Function op, Container& container, Containers&... containers );
+
+}
+
+#include "inline/C3_ForEach.hh"
+
+#endif
@@ -6,6 +6,26 @@
 namespace C3
 {
 
+    /// @class RowPitch
+    /// @brief Row layout of a Frame.
+    ///
+    /// PACKED rows follow one another with no gap, so the row pitch (pixels
+    /// from the start of one row to the start of the next) equals the number
+    /// of columns.  ALIGNED rows are padded so that every row starts on a
+    /// C3::alignment boundary.  For odd-width frames like DECam's this keeps
+    /// vector loads of each row on whole cache lines.
+    ///
+    /// Padding pixels are zero at construction but are not part of the frame.
+    /// Assignment, expressions, views, FITS I/O and MPI messages in C3 respect
+    /// the pitch, but code that walks a padded frame as a Block (size(),
+    /// begin(), end(), operator[]) sees the padding too.  Use ncolumns(),
+    /// nrows() and pitch() instead.
+
+    enum class RowPitch
+    {
+        PACKED, ALIGNED
+    };
+
     /// @class Frame
     /// @brief Two-dimensional arrangement of pixels.
 
@@ -16,10 +36,16 @@ namespace C3
         public :    // Public methods.
 
             /// Constructor.
-            Frame( const size_type ncolumns, const size_type nrows ) noexcept;
+            Frame( const size_type ncolumns, const size_type nrows, const RowPitch row_pitch = RowPitch::PACKED );
 
             /// Initializing constructor.
-            Frame( const size_type ncolumns, const size_type nrows, const T pixel ) noexcept;
+            Frame( const size_type ncolumns, const size_type nrows, const T pixel, 
+                    const RowPitch row_pitch = RowPitch::PACKED );
+
+            /// Adopting constructor, wraps pixels at data laid out with the given row layout, without copying or
+            /// taking ownership.  Padding is left as it is.
+            Frame( T* data, const size_type ncolumns, const size_type nrows, 
+                    const RowPitch row_pitch = RowPitch::PACKED ) noexcept;
 
             /// Number of columns and rows.
             ///@{
@@ -27,23 +53,46 @@ namespace C3
             size_type nrows()    const { return _nrows;    }
             ///@}
 
+            /// Row layout and pixels from the start of one row to the start of the next.
+            ///@{
+            RowPitch  row_pitch() const { return _row_pitch; }
+            size_type pitch()     const { return _pitch;     }
+            ///@}
+
             /// Coordinate access.
             ///@{
-            T& operator() ( const size_type j, const size_type k )       { return (*this)[ j + _ncolumns * k ]; }
-            T  operator() ( const size_type j, const size_type k ) const { return (*this)[ j + _ncolumns * k ]; }
+            T& operator() ( const size_type j, const size_type k )       { return (*this)[ j + _pitch * k ]; }
+            T  operator() ( const size_type j, const size_type k ) const { return (*this)[ j + _pitch * k ]; }
             ///@}
 
             /// Pixel assignment.
             Frame& operator = ( const T pixel ) noexcept;
 
+            /// Expression assignment.
+            template< class Node >
+            Frame& operator = ( const Expression< Node >& src );
+
             /// Value type conversion.
             template< class U >
-            operator Frame< U >() const noexcept;
+            operator Frame< U >() const;
+
+        private :   // Private methods.
+
+            /// Row pitch for a number of columns under a row layout.
+            static size_type _pitch_for( const size_type ncolumns, const RowPitch row_pitch );
+
+            /// Zero the padding at the end of every row.
+            void _clear_padding();
+
+            /// Fill rows with a pixel and padding with zero, in row bands over threads.
+            void _fill( const T pixel );
 
         private :   // Private data members.
 
             size_type   _ncolumns;  ///< Total columns.
             size_type   _nrows;     ///< Total rows.
+            RowPitch    _row_pitch; ///< Row layout.
+            size_type   _pitch;     ///< Pixels from row to row.
 
     };
 
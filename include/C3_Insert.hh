@@ -0,0 +1,47 @@
+#ifndef C3_INSERT_HH
+#define C3_INSERT_HH
+
+#include <vector>
+
+#include "C3_Stack.hh"
+
+/// @file
+
+namespace C3
+{
+
+    /// Copy a batch of frames or views into consecutive frames of a stack, starting at frame first.
+    ///
+    /// Assigning one frame at a time into an INTERLEAVED stack writes one pixel every nframes, so with hundreds of
+    /// frames every store misses the cache.  This transposes the batch instead: for each row, a cache line worth of
+    /// columns of every frame in the batch is read and written out frame-contiguous, tile by tile, so destination
+    /// pixels are written in order.  Float and double tiles are transposed in AVX2 registers when the instruction set
+    /// in use allows (see C3_Simd.hh); other value types, and value type conversions, transpose pixel by pixel with the
+    /// same blocking.  PLANAR and TILED stacks take contiguous runs of each frame directly.
+    ///
+    /// Every frame must be congruent with the stack, and the batch must fit.  Rows are split into bands over threads
+    /// (see C3_Threads.hh).
+    ///
+    /// @par Example
+    /// Build a cube from a list of exposures:
+    ///
+    ///     std::vector< C3::Frame< float > > exposures = load_exposures();
+    ///     C3::Stack< float > cube( exposures.size(), ncolumns, nrows );
+    ///     C3::insert( cube, exposures );
+    ///
+    /// @param  dest   Destination stack.
+    /// @param  frames Frames or views to copy, or pointers to them.
+    /// @param  first  Stack frame that receives the first of the batch.
+    /// @return Destination stack.
+
+    template< class T, class Source >
+    Stack< T >& insert( Stack< T >& dest, const std::vector< const Source* >& frames, const size_type first = 0 );
+
+    template< class T, class Source >
+    Stack< T >& insert( Stack< T >& dest, const std::vector< Source >& frames, const size_type first = 0 );
+
+}
+
+#include "inline/C3_Insert.hh"
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef C3_MASKED_FRAME_HH
+#define C3_MASKED_FRAME_HH
+
+#include "C3_Frame.hh"
+
+namespace C3
+{
+
+    /// @class MaskedFrame
+    /// @brief Frame of pixels with an inverse variance frame and a flags frame alongside.
+    ///
+    /// Pipeline stages carry their output, its inverse variance and its bit
+    /// flags together.  A masked frame keeps the three planes the same shape
+    /// and updates them together: each arithmetic assignment walks the three
+    /// planes in one fused pass, propagating inverse variance and OR-ing
+    /// flags as it goes.
+    ///
+    ///     C3::MaskedFrame< float, unsigned short > science( ncolumns, nrows );
+    ///     C3::MaskedFrame< float, unsigned short > dark   ( ncolumns, nrows );
+    ///     ...
+    ///     science -= dark;            // Variances add, flags OR.
+    ///     science *= gain / flat;     // Exact operand, invvar scales.
+    ///
+    /// The operand of an arithmetic assignment is either another masked frame
+    /// or anything that can be assigned to a Frame (pixel, Row, Column,
+    /// Frame, View or Expression), which is taken as exact: it has no
+    /// variance and no flags.  First-order error propagation is used, and an
+    /// inverse variance of zero means no information, so it stays zero.
+    ///
+    /// The Serial and Parallel contexts load and save the three planes in one
+    /// call, as HDUs named after the frame with "_INVVAR" and "_FLAGS" added.
+
+    template< class T, class F >
+    class MaskedFrame
+    {
+
+        public :    // Public methods.
+
+            /// Constructor.
+            MaskedFrame( const size_type ncolumns, const size_type nrows,
+                    const RowPitch row_pitch = RowPitch::PACKED );
+
+            /// Initializing constructor.
+            MaskedFrame( const size_type ncolumns, const size_type nrows, const T pixel, const T invvar,
+                    const F flags, const RowPitch row_pitch = RowPitch::PACKED );
+
+            /// Number of columns and rows.
+            ///@{
+            size_type ncolumns() const { return _data.ncolumns(); }
+            size_type nrows()    const { return _data.nrows();    }
+            ///@}
+
+            /// Planes.
+            ///@{
+            Frame< T >&       data()         { return _data;   }
+            const Frame< T >& data()   const { return _data;   }
+            Frame< T >&       invvar()       { return _invvar; }
+            const Frame< T >& invvar() const { return _invvar; }
+            Frame< F >&       flags()        { return _flags;  }
+            const Frame< F >& flags()  const { return _flags;  }
+            ///@}
+
+        private :   // Private data members.
+
+            Frame< T >  _data;      ///< Pixels.
+            Frame< T >  _invvar;    ///< Inverse variance.
+            Frame< F >  _flags;     ///< Bit flags.
+
+    };
+
+    /// Arithmetic assignment operators for masked frames.  These are more
+    /// specialized than the generic ones in C3_Operator.hh, so they are picked
+    /// whenever the destination is a masked frame.
+    /// @{
+
+    /// Masked frame operand.
+    ///@{
+    template< class T, class F, class U, class G >
+    MaskedFrame< T, F >& operator += ( MaskedFrame< T, F >& dest, const MaskedFrame< U, G >& src );
+
+    template< class T, class F, class U, class G >
+    MaskedFrame< T, F >& operator -= ( MaskedFrame< T, F >& dest, const MaskedFrame< U, G >& src );
+
+    template< class T, class F, class U, class G >
+    MaskedFrame< T, F >& operator *= ( MaskedFrame< T, F >& dest, const MaskedFrame< U, G >& src );
+
+    template< class T, class F, class U, class G >
+    MaskedFrame< T, F >& operator /= ( MaskedFrame< T, F >& dest, const MaskedFrame< U, G >& src );
+    ///@}
+
+    /// Exact operand.
+    ///@{
+    template< class T, class F, class Source >
+    MaskedFrame< T, F >& operator += ( MaskedFrame< T, F >& dest, const Source& src );
+
+    template< class T, class F, class Source >
+    MaskedFrame< T, F >& operator -= ( MaskedFrame< T, F >& dest, const Source& src );
+
+    template< class T, class F, class Source >
+    MaskedFrame< T, F >& operator *= ( MaskedFrame< T, F >& dest, const Source& src );
+
+    template< class T, class F, class Source >
+    MaskedFrame< T, F >& operator /= ( MaskedFrame< T, F >& dest, const Source& src );
+    ///@}
+
+    /// @}
+
+}
+
+#include "inline/C3_MaskedFrame.hh"
+
+#endif
@@ -0,0 +1,129 @@
+#ifndef C3_MATH_HH
+#define C3_MATH_HH
+
+#include "C3_Expression.hh"
+
+/// @file
+
+namespace C3
+{
+
+    // Value type of a math function of pixels of value type T: T itself for floating-point pixels, double for
+    // integers, as with the std:: functions.
+
+    template< class T >
+    struct _Real;
+
+    /// Math function objects used by expressions.  Like the arithmetic operator objects (see C3_Expression.hh) these
+    /// take pixels of any value type.  Results are floating-point except for Abs, Minimum and Maximum, which keep the
+    /// arithmetic promotion of their operands.
+    /// @{
+
+    struct Sqrt
+    {
+        template< class T > typename _Real< T >::type operator () ( const T src ) const;
+    };
+
+    struct Abs
+    {
+        template< class T > T operator () ( const T src ) const;
+    };
+
+    struct Reciprocal
+    {
+        template< class T > typename _Real< T >::type operator () ( const T src ) const;
+    };
+
+    struct Log
+    {
+        template< class T > typename _Real< T >::type operator () ( const T src ) const;
+    };
+
+    struct Exp
+    {
+        template< class T > typename _Real< T >::type operator () ( const T src ) const;
+    };
+
+    struct Power
+    {
+        template< class T, class U >
+        auto operator () ( const T base, const U exponent ) const -> typename _Real< decltype( base + exponent ) >::type;
+    };
+
+    struct Minimum
+    {
+        template< class T, class U >
+        auto operator () ( const T lhs, const U rhs ) const -> decltype( lhs + rhs );
+    };
+
+    struct Maximum
+    {
+        template< class T, class U >
+        auto operator () ( const T lhs, const U rhs ) const -> decltype( lhs + rhs );
+    };
+
+    /// @}
+
+    /// Math functions over containers.
+    ///
+    /// Like the arithmetic operators (see C3_Operator.hh) these return an Expression rather than a new container, so
+    /// they fuse with the rest of an expression into a single pass.  Operands must be containers or expressions,
+    /// except that the second and third operands of pow(), min(), max() and clamp() may also be pixels:
+    ///
+    ///     C3::Frame< float > sigma( ncolumns, nrows );
+    ///     sigma = C3::sqrt( C3::reciprocal( invvar ) + C3::pow( flux, 2.0f ) * relative_variance );
+    ///
+    /// The functions evaluate pixel by pixel with routines written without branches, so that they vectorize inside
+    /// the expression loops compiled for each instruction set (see C3_Simd.hh), which the std:: functions do not.
+    /// Over the whole range of float and double, sqrt() is within 1 ulp and log() and exp() are within 2 ulp of the
+    /// correctly rounded result.  Zeros, infinities and NaN give the same results as the std:: functions, and errno
+    /// is never set.
+    ///
+    /// @{
+
+    /// Square root.
+    template< class T >
+    typename _UnaryExpression< Sqrt, T >::type sqrt( const T& src );
+
+    /// Absolute value.
+    template< class T >
+    typename _UnaryExpression< Abs, T >::type abs( const T& src );
+
+    /// Reciprocal, 1 / src.
+    template< class T >
+    typename _UnaryExpression< Reciprocal, T >::type reciprocal( const T& src );
+
+    /// Natural logarithm.
+    template< class T >
+    typename _UnaryExpression< Log, T >::type log( const T& src );
+
+    /// Exponential.
+    template< class T >
+    typename _UnaryExpression< Exp, T >::type exp( const T& src );
+
+    /// Power, computed as exp( exponent * log( base ) ).  Bases must be positive: negative bases give NaN, and zero
+    /// gives zero for positive exponents and NaN for a zero exponent.  Relative error grows with the size of
+    /// exponent * log( base ), to a few parts in 1e13 near the limits of double.
+    template< class T, class U >
+    typename _BinaryExpression< Power, T, U >::type pow( const T& base, const U& exponent );
+
+    /// Lesser of two operands, as std::min.
+    template< class T, class U >
+    typename _BinaryExpression< Minimum, T, U >::type min( const T& lsrc, const U& rsrc );
+
+    /// Greater of two operands, as std::max.
+    template< class T, class U >
+    typename _BinaryExpression< Maximum, T, U >::type max( const T& lsrc, const U& rsrc );
+
+    /// Operand clipped to [low, high], min( max( src, low ), high ).
+    template< class T, class U, class V >
+    auto clamp( const T& src, const U& low, const V& high )
+        -> decltype( C3::min( C3::max( src, low ), high ) );
+
+    /// @}
+
+}
+
+#include "inline/C3_Math.hh"
+
+#endif
@@ -0,0 +1,328 @@
+#ifndef C3_MEMORY_HH
+#define C3_MEMORY_HH
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "C3.hh"
+
+// Block storage alignment in bytes.  Override at compile time with, for
+// example, -DC3_ALIGNMENT=128.  Must be a power of two of at least 64.
+
+#ifndef C3_ALIGNMENT
+#define C3_ALIGNMENT 64
+#endif
+
+/// @file
+
+namespace C3
+{
+
+    /// Alignment in bytes of the first pixel of every Block.  At least a cache line (and an AVX-512 register), so
+    /// vector loads from the start of a block never straddle cache lines.
+    constexpr size_type alignment = C3_ALIGNMENT;
+
+    static_assert( alignment >= 64 && ( alignment & ( alignment - 1 ) ) == 0,
+            "C3_ALIGNMENT must be a power of two of at least 64" );
+
+    /// @class MemoryResource
+    /// @brief Source of Block storage.
+    ///
+    /// Every Block takes its storage from the memory resource selected when
+    /// it is constructed, and gives it back to that same resource when it is
+    /// destroyed.  Resources hand out storage aligned to C3::alignment.  A
+    /// resource must outlive every Block allocated from it.
+
+    class MemoryResource
+    {
+
+        public :    // Public methods.
+
+            /// Destructor.
+            virtual ~MemoryResource() = default;
+
+            /// Storage for a number of bytes.  Throws std::bad_alloc on failure.
+            virtual void* allocate( const size_type bytes ) = 0;
+
+            /// Return storage of a number of bytes obtained from allocate().
+            virtual void deallocate( void* data, const size_type bytes ) = 0;
+
+    };
+
+    /// @class AlignedResource
+    /// @brief Aligned system allocation, the default memory resource.
+
+    class AlignedResource : public MemoryResource
+    {
+
+        public :    // Public methods.
+
+            /// Storage for a number of bytes, from posix_memalign().
+            void* allocate( const size_type bytes ) override;
+
+            /// Return storage to the system.
+            void deallocate( void* data, const size_type bytes ) override;
+
+    };
+
+    /// @class BufferPool
+    /// @brief Memory resource that recycles buffers of the same size.
+    ///
+    /// Processing engines tend to build the same frames and blocks for every
+    /// task.  A pool keeps storage returned by destroyed Blocks and hands it
+    /// to the next Block of the same size in bytes, so after the first task
+    /// the steady state makes no system allocations.  Statistics confirm it:
+    /// once every size has been seen, misses stop growing.
+    ///
+    /// Buffers are only recycled at exactly the same size.  Cached buffers
+    /// are kept until release() or destruction.  Allocation and deallocation
+    /// are thread-safe.
+
+    class BufferPool : public MemoryResource
+    {
+
+        public :    // Public types.
+
+            /// @class Statistics
+            /// @brief Pool usage counts.
+
+            struct Statistics
+            {
+                size_type   hits;           ///< Allocations served from cached buffers.
+                size_type   misses;         ///< Allocations passed to the system.
+                size_type   bytes_in_use;   ///< Bytes currently held by Blocks.
+                size_type   bytes_cached;   ///< Bytes waiting for reuse.
+            };
+
+        public :    // Public methods.
+
+            /// Constructor, buffers come from upstream, or from aligned system allocation given nullptr.  The upstream
+            /// resource must outlive the pool.
+            explicit BufferPool( MemoryResource* upstream = nullptr );
+
+            /// No copy constructor.
+            BufferPool( const BufferPool& pool ) = delete;
+
+            /// No copy assignment operator.
+            BufferPool& operator = ( const BufferPool& pool ) = delete;
+
+            /// Destructor, returns cached buffers to the system.
+            ~BufferPool();
+
+            /// Storage for a number of bytes, recycled if possible.
+            void* allocate( const size_type bytes ) override;
+
+            /// Keep storage for reuse.
+            void deallocate( void* data, const size_type bytes ) override;
+
+            /// Return cached buffers to the system.  Buffers in use are unaffected.
+            void release();
+
+            /// Current statistics.
+            Statistics statistics() const;
+
+            /// Reset hit and miss counts.
+            void reset_statistics();
+
+        private :   // Private data members.
+
+            AlignedResource                                         _aligned;       ///< Default upstream.
+            MemoryResource*                                         _upstream;      ///< Source of new buffers.
+            std::unordered_map< size_type, std::vector< void* > >   _cache;         ///< Free buffers by size.
+            Statistics                                              _statistics {}; ///< Usage counts.
+            mutable std::mutex                                      _mutex;         ///< Guards cache and counts.
+
+    };
+
+    /// @class MappedResource
+    /// @brief Memory resource backed by mmap(), for blocks larger than RAM.
+    ///
+    /// Each allocation is its own mapping.  Given a scratch directory, the
+    /// mapping is shared with a file created there and unlinked at once, so
+    /// the kernel can write dirty pages back to disk and drop them under
+    /// memory pressure; the file disappears when the mapping does.  Without
+    /// a directory, mappings are anonymous with MAP_NORESERVE, so pages cost
+    /// nothing until touched and no swap is reserved for the whole extent.
+    ///
+    /// Given a NAMED file instead, mappings are shared with that file, which
+    /// is created if need be and never truncated or removed.  Allocations are
+    /// laid out one after another from its start, each on a page boundary,
+    /// and the file grows to hold them, so a cube allocated first maps the
+    /// same bytes on every run and stays on disk afterwards, on whichever
+    /// filesystem the path names.
+    ///
+    /// Mappings are page-aligned, which satisfies C3::alignment, and pixels
+    /// are reached through plain pointers, so container accessors and the
+    /// assignment kernels work over mapped storage unchanged.  The access
+    /// advice is passed to madvise() for each mapping: SEQUENTIAL suits the
+    /// frame-by-frame fills and pixel-by-pixel reductions of stack combines.
+    ///
+    /// Select the resource around construction of the large containers only:
+    ///
+    ///     C3::MappedResource mapped( "/scratch" );
+    ///     auto& previous = C3::select_memory_resource( &mapped );
+    ///     C3::Stack< float > cube( nframes, ncolumns, nrows );
+    ///     C3::select_memory_resource( &previous );
+    ///
+    /// or, to keep the cube in a file of its own:
+    ///
+    ///     C3::MappedResource mapped( "/scratch/cube.dat", C3::MappedResource::NAMED );
+
+    class MappedResource : public MemoryResource
+    {
+
+        public :    // Public types.
+
+            /// Expected access pattern, passed to madvise().
+            enum Advice { NORMAL, SEQUENTIAL, RANDOM };
+
+            /// File backing mappings, for the constructor taking a path.
+            enum Backing { SCRATCH, NAMED };
+
+        public :    // Public methods.
+
+            /// Constructor, anonymous mappings unless a scratch directory is given.
+            explicit MappedResource( const std::string& directory = "", const Advice advice = SEQUENTIAL );
+
+            /// Constructor, mappings backed by scratch files in a directory or by one named file.
+            MappedResource( const std::string& path, const Backing backing, const Advice advice = SEQUENTIAL );
+
+            /// Storage for a number of bytes in a new mapping.  Throws C3::Exception if mapping fails.
+            void* allocate( const size_type bytes ) override;
+
+            /// Unmap storage.
+            void deallocate( void* data, const size_type bytes ) override;
+
+            /// Scratch directory, or the named file, empty for anonymous mappings.
+            const std::string& directory() const { return _directory; }
+
+            /// File backing mappings.
+            Backing backing() const { return _backing; }
+
+            /// Access advice.
+            Advice advice() const { return _advice; }
+
+        private :   // Private methods.
+
+            /// Open an unlinked scratch file of a number of bytes, returning its descriptor.
+            int _scratch( const size_type bytes ) const;
+
+            /// Open the named file with room for a number of bytes at offset, returning its descriptor.
+            int _named( const size_type bytes, const size_type offset ) const;
+
+        private :   // Private data members.
+
+            std::string         _directory; ///< Scratch directory or named file.
+            Backing             _backing;   ///< File backing mappings.
+            Advice              _advice;    ///< Access advice.
+            size_type           _end = 0;   ///< End of the last allocation in a named file.
+            mutable std::mutex  _mutex;     ///< Guards the end.
+
+    };
+
+    /// Size in bytes of the huge pages HugePageResource asks for, the x86-64 default.
+    constexpr size_type huge_page_size = 2 << 20;
+
+    /// @class HugePageResource
+    /// @brief Memory resource backing large blocks with 2 MB pages.
+    ///
+    /// A DECam frame of doubles spans some 17,000 ordinary 4 kB pages, far
+    /// more than the TLB holds, so row sweeps and column walks over a few
+    /// such frames miss the TLB constantly.  Backed by 2 MB pages the same
+    /// frame needs 35 entries.
+    ///
+    /// Allocations of at least huge_page_size bytes become their own
+    /// anonymous mappings, aligned to and rounded up to whole huge pages.
+    /// In TRANSPARENT mode the kernel is asked to back them with transparent
+    /// huge pages through madvise(MADV_HUGEPAGE).  RESERVED mode first tries
+    /// MAP_HUGETLB, which draws on pages the administrator set aside (see
+    /// /proc/sys/vm/nr_hugepages), and falls back to TRANSPARENT when none
+    /// are left.  If the kernel refuses the advice too, ordinary pages are
+    /// used; allocation fails only if memory itself runs out.  Statistics
+    /// tell which way each allocation went.  Smaller allocations come from
+    /// an AlignedResource.
+    ///
+    /// Put a BufferPool in front of it (the processing contexts do, given
+    /// huge_pages in the config) so mappings are made once, not per task.
+
+    class HugePageResource : public MemoryResource
+    {
+
+        public :    // Public types.
+
+            /// Where huge pages come from.
+            enum Mode { TRANSPARENT, RESERVED };
+
+            /// @class Statistics
+            /// @brief Counts of large allocations by backing.
+
+            struct Statistics
+            {
+                size_type   reserved;       ///< Mapped from reserved huge pages.
+                size_type   transparent;    ///< Advised to use transparent huge pages.
+                size_type   fallbacks;      ///< Left with ordinary pages.
+            };
+
+        public :    // Public methods.
+
+            /// Constructor.
+            explicit HugePageResource( const Mode mode = TRANSPARENT );
+
+            /// Storage for a number of bytes, on huge pages if large enough.  Throws std::bad_alloc on failure.
+            void* allocate( const size_type bytes ) override;
+
+            /// Return storage.
+            void deallocate( void* data, const size_type bytes ) override;
+
+            /// Huge page source.
+            Mode mode() const { return _mode; }
+
+            /// Current statistics.
+            Statistics statistics() const;
+
+        private :   // Private methods.
+
+            /// Bytes mapped for an allocation of a number of bytes.
+            static size_type _extent( const size_type bytes );
+
+            /// Anonymous mapping of extent bytes aligned to huge_page_size, or nullptr.
+            static void* _map_aligned( const size_type extent );
+
+        private :   // Private data members.
+
+            Mode                _mode;              ///< Huge page source.
+            AlignedResource     _small;             ///< Allocations below a huge page.
+            Statistics          _statistics {};     ///< Allocation counts.
+            mutable std::mutex  _mutex;             ///< Guards counts.
+
+    };
+
+    /// Buffer pool of a processing context, given the huge_pages setting of its config: "off" takes new buffers from
+    /// ordinary pages, and "transparent" or "reserved" from a HugePageResource in that mode, created into
+    /// huge_pages, which must outlive the pool.  Throws C3::Exception for any other setting.
+    std::unique_ptr< BufferPool > context_pool( const std::string& setting,
+            std::unique_ptr< HugePageResource >& huge_pages );
+
+    /// NUMA node of each memory page spanned by a number of bytes at data, from move_pages(2) without moving anything.
+    /// Pages not touched yet report -ENOENT.  Empty if the system cannot say.  Meant for tests and diagnostics of
+    /// first-touch placement (see C3::first_touch()).
+    std::vector< int > page_nodes( const void* data, const size_type bytes );
+
+    /// System allocation resource used when no other is selected.
+    MemoryResource& default_resource();
+
+    /// Memory resource new Blocks allocate from.
+    MemoryResource& memory_resource();
+
+    /// Select memory resource new Blocks allocate from, or the default resource given nullptr.  Returns the previous
+    /// selection.  Not thread-safe: call between tasks, not while threads construct Blocks.
+    MemoryResource& select_memory_resource( MemoryResource* resource );
+
+}
+
+#include "inline/C3_Memory.hh"
+
+#endif
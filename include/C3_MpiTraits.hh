@@ -1,12 +1,25 @@
 #ifndef C3_MPI_TRAITS_HH
 #define C3_MPI_TRAITS_HH
 
+#include <mpi.h>
+
 namespace C3
 {
 
     template< class T >
     struct MpiType {};
 
+    // Datatype member of the MpiType specializations, set from their handle().
+    // Predefined datatypes are constant expressions under some MPI libraries
+    // and addresses of library objects under others, so the member cannot be
+    // initialized in the class.
+
+    template< class M >
+    struct _MpiDatatype
+    {
+        static const MPI_Datatype datatype;
+    };
+
 }
 
 #include "inline/C3_MpiTraits.hh"
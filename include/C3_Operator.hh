@@ -1,6 +1,8 @@
 #ifndef C3_OPERATOR_HH
 #define C3_OPERATOR_HH
 
+#include "C3_Expression.hh"
+
 namespace C3
 {
 
@@ -21,23 +23,35 @@ namespace C3
 
     /// @}
 
-    /// Arithmetic creation operators
+    /// Arithmetic creation operators.
+    ///
+    /// These return an Expression rather than a new container (see C3_Expression.hh).  At least one operand must be a
+    /// container or an expression; the other may also be a pixel.  Nothing is computed until the result is assigned:
+    ///
+    ///     C3::Frame< double > output( ncolumns, nrows );
+    ///     output = ( input - bias ) / flat;
+    ///
     /// @{
 
-//  /// Unary minus.
-//  template< class T > T operator - ( const T& src );
+    /// Unary minus.
+    template< class T >
+    typename _UnaryExpression< Negate, T >::type operator - ( const T& src );
 
-//  /// Addition.
-//  template< class T, class U > T operator + ( const T& lsrc, const U& rsrc );
+    /// Addition.
+    template< class T, class U >
+    typename _BinaryExpression< Plus, T, U >::type operator + ( const T& lsrc, const U& rsrc );
 
-//  /// Subtraction.
-//  template< class T, class U > T operator - ( const T& lsrc, const U& rsrc );
+    /// Subtraction.
+    template< class T, class U >
+    typename _BinaryExpression< Minus, T, U >::type operator - ( const T& lsrc, const U& rsrc );
 
-//  /// Multiplication.
-//  template< class T, class U > T operator * ( const T& lsrc, const U& rsrc );
+    /// Multiplication.
+    template< class T, class U >
+    typename _BinaryExpression< Multiplies, T, U >::type operator * ( const T& lsrc, const U& rsrc );
 
-//  /// Division.
-//  template< class T, class U > T operator / ( const T& lsrc, const U& rsrc );
+    /// Division.
+    template< class T, class U >
+    typename _BinaryExpression< Divides, T, U >::type operator / ( const T& lsrc, const U& rsrc );
 
     /// @}
 
@@ -7,11 +7,13 @@
 
 #include "C3_Communicator.hh"
 #include "C3_FileLogger.hh"
+#include "C3_Memory.hh"
 
 namespace C3
 {
 
     template< class T > class Frame;
+    template< class T, class F > class MaskedFrame;
 
     /// @class Parallel
     /// @brief Multi-frame, parallel execution policy.
@@ -43,10 +45,17 @@ namespace C3
             /// Logger.
             Logger& logger() { return *_logger; }
 
+            /// Buffer pool new Blocks allocate from after initialization.
+            const BufferPool& pool() const { return *_pool; }
+
             /// Load frame.
             template< class T >
             void load( C3::Frame< T >& frame, const std::string& path );
 
+            /// Load masked frame planes.
+            template< class T, class F >
+            void load( C3::MaskedFrame< T, F >& input, const std::string& path );
+
             /// Save unconverted frame.
             template< class T >
             void save( C3::Frame< T >& output, const std::string& path );
@@ -63,12 +72,21 @@ namespace C3
             template< class T, class U, class V >
             void save( C3::Frame< U >& output, C3::Frame< U >& invvar, C3::Frame< V >& flags, const std::string& path );
 
+            /// Save masked frame planes without conversion.
+            template< class T, class F >
+            void save( C3::MaskedFrame< T, F >& output, const std::string& path );
+
+            /// Save masked frame planes with conversion of data and inverse variance.
+            template< class T, class U, class F >
+            void save( C3::MaskedFrame< U, F >& output, const std::string& path );
+
             /// Communicator wrappers.
             ///@{
-            const Communicator& world_comm()    const { return *_world_comm;    }
-            const Communicator& frame_comm()    const { return *_frame_comm;    }
-            const Communicator& exposure_comm() const { return *_exposure_comm; }
-            const Communicator& node_comm()     const { return *_node_comm;     }
+            const Communicator& world_comm()      const { return *_world_comm;      }
+            const Communicator& frame_comm()      const { return *_frame_comm;      }
+            const Communicator& exposure_comm()   const { return *_exposure_comm;   }
+            const Communicator& cross_lane_comm() const { return *_cross_lane_comm; }
+            const Communicator& node_comm()       const { return *_node_comm;       }
             ///@}
 
             /// Exposure lane information.
@@ -98,12 +116,17 @@ namespace C3
             void _init_exposure();                                  // Exposure communicators.
             void _init_logger();
             void _init_openmp();                                    // OpenMP information.
+            void _init_pool();                                      // Block storage recycling.
             void _init_task_queue( int& argc, char**& argv );
             ///@}
 
             /// Hostname of each process in an MPI communicator in rank order.
             std::vector< std::string > _gather_hostnames( const C3::Communicator& comm );
 
+            /// Send frame pixels, without row padding, to the exposure-lane root.
+            template< class T >
+            void _send_to_root( C3::Frame< T >& frame );
+
         protected : // Protected data members.
 
             YAML::Node                  _config;            ///< Configuration.
@@ -114,9 +137,10 @@ namespace C3
 
         private :   // Private data members.
 
-            std::unique_ptr< C3::Communicator > _world_comm;     ///< All MPI processes contained at startup.
-            std::unique_ptr< C3::Communicator > _frame_comm;     ///< MPI processes actively handling frames.
-            std::unique_ptr< C3::Communicator > _exposure_comm;  ///< MPI processes within an exposure lane.
+            std::unique_ptr< C3::Communicator > _world_comm;        ///< All MPI processes contained at startup.
+            std::unique_ptr< C3::Communicator > _frame_comm;        ///< MPI processes actively handling frames.
+            std::unique_ptr< C3::Communicator > _exposure_comm;     ///< MPI processes within an exposure lane.
+            std::unique_ptr< C3::Communicator > _cross_lane_comm;   ///< Same frame in every exposure lane.
     
             int                 _exposure_lanes;            ///< Number of exposure lanes.
             int                 _mpi_processes_per_node;    ///< MPI processes per node.
@@ -127,6 +151,9 @@ namespace C3
 
             std::unique_ptr< FileLogger >   _logger;        ///< Always a file logger.
 
+            std::unique_ptr< HugePageResource > _huge_pages;    ///< Huge page storage, if configured.
+            std::unique_ptr< BufferPool >       _pool;          ///< Recycled Block storage.
+
     };
 
 }
@@ -0,0 +1,81 @@
+#ifndef C3_QUANTILE_HH
+#define C3_QUANTILE_HH
+
+#include "C3_Reduce.hh"
+
+/// @file
+
+namespace C3
+{
+
+    /// @class Quantile
+    /// @brief Reduction operator giving a quantile of pixels.
+    ///
+    /// Master bias, flat and sky frames are per-pixel medians or other
+    /// quantiles over a stack of exposures:
+    ///
+    ///     C3::Stack< float > stack( nexposures, ncolumns, nrows );
+    ///     ...
+    ///     auto master = C3::reduce< C3::Frame >( stack, C3::Median() );
+    ///     auto upper  = C3::reduce< C3::Frame >( stack, C3::Quantile( 0.9 ) );
+    ///
+    /// The quantile interpolates linearly between the two pixels closest to
+    /// position q ( n - 1 ) in sorted order, so the median of an even number of
+    /// pixels is the mean of the middle two.  Nothing is sorted in full: the
+    /// method depends on the number of pixels n.
+    ///
+    /// - Up to 16 pixels, a sorting network trimmed to the comparisons that
+    ///   reach the pixels wanted.  Interleaved stacks hand the operator a
+    ///   whole row of pixels at a time (see C3_Reduce.hh), and the network
+    ///   runs across pixels with one vector lane per pixel, for each
+    ///   instruction set (see C3_Simd.hh).
+    /// - Integer pixels of one or two bytes, from 1024 pixels, counting
+    ///   selection: a histogram of the high byte finds the bin holding the
+    ///   pixel wanted, and a histogram of the low bytes in that bin finds the
+    ///   pixel.  Two passes, whatever the values.
+    /// - Otherwise, selection with std::nth_element on a copy of the pixels,
+    ///   in a buffer kept per thread.
+    ///
+    /// Columns of frames and views reduced into rows are copied out 16 at a
+    /// time, walking down the rows so that every row is read in whole cache
+    /// lines, and then go through the same methods as a batch.
+    ///
+    /// Results are exact order statistics, the same for every method and
+    /// instruction set (see C3_Simd.hh).  NaN pixels have no place in sorted
+    /// order, so the result is unspecified if there are any; flag them and
+    /// leave them out first.
+
+    struct Quantile
+    {
+
+        /// Constructor, for quantile q in [0, 1].
+        explicit Quantile( const double q );
+
+        /// Quantile of a range of pixels.
+        template< class T, class U >
+        C3_NO_FP_CONTRACT void operator () ( T& dest, const U* begin, const U* end ) const;
+
+        /// Quantiles of count ranges of length pixels, one after another.
+        template< class T, class U >
+        void batch( T* dest, const U* src, const size_type count, const size_type length ) const;
+
+        /// Quantiles of ncolumns columns of nrows pixels, rows stride pixels apart.
+        template< class T, class U >
+        void columns( T* dest, const U* src, const size_type ncolumns, const size_type nrows,
+                const size_type stride ) const;
+
+        double  q;  ///< Quantile.
+
+    };
+
+    /// Median, the 0.5 quantile.
+    struct Median : Quantile
+    {
+        Median() : Quantile( 0.5 ) {}
+    };
+
+}
+
+#include "inline/C3_Quantile.hh"
+
+#endif
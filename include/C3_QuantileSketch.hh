@@ -0,0 +1,95 @@
+#ifndef C3_QUANTILE_SKETCH_HH
+#define C3_QUANTILE_SKETCH_HH
+
+#include <type_traits>
+
+#include "C3.hh"
+#include "C3_Block.hh"
+#include "C3_Frame.hh"
+
+namespace C3
+{
+
+    template< class T, class F > class MaskedFrame;
+
+    /// @class QuantileSketch
+    /// @brief Per-pixel estimate of a quantile of frames added one at a time.
+    ///
+    /// Exact quantiles need every exposure at once (see C3_Quantile.hh).  A
+    /// sketch keeps nine numbers per pixel instead, so a median of any number
+    /// of exposures fits in a few frames of memory, like the statistics of
+    /// an Accumulator:
+    ///
+    ///     C3::QuantileSketch< float > sky( ncolumns, nrows );     // Median.
+    ///     for( const auto& path : paths )
+    ///     {
+    ///         C3::FitsLoader( path ).load( frame, "IMAGE" );
+    ///         sky.add( frame );
+    ///     }
+    ///     auto median = sky.estimate();
+    ///
+    /// Each pixel runs the P-square algorithm of Jain and Chlamtac (1985):
+    /// five markers hold the least and greatest pixels, the quantile and two
+    /// points either side of it.  Each new pixel shifts the markers' positions
+    /// in sorted order, and markers that drift from where they should be are
+    /// moved a position along, their heights adjusted by piecewise-parabolic
+    /// interpolation between their neighbours.  The estimate is exact up to
+    /// five pixels and approximate after that, usually to within a small
+    /// fraction of the spread of the pixels for smooth distributions; it
+    /// depends on the order pixels were added in.
+    ///
+    /// Pixels are added in row bands over threads.  Masked frames leave out
+    /// pixels with any flag set or with no inverse variance.  Pixels nothing
+    /// was added to have a NaN estimate.
+
+    template< class T >
+    class QuantileSketch
+    {
+
+        static_assert( std::is_floating_point< T >::value, "QuantileSketch needs a floating-point value type." );
+
+        public :    // Public methods.
+
+            /// Constructor, for quantile q in [0, 1], nothing added.
+            QuantileSketch( const size_type ncolumns, const size_type nrows, const double q = 0.5 ) noexcept;
+
+            /// Add every pixel of a frame.
+            template< class U >
+            QuantileSketch& add( const Frame< U >& frame );
+
+            /// Add unflagged pixels of a masked frame.
+            template< class U, class F >
+            QuantileSketch& add( const MaskedFrame< U, F >& frame );
+
+            /// Number of columns and rows.
+            ///@{
+            size_type ncolumns() const { return _ncolumns; }
+            size_type nrows()    const { return _nrows;    }
+            ///@}
+
+            /// Quantile estimated.
+            double q() const { return _q; }
+
+            /// Estimate so far.
+            Frame< T > estimate() const;
+
+        private :   // Private methods.
+
+            /// Add pixels of rows where keep( j, k ) is true.
+            template< class Source, class Keep >
+            void _add( const Source& src, Keep keep );
+
+        private :   // Private data members.
+
+            size_type   _ncolumns;  ///< Total columns.
+            size_type   _nrows;     ///< Total rows.
+            double      _q;         ///< Quantile.
+            Block< T >  _state;     ///< Per pixel in turn: count, five marker heights, three inner marker positions.
+
+    };
+
+}
+
+#include "inline/C3_QuantileSketch.hh"
+
+#endif
@@ -0,0 +1,227 @@
+#ifndef C3_REDUCE_HH
+#define C3_REDUCE_HH
+
+#include "C3.hh"
+
+/// @file
+
+namespace C3
+{
+
+    /// Reduction operator objects.
+    ///
+    /// A reduction operator reduces a contiguous range of pixels to one destination pixel, computed at the precision
+    /// of the destination's value type:
+    ///
+    ///     template< class T, class U > void operator () ( T& dest, const U* begin, const U* end ) const;
+    ///
+    /// Reduction drivers hand each operator one range per destination pixel, gathering pixels that are not
+    /// contiguous in the source into a buffer first, so any object with this call operator can be used.
+    ///
+    /// An operator may also reduce many ranges in one call, so that it can work across them, one vector lane per
+    /// range:
+    ///
+    ///     template< class T, class U > void batch( T* dest, const U* src, const size_type count,
+    ///             const size_type length ) const;
+    ///
+    /// reduces count ranges of length pixels each, stored one after another from src, into count contiguous
+    /// destination pixels.  Reductions of interleaved stacks hand it a whole row of pixels at a time.
+    ///
+    /// And an operator may reduce columns in place, walking rows rather than gathering each column:
+    ///
+    ///     template< class T, class U > void columns( T* dest, const U* src, const size_type ncolumns,
+    ///             const size_type nrows, const size_type stride ) const;
+    ///
+    /// reduces ncolumns adjacent columns of nrows pixels each, rows stride pixels apart from src, into ncolumns
+    /// contiguous destination pixels.  Reductions of frames and views into rows hand it a band of columns at a time.
+    ///
+    /// The operators below accumulate a range in blocks of fixed size, each block in 16 interleaved partial results
+    /// combined in a fixed tree, and then combine the block results pairwise, again in a fixed order.  The order of
+    /// operations depends only on the length of the range, so results are bitwise reproducible for any number of
+    /// threads and any instruction set (see C3_Simd.hh).  Blocks are reduced by loops that vectorize for each
+    /// instruction set, and ranges of many blocks are split over threads (see C3_Threads.hh).
+    /// Pairwise summation also keeps rounding error growing with the logarithm of the length rather than the length.
+    /// Their column reductions keep the same partial results for a tile of columns side by side and fill them a row
+    /// at a time, vectorized across columns, with the same order of operations per column and so the same results.
+    ///
+    /// Ranges must not be empty, and Variance needs at least two pixels.
+    ///
+    /// @{
+
+    /// Sum of pixels.
+    struct Sum
+    {
+        template< class T, class U > void operator () ( T& dest, const U* begin, const U* end ) const;
+        template< class T, class U > void columns( T* dest, const U* src, const size_type ncolumns,
+                const size_type nrows, const size_type stride ) const;
+    };
+
+    /// Arithmetic mean of pixels.
+    struct Mean
+    {
+        template< class T, class U > void operator () ( T& dest, const U* begin, const U* end ) const;
+        template< class T, class U > void columns( T* dest, const U* src, const size_type ncolumns,
+                const size_type nrows, const size_type stride ) const;
+    };
+
+    /// Sample variance of pixels, normalized by one less than their number.  Computed in two passes, the squared
+    /// deviations from the mean summed in the second, so it does not lose precision when the mean is large.
+    struct Variance
+    {
+        template< class T, class U > void operator () ( T& dest, const U* begin, const U* end ) const;
+        template< class T, class U > void columns( T* dest, const U* src, const size_type ncolumns,
+                const size_type nrows, const size_type stride ) const;
+    };
+
+    /// Smallest pixel.  NaN pixels are ignored unless the first pixel is NaN.
+    struct Min
+    {
+        template< class T, class U > void operator () ( T& dest, const U* begin, const U* end ) const;
+        template< class T, class U > void columns( T* dest, const U* src, const size_type ncolumns,
+                const size_type nrows, const size_type stride ) const;
+    };
+
+    /// Largest pixel.  NaN pixels are ignored unless the first pixel is NaN.
+    struct Max
+    {
+        template< class T, class U > void operator () ( T& dest, const U* begin, const U* end ) const;
+        template< class T, class U > void columns( T* dest, const U* src, const size_type ncolumns,
+                const size_type nrows, const size_type stride ) const;
+    };
+
+    /// @}
+
+    /// @defgroup reduction
+    /// @brief Reduce containers into lower-dimensional containers or pixels.
+    ///
+    /// Reduction is defined only for certain container combinations.  Here is a table listing possible combinations.
+    /// For each source container listed on a given row, columns list which destination containers can be computed by
+    /// reduction.
+    ///
+    ///                  To
+    ///                  Pixel  Column  Row     Frame   View    Stack
+    ///     From Block   YES    no      no      no      no      no
+    ///          Column  YES    no      no      no      no      no
+    ///          Row     YES    no      no      no      no      no
+    ///          Frame   YES    YES     YES     no      no      no
+    ///          View    YES    YES     YES     no      no      no
+    ///          Stack   YES    no      no      YES     YES     no
+    ///
+    /// A Column holds one reduced pixel per row (the reduction runs along each row), a Row one per column (along each
+    /// column), and a Frame or View one per column and row of a Stack (along its frames).
+    ///
+    /// Reduction can be used to create and initialize a new container, except in the case of View.  These must always
+    /// be created before the reduction, and use the in-place (three argument) reduce.
+    ///
+    /// Destination pixels are split over threads in bands, like assignment (see C3_Threads.hh).  Each is computed by
+    /// one call of the operator, so results do not depend on the number of threads.  Rows of frames and pixels of
+    /// interleaved stacks are handed to the operator in place, whole rows of an interleaved stack at a time if the
+    /// operator has a batch reduction.  Columns of frames and views without a column step go to the operator's column
+    /// reduction in bands, if it has one.  Other columns, strided view rows and pixels of planar or tiled stacks are
+    /// gathered into a buffer per thread first.
+    ///
+    /// @{
+
+    /// Create destination container by reducing from source container, both having the same value type.
+    ///
+    /// @par Example
+    /// Reduce a 2048x4096 frame and put the result in a new column containing 4096 pixels/rows having the same value
+    /// type as the original frame.  This column is the sum over all columns for each row:
+    ///
+    ///     C3::Frame< double > frame( 2048, 4096, 2.0 );
+    ///     auto column = C3::reduce< C3::Column >( frame, C3::Sum() );
+    ///     // ... column is a C3::Column< double > with 4096 pixels.
+    ///
+    /// @param  src Source container of larger dimension.
+    /// @param  op Reduction operator object.
+    /// @return Destination container of smaller dimension.
+
+    template< template< class > class Destination, template< class > class Source, class T, class Operator >
+    Destination< T > reduce( const Source< T >& src, Operator op );
+
+    /// Reduce a source container into a single pixel value, both having the same value type.
+    ///
+    /// @par Example
+    /// Sum all the pixels in a frame into a single scalar value.  The value type will be the same as the frame's value
+    /// type.
+    ///
+    ///     C3::Frame< double > frame( 2048, 4096, 2.0 );
+    ///     auto pixel = C3::reduce( frame, C3::Sum() );
+    ///     // ... pixel has type double
+    ///
+    /// @param  src Source container.
+    /// @param  op Reduction operator object.
+    /// @return Destination pixel value.
+
+    template< template< class > class Source, class T, class Operator >
+    T reduce( const Source< T >& src, Operator op );
+
+    /// Create destination container with one value type by reducing from source container with another value type.
+    ///
+    /// @par Example
+    /// Reduce a 2048x4096 frame of value type float and put the result in a new row containing 2048 pixels/columns of
+    /// value type double (not float).  This row is the sum over all rows for each column, and the operation is done
+    /// in the destination container's precision.
+    ///
+    ///     C3::Frame< float > frame( 2048, 4096, 2.0 );
+    ///     auto row = C3::reduce< C3::Row, double >( frame, C3::Sum() );
+    ///     // ... row is a C3::Row< double > (not float) with 2048 pixels.
+    ///
+    /// @param  src Source container of larger dimension.
+    /// @param  op Reduction operator object.
+    /// @return Destination container of smaller dimension.
+
+    template< template< class > class Destination, class T, template< class > class Source, class U, class Operator >
+    Destination< T > reduce( const Source< U >& src, Operator op );
+
+    /// Reduce a source container having one value type into a single pixel value having another value type.
+    ///
+    /// @par Example
+    /// Sum all the pixels in a frame into a single scalar value of some other type.  The reduction is done at the
+    /// precision of the target pixel type.
+    ///
+    ///     C3::Frame< float > frame( 100, 100, 2.0 );
+    ///     auto pixel = C3::reduce< double >( frame, C3::Sum() );
+    ///     // ... pixel has type double (not float).
+    ///
+    /// @param  src Source container.
+    /// @param  op Reduction operator object.
+    /// @return Destination pixel value.
+
+    template< class T, template< class > class Source, class U, class Operator >
+    T reduce( const Source< U >& src, Operator op );
+
+    /// Reduce a source container to existing destination container.
+    ///
+    /// @par Example 1
+    /// Average the pixels in a stack into a single frame of another type.  Here since both the destination and source
+    /// container types can be inferred (they are both arguments to the reduce function) the user does not have to
+    /// supply any template parameters even if they have different value types.
+    ///
+    ///     C3::Stack< float > stack( 10, 100, 100, 2.0 );
+    ///     C3::Frame< double > frame( 100, 100 );
+    ///     C3::reduce( frame, stack, C3::Mean() );
+    ///
+    /// @par Example 2
+    /// Sum all the pixels in a stack into a single pixel.  Again the argument types are known so the right template
+    /// parameters are all inferred by the compiler.
+    ///
+    ///     C3::Stack< float > stack( 10, 100, 100, 2.0 );
+    ///     double x;
+    ///     C3::reduce( x, stack, C3::Sum() ); // return value can be ignored
+    ///
+    /// @param  dest Destination container or pixel, gets modified.
+    /// @param  src Source container.
+    /// @param  op Reduction operator object.
+    /// @return Destination container (optional).
+
+    template< class Destination, class Source, class Operator >
+    Destination& reduce( Destination& dest, const Source& src, Operator op );
+
+    /// @}
+
+}
+
+#include "inline/C3_Reduce.hh"
+
+#endif
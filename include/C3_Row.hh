@@ -16,10 +16,13 @@ namespace C3
         public :    // Public methods.
 
             /// Constructor.
-            explicit Row( const size_type ncolumns ) noexcept;
+            explicit Row( const size_type ncolumns );
 
             /// Initializing constructor.
-            Row( const size_type ncolumns, const T pixel ) noexcept;
+            Row( const size_type ncolumns, const T pixel );
+
+            /// Adopting constructor, wraps pixels at data without copying or taking ownership.
+            Row( T* data, const size_type ncolumns ) noexcept;
 
             /// Number of columns.
             size_type ncolumns() const { return this->size(); }
@@ -33,9 +36,13 @@ namespace C3
             /// Pixel assignment.
             Row& operator = ( const T pixel ) noexcept;
 
+            /// Expression assignment.
+            template< class Node >
+            Row& operator = ( const Expression< Node >& src );
+
             /// Value type conversion.
             template< class U >
-            operator Row< U >() const noexcept;
+            operator Row< U >() const;
 
     };
 
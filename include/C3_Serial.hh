@@ -6,11 +6,13 @@
 #include <yaml-cpp/yaml.h>
 
 #include "C3_Logger.hh"
+#include "C3_Memory.hh"
 
 namespace C3
 {
 
     template< class T > class Frame;
+    template< class T, class F > class MaskedFrame;
 
     /// @class Serial
     /// @brief Single-frame, serial execution policy.
@@ -43,6 +45,10 @@ namespace C3
             template< class T >
             void load( C3::Frame< T >& input, const std::string& path );
 
+            /// Load masked frame planes.
+            template< class T, class F >
+            void load( C3::MaskedFrame< T, F >& input, const std::string& path );
+
             /// Save unconverted frame.
             template< class T >
             void save( C3::Frame< T >& output, const std::string& path );
@@ -59,9 +65,20 @@ namespace C3
             template< class T, class U, class V >
             void save( C3::Frame< U >& output, C3::Frame< U >& invvar, C3::Frame< V >& flags, const std::string& path );
 
+            /// Save masked frame planes without conversion.
+            template< class T, class F >
+            void save( C3::MaskedFrame< T, F >& output, const std::string& path );
+
+            /// Save masked frame planes with conversion of data and inverse variance.
+            template< class T, class U, class F >
+            void save( C3::MaskedFrame< U, F >& output, const std::string& path );
+
             /// Logger.
             Logger& logger() { return *_logger; }
 
+            /// Buffer pool new Blocks allocate from after initialization.
+            const BufferPool& pool() const { return *_pool; }
+
         protected : // Protected methods.
 
             /// Destructor.
@@ -76,14 +93,18 @@ namespace C3
             void _init_logger_defined();
             void _init_logger_default();
             void _init_task_queue( int& argc, char**& argv );
+            void _init_pool();
 
         private : // Private data members.
 
-            YAML::Node                  _config;        ///< Configuration.
-            std::queue< std::string >   _task_files;    ///< Task stream.
-            std::queue< YAML::Node  >   _tasks;         ///< Current task chunk.
+            YAML::Node                          _config;        ///< Configuration.
+            std::queue< std::string >           _task_files;    ///< Task stream.
+            std::queue< YAML::Node  >           _tasks;         ///< Current task chunk.
+
+            std::unique_ptr< Logger >           _logger;        ///< Logger, either standard or file-based.
 
-            std::unique_ptr< Logger >   _logger;        ///< Logger, either standard or file-based.
+            std::unique_ptr< HugePageResource > _huge_pages;    ///< Huge page storage, if configured.
+            std::unique_ptr< BufferPool >       _pool;          ///< Recycled Block storage.
 
     };
 
@@ -0,0 +1,72 @@
+#ifndef C3_SIGMA_CLIP_HH
+#define C3_SIGMA_CLIP_HH
+
+#include "C3_Reduce.hh"
+
+/// @file
+
+namespace C3
+{
+
+    /// @class SigmaClip
+    /// @brief Iterative sigma clipping, the base of the clipped reduction operators.
+    ///
+    /// Overscan levels, sky levels and combines of few exposures want the typical pixel with outliers left out:
+    ///
+    ///     auto bias = C3::reduce< C3::Column >( overscan, C3::ClippedMean() );        // Row by row.
+    ///     auto sky  = C3::reduce< C3::Frame >( stack, C3::ClippedMedian( 2.5, 5 ) );
+    ///
+    /// Each pass leaves out pixels more than nsigma standard deviations of the pixels kept so far from their median,
+    /// until a pass leaves nothing more out or the iterations run out.  Pixels left out stay out.
+    ///
+    /// Nothing is sorted in full.  The pixels are copied into a buffer kept per thread, and the median of those kept
+    /// is selected in place with std::nth_element, which leaves lesser pixels before it and greater ones after.
+    /// Pixels left out are then moved to the ends of the buffer, searched for only on the side of the median they
+    /// can be on, and the pixels kept stay a contiguous window in the middle.  The sums giving the mean and standard
+    /// deviation are in double whatever the pixel type, of deviations from the first median, and have only the
+    /// pixels left out taken away from them, unless those made up most of the sum of squares; the window kept is
+    /// then summed again, as taking away a far outlier would leave little but rounding error.
+    ///
+    /// NaN pixels have no place in sorted order, so the result is unspecified if there are any; flag them and leave
+    /// them out first.
+
+    struct SigmaClip
+    {
+
+        /// Constructor, for a threshold of nsigma standard deviations and at most the given number of passes.
+        explicit SigmaClip( const double nsigma = 3.0, const size_type iterations = 10 );
+
+        double      nsigma;     ///< Clipping threshold in standard deviations.
+        size_type   iterations; ///< Most clipping passes.
+
+    };
+
+    /// Mean of pixels kept by sigma clipping.
+    struct ClippedMean : SigmaClip
+    {
+
+        explicit ClippedMean( const double nsigma = 3.0, const size_type iterations = 10 ) :
+            SigmaClip( nsigma, iterations ) {}
+
+        template< class T, class U >
+        void operator () ( T& dest, const U* begin, const U* end ) const;
+
+    };
+
+    /// Median of pixels kept by sigma clipping, the mean of the middle two of an even number.
+    struct ClippedMedian : SigmaClip
+    {
+
+        explicit ClippedMedian( const double nsigma = 3.0, const size_type iterations = 10 ) :
+            SigmaClip( nsigma, iterations ) {}
+
+        template< class T, class U >
+        void operator () ( T& dest, const U* begin, const U* end ) const;
+
+    };
+
+}
+
+#include "inline/C3_SigmaClip.hh"
+
+#endif
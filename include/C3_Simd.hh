@@ -0,0 +1,82 @@
+#ifndef C3_SIMD_HH
+#define C3_SIMD_HH
+
+#include <string>
+
+#include "C3.hh"
+
+// Explicit vector kernels are compiled on x86-64 with GCC-compatible compilers
+// (GCC, Clang, Intel) unless C3_NO_SIMD is defined.  Each vector kernel is
+// compiled for its instruction set with a function target attribute, so the
+// rest of the application can be built for a baseline processor and still
+// dispatch to AVX2 or AVX-512 code at run time.
+
+// Kernels promise the same results along every code path and instruction set,
+// which only holds if a multiply and an add are never contracted into one
+// multiply-add on some paths and not others.  GCC contracts across statements
+// wherever FMA is enabled, and AVX-512 enables it, so vector kernels and the
+// scalar kernels they must match turn contraction off whatever the build
+// flags.  Clang contracts only within an expression unless built with
+// -ffp-contract=fast, and C3 kernels never write a multiply-add as one
+// expression.  The Intel compiler has no such attribute, so its builds pass
+// -no-fma (see Build.py).
+
+#if defined( __GNUC__ ) && ! defined( __clang__ ) && ! defined( __INTEL_COMPILER )
+#define C3_NO_FP_CONTRACT   __attribute__(( optimize( "fp-contract=off" ) ))
+#else
+#define C3_NO_FP_CONTRACT
+#endif
+
+#if defined( __x86_64__ ) && defined( __GNUC__ ) && ! defined( C3_NO_SIMD )
+#define C3_SIMD_X86
+#define C3_TARGET_AVX2      __attribute__(( target( "avx2,fma" ) )) C3_NO_FP_CONTRACT
+#define C3_TARGET_AVX512    __attribute__(( target( "avx2,fma,avx512f" ) )) C3_NO_FP_CONTRACT
+#endif
+
+// Kernel bodies shared by the scalar and vector versions are forced inline, so
+// each version compiles the body for its own instruction set instead of all of
+// them calling one copy built for the baseline processor.
+
+#if defined( __GNUC__ )
+#define C3_SHARED_BODY      __attribute__(( always_inline ))
+#else
+#define C3_SHARED_BODY
+#endif
+
+/// @file
+
+namespace C3
+{
+
+    /// @class Isa
+    /// @brief Vector instruction sets kernels can dispatch to, in increasing order of capability.
+
+    enum class Isa : unsigned int
+    {
+        SCALAR, AVX2, AVX512
+    };
+
+    /// Most capable instruction set supported by both the processor (CPUID) and the operating system.
+    Isa detected_isa();
+
+    /// Instruction set kernels currently dispatch to.
+    ///
+    /// Defaults to the detected instruction set.  The C3_ISA environment variable ("scalar", "avx2", "avx512") can
+    /// lower it at start-up, for instance to compare results or timings between node generations.
+    Isa isa();
+
+    /// Restrict kernels to an instruction set, clamped to the detected one.  Returns the instruction set now in use.
+    /// Not thread-safe: call before launching threaded work.
+    Isa select_isa( const Isa isa );
+
+    /// Instruction set enum to string.
+    std::string isa_string( const Isa isa );
+
+    /// Instruction set string to enum.  Unrecognized strings map to SCALAR.
+    Isa isa_enum( std::string string );
+
+}
+
+#include "inline/C3_Simd.hh"
+
+#endif
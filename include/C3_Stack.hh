@@ -6,12 +6,38 @@
 namespace C3
 {
 
+    /// Columns per tile of a TILED Stack.  A power of two.
+    constexpr size_type stack_tile = 16;
+
+    static_assert( ( stack_tile & ( stack_tile - 1 ) ) == 0, "stack_tile must be a power of two" );
+
     /// @class Stack
     /// @brief Three-dimensional arrangement of pixels.
     ///
     /// This is a frame stack.  First coordinate indexes over frame, second
-    /// indexes over column, third indexes over row.  This means that pixels at
-    /// a given column and row in the stack are contiguously arranged in memory.
+    /// indexes over column, third indexes over row.  By default pixels at a
+    /// given column and row in the stack are contiguously arranged in memory.
+    /// The pixel arrangement, or StackLayout, is chosen per stack:
+    ///
+    /// INTERLEAVED stacks keep the pixels of every frame at a given column and
+    /// row contiguous, which suits per-pixel combines over frames.  Inserting
+    /// or scaling a single frame, though, strides across the whole cube.
+    ///
+    /// PLANAR stacks are frame-major: each frame is contiguous, like a Frame,
+    /// which suits per-frame operations like scaling or background removal.
+    ///
+    /// TILED stacks split each row into tiles of C3::stack_tile columns and
+    /// keep each tile of every frame together, frame after frame.  Writing one
+    /// frame touches contiguous runs of a tile, and a combine over frames at
+    /// a pixel reads one short run per frame from a compact block.  Rows are
+    /// padded to whole tiles.  Padding pixels are zero at construction but
+    /// are not part of the stack, as for Frame row padding.
+    ///
+    /// The layout is chosen per stack at construction, so each pipeline stage
+    /// can use the layout that streams best.  Coordinate access, assignment,
+    /// expressions, congruence and C3::create() all respect it.  Code that
+    /// walks a stack as a Block (size(), begin(), end(), operator[]) sees the
+    /// raw arrangement.
 
     template< class T >
     class Stack : public Block< T >
@@ -20,10 +46,17 @@ namespace C3
         public :    // Public methods.
 
             /// Constructor.
-            Stack( const size_type nframes, const size_type ncolumns, const size_type nrows ) noexcept;
+            Stack( const size_type nframes, const size_type ncolumns, const size_type nrows, 
+                    const StackLayout layout = StackLayout::INTERLEAVED );
 
             /// Initializing constructor.
-            Stack( const size_type nframes, const size_type ncolumns, const size_type nrows, const T pixel ) noexcept;
+            Stack( const size_type nframes, const size_type ncolumns, const size_type nrows, const T pixel,
+                    const StackLayout layout = StackLayout::INTERLEAVED );
+
+            /// Adopting constructor, wraps pixels at data laid out with the given layout, without copying or taking
+            /// ownership.
+            Stack( T* data, const size_type nframes, const size_type ncolumns, const size_type nrows,
+                    const StackLayout layout = StackLayout::INTERLEAVED ) noexcept;
 
             /// Number of columns and rows.
             ///@{
@@ -32,26 +65,63 @@ namespace C3
             size_type nrows()    const { return _nrows;    }
             ///@}
 
+            /// Pixel arrangement.
+            StackLayout layout() const { return _layout; }
+
+            /// Columns in each contiguous run of one frame: 1 if INTERLEAVED, all of them if PLANAR, C3::stack_tile if 
+            /// TILED.
+            size_type run() const { return _run; }
+
+            /// Offset of a pixel from the start of the stack.
+            size_type offset( const size_type i, const size_type j, const size_type k ) const
+                { return _frame_stride * i + _row_stride * k + _tile_stride * ( j >> _shift ) + ( j & _mask ); }
+
             /// Coordinate access.
             /// @{
             T& operator() ( const size_type i, const size_type j, const size_type k )
-                { return (*this)[ i + nframes() * ( j + ncolumns() * k ) ]; }
+                { return (*this)[ offset( i, j, k ) ]; }
             T  operator() ( const size_type i, const size_type j, const size_type k ) const 
-                { return (*this)[ i + nframes() * ( j + ncolumns() * k ) ]; }
+                { return (*this)[ offset( i, j, k ) ]; }
             /// @}
 
             /// Pixel assignment.
             Stack& operator = ( const T pixel ) noexcept;
 
+            /// Expression assignment.
+            template< class Node >
+            Stack& operator = ( const Expression< Node >& src );
+
             /// Value type conversion.
             template< class U >
-            operator Stack< U >() const noexcept;
+            operator Stack< U >() const;
+
+        private :   // Private methods.
+
+            /// Total elements for a shape under a layout, including padding.
+            static size_type _size_for( const size_type nframes, const size_type ncolumns, const size_type nrows,
+                    const StackLayout layout );
+
+            /// Set up strides for the layout.
+            void _init_layout();
+
+            /// Zero the padding at the end of tiled rows first to last.
+            void _clear_padding( const size_type first, const size_type last );
+
+            /// Fill with a pixel and padding with zero, in row bands over threads.
+            void _fill( const T pixel );
 
         private :   // Private data members.
 
-            size_type   _nframes;   ///< Total frames.
-            size_type   _ncolumns;  ///< Total columns.
-            size_type   _nrows;     ///< Total rows.
+            size_type   _nframes;       ///< Total frames.
+            size_type   _ncolumns;      ///< Total columns.
+            size_type   _nrows;         ///< Total rows.
+            StackLayout _layout;        ///< Pixel arrangement.
+            size_type   _run;           ///< Columns per contiguous run.
+            size_type   _frame_stride;  ///< Offset from frame to frame.
+            size_type   _row_stride;    ///< Offset from row to row.
+            size_type   _tile_stride;   ///< Offset from tile to tile.
+            size_type   _shift;         ///< Column to tile shift.
+            size_type   _mask;          ///< Column within tile mask.
 
     };
 
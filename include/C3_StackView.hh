@@ -0,0 +1,106 @@
+#ifndef C3_STACK_VIEW_HH
+#define C3_STACK_VIEW_HH
+
+#include "C3_Stack.hh"
+
+namespace C3
+{
+
+    /// @class StackView
+    /// @brief Reference to a range of frames and a rectangular section of a stack.
+    ///
+    /// A stack view picks consecutive frames and a pixel region out of a
+    /// stack, or out of another stack view, in which case offsets count from
+    /// the start of that view and the new view refers to the same stack
+    /// directly.  Amplifier sections of a stack can be processed in place:
+    ///
+    ///     C3::StackView< float > amp( stack, stack.nframes(), 1024, 4096, 0, 1024, 0 );
+    ///     amp *= gain;
+    ///
+    /// Coordinate access, assignment, expressions, congruence and C3::create()
+    /// work with stack views as with stacks, whatever the layout of the stack.
+    /// Views never copy pixels, and the stack must outlive them.
+
+    template< class T >
+    class StackView
+    {
+
+        public :    // Public methods.
+
+            /// Constructor.
+            StackView( Stack< T >& stack, const size_type nframes, const size_type ncolumns, const size_type nrows,
+                    const size_type frame_offset, const size_type column_offset, const size_type row_offset ) noexcept;
+
+            /// Sub-view constructor, offsets in frames, columns and rows of the view.
+            StackView( StackView& view, const size_type nframes, const size_type ncolumns, const size_type nrows,
+                    const size_type frame_offset, const size_type column_offset, const size_type row_offset ) noexcept;
+
+            /// Number of frames, columns and rows.
+            ///@{
+            size_type nframes()  const { return _nframes;  }
+            size_type ncolumns() const { return _ncolumns; }
+            size_type nrows()    const { return _nrows;    }
+            ///@}
+
+            /// Referenced stack.
+            ///@{
+                  Stack< T >& stack()       { return *_stack; }
+            const Stack< T >& stack() const { return *_stack; }
+            ///@}
+
+            /// Pixel arrangement of the referenced stack.
+            StackLayout layout() const { return _stack->layout(); }
+
+            /// Native C++ array access, the start of the referenced stack.
+            /// @{
+                  T* data()       { return _stack->data(); }
+            const T* data() const { return _stack->data(); }
+            /// @}
+
+            /// Offset of the view in frames, columns and rows of the referenced stack.
+            ///@{
+            size_type frame_offset()  const { return _frame_offset;  }
+            size_type column_offset() const { return _column_offset; }
+            size_type row_offset()    const { return _row_offset;    }
+            ///@}
+
+            /// Pixels from frame to frame.
+            size_type frame_step() const { return _frame_step; }
+
+            /// Offset of a pixel from the start of the referenced stack.
+            size_type offset( const size_type i, const size_type j, const size_type k ) const
+                { return _stack->offset( _frame_offset + i, _column_offset + j, _row_offset + k ); }
+
+            /// Coordinate access.
+            /// @{
+            T& operator() ( const size_type i, const size_type j, const size_type k )
+                { return data()[ offset( i, j, k ) ]; }
+            T  operator() ( const size_type i, const size_type j, const size_type k ) const 
+                { return data()[ offset( i, j, k ) ]; }
+            /// @}
+
+            /// Pixel assignment.
+            StackView& operator = ( const T pixel ) noexcept;
+
+            /// Expression assignment.
+            template< class Node >
+            StackView& operator = ( const Expression< Node >& src );
+
+        private :   // Private data members.
+
+            Stack< T >*     _stack;         ///< Referenced stack.
+            size_type       _nframes;       ///< Total frames.
+            size_type       _ncolumns;      ///< Total columns.
+            size_type       _nrows;         ///< Total rows.
+            size_type       _frame_offset;  ///< First frame in the stack.
+            size_type       _column_offset; ///< First column in the stack.
+            size_type       _row_offset;    ///< First row in the stack.
+            size_type       _frame_step;    ///< Offset from frame to frame.
+
+    };
+
+}
+
+#include "inline/C3_StackView.hh"
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef C3_THREADS_HH
+#define C3_THREADS_HH
+
+#include "C3.hh"
+
+// Assignment and expression kernels are threaded with OpenMP when the
+// application is compiled with it (-fopenmp, -qopenmp, ...).  Otherwise they
+// always run on the calling thread and the functions below only record
+// settings.
+
+/// @file
+
+namespace C3
+{
+
+    /// Threads assignment kernels may use.
+    ///
+    /// Defaults to one, so kernels stay serial unless asked.  The C3_THREADS environment variable can set it at
+    /// start-up.  A Parallel context sets it to the OpenMP threads it finds per MPI process.
+    int threads();
+
+    /// Set threads assignment kernels may use, at least one.  Returns the number now in use.  Not thread-safe: call
+    /// before launching threaded work.
+    int select_threads( const int nthreads );
+
+    /// Destination pixels below which assignment kernels stay serial regardless of threads().
+    size_type thread_threshold();
+
+    /// Set destination pixels below which assignment kernels stay serial.  Returns the threshold now in use.  Not
+    /// thread-safe: call before launching threaded work.
+    size_type select_thread_threshold( const size_type npixels );
+
+    /// True if new containers first-touch their pixels from the threads that will work on them.
+    ///
+    /// Memory pages land on the NUMA node of the thread that first writes them.  With first touch on, Block(size)
+    /// value-initializes its pixels, and Frame and Stack constructors fill theirs, split over threads exactly as the
+    /// assignment kernels split the same container: flat bands for blocks, row bands for frames and stacks.  Later
+    /// threaded kernels then mostly find their bands in local memory.  Off by default, since uninitialized Blocks then
+    /// cost nothing; initializing constructors fill in bands either way.  The C3_FIRST_TOUCH environment variable (any
+    /// value but 0) turns it on at start-up.  Threads only keep their pages local if OpenMP pins them
+    /// (OMP_PROC_BIND=close or spread).  Use C3::page_nodes() to check placement.
+    bool first_touch();
+
+    /// Turn first touch on or off.  Returns the setting now in use.  Not thread-safe: call before launching threaded
+    /// work.
+    bool select_first_touch( const bool enable );
+
+}
+
+#include "inline/C3_Threads.hh"
+
+#endif
@@ -24,6 +24,9 @@ namespace C3
     template< class T > struct ValueType< Frame < T > > { using type = T; };
     template< class T > struct ValueType< View  < T > > { using type = T; };
     template< class T > struct ValueType< Stack < T > > { using type = T; };
+    template< class T > struct ValueType< StackView< T > > { using type = T; };
+
+    template< class Node > struct ValueType< Expression< Node > > { using type = typename Node::value_type; };
 
     template< class T > struct IsBlock                 { static const bool value = false; };
     template< class T > struct IsBlock< Block< T > >   { static const bool value =  true; };
@@ -43,6 +46,9 @@ namespace C3
     template< class T > struct IsView                   { static const bool value = false; };
     template< class T > struct IsView< View< T > >      { static const bool value =  true; };
 
+    template< class T > struct IsStackView                  { static const bool value = false; };
+    template< class T > struct IsStackView< StackView< T > >{ static const bool value =  true; };
+
     template< class T > struct IsFrameOrView                { static const bool value = false; };
     template< class T > struct IsFrameOrView< Frame< T > >  { static const bool value =  true; };
     template< class T > struct IsFrameOrView<  View< T > >  { static const bool value =  true; };
@@ -54,9 +60,13 @@ namespace C3
             || IsRow< T >::value
             || IsFrame< T >::value
             || IsStack< T >::value
-            || IsView< T >::value;
+            || IsView< T >::value
+            || IsStackView< T >::value;
     };
 
+    template< class T > struct IsExpression                         { static const bool value = false; };
+    template< class Node > struct IsExpression< Expression< Node > >  { static const bool value =  true; };
+
     template< class Head, class Tail >
     struct ContainerPairTraits
     {
@@ -8,6 +8,18 @@ namespace C3
 
     /// @class View
     /// @brief Reference to rectangular section of a frame.
+    ///
+    /// A view is built over a frame or over another view, in which case
+    /// offsets count from the start of that view and the new view refers to
+    /// the same frame directly.  Optional column and row steps pick every Nth
+    /// column or row of the section, so
+    ///
+    ///     C3::View< float > even( frame, frame.ncolumns() / 2, frame.nrows(), 0, 0, 2 );
+    ///
+    /// refers to the even columns of a frame.  Views never copy pixels.
+    /// Assignment and expressions work on strided views too, but rows of a
+    /// view with a column step other than 1 are not contiguous, so they go
+    /// through scalar loops.
 
     template< class T >
     class View 
@@ -16,12 +28,22 @@ namespace C3
         public :    // Public methods.
 
             /// IRAF-style section definitions.
+            ///@{
             static View iraf_style( Frame< T >& frame, const size_type first_column, const size_type final_column,
                     const size_type first_row, const size_type final_row );
+            static View iraf_style( View& view, const size_type first_column, const size_type final_column,
+                    const size_type first_row, const size_type final_row );
+            ///@}
 
             /// Constructor.
             View( Frame< T >& frame, const size_type ncolumns, const size_type nrows, 
-                    const size_type column_offset, const size_type row_offset ) noexcept;
+                    const size_type column_offset, const size_type row_offset, 
+                    const size_type column_step = 1, const size_type row_step = 1 ) noexcept;
+
+            /// Sub-view constructor, offsets and steps in columns and rows of the view.
+            View( View& view, const size_type ncolumns, const size_type nrows, 
+                    const size_type column_offset, const size_type row_offset, 
+                    const size_type column_step = 1, const size_type row_step = 1 ) noexcept;
 
             /// Number of columns and rows.
             ///@{
@@ -35,27 +57,32 @@ namespace C3
             const T* data() const { return _data; }
             /// @}
 
-            /// Start of native C++ array.
+            /// First pixel of the view in the native C++ array.
             /// @{
-                  T* begin()       { return data(); }
-            const T* begin() const { return data(); }
+                  T* begin()       { return _begin; }
+            const T* begin() const { return _begin; }
             /// @}
 
-            /// Referenced frame offset position and stride.
+            /// Referenced frame offset position, pixels from row to row, and pixels from column to column.
             ///@{
             size_type offset() const { return _offset; }
             size_type stride() const { return _stride; }
+            size_type step()   const { return _step;   }
             ///@}
 
             /// Coordinate access.
             ///@{
-            T& operator() ( const size_type j, const size_type k )       { return _begin[ j + _stride * k ]; }
-            T  operator() ( const size_type j, const size_type k ) const { return _begin[ j + _stride * k ]; }
+            T& operator() ( const size_type j, const size_type k )       { return _begin[ _step * j + _stride * k ]; }
+            T  operator() ( const size_type j, const size_type k ) const { return _begin[ _step * j + _stride * k ]; }
             ///@}
 
             /// Pixel assignment.
             View& operator = ( const T pixel ) noexcept;
 
+            /// Expression assignment.
+            template< class Node >
+            View& operator = ( const Expression< Node >& src );
+
         private :   // Private data members.
 
             T*              _data;      ///< Start of data array.
@@ -63,6 +90,7 @@ namespace C3
             size_type       _nrows;     ///< Total rows.
             size_type       _offset;    ///< Block start.
             size_type       _stride;    ///< Block stride.
+            size_type       _step;      ///< Column step.
             T*              _begin;     ///< Data plus offset.
 
     };
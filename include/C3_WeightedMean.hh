@@ -0,0 +1,104 @@
+#ifndef C3_WEIGHTED_MEAN_HH
+#define C3_WEIGHTED_MEAN_HH
+
+#include "C3.hh"
+#include "C3_Column.hh"
+#include "C3_Frame.hh"
+#include "C3_Row.hh"
+#include "C3_Stack.hh"
+
+/// @file
+
+namespace C3
+{
+
+    template< class T, class F > class MaskedFrame;
+
+    /// Weighted reduction operator objects.
+    ///
+    /// Combining calibrated frames takes their inverse variances and flags along with their pixels.  A weighted
+    /// reduction reads pixels x, weights w and flags together and gives, for each destination pixel, the weighted
+    /// mean and its inverse variance
+    ///
+    ///     mean = sum( w x ) / sum( w ),   invvar = sum( w ),
+    ///
+    /// over pixels with no flag set and positive weight, in one pass over the three sources:
+    ///
+    ///     C3::Frame< float > mean( ncolumns, nrows ), invvar( ncolumns, nrows );
+    ///     C3::reduce( mean, invvar, data, weight, flags, C3::WeightedMean() );             // Stacks to frames.
+    ///
+    ///     C3::Row< double > profile( ncolumns ), profile_invvar( ncolumns );
+    ///     C3::reduce( profile, profile_invvar, science, C3::ClippedWeightedMean( 3.0 ) );  // Masked frame to row.
+    ///
+    /// The clipped mean then leaves out pixels more than nsigma standard deviations, their own, from the mean of the
+    /// pixels kept so far, and goes again until no destination pixel keeps a different number of pixels or the
+    /// iterations run out.  Each pass starts from all the pixels again, so a pixel left out once may come back.  The
+    /// passes work on a band of destination pixels at a time, so the sources are read from memory once.
+    ///
+    /// Destination pixels with nothing left have mean and inverse variance zero, which means no information.  NaN
+    /// pixels are left out.
+    ///
+    /// @{
+
+    /// Weighted mean of unflagged pixels.
+    struct WeightedMean
+    {
+    };
+
+    /// Weighted mean of unflagged pixels within nsigma standard deviations of it.
+    struct ClippedWeightedMean
+    {
+
+        /// Constructor.
+        explicit ClippedWeightedMean( const double nsigma = 3.0, const size_type iterations = 5 );
+
+        double      nsigma;     ///< Clipping threshold in standard deviations.
+        size_type   iterations; ///< Most clipping passes after the first, unclipped one.
+
+    };
+
+    /// @}
+
+    /// @addtogroup reduction
+    /// @{
+
+    /// Weighted reduction of stacks into frames, along frames.  The three stacks have the same shape and layout, and
+    /// the destination frames have their columns and rows.
+    ///
+    /// @param  mean    Destination weighted means.
+    /// @param  invvar  Destination inverse variances of the means.
+    /// @param  data    Pixels.
+    /// @param  weight  Inverse variances of the pixels.
+    /// @param  flags   Bit flags, zero for good pixels.
+    /// @param  op      Weighted reduction operator object.
+
+    template< class T, class U, class W, class F, class Operator >
+    void reduce( Frame< T >& mean, Frame< T >& invvar, const Stack< U >& data, const Stack< W >& weight,
+            const Stack< F >& flags, Operator op );
+
+    /// Weighted reduction of frames into columns, along each row.
+    template< class T, class U, class W, class F, class Operator >
+    void reduce( Column< T >& mean, Column< T >& invvar, const Frame< U >& data, const Frame< W >& weight,
+            const Frame< F >& flags, Operator op );
+
+    /// Weighted reduction of frames into rows, along each column.
+    template< class T, class U, class W, class F, class Operator >
+    void reduce( Row< T >& mean, Row< T >& invvar, const Frame< U >& data, const Frame< W >& weight,
+            const Frame< F >& flags, Operator op );
+
+    /// Weighted reduction of a masked frame into columns or rows, weighted by its inverse variance.
+    ///@{
+    template< class T, class U, class F, class Operator >
+    void reduce( Column< T >& mean, Column< T >& invvar, const MaskedFrame< U, F >& src, Operator op );
+
+    template< class T, class U, class F, class Operator >
+    void reduce( Row< T >& mean, Row< T >& invvar, const MaskedFrame< U, F >& src, Operator op );
+    ///@}
+
+    /// @}
+
+}
+
+#include "inline/C3_WeightedMean.hh"
+
+#endif
@@ -0,0 +1,99 @@
+
+#include <limits>
+
+#include "../C3_ForEach.hh"
+#include "../C3_MaskedFrame.hh"
+#include "../C3_Math.hh"
+
+// Internal declarations
+
+namespace C3
+{
+
+    // One pixel x of weight w into the running statistics of its position, if
+    // keep is true.  Without branches, so that for_each() vectorizes it.
+
+    template< class T >
+    void _accumulate( T& count, T& mean, T& m2, T& min, T& max, T& weight, T& wmean, const T x, const T w,
+            const bool keep );
+
+}
+
+// Constructor.
+
+template< class T >
+inline C3::Accumulator< T >::Accumulator( const C3::size_type ncolumns, const C3::size_type nrows ) noexcept :
+    _nframes( 0 ),
+    _count ( ncolumns, nrows, T( 0 ) ),
+    _mean  ( ncolumns, nrows, T( 0 ) ),
+    _m2    ( ncolumns, nrows, T( 0 ) ),
+    _min   ( ncolumns, nrows,  std::numeric_limits< T >::infinity() ),
+    _max   ( ncolumns, nrows, -std::numeric_limits< T >::infinity() ),
+    _weight( ncolumns, nrows, T( 0 ) ),
+    _wmean ( ncolumns, nrows, T( 0 ) )
+{}
+
+// Add frame.
+
+template< class T >
+template< class U >
+inline C3::Accumulator< T >& C3::Accumulator< T >::add( const C3::Frame< U >& frame )
+{
+    C3::for_each( []( T& count, T& mean, T& m2, T& min, T& max, T& weight, T& wmean, const U x )
+        {
+            C3::_accumulate( count, mean, m2, min, max, weight, wmean, static_cast< T >( x ), T( 1 ), true );
+        }, _count, _mean, _m2, _min, _max, _weight, _wmean, frame );
+    ++_nframes;
+    return *this;
+}
+
+// Add masked frame.
+
+template< class T >
+template< class U, class F >
+inline C3::Accumulator< T >& C3::Accumulator< T >::add( const C3::MaskedFrame< U, F >& frame )
+{
+    C3::for_each( []( T& count, T& mean, T& m2, T& min, T& max, T& weight, T& wmean, const U x, const U invvar,
+                const F flags )
+        {
+            const T w = static_cast< T >( invvar );
+            C3::_accumulate( count, mean, m2, min, max, weight, wmean, static_cast< T >( x ), w,
+                    ( flags == F( 0 ) ) & ( w > T( 0 ) ) );
+        }, _count, _mean, _m2, _min, _max, _weight, _wmean, frame.data(), frame.invvar(), frame.flags() );
+    ++_nframes;
+    return *this;
+}
+
+// Sample variance.
+
+template< class T >
+inline C3::Frame< T > C3::Accumulator< T >::variance() const
+{
+    C3::Frame< T > variance( ncolumns(), nrows() );
+    C3::for_each( []( T& dest, const T count, const T m2 )
+        {
+            dest = C3::_select( count > T( 1 ), m2 / ( count - T( 1 ) ), std::numeric_limits< T >::quiet_NaN() );
+        }, variance, _count, _m2 );
+    return variance;
+}
+
+// Welford's update of the mean and of the squared deviations from it, with
+// the deviation from the old mean times the deviation from the new.  The
+// weighted mean moves towards x by the share of the total weight x brings.
+
+template< class T >
+inline void C3::_accumulate( T& count, T& mean, T& m2, T& min, T& max, T& weight, T& wmean, const T x, const T w,
+        const bool keep )
+{
+    const T n       = count + T( keep );
+    const T delta   = x - mean;
+    const T updated = mean + C3::_select( keep, delta / n, T( 0 ) );
+    m2   += C3::_select( keep, delta * ( x - updated ), T( 0 ) );
+    mean  = updated;
+    count = n;
+    min   = C3::_select( keep & ( x < min ), x, min );
+    max   = C3::_select( keep & ( max < x ), x, max );
+    const T total = weight + C3::_select( keep, w, T( 0 ) );
+    wmean += C3::_select( keep, w / total * ( x - wmean ), T( 0 ) );
+    weight = total;
+}
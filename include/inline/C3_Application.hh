@@ -33,6 +33,8 @@ inline int C3::Application< Concurrency, InstrumentTraits, Engine >::run( int& a
             logger.info( "Starting next preprocessing task. " );
             engine.process( context.next_task() );
             logger.info( "Preprocessing task complete. Total tasks completed so far:", ++ counter );
+            auto statistics = context.pool().statistics();
+            logger.debug( "Buffer pool hits / misses so far:", statistics.hits, "/", statistics.misses );
         }
 
         logger.info( "Shutting down preprocessing engine. Total tasks completed:", counter );
@@ -1,8 +1,13 @@
 
 #include <algorithm>
 #include <cassert>
+#include <functional>
 
 #include "../C3_Congruent.hh"
+#include "../C3_Convert.hh"
+#include "../C3_Expression.hh"
+#include "../C3_Simd.hh"
+#include "../C3_Threads.hh"
 
 // Internal declarations
 
@@ -15,14 +20,23 @@ namespace C3
     template< class Destination, class T, class BinaryOperator >
     Destination& _assign( Destination& dest, const T src, BinaryOperator op );
     
+    template< class T, class U, class BinaryOperator >
+    Frame< T >& _assign( Frame< T >& dest, const U src, BinaryOperator op );
+
     template< class T, class U, class BinaryOperator >
     View< T >& _assign( View< T >& dest, const U src, BinaryOperator op );
+
+    template< class T, class U, class BinaryOperator >
+    Stack< T >& _assign( Stack< T >& dest, const U src, BinaryOperator op );
     
     template< template< class > class Container, class T, class U, class BinaryOperator >
     Container< T >& _assign( Container< T >& dest, const Container< U >& src, BinaryOperator op );
     
     template< class T, class U, class BinaryOperator >
     View< T >& _assign( View< T >& dest, const View< U >& src, BinaryOperator op );
+
+    template< class T, class U, class BinaryOperator >
+    Frame< T >& _assign( Frame< T >& dest, const Frame< U >& src, BinaryOperator op );
     
     template< class T, class U, class BinaryOperator >
     Frame< T >& _assign( Frame< T >& dest, const Column< U >& src, BinaryOperator op );
@@ -42,12 +56,48 @@ namespace C3
     template< class T, class U, class BinaryOperator >
     View< T >& _assign( View< T >& dest, const Frame< U >& src, BinaryOperator op );
 
+    template< class T, class U, class BinaryOperator >
+    Stack< T >& _assign( Stack< T >& dest, const Stack< U >& src, BinaryOperator op );
+
     template< class T, class U, class BinaryOperator >
     Stack< T >& _assign( Stack< T >& dest, const Frame< U >& src, BinaryOperator op );
     
     template< class T, class U, class BinaryOperator >
     Stack< T >& _assign( Stack< T >& dest, const View< U >& src, BinaryOperator op );
 
+    template< class T, class U, class BinaryOperator >
+    Stack< T >& _assign( Stack< T >& dest, const StackView< U >& src, BinaryOperator op );
+
+    template< class T, class U, class BinaryOperator >
+    StackView< T >& _assign( StackView< T >& dest, const U src, BinaryOperator op );
+
+    template< class T, class U, class BinaryOperator >
+    StackView< T >& _assign( StackView< T >& dest, const StackView< U >& src, BinaryOperator op );
+
+    template< class T, class U, class BinaryOperator >
+    StackView< T >& _assign( StackView< T >& dest, const Stack< U >& src, BinaryOperator op );
+
+    template< class T, class U, class BinaryOperator >
+    StackView< T >& _assign( StackView< T >& dest, const Frame< U >& src, BinaryOperator op );
+
+    template< class T, class U, class BinaryOperator >
+    StackView< T >& _assign( StackView< T >& dest, const View< U >& src, BinaryOperator op );
+
+    template< class Destination, class Node, class BinaryOperator >
+    Destination& _assign( Destination& dest, const Expression< Node >& src, BinaryOperator op );
+
+    template< class T, class Node, class BinaryOperator >
+    Frame< T >& _assign( Frame< T >& dest, const Expression< Node >& src, BinaryOperator op );
+
+    template< class T, class Node, class BinaryOperator >
+    View< T >& _assign( View< T >& dest, const Expression< Node >& src, BinaryOperator op );
+
+    template< class T, class Node, class BinaryOperator >
+    Stack< T >& _assign( Stack< T >& dest, const Expression< Node >& src, BinaryOperator op );
+
+    template< class T, class Node, class BinaryOperator >
+    StackView< T >& _assign( StackView< T >& dest, const Expression< Node >& src, BinaryOperator op );
+
     // Identity (Binary Pass-Through)
     // ------------------------------
 
@@ -55,18 +105,142 @@ namespace C3
 
     // Assignment Kernel Declarations
     // ------------------------------
+    // Kernels 1 and 2 are the innermost contiguous loops.  Each dispatches at run time to an explicitly vectorized
+    // version for the instruction set in use (see C3_Simd.hh) when the value types and operator have vector
+    // implementations, and otherwise runs its scalar version.  The drivers and kernels 3 to 6 split their outer loops
+    // into bands over threads (see C3_Threads.hh) and call kernels 1 and 2 within each band.
+
+    template< class T, class U, class BinaryOperator >
+    void _assign_kernel_1( T* begin, T* end, const U src, BinaryOperator op );
+
+    template< class T, class U, class BinaryOperator >
+    void _assign_kernel_2( T* dest_begin, const U* src_begin, const U* src_end, BinaryOperator op );
+
+    template< class T, class U, class BinaryOperator >
+    void _assign_kernel_1( T* begin, T* end, const U src, BinaryOperator op, std::false_type );
+
+    template< class T, class U, class BinaryOperator >
+    void _assign_kernel_1( T* begin, T* end, const U src, BinaryOperator op, std::true_type );
+
+    template< class T, class U, class BinaryOperator >
+    void _assign_kernel_2( T* dest_begin, const U* src_begin, const U* src_end, BinaryOperator op, std::false_type );
+
+    template< class T, class U >
+    void _assign_kernel_2( T* dest_begin, const U* src_begin, const U* src_end, Identity, std::false_type );
+
+    template< class T, class U, class BinaryOperator >
+    void _assign_kernel_2( T* dest_begin, const U* src_begin, const U* src_end, BinaryOperator op, std::true_type );
+
+    // Scalar Kernel Declarations
+    // --------------------------
 
     template< class T, class U >
-    void _assign_kernel_1( T* begin, T* end, const U src, Identity );
+    void _scalar_kernel_1( T* begin, T* end, const U src, Identity );
     
     template< class T, class U, class BinaryOperator >
-    void _assign_kernel_1( T* begin, T* end, const U src, BinaryOperator op );
+    void _scalar_kernel_1( T* begin, T* end, const U src, BinaryOperator op );
 
     template< class T, class U >
-    void _assign_kernel_2( T* dest_begin, const U* src_begin, const U* src_end, Identity );
+    void _scalar_kernel_2( T* dest_begin, const U* src_begin, const U* src_end, Identity );
     
     template< class T, class U, class BinaryOperator >
-    void _assign_kernel_2( T* dest_begin, const U* src_begin, const U* src_end, BinaryOperator op );
+    void _scalar_kernel_2( T* dest_begin, const U* src_begin, const U* src_end, BinaryOperator op );
+
+    // Strided Kernel Declarations
+    // ---------------------------
+    // Kernels 1 and 2 over pixels a fixed step apart, as in rows of a strided View.  Unit steps go to kernels 1 and 2.
+
+    template< class T, class U, class BinaryOperator >
+    void _strided_kernel_1( T* begin, const size_type step, const size_type length, const U src, BinaryOperator op );
+
+    template< class T, class U, class BinaryOperator >
+    void _strided_kernel_2( T* dest_begin, const size_type dest_step, const U* src_begin, const size_type src_step,
+            const size_type length, BinaryOperator op );
+
+#ifdef C3_SIMD_X86
+
+    // Vector Kernel Declarations
+    // --------------------------
+
+    template< class T, class U, class BinaryOperator >
+    C3_TARGET_AVX2 void _vector_kernel_1( detail::Avx2, T* begin, T* end, const U src, BinaryOperator op );
+
+    template< class T, class U, class BinaryOperator >
+    C3_TARGET_AVX512 void _vector_kernel_1( detail::Avx512, T* begin, T* end, const U src, BinaryOperator op );
+
+    template< class T, class U, class BinaryOperator >
+    C3_TARGET_AVX2 void _vector_kernel_2( detail::Avx2, T* dest_begin, const U* src_begin, const U* src_end,
+            BinaryOperator op );
+
+    template< class T, class U, class BinaryOperator >
+    C3_TARGET_AVX512 void _vector_kernel_2( detail::Avx512, T* dest_begin, const U* src_begin, const U* src_end,
+            BinaryOperator op );
+
+#endif
+
+    // Pack Operators
+    // --------------
+    // Binary operators on pixels of value type T that have Pack arithmetic.  Operators without a specialization here
+    // are applied by the scalar kernels.
+
+    namespace detail
+    {
+
+        template< class BinaryOperator, class T > struct PackOperator                            { static const bool value = false; };
+        template< class T >                       struct PackOperator< Identity            , T > { static const bool value = true;  };
+        template< class T >                       struct PackOperator< std::plus      < T >, T > { static const bool value = true;  };
+        template< class T >                       struct PackOperator< std::minus     < T >, T > { static const bool value = true;  };
+        template< class T >                       struct PackOperator< std::multiplies< T >, T > { static const bool value = true;  };
+        template< class T >                       struct PackOperator< std::divides   < T >, T > 
+            { static const bool value = std::is_floating_point< T >::value; };
+
+#ifdef C3_SIMD_X86
+
+        // Pack application of those operators, one overload set per instruction set so that each is compiled for
+        // (and inlined into) kernels of the same instruction set.
+
+        template< class Target > struct PackApply;
+
+        template<>
+        struct PackApply< Avx2 >
+        {
+            template< class Pack > C3_TARGET_AVX2 static typename Pack::type 
+                apply( const typename Pack::type    , const typename Pack::type src, Identity ) { return src; }
+            template< class Pack, class T > C3_TARGET_AVX2 static typename Pack::type 
+                apply( const typename Pack::type lhs, const typename Pack::type rhs, std::plus< T > ) { return Pack::add( lhs, rhs ); }
+            template< class Pack, class T > C3_TARGET_AVX2 static typename Pack::type 
+                apply( const typename Pack::type lhs, const typename Pack::type rhs, std::minus< T > ) { return Pack::sub( lhs, rhs ); }
+            template< class Pack, class T > C3_TARGET_AVX2 static typename Pack::type 
+                apply( const typename Pack::type lhs, const typename Pack::type rhs, std::multiplies< T > ) { return Pack::mul( lhs, rhs ); }
+            template< class Pack, class T > C3_TARGET_AVX2 static typename Pack::type 
+                apply( const typename Pack::type lhs, const typename Pack::type rhs, std::divides< T > ) { return Pack::div( lhs, rhs ); }
+        };
+
+        template<>
+        struct PackApply< Avx512 >
+        {
+            template< class Pack > C3_TARGET_AVX512 static typename Pack::type 
+                apply( const typename Pack::type    , const typename Pack::type src, Identity ) { return src; }
+            template< class Pack, class T > C3_TARGET_AVX512 static typename Pack::type 
+                apply( const typename Pack::type lhs, const typename Pack::type rhs, std::plus< T > ) { return Pack::add( lhs, rhs ); }
+            template< class Pack, class T > C3_TARGET_AVX512 static typename Pack::type 
+                apply( const typename Pack::type lhs, const typename Pack::type rhs, std::minus< T > ) { return Pack::sub( lhs, rhs ); }
+            template< class Pack, class T > C3_TARGET_AVX512 static typename Pack::type 
+                apply( const typename Pack::type lhs, const typename Pack::type rhs, std::multiplies< T > ) { return Pack::mul( lhs, rhs ); }
+            template< class Pack, class T > C3_TARGET_AVX512 static typename Pack::type 
+                apply( const typename Pack::type lhs, const typename Pack::type rhs, std::divides< T > ) { return Pack::div( lhs, rhs ); }
+        };
+
+#endif
+
+        /// Kernel dispatch tag: true if assigning pixels of value type U to value type T through the binary operator
+        /// has a vector implementation.
+
+        template< class T, class U, class BinaryOperator >
+        struct IsVectorizable : std::integral_constant< bool, 
+            HasPacks< T, U >::value && PackOperator< BinaryOperator, T >::value > {};
+
+    }
 
     template< class Destination, class Source, class BinaryOperator >
     Destination& _assign_kernel_3( Destination& dest, const Source& src, BinaryOperator op,
@@ -76,6 +250,63 @@ namespace C3
     Destination& _assign_kernel_4( Destination& dest, const Source& src, BinaryOperator op,
         const size_type length, const size_type stride );
 
+    template< class T, class Source, class BinaryOperator >
+    Stack< T >& _assign_kernel_6( Stack< T >& dest, const Source& src, BinaryOperator op );
+
+    template< class T, class U, class BinaryOperator >
+    Stack< T >& _assign_kernel_7( Stack< T >& dest, const Stack< U >& src, BinaryOperator op );
+
+    // Expression Kernel Declarations
+    // ------------------------------
+    // Kernel 5 evaluates an expression line by line into the destination (see C3_Expression.hh).  Each line is one
+    // fused loop, written so the compiler can vectorize it, and compiled once per instruction set so the dispatch
+    // picks up AVX2 or AVX-512 versions of whatever mix of value types and operators the expression has.
+
+    template< class Destination, class Node, class BinaryOperator >
+    Destination& _assign_kernel_5( Destination& dest, const Expression< Node >& src, BinaryOperator op );
+
+    template< class T, class Node, class BinaryOperator >
+    Stack< T >& _assign_kernel_5( Stack< T >& dest, const Expression< Node >& src, BinaryOperator op );
+
+    template< class Destination, class Source, class BinaryOperator >
+    Destination& _assign_kernel_8( Destination& dest, const Source& src, BinaryOperator op );
+
+    template< class Destination, class Node, class BinaryOperator, class Lines >
+    Destination& _assign_lines( Destination& dest, const Expression< Node >& src, BinaryOperator op, 
+            const Lines lines );
+
+    template< class T, class Line, class BinaryOperator >
+    void _expression_line( T* dest, const size_type step, const Line& line, const size_type first, 
+            const size_type last, BinaryOperator op );
+
+    template< class T, class Line, class BinaryOperator >
+    void _expression_kernel( T* dest, const Line& line, const size_type first, const size_type last, 
+            BinaryOperator op );
+
+    template< class T, class Line, class BinaryOperator >
+    void _scalar_expression_kernel( T* dest, const Line& line, const size_type first, const size_type last, 
+            BinaryOperator op );
+
+#ifdef C3_SIMD_X86
+
+    template< class T, class Line, class BinaryOperator >
+    C3_TARGET_AVX2 void _vector_expression_kernel( detail::Avx2, T* dest, const Line& line, const size_type first,
+            const size_type last, BinaryOperator op );
+
+    template< class T, class Line, class BinaryOperator >
+    C3_TARGET_AVX512 void _vector_expression_kernel( detail::Avx512, T* dest, const Line& line, const size_type first,
+            const size_type last, BinaryOperator op );
+
+#endif
+
+    // Combination of destination pixel and expression value.
+
+    template< class T, class U >
+    T _combine( const T, const U src, Identity );
+
+    template< class T, class U, class BinaryOperator >
+    T _combine( const T dest, const U src, BinaryOperator op );
+
 }
 
 // 
@@ -98,21 +329,82 @@ inline Destination& C3::assign( Destination& dest, const Source& src, BinaryOper
 template< class Destination, class T, class BinaryOperator >
 inline Destination& C3::_assign( Destination& dest, const T src, BinaryOperator op )
 {
-    C3::_assign_kernel_1( dest.begin(), dest.end(), src, op );
+    using V = typename C3::ValueType< Destination >::type;
+    const auto begin = dest.begin();
+    C3::detail::_parallel_for( dest.size(), dest.size(), C3::detail::_grain< V >(), 
+        [ & ]( const C3::size_type first, const C3::size_type last )
+        {
+            C3::_assign_kernel_1( begin + first, begin + last, src, op );
+        } );
+    return dest;
+}
+
+// Frames are written row by row, so padding at the end of aligned rows stays
+// zero.
+
+template< class T, class U, class BinaryOperator >
+inline C3::Frame< T >& C3::_assign( C3::Frame< T >& dest, const U src, BinaryOperator op )
+{
+    const auto begin = dest.begin();
+    C3::detail::_parallel_for( dest.nrows(), dest.ncolumns() * dest.nrows(), 1, 
+        [ & ]( const C3::size_type first, const C3::size_type last )
+        {
+            for( auto k = first; k < last; ++k )
+            {
+                const auto row = begin + dest.pitch() * k;
+                C3::_assign_kernel_1( row, row + dest.ncolumns(), src, op );
+            }
+        } );
     return dest;
 }
 
 template< class T, class U, class BinaryOperator >
 inline C3::View< T >& C3::_assign( C3::View< T >& dest, const U src, BinaryOperator op )
 {
-    auto begin = dest.begin();
-    auto end   = dest.begin + dest.ncolumns();
-    for( auto k = 0; k < dest.nrows(); ++k )
+    const auto begin = dest.begin();
+    C3::detail::_parallel_for( dest.nrows(), dest.ncolumns() * dest.nrows(), 1, 
+        [ & ]( const C3::size_type first, const C3::size_type last )
+        {
+            for( auto k = first; k < last; ++k )
+            {
+                C3::_strided_kernel_1( begin + dest.stride() * k, dest.step(), dest.ncolumns(), src, op );
+            }
+        } );
+    return dest;
+}
+
+// Tiled stacks with a partial last tile write the whole tiles of each row in
+// one run, then the columns in the last tile frame by frame, so its padding
+// stays zero.  Other stacks have no padding.
+
+template< class T, class U, class BinaryOperator >
+inline C3::Stack< T >& C3::_assign( C3::Stack< T >& dest, const U src, BinaryOperator op )
+{
+    const auto begin = dest.begin();
+    const auto whole = dest.ncolumns() / dest.run() * dest.run();
+    if( whole == dest.ncolumns() )
     {
-        C3::_assign_kernel_1( begin, end, src, op );
-        begin += dest.stride();
-        src   += dest.stride();
+        C3::detail::_parallel_for( dest.size(), dest.size(), C3::detail::_grain< T >(), 
+            [ & ]( const C3::size_type first, const C3::size_type last )
+            {
+                C3::_assign_kernel_1( begin + first, begin + last, src, op );
+            } );
+        return dest;
     }
+    C3::detail::_parallel_for( dest.nrows(), dest.size(), 1, 
+        [ & ]( const C3::size_type first, const C3::size_type last )
+        {
+            for( auto k = first; k < last; ++k )
+            {
+                const auto row = begin + dest.offset( 0, 0, k );
+                C3::_assign_kernel_1( row, row + whole * dest.nframes(), src, op );
+                for( C3::size_type i = 0; i < dest.nframes(); ++i )
+                {
+                    const auto tile = begin + dest.offset( i, whole, k );
+                    C3::_assign_kernel_1( tile, tile + ( dest.ncolumns() - whole ), src, op );
+                }
+            }
+        } );
     return dest;
 }
 
@@ -123,7 +415,13 @@ template< template< class > class Container, class T, class U, class BinaryOpera
 inline Container< T >& C3::_assign( Container< T >& dest, const Container< U >& src, BinaryOperator op )
 {
     assert( C3::congruent( dest, src ) );
-    C3::_assign_kernel_2( dest.begin(), src.begin(), src.end(), op );
+    const auto dest_begin = dest.begin();
+    const auto src_begin  = src.begin();
+    C3::detail::_parallel_for( src.size(), src.size(), C3::detail::_grain< T >(), 
+        [ & ]( const C3::size_type first, const C3::size_type last )
+        {
+            C3::_assign_kernel_2( dest_begin + first, src_begin + first, src_begin + last, op );
+        } );
     return dest;
 }
 
@@ -133,6 +431,32 @@ inline C3::View< T >& C3::_assign( C3::View< T >& dest, const C3::View< U >& src
     return C3::_assign_kernel_3( dest, src, op, dest.stride(), src.stride() );
 }
 
+// Frames go row by row, since their row pitches may differ and padding is not
+// part of either frame.
+
+template< class T, class U, class BinaryOperator >
+inline C3::Frame< T >& C3::_assign( C3::Frame< T >& dest, const C3::Frame< U >& src, BinaryOperator op )
+{
+    return C3::_assign_kernel_3( dest, src, op, dest.pitch(), src.pitch() );
+}
+
+// Stacks of the same layout are copied flat, otherwise pixel by pixel.
+
+template< class T, class U, class BinaryOperator >
+inline C3::Stack< T >& C3::_assign( C3::Stack< T >& dest, const C3::Stack< U >& src, BinaryOperator op )
+{
+    if( dest.layout() != src.layout() ) return C3::_assign_kernel_7( dest, src, op );
+    assert( C3::congruent( dest, src ) );
+    const auto dest_begin = dest.begin();
+    const auto src_begin  = src.begin();
+    C3::detail::_parallel_for( src.size(), src.size(), C3::detail::_grain< T >(), 
+        [ & ]( const C3::size_type first, const C3::size_type last )
+        {
+            C3::_assign_kernel_2( dest_begin + first, src_begin + first, src_begin + last, op );
+        } );
+    return dest;
+}
+
 // Container from Different Container
 // ----------------------------------
 
@@ -141,7 +465,7 @@ inline C3::View< T >& C3::_assign( C3::View< T >& dest, const C3::View< U >& src
 template< class T, class U, class BinaryOperator >
 inline C3::Frame< T >& C3::_assign( C3::Frame< T >& dest, const C3::Column< U >& src, BinaryOperator op )
 {
-    return C3::_assign_kernel_4( dest, src, op, dest.ncolumns(), dest.ncolumns() );
+    return C3::_assign_kernel_4( dest, src, op, dest.ncolumns(), dest.pitch() );
 }
 
 // Frame from Row.
@@ -149,7 +473,7 @@ inline C3::Frame< T >& C3::_assign( C3::Frame< T >& dest, const C3::Column< U >&
 template< class T, class U, class BinaryOperator >
 inline C3::Frame< T >& C3::_assign( C3::Frame< T >& dest, const C3::Row< U >& src, BinaryOperator op )
 {
-    return C3::_assign_kernel_3( dest, src, op, dest.ncolumns() );
+    return C3::_assign_kernel_3( dest, src, op, dest.pitch() );
 }
 
 // Frame from View.
@@ -157,7 +481,7 @@ inline C3::Frame< T >& C3::_assign( C3::Frame< T >& dest, const C3::Row< U >& sr
 template< class T, class U, class BinaryOperator >
 inline C3::Frame< T >& C3::_assign( C3::Frame< T >& dest, const C3::View< U >& src, BinaryOperator op )
 {
-    return C3::_assign_kernel_3( dest, src, op, dest.ncolumns(), src.stride() );
+    return C3::_assign_kernel_3( dest, src, op, dest.pitch(), src.stride() );
 }
 
 // View from Column.
@@ -181,7 +505,7 @@ inline C3::View< T >& C3::_assign( C3::View< T >& dest, const C3::Row< U >& src,
 template< class T, class U, class BinaryOperator >
 inline C3::View< T >& C3::_assign( C3::View< T >& dest, const C3::Frame< U >& src, BinaryOperator op )
 {
-    return C3::_assign_kernel_3( dest, src, op, dest.stride(), src.ncolumns() );
+    return C3::_assign_kernel_3( dest, src, op, dest.stride(), src.pitch() );
 }
 
 // Stack from Frame.
@@ -189,7 +513,7 @@ inline C3::View< T >& C3::_assign( C3::View< T >& dest, const C3::Frame< U >& sr
 template< class T, class U, class BinaryOperator >
 inline C3::Stack< T >& C3::_assign( C3::Stack< T >& dest, const C3::Frame< U >& src, BinaryOperator op )
 {
-    return C3::_assign_kernel_4( dest, src, op, dest.nframes(), dest.nframes() );
+    return C3::_assign_kernel_6( dest, src, op );
 }
 
 // Stack from View.
@@ -197,84 +521,536 @@ inline C3::Stack< T >& C3::_assign( C3::Stack< T >& dest, const C3::Frame< U >&
 template< class T, class U, class BinaryOperator >
 inline C3::Stack< T >& C3::_assign( C3::Stack< T >& dest, const C3::View< U >& src, BinaryOperator op )
 {
-    assert( C3::congruent( dest, src ) );
-    auto dest_begin = dest.begin();
-    auto dest_end   = dest_begin + dest.nframes();
-    const auto src_begin = src.begin();
-    const auto src_end   = src_begin + src.ncolumns();
-    for( auto k = 0; k < dest.nrows(); ++k )
-    {
-        for( auto pixel = src_begin; pixel != src_end; ++pixel )
-        {
-            C3::_assign_kernel_1( dest_begin, dest_end, *pixel );
-            dest_begin += dest.nframes();
-            dest_end   += dest.nframes();
-        }
-        src_begin += src.stride();
-        src_end   += src.stride();
-    }
-    return dest;
+    return C3::_assign_kernel_6( dest, src, op );
+}
+
+// Stack from StackView.
+
+template< class T, class U, class BinaryOperator >
+inline C3::Stack< T >& C3::_assign( C3::Stack< T >& dest, const C3::StackView< U >& src, BinaryOperator op )
+{
+    return C3::_assign_kernel_8( dest, src, op );
+}
+
+// StackView from Pixel, StackView, Stack, Frame, or View.  Stack views go
+// line by line like expressions, whatever the layouts involved.
+
+template< class T, class U, class BinaryOperator >
+inline C3::StackView< T >& C3::_assign( C3::StackView< T >& dest, const U src, BinaryOperator op )
+{
+    return C3::_assign_kernel_8( dest, src, op );
+}
+
+template< class T, class U, class BinaryOperator >
+inline C3::StackView< T >& C3::_assign( C3::StackView< T >& dest, const C3::StackView< U >& src, BinaryOperator op )
+{
+    return C3::_assign_kernel_8( dest, src, op );
+}
+
+template< class T, class U, class BinaryOperator >
+inline C3::StackView< T >& C3::_assign( C3::StackView< T >& dest, const C3::Stack< U >& src, BinaryOperator op )
+{
+    return C3::_assign_kernel_8( dest, src, op );
+}
+
+template< class T, class U, class BinaryOperator >
+inline C3::StackView< T >& C3::_assign( C3::StackView< T >& dest, const C3::Frame< U >& src, BinaryOperator op )
+{
+    return C3::_assign_kernel_8( dest, src, op );
+}
+
+template< class T, class U, class BinaryOperator >
+inline C3::StackView< T >& C3::_assign( C3::StackView< T >& dest, const C3::View< U >& src, BinaryOperator op )
+{
+    return C3::_assign_kernel_8( dest, src, op );
+}
+
+// Container from Expression
+// -------------------------
+
+template< class Destination, class Node, class BinaryOperator >
+inline Destination& C3::_assign( Destination& dest, const C3::Expression< Node >& src, BinaryOperator op )
+{
+    return C3::_assign_kernel_5( dest, src, op );
+}
+
+template< class T, class Node, class BinaryOperator >
+inline C3::Frame< T >& C3::_assign( C3::Frame< T >& dest, const C3::Expression< Node >& src, BinaryOperator op )
+{
+    return C3::_assign_kernel_5( dest, src, op );
+}
+
+template< class T, class Node, class BinaryOperator >
+inline C3::View< T >& C3::_assign( C3::View< T >& dest, const C3::Expression< Node >& src, BinaryOperator op )
+{
+    return C3::_assign_kernel_5( dest, src, op );
+}
+
+template< class T, class Node, class BinaryOperator >
+inline C3::Stack< T >& C3::_assign( C3::Stack< T >& dest, const C3::Expression< Node >& src, BinaryOperator op )
+{
+    return C3::_assign_kernel_5( dest, src, op );
+}
+
+template< class T, class Node, class BinaryOperator >
+inline C3::StackView< T >& C3::_assign( C3::StackView< T >& dest, const C3::Expression< Node >& src, 
+        BinaryOperator op )
+{
+    return C3::_assign_kernel_5( dest, src, op );
 }
 
 // Assignment Kernel Definitions
 // -----------------------------
 
+// Contiguous destination from pixel, dispatched.
+
+template< class T, class U, class BinaryOperator >
+inline void C3::_assign_kernel_1( T* begin, T* end, const U src, BinaryOperator op )
+{
+    C3::_assign_kernel_1( begin, end, src, op, C3::detail::IsVectorizable< T, T, BinaryOperator >() );
+}
+
+// Contiguous destination from contiguous source, dispatched.
+
+template< class T, class U, class BinaryOperator >
+inline void C3::_assign_kernel_2( T* dest_begin, const U* src_begin, const U* src_end, BinaryOperator op )
+{
+    C3::_assign_kernel_2( dest_begin, src_begin, src_end, op, C3::detail::IsVectorizable< T, U, BinaryOperator >() );
+}
+
+// No vector implementation.
+
+template< class T, class U, class BinaryOperator >
+inline void C3::_assign_kernel_1( T* begin, T* end, const U src, BinaryOperator op, std::false_type )
+{
+    C3::_scalar_kernel_1( begin, end, src, op );
+}
+
+template< class T, class U, class BinaryOperator >
+inline void C3::_assign_kernel_2( T* dest_begin, const U* src_begin, const U* src_end, BinaryOperator op, 
+        std::false_type )
+{
+    C3::_scalar_kernel_2( dest_begin, src_begin, src_end, op );
+}
+
+// Plain copies without packs, such as between integer and floating-point
+// value types, go through the conversion kernels (see C3_Convert.hh).
+
 template< class T, class U >
-inline void C3::_assign_kernel_1( T* begin, T* end, const U src, C3::Identity )
+inline void C3::_assign_kernel_2( T* dest_begin, const U* src_begin, const U* src_end, C3::Identity, 
+        std::false_type )
+{
+    C3::_convert_kernel( dest_begin, src_begin, C3::size_type( src_end - src_begin ), C3::_Cast< T >() );
+}
+
+// Vector implementation selected by instruction set in use.
+
+template< class T, class U, class BinaryOperator >
+inline void C3::_assign_kernel_1( T* begin, T* end, const U src, BinaryOperator op, std::true_type )
+{
+#ifdef C3_SIMD_X86
+    switch( C3::isa() )
+    {
+        case C3::Isa::AVX512 : C3::_vector_kernel_1( C3::detail::Avx512(), begin, end, src, op ); return;
+        case C3::Isa::AVX2   : C3::_vector_kernel_1( C3::detail::Avx2()  , begin, end, src, op ); return;
+        default              : break;
+    }
+#endif
+    C3::_scalar_kernel_1( begin, end, src, op );
+}
+
+template< class T, class U, class BinaryOperator >
+inline void C3::_assign_kernel_2( T* dest_begin, const U* src_begin, const U* src_end, BinaryOperator op, 
+        std::true_type )
+{
+#ifdef C3_SIMD_X86
+    switch( C3::isa() )
+    {
+        case C3::Isa::AVX512 : C3::_vector_kernel_2( C3::detail::Avx512(), dest_begin, src_begin, src_end, op ); return;
+        case C3::Isa::AVX2   : C3::_vector_kernel_2( C3::detail::Avx2()  , dest_begin, src_begin, src_end, op ); return;
+        default              : break;
+    }
+#endif
+    C3::_scalar_kernel_2( dest_begin, src_begin, src_end, op );
+}
+
+// Scalar Kernel Definitions
+// -------------------------
+
+template< class T, class U >
+inline void C3::_scalar_kernel_1( T* begin, T* end, const U src, C3::Identity )
 {
     std::fill( begin, end, src );
 }
 
 template< class T, class U, class BinaryOperator >
-inline void C3::_assign_kernel_1( T* begin, T* end, const U src, BinaryOperator op )
+inline void C3::_scalar_kernel_1( T* begin, T* end, const U src, BinaryOperator op )
 {
     for( ; begin != end; ++begin ) *begin = op( *begin, src ); // Ensure order (see std::transform).
 }
 
 template< class T, class U >
-inline void C3::_assign_kernel_2( T* dest_begin, const U* src_begin, const U* src_end, C3::Identity )
+inline void C3::_scalar_kernel_2( T* dest_begin, const U* src_begin, const U* src_end, C3::Identity )
 {
     std::copy( src_begin, src_end, dest_begin );
 }
 
 template< class T, class U, class BinaryOperator >
-inline void C3::_assign_kernel_2( T* dest_begin, const U* src_begin, const U* src_end, BinaryOperator op )
+inline void C3::_scalar_kernel_2( T* dest_begin, const U* src_begin, const U* src_end, BinaryOperator op )
 {
-    std::copy( src_begin, src_end, dest_begin );
-    for( ; src_begin != src_end; ++src_begin, ++dest_begin ) *dest_begin = op( *dest_begin, src_begin ); 
+    for( ; src_begin != src_end; ++src_begin, ++dest_begin ) *dest_begin = op( *dest_begin, *src_begin ); 
     // Ensure order (see std::transform).
 }
 
+#ifdef C3_SIMD_X86
+
+// Vector Kernel Definitions
+// -------------------------
+// The AVX2 and AVX-512 versions are identical except for their target attribute and Pack, and must stay separate
+// functions so that each is compiled for its own instruction set.  Remainders shorter than a Pack go to the scalar
+// kernels.  Loads and stores are unaligned.
+
+template< class T, class U, class BinaryOperator >
+C3_TARGET_AVX2 inline void C3::_vector_kernel_1( C3::detail::Avx2, T* begin, T* end, const U src, BinaryOperator op )
+{
+    using Pack  = C3::detail::Pack< C3::detail::Avx2, T >;
+    using Apply = C3::detail::PackApply< C3::detail::Avx2 >;
+    const auto value = Pack::broadcast( static_cast< T >( src ) );
+    for( ; end - begin >= static_cast< std::ptrdiff_t >( Pack::width ); begin += Pack::width ) 
+    {
+        Pack::store( begin, Apply::template apply< Pack >( Pack::load( begin ), value, op ) );
+    }
+    C3::_scalar_kernel_1( begin, end, src, op );
+}
+
+template< class T, class U, class BinaryOperator >
+C3_TARGET_AVX512 inline void C3::_vector_kernel_1( C3::detail::Avx512, T* begin, T* end, const U src, BinaryOperator op )
+{
+    using Pack  = C3::detail::Pack< C3::detail::Avx512, T >;
+    using Apply = C3::detail::PackApply< C3::detail::Avx512 >;
+    const auto value = Pack::broadcast( static_cast< T >( src ) );
+    for( ; end - begin >= static_cast< std::ptrdiff_t >( Pack::width ); begin += Pack::width ) 
+    {
+        Pack::store( begin, Apply::template apply< Pack >( Pack::load( begin ), value, op ) );
+    }
+    C3::_scalar_kernel_1( begin, end, src, op );
+}
+
+template< class T, class U, class BinaryOperator >
+C3_TARGET_AVX2 inline void C3::_vector_kernel_2( C3::detail::Avx2, T* dest_begin, const U* src_begin, const U* src_end, 
+        BinaryOperator op )
+{
+    using Pack  = C3::detail::Pack< C3::detail::Avx2, T >;
+    using Apply = C3::detail::PackApply< C3::detail::Avx2 >;
+    for( ; src_end - src_begin >= static_cast< std::ptrdiff_t >( Pack::width ); 
+            src_begin += Pack::width, dest_begin += Pack::width ) 
+    {
+        Pack::store( dest_begin, Apply::template apply< Pack >( Pack::load( dest_begin ), Pack::load( src_begin ), op ) );
+    }
+    C3::_scalar_kernel_2( dest_begin, src_begin, src_end, op );
+}
+
+template< class T, class U, class BinaryOperator >
+C3_TARGET_AVX512 inline void C3::_vector_kernel_2( C3::detail::Avx512, T* dest_begin, const U* src_begin, const U* src_end, 
+        BinaryOperator op )
+{
+    using Pack  = C3::detail::Pack< C3::detail::Avx512, T >;
+    using Apply = C3::detail::PackApply< C3::detail::Avx512 >;
+    for( ; src_end - src_begin >= static_cast< std::ptrdiff_t >( Pack::width ); 
+            src_begin += Pack::width, dest_begin += Pack::width ) 
+    {
+        Pack::store( dest_begin, Apply::template apply< Pack >( Pack::load( dest_begin ), Pack::load( src_begin ), op ) );
+    }
+    C3::_scalar_kernel_2( dest_begin, src_begin, src_end, op );
+}
+
+#endif
+
+// Strided Kernel Definitions
+// --------------------------
+
+template< class T, class U, class BinaryOperator >
+inline void C3::_strided_kernel_1( T* begin, const C3::size_type step, const C3::size_type length, const U src, 
+        BinaryOperator op )
+{
+    if( step == 1 ) return C3::_assign_kernel_1( begin, begin + length, src, op );
+    for( C3::size_type j = 0; j < length; ++j ) begin[ step * j ] = C3::_combine( begin[ step * j ], src, op );
+}
+
+template< class T, class U, class BinaryOperator >
+inline void C3::_strided_kernel_2( T* dest_begin, const C3::size_type dest_step, const U* src_begin, 
+        const C3::size_type src_step, const C3::size_type length, BinaryOperator op )
+{
+    if( dest_step == 1 && src_step == 1 ) return C3::_assign_kernel_2( dest_begin, src_begin, src_begin + length, op );
+    for( C3::size_type j = 0; j < length; ++j ) 
+    {
+        dest_begin[ dest_step * j ] = C3::_combine( dest_begin[ dest_step * j ], src_begin[ src_step * j ], op );
+    }
+}
+
+// Row and Column Kernel Definitions
+// ---------------------------------
+
+// Rows are split into bands over threads.
+
 template< class Destination, class Source, class BinaryOperator >
 inline Destination& C3::_assign_kernel_3( Destination& dest, const Source& src, BinaryOperator op,
         const C3::size_type dest_stride, const C3::size_type src_stride )
 {
     assert( C3::congruent( dest, src ) );
-    auto dest_begin = dest.begin();
-    const auto src_begin = src.begin();
-    const auto src_end   = src_begin + src.ncolumns();
-    for( auto k = 0; k < dest.nrows(); ++k )
-    {
-        C3::_assign_kernel_2( dest_begin, src_begin, src_end, op );
-        dest_begin += dest_stride;
-        src_begin  += src_stride;
-        src_end    += src_stride;
-    }
+    const auto dest_begin = dest.begin();
+    const auto src_begin  = src.begin();
+    const auto dest_step  = C3::_line_step( dest );
+    const auto src_step   = C3::_line_step( src );
+    C3::detail::_parallel_for( dest.nrows(), dest.nrows() * src.ncolumns(), 1, 
+        [ & ]( const C3::size_type first, const C3::size_type last )
+        {
+            for( auto k = first; k < last; ++k )
+            {
+                C3::_strided_kernel_2( dest_begin + dest_stride * k, dest_step, src_begin + src_stride * k, src_step,
+                        src.ncolumns(), op );
+            }
+        } );
     return dest;
 }
 
+// Source pixels, each broadcast over a run of destination pixels, are split
+// into bands over threads.
+
 template< class Destination, class Source, class BinaryOperator >
 inline Destination& C3::_assign_kernel_4( Destination& dest, const Source& src, BinaryOperator op,
         const C3::size_type length, const C3::size_type stride )
 {
     assert( C3::congruent( dest, src ) );
-    auto begin = dest.begin();
-    auto end   = begin + length;
-    for( auto pixel : src )
+    const auto dest_begin = dest.begin();
+    const auto src_begin  = src.begin();
+    const auto step       = C3::_line_step( dest );
+    C3::detail::_parallel_for( src.size(), src.size() * length, 1, 
+        [ & ]( const C3::size_type first, const C3::size_type last )
+        {
+            for( auto p = first; p < last; ++p )
+            {
+                C3::_strided_kernel_1( dest_begin + stride * p, step, length, src_begin[ p ], op );
+            }
+        } );
+    return dest;
+}
+
+// Stack from Frame or View, with rows split into bands over threads.  In an
+// interleaved stack each source pixel is broadcast over the frames at its
+// position.  Otherwise each run of source columns is copied into every frame.
+
+template< class T, class Source, class BinaryOperator >
+inline C3::Stack< T >& C3::_assign_kernel_6( C3::Stack< T >& dest, const Source& src, BinaryOperator op )
+{
+    assert( C3::congruent( dest, src ) );
+    const auto dest_begin = dest.begin();
+    if( dest.layout() == C3::StackLayout::INTERLEAVED )
     {
-        C3::_assign_kernel_1( begin, end, pixel, op );
-        begin += stride;
-        end   += stride;
+        C3::detail::_parallel_for( dest.nrows(), dest.size(), 1, 
+            [ & ]( const C3::size_type first, const C3::size_type last )
+            {
+                for( auto k = first; k < last; ++k )
+                {
+                    for( C3::size_type j = 0; j < dest.ncolumns(); ++j )
+                    {
+                        const auto pixel = dest_begin + dest.offset( 0, j, k );
+                        C3::_assign_kernel_1( pixel, pixel + dest.nframes(), src( j, k ), op );
+                    }
+                }
+            } );
+        return dest;
     }
+    const auto src_step = C3::_line_step( src );
+    C3::detail::_parallel_for( dest.nrows(), dest.size(), 1, 
+        [ & ]( const C3::size_type first, const C3::size_type last )
+        {
+            for( auto k = first; k < last; ++k )
+            {
+                const auto src_row = C3::_line( src, C3::_RowLines(), k ).data;
+                for( C3::size_type j = 0; j < dest.ncolumns(); j += dest.run() )
+                {
+                    const auto length = std::min( dest.run(), dest.ncolumns() - j );
+                    for( C3::size_type i = 0; i < dest.nframes(); ++i )
+                    {
+                        C3::_strided_kernel_2( dest_begin + dest.offset( i, j, k ), 1, src_row + src_step * j, 
+                                src_step, length, op );
+                    }
+                }
+            }
+        } );
     return dest;
 }
+
+// Stack from Stack of another layout, pixel by pixel with rows split into
+// bands over threads.
+
+template< class T, class U, class BinaryOperator >
+inline C3::Stack< T >& C3::_assign_kernel_7( C3::Stack< T >& dest, const C3::Stack< U >& src, BinaryOperator op )
+{
+    assert( dest.nframes() == src.nframes() && dest.ncolumns() == src.ncolumns() && dest.nrows() == src.nrows() );
+    C3::detail::_parallel_for( dest.nrows(), dest.size(), 1, 
+        [ & ]( const C3::size_type first, const C3::size_type last )
+        {
+            for( auto k = first; k < last; ++k )
+            {
+                for( C3::size_type j = 0; j < dest.ncolumns(); ++j )
+                {
+                    for( C3::size_type i = 0; i < dest.nframes(); ++i ) 
+                    {
+                        dest( i, j, k ) = C3::_combine( dest( i, j, k ), src( i, j, k ), op );
+                    }
+                }
+            }
+        } );
+    return dest;
+}
+
+// Expression Kernel Definitions
+// -----------------------------
+
+// Lines are split into bands over threads, or for a single-line destination
+// the line itself is.
+
+template< class Destination, class Node, class BinaryOperator >
+inline Destination& C3::_assign_kernel_5( Destination& dest, const C3::Expression< Node >& src, BinaryOperator op )
+{
+    return C3::_assign_lines( dest, src, op, C3::_lines( dest ) );
+}
+
+// Interleaved stacks take one line per pixel position.  Other stacks take one
+// line per run of columns, frame by frame within each run, so tiled stacks
+// are written in storage order.
+
+template< class T, class Node, class BinaryOperator >
+inline C3::Stack< T >& C3::_assign_kernel_5( C3::Stack< T >& dest, const C3::Expression< Node >& src, 
+        BinaryOperator op )
+{
+    if( dest.layout() == C3::StackLayout::INTERLEAVED ) return C3::_assign_lines( dest, src, op, C3::_lines( dest ) );
+    assert( C3::_congruent( dest, src.node() ) );
+    const auto nruns = ( dest.ncolumns() + dest.run() - 1 ) / dest.run();
+    const auto count = dest.nrows() * nruns * dest.nframes();
+    C3::detail::_parallel_for( count, dest.size(), 1, 
+        [ & ]( const C3::size_type first, const C3::size_type last )
+        {
+            for( auto n = first; n < last; ++n )
+            {
+                const auto i = n % dest.nframes();
+                const auto j = n / dest.nframes() % nruns * dest.run();
+                const auto k = n / dest.nframes() / nruns;
+                const auto lines = C3::_RunLines{ i, j, k };
+                C3::_expression_kernel( dest.data() + dest.offset( i, j, k ), src.node().line( lines, n ), 0, 
+                        std::min( dest.run(), dest.ncolumns() - j ), op );
+            }
+        } );
+    return dest;
+}
+
+// Container or pixel source as an expression of one operand, for
+// destinations that go line by line whatever the source.
+
+template< class Destination, class Source, class BinaryOperator >
+inline Destination& C3::_assign_kernel_8( Destination& dest, const Source& src, BinaryOperator op )
+{
+    using Node = typename C3::_NodeOf< Source >::type;
+    return C3::_assign_kernel_5( dest, C3::Expression< Node >( C3::_NodeOf< Source >::node( src ) ), op );
+}
+
+// Evaluate an expression over destination lines of one kind.
+
+template< class Destination, class Node, class BinaryOperator, class Lines >
+inline Destination& C3::_assign_lines( Destination& dest, const C3::Expression< Node >& src, BinaryOperator op, 
+        const Lines lines )
+{
+    using T = typename C3::ValueType< Destination >::type;
+    assert( C3::_congruent( dest, src.node() ) );
+    const auto count  = C3::_line_count( dest, lines );
+    const auto length = C3::_line_length( dest, lines );
+    const auto step   = C3::_line_step( dest );
+    if( count == 1 )
+    {
+        C3::detail::_parallel_for( length, length, C3::detail::_grain< T >(), 
+            [ & ]( const C3::size_type first, const C3::size_type last )
+            {
+                C3::_expression_line( C3::_line_begin( dest, 0 ), step, src.node().line( lines, 0 ), first, last, op );
+            } );
+        return dest;
+    }
+    C3::detail::_parallel_for( count, count * length, 1, 
+        [ & ]( const C3::size_type first, const C3::size_type last )
+        {
+            for( auto n = first; n < last; ++n )
+            {
+                C3::_expression_line( C3::_line_begin( dest, n ), step, src.node().line( lines, n ), 0, length, op );
+            }
+        } );
+    return dest;
+}
+
+// Expression line into contiguous destination pixels, dispatched, or into
+// pixels a step apart.
+
+template< class T, class Line, class BinaryOperator >
+inline void C3::_expression_line( T* dest, const C3::size_type step, const Line& line, const C3::size_type first,
+        const C3::size_type last, BinaryOperator op )
+{
+    if( step == 1 ) return C3::_expression_kernel( dest, line, first, last, op );
+    for( auto i = first; i < last; ++i ) dest[ step * i ] = C3::_combine( dest[ step * i ], line[ i ], op );
+}
+
+// Expression line, dispatched.
+
+template< class T, class Line, class BinaryOperator >
+inline void C3::_expression_kernel( T* dest, const Line& line, const C3::size_type first, const C3::size_type last,
+        BinaryOperator op )
+{
+#ifdef C3_SIMD_X86
+    switch( C3::isa() )
+    {
+        case C3::Isa::AVX512 : C3::_vector_expression_kernel( C3::detail::Avx512(), dest, line, first, last, op ); return;
+        case C3::Isa::AVX2   : C3::_vector_expression_kernel( C3::detail::Avx2()  , dest, line, first, last, op ); return;
+        default              : break;
+    }
+#endif
+    C3::_scalar_expression_kernel( dest, line, first, last, op );
+}
+
+template< class T, class Line, class BinaryOperator >
+inline void C3::_scalar_expression_kernel( T* dest, const Line& line, const C3::size_type first, 
+        const C3::size_type last, BinaryOperator op )
+{
+    for( auto i = first; i < last; ++i ) dest[ i ] = C3::_combine( dest[ i ], line[ i ], op );
+}
+
+#ifdef C3_SIMD_X86
+
+// The loop bodies are the same as the scalar one.  Line cursors are small inline objects, so the compiler inlines
+// them into each target-specific loop and vectorizes the whole expression for that instruction set.
+
+template< class T, class Line, class BinaryOperator >
+C3_TARGET_AVX2 inline void C3::_vector_expression_kernel( C3::detail::Avx2, T* dest, const Line& line, 
+        const C3::size_type first, const C3::size_type last, BinaryOperator op )
+{
+    for( auto i = first; i < last; ++i ) dest[ i ] = C3::_combine( dest[ i ], line[ i ], op );
+}
+
+template< class T, class Line, class BinaryOperator >
+C3_TARGET_AVX512 inline void C3::_vector_expression_kernel( C3::detail::Avx512, T* dest, const Line& line, 
+        const C3::size_type first, const C3::size_type last, BinaryOperator op )
+{
+    for( auto i = first; i < last; ++i ) dest[ i ] = C3::_combine( dest[ i ], line[ i ], op );
+}
+
+#endif
+
+template< class T, class U >
+inline T C3::_combine( const T, const U src, C3::Identity )
+{
+    return static_cast< T >( src );
+}
+
+template< class T, class U, class BinaryOperator >
+inline T C3::_combine( const T dest, const U src, BinaryOperator op )
+{
+    return static_cast< T >( op( dest, src ) );
+}
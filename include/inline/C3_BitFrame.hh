@@ -0,0 +1,283 @@
+
+#include <algorithm>
+#include <bitset>
+#include <cassert>
+
+#include "../C3_Simd.hh"
+#include "../C3_Threads.hh"
+
+// Internal declarations
+
+namespace C3
+{
+
+    // Bit Kernels
+    // -----------
+    // One row of bits to or from one row of flags, dispatched like the
+    // expression kernels (see C3_Assign.hh).  Each word is built or spread
+    // in an inner loop over its 64 bits, which vectorizes as shifts of the
+    // lanes by their bit positions.
+
+    template< class F >
+    void _pack_kernel( BitFrame::word_type* dest, const F* flags, const size_type length, const F bits );
+
+    template< class F >
+    void _scalar_pack_kernel( BitFrame::word_type* dest, const F* flags, const size_type length, const F bits );
+
+    template< class F >
+    void _unpack_kernel( F* flags, const BitFrame::word_type* src, const size_type length, const F bits );
+
+    template< class F >
+    void _scalar_unpack_kernel( F* flags, const BitFrame::word_type* src, const size_type length, const F bits );
+
+#ifdef C3_SIMD_X86
+
+    template< class F >
+    C3_TARGET_AVX2 void _vector_pack_kernel( detail::Avx2, BitFrame::word_type* dest, const F* flags,
+            const size_type length, const F bits );
+
+    template< class F >
+    C3_TARGET_AVX512 void _vector_pack_kernel( detail::Avx512, BitFrame::word_type* dest, const F* flags,
+            const size_type length, const F bits );
+
+    template< class F >
+    C3_TARGET_AVX2 void _vector_unpack_kernel( detail::Avx2, F* flags, const BitFrame::word_type* src,
+            const size_type length, const F bits );
+
+    template< class F >
+    C3_TARGET_AVX512 void _vector_unpack_kernel( detail::Avx512, F* flags, const BitFrame::word_type* src,
+            const size_type length, const F bits );
+
+#endif
+
+    // One row, whole words first so that their inner loops have a fixed
+    // trip count, then what is left over.
+
+    template< class F >
+    void _pack_row( BitFrame::word_type* dest, const F* flags, const size_type length, const F bits );
+
+    template< class F >
+    void _unpack_row( F* flags, const BitFrame::word_type* src, const size_type length, const F bits );
+
+    // One word from up to 64 flags, and up to 64 flags from one word.
+
+    template< class F >
+    BitFrame::word_type _pack_word( const F* flags, const size_type length, const F bits );
+
+    template< class F >
+    void _unpack_word( F* flags, const BitFrame::word_type word, const size_type length, const F bits );
+
+}
+
+// Constructor.
+
+inline C3::BitFrame::BitFrame( const C3::size_type ncolumns, const C3::size_type nrows ) :
+    _ncolumns( ncolumns ), _nrows( nrows ), _pitch( ( ncolumns + word_bits - 1 ) / word_bits ),
+    _words( _pitch * nrows, word_type( 0 ) )
+{}
+
+// Initializing constructor.  Padding bits stay clear.
+
+inline C3::BitFrame::BitFrame( const C3::size_type ncolumns, const C3::size_type nrows, const bool value ) :
+    BitFrame( ncolumns, nrows )
+{
+    if( ! value || _pitch == 0 ) return;
+    const auto tail = _ncolumns % word_bits;
+    const auto last = tail == 0 ? ~word_type( 0 ) : ( word_type( 1 ) << tail ) - 1;
+    for( C3::size_type k = 0; k < _nrows; ++k )
+    {
+        std::fill( data() + _pitch * k, data() + _pitch * ( k + 1 ) - 1, ~word_type( 0 ) );
+        data()[ _pitch * ( k + 1 ) - 1 ] = last;
+    }
+}
+
+// Bit access.
+
+inline bool C3::BitFrame::operator() ( const C3::size_type j, const C3::size_type k ) const
+{
+    return ( data()[ _pitch * k + j / word_bits ] >> ( j % word_bits ) ) & 1;
+}
+
+inline void C3::BitFrame::set( const C3::size_type j, const C3::size_type k )
+{
+    data()[ _pitch * k + j / word_bits ] |= word_type( 1 ) << ( j % word_bits );
+}
+
+inline void C3::BitFrame::reset( const C3::size_type j, const C3::size_type k )
+{
+    data()[ _pitch * k + j / word_bits ] &= ~( word_type( 1 ) << ( j % word_bits ) );
+}
+
+// Number of bits set.
+
+inline C3::size_type C3::BitFrame::count() const
+{
+    C3::size_type total = 0;
+    for( C3::size_type i = 0; i < _words.size(); ++i ) total += std::bitset< word_bits >( data()[ i ] ).count();
+    return total;
+}
+
+// Pack flags into bits, in row bands over threads.
+
+template< class F >
+inline C3::BitFrame& C3::pack( C3::BitFrame& dest, const C3::Frame< F >& flags, const F bits )
+{
+    assert( dest.ncolumns() == flags.ncolumns() && dest.nrows() == flags.nrows() );
+    C3::detail::_parallel_for( dest.nrows(), dest.nrows() * dest.ncolumns(), 1,
+        [ & ]( const C3::size_type first, const C3::size_type last )
+        {
+            for( auto k = first; k < last; ++k )
+            {
+                C3::_pack_kernel( dest.data() + dest.pitch() * k, flags.data() + flags.pitch() * k, dest.ncolumns(),
+                        bits );
+            }
+        } );
+    return dest;
+}
+
+// Unpack bits into flags, in row bands over threads.
+
+template< class F >
+inline C3::Frame< F >& C3::unpack( C3::Frame< F >& flags, const C3::BitFrame& src, const F bits )
+{
+    assert( src.ncolumns() == flags.ncolumns() && src.nrows() == flags.nrows() );
+    C3::detail::_parallel_for( src.nrows(), src.nrows() * src.ncolumns(), 1,
+        [ & ]( const C3::size_type first, const C3::size_type last )
+        {
+            for( auto k = first; k < last; ++k )
+            {
+                C3::_unpack_kernel( flags.data() + flags.pitch() * k, src.data() + src.pitch() * k, src.ncolumns(),
+                        bits );
+            }
+        } );
+    return flags;
+}
+
+// Row of flags packed.
+
+template< class F >
+inline void C3::_pack_row( C3::BitFrame::word_type* dest, const F* flags, const C3::size_type length, const F bits )
+{
+    const auto w = C3::BitFrame::word_bits;
+    const auto nwords = length / w;
+    for( C3::size_type i = 0; i < nwords; ++i ) dest[ i ] = C3::_pack_word( flags + w * i, w, bits );
+    if( length % w != 0 ) dest[ nwords ] = C3::_pack_word( flags + w * nwords, length % w, bits );
+}
+
+// Row of flags unpacked.
+
+template< class F >
+inline void C3::_unpack_row( F* flags, const C3::BitFrame::word_type* src, const C3::size_type length, const F bits )
+{
+    const auto w = C3::BitFrame::word_bits;
+    const auto nwords = length / w;
+    for( C3::size_type i = 0; i < nwords; ++i ) C3::_unpack_word( flags + w * i, src[ i ], w, bits );
+    if( length % w != 0 ) C3::_unpack_word( flags + w * nwords, src[ nwords ], length % w, bits );
+}
+
+// Word from flags.  The OR of shifted bits is a reduction over the word.
+
+template< class F >
+inline C3::BitFrame::word_type C3::_pack_word( const F* flags, const C3::size_type length, const F bits )
+{
+    C3::BitFrame::word_type word = 0;
+    for( C3::size_type b = 0; b < length; ++b )
+    {
+        word |= C3::BitFrame::word_type( ( flags[ b ] & bits ) != 0 ) << b;
+    }
+    return word;
+}
+
+// Flags from word.
+
+template< class F >
+inline void C3::_unpack_word( F* flags, const C3::BitFrame::word_type word, const C3::size_type length, const F bits )
+{
+    for( C3::size_type b = 0; b < length; ++b )
+    {
+        const F set = static_cast< F >( ( word >> b ) & 1 );
+        flags[ b ] = static_cast< F >( flags[ b ] | ( bits & static_cast< F >( -set ) ) );
+    }
+}
+
+// Pack row, dispatched.
+
+template< class F >
+inline void C3::_pack_kernel( C3::BitFrame::word_type* dest, const F* flags, const C3::size_type length,
+        const F bits )
+{
+#ifdef C3_SIMD_X86
+    switch( C3::isa() )
+    {
+        case C3::Isa::AVX512 : C3::_vector_pack_kernel( C3::detail::Avx512(), dest, flags, length, bits ); return;
+        case C3::Isa::AVX2   : C3::_vector_pack_kernel( C3::detail::Avx2()  , dest, flags, length, bits ); return;
+        default              : break;
+    }
+#endif
+    C3::_scalar_pack_kernel( dest, flags, length, bits );
+}
+
+template< class F >
+inline void C3::_scalar_pack_kernel( C3::BitFrame::word_type* dest, const F* flags, const C3::size_type length,
+        const F bits )
+{
+    C3::_pack_row( dest, flags, length, bits );
+}
+
+// Unpack row, dispatched.
+
+template< class F >
+inline void C3::_unpack_kernel( F* flags, const C3::BitFrame::word_type* src, const C3::size_type length,
+        const F bits )
+{
+#ifdef C3_SIMD_X86
+    switch( C3::isa() )
+    {
+        case C3::Isa::AVX512 : C3::_vector_unpack_kernel( C3::detail::Avx512(), flags, src, length, bits ); return;
+        case C3::Isa::AVX2   : C3::_vector_unpack_kernel( C3::detail::Avx2()  , flags, src, length, bits ); return;
+        default              : break;
+    }
+#endif
+    C3::_scalar_unpack_kernel( flags, src, length, bits );
+}
+
+template< class F >
+inline void C3::_scalar_unpack_kernel( F* flags, const C3::BitFrame::word_type* src, const C3::size_type length,
+        const F bits )
+{
+    C3::_unpack_row( flags, src, length, bits );
+}
+
+#ifdef C3_SIMD_X86
+
+// The rows are the scalar ones compiled for each instruction set.
+
+template< class F >
+C3_TARGET_AVX2 inline void C3::_vector_pack_kernel( C3::detail::Avx2, C3::BitFrame::word_type* dest, const F* flags,
+        const C3::size_type length, const F bits )
+{
+    C3::_pack_row( dest, flags, length, bits );
+}
+
+template< class F >
+C3_TARGET_AVX512 inline void C3::_vector_pack_kernel( C3::detail::Avx512, C3::BitFrame::word_type* dest,
+        const F* flags, const C3::size_type length, const F bits )
+{
+    C3::_pack_row( dest, flags, length, bits );
+}
+
+template< class F >
+C3_TARGET_AVX2 inline void C3::_vector_unpack_kernel( C3::detail::Avx2, F* flags, const C3::BitFrame::word_type* src,
+        const C3::size_type length, const F bits )
+{
+    C3::_unpack_row( flags, src, length, bits );
+}
+
+template< class F >
+C3_TARGET_AVX512 inline void C3::_vector_unpack_kernel( C3::detail::Avx512, F* flags,
+        const C3::BitFrame::word_type* src, const C3::size_type length, const F bits )
+{
+    C3::_unpack_row( flags, src, length, bits );
+}
+
+#endif
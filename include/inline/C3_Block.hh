@@ -1,27 +1,43 @@
 
+#include <new>
+
 #include "../C3_Assign.hh"
 
 // Constructor.
 
 template< class T >
-inline C3::Block< T >::Block( const C3::size_type size ) noexcept :
-    _size( size ), _data( new T [ size ] )
+inline C3::Block< T >::Block( const C3::size_type size ) :
+    _size( size ), _resource( &C3::memory_resource() ), _data( _allocate( size, C3::first_touch() ) )
 {}
 
 // Initializing constructor.
 
 template< class T >
-inline C3::Block< T >::Block( const C3::size_type size, const T pixel ) noexcept :
-    _size( size ), _data( new T [ size ] )
+inline C3::Block< T >::Block( const C3::size_type size, const T pixel ) :
+    _size( size ), _resource( &C3::memory_resource() ), _data( _allocate( size ) )
 {
     C3::assign( *this, pixel );
 }
 
+// Adopting constructor.
+
+template< class T >
+inline C3::Block< T >::Block( T* data, const C3::size_type size ) noexcept :
+    _size( size ), _resource( nullptr ), _data( data )
+{}
+
+// Constructor that never touches pixels.
+
+template< class T >
+inline C3::Block< T >::Block( const C3::size_type size, Untouched ) :
+    _size( size ), _resource( &C3::memory_resource() ), _data( _allocate( size ) )
+{}
+
 // Copy constructor.
 
 template< class T >
-inline C3::Block< T >::Block( const C3::Block< T >& block ) noexcept :
-    _size( block.size() ), _data( new T [ block.size() ] )
+inline C3::Block< T >::Block( const C3::Block< T >& block ) :
+    _size( block.size() ), _resource( &C3::memory_resource() ), _data( _allocate( block.size() ) )
 {
     C3::assign( *this, block );
 }
@@ -30,7 +46,7 @@ inline C3::Block< T >::Block( const C3::Block< T >& block ) noexcept :
 
 template< class T >
 inline C3::Block< T >::Block( C3::Block< T >&& block ) noexcept :
-    _size( block.size() ), _data( block.data() )
+    _size( block.size() ), _resource( block._resource ), _data( block.data() )
 {
     block._size = 0;
     block._data = nullptr;
@@ -42,7 +58,7 @@ inline C3::Block< T >::Block( C3::Block< T >&& block ) noexcept :
 // breaks an assertion.
 
 template< class T >
-inline C3::Block< T >& C3::Block< T >::operator = ( const C3::Block< T >& block ) noexcept
+inline C3::Block< T >& C3::Block< T >::operator = ( const C3::Block< T >& block )
 {
     return this != &block ? C3::assign( *this, block ) : *this;
 }
@@ -54,8 +70,10 @@ inline C3::Block< T >& C3::Block< T >::operator = ( C3::Block< T >&& block ) noe
 {
     if( this != &block )
     {
-        _size = block.size();
-        _data = block.data();
+        _deallocate();
+        _size     = block.size();
+        _resource = block._resource;
+        _data     = block.data();
         block._size = 0;
         block._data = nullptr;
     }
@@ -70,11 +88,20 @@ inline C3::Block< T >& C3::Block< T >::operator = ( const T pixel ) noexcept
     return C3::assign( *this, pixel );
 }
 
+// Expression assignment.
+
+template< class T >
+template< class Node >
+inline C3::Block< T >& C3::Block< T >::operator = ( const C3::Expression< Node >& src )
+{
+    return C3::assign( *this, src );
+}
+
 // Overload conversion to block of another type.
 
 template< class T >
 template< class U >
-inline C3::Block< T >::operator C3::Block< U >() const noexcept 
+inline C3::Block< T >::operator C3::Block< U >() const 
 {
     C3::Block< U > block( size() );
     return C3::assign( block, *this );
@@ -85,5 +112,38 @@ inline C3::Block< T >::operator C3::Block< U >() const noexcept
 template< class T >
 inline C3::Block< T >::~Block()
 {
-    delete [] _data;
+    _deallocate();
+}
+
+// Storage from the memory resource.  Elements are default-initialized as
+// new[] would do, which for pixel types compiles to nothing.  To first-touch
+// they are value-initialized instead, in the same flat bands over threads as
+// the assignment kernels.
+
+template< class T >
+inline T* C3::Block< T >::_allocate( const C3::size_type size, const bool touch )
+{
+    T* data = static_cast< T* >( _resource->allocate( size * sizeof( T ) ) );
+    if( ! touch )
+    {
+        for( C3::size_type i = 0; i < size; ++i ) ::new( static_cast< void* >( data + i ) ) T;
+        return data;
+    }
+    C3::detail::_parallel_for( size, size, C3::detail::_grain< T >(), 
+        [ & ]( const C3::size_type first, const C3::size_type last )
+        {
+            for( auto i = first; i < last; ++i ) ::new( static_cast< void* >( data + i ) ) T();
+        } );
+    return data;
+}
+
+// Destroy elements and return storage to the resource it came from.  Moved-from
+// blocks have nothing to return, and adopted pixels belong to someone else.
+
+template< class T >
+inline void C3::Block< T >::_deallocate()
+{
+    if( ! _data || ! owner() ) return;
+    for( C3::size_type i = 0; i < _size; ++i ) _data[ i ].~T();
+    _resource->deallocate( _data, _size * sizeof( T ) );
 }
@@ -2,17 +2,24 @@
 // Construction.
 
 template< class T >
-inline C3::Column< T >::Column( const C3::size_type nrows ) noexcept : 
+inline C3::Column< T >::Column( const C3::size_type nrows ) : 
     C3::Block< T >( nrows ) 
 {}
 
 // Initializing constructor.
 
 template< class T >
-inline C3::Column< T >::Column( const C3::size_type nrows, const T pixel ) noexcept : 
+inline C3::Column< T >::Column( const C3::size_type nrows, const T pixel ) : 
     C3::Block< T >( nrows, pixel ) 
 {}
 
+// Adopting constructor.
+
+template< class T >
+inline C3::Column< T >::Column( T* data, const C3::size_type nrows ) noexcept : 
+    C3::Block< T >( data, nrows ) 
+{}
+
 // Pixel assignment.
 
 template< class T >
@@ -21,11 +28,20 @@ inline C3::Column< T >& C3::Column< T >::operator = ( const T pixel ) noexcept
     return C3::assign( *this, pixel );
 }
 
+// Expression assignment.
+
+template< class T >
+template< class Node >
+inline C3::Column< T >& C3::Column< T >::operator = ( const C3::Expression< Node >& src )
+{
+    return C3::assign( *this, src );
+}
+
 // Value type conversion.
 
 template< class T >
 template< class U >
-inline C3::Column< T >::operator C3::Column< U >() const noexcept
+inline C3::Column< T >::operator C3::Column< U >() const
 {
     C3::Column< U > column( nrows() );
     return C3::assign( column, *this );
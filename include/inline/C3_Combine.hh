@@ -0,0 +1,104 @@
+
+#include <algorithm>
+#include <future>
+#include <memory>
+#include <vector>
+
+#include "../C3_Block.hh"
+#include "../C3_Frame.hh"
+#include "../C3_Insert.hh"
+#include "../C3_Reduce.hh"
+#include "../C3_Stack.hh"
+
+// Internal declarations
+
+namespace C3
+{
+
+    // Input bands loaded before each insert into the stack, so that the
+    // transpose writes whole cache lines (see C3_Insert.hh).
+
+    const size_type _combine_batch = 16;
+
+    // Load the band of rows from first_row on of every input frame into a
+    // stack at data, a batch of frames at a time through staging.
+
+    template< class U, class Load >
+    void _combine_load( U* data, U* staging, const size_type nframes, const size_type ncolumns,
+            const size_type nrows, const size_type first_row, Load& load );
+
+}
+
+// Combine bands of rows.
+
+template< class T, class U, class Load, class Store, class Operator >
+inline void C3::combine( const C3::size_type nframes, const C3::size_type ncolumns, const C3::size_type nrows,
+        const C3::size_type budget, Load load, Store store, Operator op )
+{
+    const auto band  = C3::combine_rows< T, U >( nframes, ncolumns, nrows, budget );
+    const auto batch = std::min( nframes, C3::_combine_batch );
+
+    C3::Block< U > stacks[ 2 ] = { C3::Block< U >( nframes * ncolumns * band ),
+                                   C3::Block< U >( nframes * ncolumns * band ) };
+    C3::Block< U > staging( batch * ncolumns * band );
+    C3::Block< T > output( ncolumns * band );
+
+    auto start = [ & ]( const int s, const C3::size_type first_row )
+        {
+            return std::async( std::launch::async, [ &, s, first_row ]()
+                {
+                    C3::_combine_load( stacks[ s ].data(), staging.data(), nframes, ncolumns,
+                            std::min( band, nrows - first_row ), first_row, load );
+                } );
+        };
+
+    auto pending = start( 0, 0 );
+    int s = 0;
+    for( C3::size_type first_row = 0; first_row < nrows; first_row += band, s = 1 - s )
+    {
+        pending.get();
+        if( first_row + band < nrows ) pending = start( 1 - s, first_row + band );
+
+        const auto rows = std::min( band, nrows - first_row );
+        C3::Stack< U > stack( stacks[ s ].data(), nframes, ncolumns, rows, C3::StackLayout::INTERLEAVED );
+        C3::Frame< T > result( output.data(), ncolumns, rows );
+        C3::reduce( result, stack, op );
+        store( result, first_row );
+    }
+}
+
+// Rows per band within budget.
+
+template< class T, class U >
+inline C3::size_type C3::combine_rows( const C3::size_type nframes, const C3::size_type ncolumns,
+        const C3::size_type nrows, const C3::size_type budget )
+{
+    const auto batch = std::min( nframes, C3::_combine_batch );
+    const auto row   = ( 2 * nframes + batch ) * ncolumns * sizeof( U ) + ncolumns * sizeof( T );
+    return std::max< C3::size_type >( 1, std::min( nrows, budget / row ) );
+}
+
+// Load one band into a stack.
+
+template< class U, class Load >
+inline void C3::_combine_load( U* data, U* staging, const C3::size_type nframes, const C3::size_type ncolumns,
+        const C3::size_type nrows, const C3::size_type first_row, Load& load )
+{
+    C3::Stack< U > stack( data, nframes, ncolumns, nrows, C3::StackLayout::INTERLEAVED );
+    const auto batch = std::min( nframes, C3::_combine_batch );
+    std::vector< std::unique_ptr< C3::Frame< U > > > frames;
+    for( C3::size_type b = 0; b < batch; ++b )
+    {
+        frames.emplace_back( new C3::Frame< U >( staging + ncolumns * nrows * b, ncolumns, nrows ) );
+    }
+    for( C3::size_type i = 0; i < nframes; i += batch )
+    {
+        std::vector< const C3::Frame< U >* > loaded;
+        for( C3::size_type b = 0; b < batch && i + b < nframes; ++b )
+        {
+            load( *frames[ b ], i + b, first_row );
+            loaded.push_back( frames[ b ].get() );
+        }
+        C3::insert( stack, loaded, i );
+    }
+}
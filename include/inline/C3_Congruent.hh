@@ -15,6 +15,7 @@ namespace C3
         struct ColumnCongruence {};
         struct FrameCongruence  {};
         struct StackCongruence  {};
+        struct CubeCongruence   {};
         
         /// The following traits class returns a single type corresponding to
         /// one of the above congruence types, or UndefinedType if none applies.
@@ -75,6 +76,20 @@ namespace C3
         template< class T, class U > struct CongruenceTraits<  Frame< T >, View< U > >   { using type = FrameCongruence;  };
         template< class T, class U > struct CongruenceTraits<  Stack< T >, View< U > >   { using type = FrameCongruence;  };
         template< class T, class U > struct CongruenceTraits<   View< T >, View< U > >   { using type = FrameCongruence;  };
+
+        // Stack view specializations.  Stack views may refer to stacks of any layout, so only their shapes must match.
+
+        template< class T, class U > struct CongruenceTraits< Column< T >, StackView< U > > { using type = RowCongruence;    };
+        template< class T, class U > struct CongruenceTraits<    Row< T >, StackView< U > > { using type = ColumnCongruence; };
+        template< class T, class U > struct CongruenceTraits<  Frame< T >, StackView< U > > { using type = FrameCongruence;  };
+        template< class T, class U > struct CongruenceTraits<   View< T >, StackView< U > > { using type = FrameCongruence;  };
+        template< class T, class U > struct CongruenceTraits<  Stack< T >, StackView< U > > { using type = CubeCongruence;   };
+        template< class T, class U > struct CongruenceTraits< StackView< T >, Column< U > > { using type = RowCongruence;    };
+        template< class T, class U > struct CongruenceTraits< StackView< T >,    Row< U > > { using type = ColumnCongruence; };
+        template< class T, class U > struct CongruenceTraits< StackView< T >,  Frame< U > > { using type = FrameCongruence;  };
+        template< class T, class U > struct CongruenceTraits< StackView< T >,   View< U > > { using type = FrameCongruence;  };
+        template< class T, class U > struct CongruenceTraits< StackView< T >,  Stack< U > > { using type = CubeCongruence;   };
+        template< class T, class U > struct CongruenceTraits< StackView< T >, StackView< U > > { using type = CubeCongruence; };
         
         // Congruence check implementations, selected via tag dispatch.
         
@@ -117,6 +132,15 @@ namespace C3
         
         template< class T, class U >
         inline bool congruent( const T& lhs, const U& rhs, StackCongruence )
+        {
+            return lhs.nframes()  == rhs.nframes()
+                && lhs.ncolumns() == rhs.ncolumns()
+                && lhs.nrows()    == rhs.nrows()
+                && lhs.layout()   == rhs.layout();
+        }
+        
+        template< class T, class U >
+        inline bool congruent( const T& lhs, const U& rhs, CubeCongruence )
         {
             return lhs.nframes()  == rhs.nframes()
                 && lhs.ncolumns() == rhs.ncolumns()
@@ -0,0 +1,194 @@
+
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+
+#include "../C3_Simd.hh"
+#include "../C3_Threads.hh"
+
+// Internal declarations
+
+namespace C3
+{
+
+    // Arithmetic type of a scaled conversion: float if it holds every value of both value types exactly.
+
+    template< class T >
+    struct _ExactInFloat
+    {
+        static const bool value = std::is_same< T, float >::value
+            || ( std::is_integral< T >::value && sizeof( T ) <= 2 );
+    };
+
+    template< class T, class U >
+    struct _ScaleType
+    {
+        using type = typename std::conditional< _ExactInFloat< T >::value && _ExactInFloat< U >::value,
+                float, double >::type;
+    };
+
+    // Conversion of one pixel.
+
+    template< class T >
+    struct _Cast
+    {
+        template< class U > T operator () ( const U src ) const { return static_cast< T >( src ); }
+    };
+
+    template< class T, class S >
+    struct _Scale
+    {
+        S scale;
+        S zero;
+        template< class U > T operator () ( const U src ) const;
+    };
+
+    // Scaled value to destination value type, rounded and saturated for integers.
+
+    template< class T, class S >
+    T _scaled_pixel( const S value, std::false_type );
+
+    template< class T, class S >
+    T _scaled_pixel( const S value, std::true_type );
+
+    // Conversion Kernels
+    // ------------------
+    // One run of pixels, dispatched like the expression kernels (see C3_Assign.hh).  Unthreaded, for callers that
+    // already split their work into bands.
+
+    template< class T, class U, class Conversion >
+    void _convert_kernel( T* dest, const U* src, const size_type count, Conversion conversion );
+
+    template< class T >
+    void _convert_kernel( T* dest, const T* src, const size_type count, _Cast< T > );
+
+    template< class T, class U, class Conversion >
+    void _scalar_convert_kernel( T* dest, const U* src, const size_type count, Conversion conversion );
+
+#ifdef C3_SIMD_X86
+
+    template< class T, class U, class Conversion >
+    C3_TARGET_AVX2 void _vector_convert_kernel( detail::Avx2, T* dest, const U* src, const size_type count,
+            Conversion conversion );
+
+    template< class T, class U, class Conversion >
+    C3_TARGET_AVX512 void _vector_convert_kernel( detail::Avx512, T* dest, const U* src, const size_type count,
+            Conversion conversion );
+
+#endif
+
+    // Conversion in bands over threads.
+
+    template< class T, class U, class Conversion >
+    void _convert( T* dest, const U* src, const size_type count, Conversion conversion );
+
+}
+
+// Convert pixels as static_cast does.
+
+template< class T, class U >
+inline void C3::convert( T* dest, const U* src, const C3::size_type count )
+{
+    C3::_convert( dest, src, count, C3::_Cast< T >() );
+}
+
+// Convert pixels through a linear scale.
+
+template< class T, class U >
+inline void C3::convert( T* dest, const U* src, const C3::size_type count, const double scale, const double zero )
+{
+    using S = typename C3::_ScaleType< T, U >::type;
+    C3::_convert( dest, src, count, C3::_Scale< T, S >{ static_cast< S >( scale ), static_cast< S >( zero ) } );
+}
+
+// Scaled conversion of one pixel.
+
+template< class T, class S >
+template< class U >
+inline T C3::_Scale< T, S >::operator () ( const U src ) const
+{
+    return C3::_scaled_pixel< T >( static_cast< S >( src ) * scale + zero, std::is_integral< T >() );
+}
+
+template< class T, class S >
+inline T C3::_scaled_pixel( const S value, std::false_type )
+{
+    return static_cast< T >( value );
+}
+
+// Round half away from zero by adding a signed half, then clamp, so that
+// truncation by the cast never sees a value out of range.  Mask arithmetic
+// and min/max in place of branches keep the loop vectorizable.  NaN stays
+// undefined, as in CFITSIO.
+
+template< class T, class S >
+inline T C3::_scaled_pixel( const S value, std::true_type )
+{
+    const S low     = static_cast< S >( std::numeric_limits< T >::min() );
+    const S high    = static_cast< S >( std::numeric_limits< T >::max() );
+    const S rounded = value + ( S( 0.5 ) - S( value < S( 0 ) ) );
+    return static_cast< T >( std::min( std::max( rounded, low ), high ) );
+}
+
+// Conversion, dispatched.
+
+template< class T, class U, class Conversion >
+inline void C3::_convert_kernel( T* dest, const U* src, const C3::size_type count, Conversion conversion )
+{
+#ifdef C3_SIMD_X86
+    switch( C3::isa() )
+    {
+        case C3::Isa::AVX512 : C3::_vector_convert_kernel( C3::detail::Avx512(), dest, src, count, conversion ); return;
+        case C3::Isa::AVX2   : C3::_vector_convert_kernel( C3::detail::Avx2()  , dest, src, count, conversion ); return;
+        default              : break;
+    }
+#endif
+    C3::_scalar_convert_kernel( dest, src, count, conversion );
+}
+
+// Same value type and no scale is a copy.
+
+template< class T >
+inline void C3::_convert_kernel( T* dest, const T* src, const C3::size_type count, C3::_Cast< T > )
+{
+    std::copy( src, src + count, dest );
+}
+
+template< class T, class U, class Conversion >
+inline void C3::_scalar_convert_kernel( T* dest, const U* src, const C3::size_type count, Conversion conversion )
+{
+    for( C3::size_type i = 0; i < count; ++i ) dest[ i ] = conversion( src[ i ] );
+}
+
+#ifdef C3_SIMD_X86
+
+// As with expression kernels, the loop bodies are the scalar one compiled for each instruction set.  Widening and
+// narrowing between 16-bit, 32-bit and floating-point lanes, and the clamps, all have vector instructions.
+
+template< class T, class U, class Conversion >
+C3_TARGET_AVX2 inline void C3::_vector_convert_kernel( C3::detail::Avx2, T* dest, const U* src,
+        const C3::size_type count, Conversion conversion )
+{
+    for( C3::size_type i = 0; i < count; ++i ) dest[ i ] = conversion( src[ i ] );
+}
+
+template< class T, class U, class Conversion >
+C3_TARGET_AVX512 inline void C3::_vector_convert_kernel( C3::detail::Avx512, T* dest, const U* src,
+        const C3::size_type count, Conversion conversion )
+{
+    for( C3::size_type i = 0; i < count; ++i ) dest[ i ] = conversion( src[ i ] );
+}
+
+#endif
+
+// Conversion in bands over threads.
+
+template< class T, class U, class Conversion >
+inline void C3::_convert( T* dest, const U* src, const C3::size_type count, Conversion conversion )
+{
+    C3::detail::_parallel_for( count, count, C3::detail::_grain< T >(),
+        [ & ]( const C3::size_type first, const C3::size_type last )
+        {
+            C3::_convert_kernel( dest + first, src + first, last - first, conversion );
+        } );
+}
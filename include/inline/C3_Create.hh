@@ -9,12 +9,13 @@ namespace C3
     template< class T, class U >  Frame< T > _create( const  Frame< U >& src );
     template< class T, class U >  Frame< T > _create( const   View< U >& src );
     template< class T, class U >  Stack< T > _create( const  Stack< U >& src );
+    template< class T, class U >  Stack< T > _create( const StackView< U >& src );
 }
 
 // From prototype instance with same value type.
 
 template< class Container >
-inline Container C3::create( const Container& src )
+inline typename C3::Created< Container >::type C3::create( const Container& src )
 {
     using value_type = typename C3::ValueType< Container >::type;
     return C3::_create< value_type >( src );
@@ -23,7 +24,7 @@ inline Container C3::create( const Container& src )
 // From prototype instance with possibly different value type.
 
 template< class T, template< class > class Container, class U >
-inline Container< T > C3::create( const Container< U >& src )
+inline typename C3::Created< Container< T > >::type C3::create( const Container< U >& src )
 {
     return C3::_create< T >( src );
 }
@@ -68,10 +69,18 @@ inline C3::Frame< T > C3::_create( const C3::View< U >& src )
     return C3::Frame< T >( src.ncolumns(), src.nrows() );
 }
 
-// Stack.
+// Stack, with the same layout.
 
 template< class T, class U >
 inline C3::Stack< T > C3::_create( const C3::Stack< U >& src )
 {
-    return C3::Stack< T >( src.nframes(), src.ncolumns(), src.nrows() );
+    return C3::Stack< T >( src.nframes(), src.ncolumns(), src.nrows(), src.layout() );
+}
+
+// Stack from stack view, with the layout of the referenced stack.
+
+template< class T, class U >
+inline C3::Stack< T > C3::_create( const C3::StackView< U >& src )
+{
+    return C3::Stack< T >( src.nframes(), src.ncolumns(), src.nrows(), src.layout() );
 }
@@ -0,0 +1,455 @@
+
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "../C3_Block.hh"
+#include "../C3_Frame.hh"
+#include "../C3_Insert.hh"
+#include "../C3_MaskedFrame.hh"
+#include "../C3_MpiException.hh"
+#include "../C3_MpiTraits.hh"
+#include "../C3_Reduce.hh"
+#include "../C3_Stack.hh"
+#include "../C3_WeightedMean.hh"
+
+// Internal declarations
+
+namespace C3
+{
+
+    // Frame pixels to and from a buffer of packed rows.
+
+    template< class T >
+    void _mpi_pack( T* dest, const Frame< T >& src );
+
+    template< class T >
+    void _mpi_unpack( Frame< T >& dest, const T* src );
+
+    // Result pixel from the sum of n processes' pixels.
+
+    template< class T >
+    T _mpi_finish( const Sum&, const T sum, const int n );
+
+    template< class T >
+    T _mpi_finish( const Mean&, const T sum, const int n );
+
+    // Sum onto the root, or onto every process if all is true, finished for the operator.
+
+    template< class T, class Operator >
+    MpiRequest _mpi_ireduce( Frame< T >& frame, const Communicator& comm, const int root, const bool all,
+            Operator op );
+
+    // Weighted mean onto the root, or onto every process if all is true.
+
+    template< class T, class F >
+    MpiRequest _mpi_ireduce( MaskedFrame< T, F >& frame, const Communicator& comm, const int root, const bool all );
+
+    // MPI user operation combining length pairs of mean and weight, in into inout.
+
+    template< class T >
+    void _mpi_weighted_mean( void* in, void* inout, int* length, MPI_Datatype* );
+
+    // Rows first to last of the band of process rank out of size.
+
+    std::pair< size_type, size_type > _mpi_band( const size_type nrows, const int size, const int rank );
+
+}
+
+// Request constructor.
+
+inline C3::MpiRequest::MpiRequest( std::vector< MPI_Request >&& requests, std::function< void() >&& finish ) noexcept :
+    _requests( std::move( requests ) ), _finish( std::move( finish ) )
+{}
+
+// Move constructor.
+
+inline C3::MpiRequest::MpiRequest( C3::MpiRequest&& other ) noexcept :
+    _requests( std::move( other._requests ) ), _finish( std::move( other._finish ) )
+{
+    other._requests.clear();
+}
+
+// Move assignment, dropping any reduction in progress first.
+
+inline C3::MpiRequest& C3::MpiRequest::operator = ( C3::MpiRequest&& other ) noexcept
+{
+    if( this == &other ) return *this;
+    _discard();
+    _requests = std::move( other._requests );
+    _finish   = std::move( other._finish );
+    other._requests.clear();
+    return *this;
+}
+
+// Destructor, dropping any reduction in progress.
+
+inline C3::MpiRequest::~MpiRequest()
+{
+    _discard();
+}
+
+// Test for completion.
+
+inline bool C3::MpiRequest::test()
+{
+    if( ! pending() ) return true;
+    int complete = 0;
+    int status = MPI_Testall( _requests.size(), _requests.data(), &complete, MPI_STATUSES_IGNORE );
+    C3::assert_mpi_status( status );
+    if( complete ) _finish_requests();
+    return complete;
+}
+
+// Wait for completion.
+
+inline void C3::MpiRequest::wait()
+{
+    if( ! pending() ) return;
+    int status = MPI_Waitall( _requests.size(), _requests.data(), MPI_STATUSES_IGNORE );
+    C3::assert_mpi_status( status );
+    _finish_requests();
+}
+
+// Finish once, even if the finishing step throws.
+
+inline void C3::MpiRequest::_finish_requests()
+{
+    _requests.clear();
+    auto finish = std::move( _finish );
+    _finish = nullptr;
+    if( finish ) finish();
+}
+
+// Discard.  Requests of nonblocking collectives may not be freed, only
+// waited for, and every process has started them, so waiting cannot hang.
+// The finishing step is dropped unrun, releasing what it holds.
+
+inline void C3::MpiRequest::_discard() noexcept
+{
+    if( pending() ) MPI_Waitall( _requests.size(), _requests.data(), MPI_STATUSES_IGNORE );
+    _requests.clear();
+    _finish = nullptr;
+}
+
+// Sum or mean onto the root.
+
+template< class T, class Operator >
+inline void C3::mpi_reduce( C3::Frame< T >& frame, const C3::Communicator& comm, const int root, Operator op )
+{
+    C3::mpi_ireduce( frame, comm, root, op ).wait();
+}
+
+// Sum or mean onto every process.
+
+template< class T, class Operator >
+inline void C3::mpi_allreduce( C3::Frame< T >& frame, const C3::Communicator& comm, Operator op )
+{
+    C3::mpi_iallreduce( frame, comm, op ).wait();
+}
+
+// Nonblocking sum or mean onto the root.
+
+template< class T, class Operator >
+inline C3::MpiRequest C3::mpi_ireduce( C3::Frame< T >& frame, const C3::Communicator& comm, const int root,
+        Operator op )
+{
+    return C3::_mpi_ireduce( frame, comm, root, false, op );
+}
+
+// Nonblocking sum or mean onto every process.
+
+template< class T, class Operator >
+inline C3::MpiRequest C3::mpi_iallreduce( C3::Frame< T >& frame, const C3::Communicator& comm, Operator op )
+{
+    return C3::_mpi_ireduce( frame, comm, 0, true, op );
+}
+
+// Weighted mean onto the root.
+
+template< class T, class F >
+inline void C3::mpi_reduce( C3::MaskedFrame< T, F >& frame, const C3::Communicator& comm, const int root,
+        C3::WeightedMean )
+{
+    C3::_mpi_ireduce( frame, comm, root, false ).wait();
+}
+
+// Weighted mean onto every process.
+
+template< class T, class F >
+inline void C3::mpi_allreduce( C3::MaskedFrame< T, F >& frame, const C3::Communicator& comm, C3::WeightedMean )
+{
+    C3::_mpi_ireduce( frame, comm, 0, true ).wait();
+}
+
+// Nonblocking weighted mean onto the root.
+
+template< class T, class F >
+inline C3::MpiRequest C3::mpi_ireduce( C3::MaskedFrame< T, F >& frame, const C3::Communicator& comm,
+        const int root, C3::WeightedMean )
+{
+    return C3::_mpi_ireduce( frame, comm, root, false );
+}
+
+// Nonblocking weighted mean onto every process.
+
+template< class T, class F >
+inline C3::MpiRequest C3::mpi_iallreduce( C3::MaskedFrame< T, F >& frame, const C3::Communicator& comm,
+        C3::WeightedMean )
+{
+    return C3::_mpi_ireduce( frame, comm, 0, true );
+}
+
+// Combine by redistribution.
+
+template< class T, class Operator >
+inline void C3::mpi_combine( C3::Frame< T >& frame, const C3::Communicator& comm, Operator op )
+{
+    C3::mpi_icombine( frame, comm, op ).wait();
+}
+
+// Nonblocking combine.  Each process sends band r of its rows to process r,
+// and receives its own band from every process, one after another like the
+// frames of a planar stack.  Once they arrive the bands go into an
+// interleaved stack, so that operators with batch reductions get whole rows,
+// and the reduced bands are gathered back into every process's frame.
+
+template< class T, class Operator >
+inline C3::MpiRequest C3::mpi_icombine( C3::Frame< T >& frame, const C3::Communicator& comm, Operator op )
+{
+    const auto size     = comm.size();
+    const auto ncolumns = frame.ncolumns();
+    const auto nrows    = frame.nrows();
+    const auto band     = C3::_mpi_band( nrows, size, comm.rank() );
+    const auto rows     = band.second - band.first;
+
+    auto packed   = std::make_shared< C3::Block< T > >( ncolumns * nrows );
+    auto received = std::make_shared< C3::Block< T > >( size * rows * ncolumns );
+    C3::_mpi_pack( packed->data(), frame );
+
+    // Send counts and offsets, which are also the counts and offsets of the
+    // gather, then receive counts and offsets.
+
+    auto counts = std::make_shared< std::vector< int > >( 4 * size );
+    for( int r = 0; r < size; ++r )
+    {
+        const auto other = C3::_mpi_band( nrows, size, r );
+        ( *counts )[ r ]            = static_cast< int >( ( other.second - other.first ) * ncolumns );
+        ( *counts )[ size + r ]     = static_cast< int >( other.first * ncolumns );
+        ( *counts )[ 2 * size + r ] = static_cast< int >( rows * ncolumns );
+        ( *counts )[ 3 * size + r ] = static_cast< int >( r * rows * ncolumns );
+    }
+
+    const auto type = C3::MpiType< T >::datatype;
+    MPI_Request request;
+    int status = MPI_Ialltoallv( packed->data(), counts->data(), counts->data() + size, type, received->data(),
+            counts->data() + 2 * size, counts->data() + 3 * size, type, comm.comm(), &request );
+    C3::assert_mpi_status( status );
+
+    const MPI_Comm handle = comm.comm();
+    return C3::MpiRequest( std::vector< MPI_Request >( 1, request ),
+        [ &frame, packed, received, counts, handle, size, ncolumns, rows, op ]()
+        {
+            C3::Block< T > reduced( rows * ncolumns );
+            if( rows > 0 )
+            {
+                C3::Stack< T > stack( size, ncolumns, rows, C3::StackLayout::INTERLEAVED );
+                std::vector< std::unique_ptr< C3::Frame< T > > > bands;
+                std::vector< const C3::Frame< T >* > sources;
+                for( int r = 0; r < size; ++r )
+                {
+                    bands.emplace_back( new C3::Frame< T >( received->data() + r * rows * ncolumns, ncolumns, rows ) );
+                    sources.push_back( bands.back().get() );
+                }
+                C3::insert( stack, sources );
+                C3::Frame< T > result( reduced.data(), ncolumns, rows );
+                C3::reduce( result, stack, op );
+            }
+            const auto type = C3::MpiType< T >::datatype;
+            int status = MPI_Allgatherv( reduced.data(), static_cast< int >( rows * ncolumns ), type, packed->data(),
+                    counts->data(), counts->data() + size, type, handle );
+            C3::assert_mpi_status( status );
+            C3::_mpi_unpack( frame, packed->data() );
+        } );
+}
+
+// Pack rows.
+
+template< class T >
+inline void C3::_mpi_pack( T* dest, const C3::Frame< T >& src )
+{
+    for( C3::size_type k = 0; k < src.nrows(); ++k )
+    {
+        const T* row = src.data() + src.pitch() * k;
+        std::copy( row, row + src.ncolumns(), dest + src.ncolumns() * k );
+    }
+}
+
+// Unpack rows.
+
+template< class T >
+inline void C3::_mpi_unpack( C3::Frame< T >& dest, const T* src )
+{
+    for( C3::size_type k = 0; k < dest.nrows(); ++k )
+    {
+        std::copy( src + dest.ncolumns() * k, src + dest.ncolumns() * ( k + 1 ), dest.data() + dest.pitch() * k );
+    }
+}
+
+// Sum as it is.
+
+template< class T >
+inline T C3::_mpi_finish( const C3::Sum&, const T sum, const int )
+{
+    return sum;
+}
+
+// Mean from sum.
+
+template< class T >
+inline T C3::_mpi_finish( const C3::Mean&, const T sum, const int n )
+{
+    return static_cast< T >( sum / static_cast< typename C3::_Real< T >::type >( n ) );
+}
+
+// Sum or mean.  The packed buffer is reduced in place.
+
+template< class T, class Operator >
+inline C3::MpiRequest C3::_mpi_ireduce( C3::Frame< T >& frame, const C3::Communicator& comm, const int root,
+        const bool all, Operator op )
+{
+    auto buffer = std::make_shared< C3::Block< T > >( frame.ncolumns() * frame.nrows() );
+    C3::_mpi_pack( buffer->data(), frame );
+
+    const auto type     = C3::MpiType< T >::datatype;
+    const auto count    = static_cast< int >( buffer->size() );
+    const bool receives = all || comm.rank() == root;
+    MPI_Request request;
+    int status;
+    if( all )
+    {
+        status = MPI_Iallreduce( MPI_IN_PLACE, buffer->data(), count, type, MPI_SUM, comm.comm(), &request );
+    }
+    else
+    {
+        status = MPI_Ireduce( receives ? MPI_IN_PLACE : buffer->data(), receives ? buffer->data() : nullptr, count,
+                type, MPI_SUM, root, comm.comm(), &request );
+    }
+    C3::assert_mpi_status( status );
+
+    const auto n = comm.size();
+    return C3::MpiRequest( std::vector< MPI_Request >( 1, request ),
+        [ &frame, buffer, receives, n, op ]()
+        {
+            if( ! receives ) return;
+            for( auto& pixel : *buffer ) pixel = C3::_mpi_finish( op, pixel, n );
+            C3::_mpi_unpack( frame, buffer->data() );
+        } );
+}
+
+// Weighted mean.  Mean and weight pairs go through a user operation on a
+// datatype of two pixels, flags through a bitwise and.  Both are freed with
+// the finishing step, whether it runs or the request is dropped.
+
+template< class T, class F >
+inline C3::MpiRequest C3::_mpi_ireduce( C3::MaskedFrame< T, F >& frame, const C3::Communicator& comm,
+        const int root, const bool all )
+{
+    static_assert( std::is_floating_point< T >::value, "Weighted means need a floating-point value type." );
+
+    const auto ncolumns = frame.ncolumns();
+    const auto count    = ncolumns * frame.nrows();
+    auto pairs = std::make_shared< C3::Block< T > >( 2 * count );
+    auto flags = std::make_shared< C3::Block< F > >( count );
+    for( C3::size_type k = 0; k < frame.nrows(); ++k )
+    {
+        for( C3::size_type j = 0; j < ncolumns; ++j )
+        {
+            const auto n    = j + ncolumns * k;
+            const bool keep = frame.flags()( j, k ) == F( 0 ) && frame.invvar()( j, k ) > T( 0 );
+            ( *pairs )[ 2 * n ]     = keep ? frame.data()( j, k ) : T( 0 );
+            ( *pairs )[ 2 * n + 1 ] = keep ? frame.invvar()( j, k ) : T( 0 );
+            ( *flags )[ n ]         = frame.flags()( j, k );
+        }
+    }
+
+    MPI_Datatype pair;
+    int status = MPI_Type_contiguous( 2, C3::MpiType< T >::datatype, &pair );
+    C3::assert_mpi_status( status );
+    status = MPI_Type_commit( &pair );
+    C3::assert_mpi_status( status );
+    MPI_Op weighted_mean;
+    status = MPI_Op_create( &C3::_mpi_weighted_mean< T >, 1, &weighted_mean );
+    C3::assert_mpi_status( status );
+    std::shared_ptr< void > handles( nullptr, [ pair, weighted_mean ]( void* )
+        {
+            auto type = pair;
+            auto op   = weighted_mean;
+            MPI_Type_free( &type );
+            MPI_Op_free( &op );
+        } );
+
+    const bool receives = all || comm.rank() == root;
+    const auto n = static_cast< int >( count );
+    std::vector< MPI_Request > requests( 2 );
+    if( all )
+    {
+        status = MPI_Iallreduce( MPI_IN_PLACE, pairs->data(), n, pair, weighted_mean, comm.comm(), &requests[ 0 ] );
+        C3::assert_mpi_status( status );
+        status = MPI_Iallreduce( MPI_IN_PLACE, flags->data(), n, C3::MpiType< F >::datatype, MPI_BAND, comm.comm(),
+                &requests[ 1 ] );
+    }
+    else
+    {
+        status = MPI_Ireduce( receives ? MPI_IN_PLACE : pairs->data(), receives ? pairs->data() : nullptr, n, pair,
+                weighted_mean, root, comm.comm(), &requests[ 0 ] );
+        C3::assert_mpi_status( status );
+        status = MPI_Ireduce( receives ? MPI_IN_PLACE : flags->data(), receives ? flags->data() : nullptr, n,
+                C3::MpiType< F >::datatype, MPI_BAND, root, comm.comm(), &requests[ 1 ] );
+    }
+    C3::assert_mpi_status( status );
+
+    return C3::MpiRequest( std::move( requests ),
+        [ &frame, pairs, flags, handles, receives, ncolumns ]()
+        {
+            if( ! receives ) return;
+            for( C3::size_type k = 0; k < frame.nrows(); ++k )
+            {
+                for( C3::size_type j = 0; j < ncolumns; ++j )
+                {
+                    const auto n = j + ncolumns * k;
+                    frame.data()( j, k )   = ( *pairs )[ 2 * n ];
+                    frame.invvar()( j, k ) = ( *pairs )[ 2 * n + 1 ];
+                    frame.flags()( j, k )  = ( *flags )[ n ];
+                }
+            }
+        } );
+}
+
+// Mean and weight pairs combined, weight zero meaning no information.
+
+template< class T >
+inline void C3::_mpi_weighted_mean( void* in, void* inout, int* length, MPI_Datatype* )
+{
+    const T* src  = static_cast< const T* >( in );
+    T*       dest = static_cast< T* >( inout );
+    for( int n = 0; n < *length; ++n )
+    {
+        const T weight = src[ 2 * n + 1 ] + dest[ 2 * n + 1 ];
+        dest[ 2 * n ]     = weight > T( 0 ) ? ( src[ 2 * n + 1 ] * src[ 2 * n ] + dest[ 2 * n + 1 ] * dest[ 2 * n ] )
+            / weight : T( 0 );
+        dest[ 2 * n + 1 ] = weight;
+    }
+}
+
+// Bands of nearly equal numbers of rows, the first ones a row longer.
+
+inline std::pair< C3::size_type, C3::size_type > C3::_mpi_band( const C3::size_type nrows, const int size,
+        const int rank )
+{
+    const auto base  = nrows / size;
+    const auto extra = nrows % size;
+    const auto first = base * rank + std::min< C3::size_type >( rank, extra );
+    return std::make_pair( first, first + base + ( static_cast< C3::size_type >( rank ) < extra ? 1 : 0 ) );
+}
@@ -0,0 +1,697 @@
+
+#include <utility>
+
+#include "../C3_Congruent.hh"
+
+// Internal declarations.
+
+namespace C3
+{
+
+    // Expression Nodes
+    // ----------------
+    // Every node has a value type and produces a line cursor for a given line of the destination (see below).
+
+    // Container operand, held by reference.
+    template< class Container >
+    class _Leaf;
+
+    // Pixel operand, held by value.
+    template< class T >
+    class _Pixel;
+
+    // Binary operation.
+    template< class Operator, class Left, class Right >
+    class _Binary;
+
+    // Unary operation.
+    template< class Operator, class Operand >
+    class _Unary;
+
+    // Operand to node mapping: containers become leaves, pixels become pixel nodes, and expressions contribute their
+    // operation trees.
+    template< class T, class Enable = void >
+    struct _NodeOf;
+
+    // Expression types built by the arithmetic operators (C3_Operator.hh).  These only define a type when the operands
+    // qualify, so the operators drop out of overload resolution for anything else.
+
+    template< class T >
+    struct _IsTerm
+    {
+        static const bool value = IsContainer< T >::value || IsExpression< T >::value;
+    };
+
+    template< class Operator, class T, class U, class Enable = void >
+    struct _BinaryExpression {};
+
+    template< class Operator, class T, class U >
+    struct _BinaryExpression< Operator, T, U, typename std::enable_if< 
+        ( _IsTerm< T >::value || _IsTerm< U >::value ) &&
+        ( _IsTerm< T >::value || IsPixel< T >::value ) && 
+        ( _IsTerm< U >::value || IsPixel< U >::value ) >::type >;
+
+    template< class Operator, class T, class Enable = void >
+    struct _UnaryExpression {};
+
+    template< class Operator, class T >
+    struct _UnaryExpression< Operator, T, typename std::enable_if< _IsTerm< T >::value >::type >;
+
+    // Line Traversal
+    // --------------
+    // Expressions are evaluated one destination line at a time.  A line is a contiguous run of destination pixels, and
+    // every operand produces a cursor over the pixels it contributes to that line: either a pointer into its own
+    // pixels, or a single pixel broadcast along the line.  What a line is depends on the destination:
+    //
+    //      Block, Column, Row  one line, the whole container
+    //      Frame, View         one line per row
+    //      Stack, interleaved  one line per pixel position (j, k), running over frames
+    //      Stack, otherwise    one line per run of columns of one frame in one row (see Stack::run())
+    //      StackView           one line per pixel position (j, k), running over frames
+    //
+    // The traversal tag types below identify these cases.  Run lines carry their own position, since the drivers
+    // work it out anyway.  Lines of a strided View or a StackView are not contiguous: their pixels are a fixed step
+    // apart (see _line_step()).
+
+    struct _FlatLines  {};
+    struct _RowLines   {};
+    struct _PixelLines { size_type ncolumns; };
+    struct _RunLines   { size_type i, j, k; };
+    struct _FrameLines { size_type ncolumns; };
+
+    // Line cursors.
+
+    template< class T >
+    struct _Pointer
+    {
+        const T* data;
+        T operator [] ( const size_type i ) const { return data[ i ]; }
+    };
+
+    template< class T >
+    struct _Strided
+    {
+        const T*  data;
+        size_type step;
+        T operator [] ( const size_type i ) const { return data[ step * i ]; }
+    };
+
+    template< class T >
+    struct _Gather
+    {
+        const StackView< T >* view;
+        size_type i, j, k;
+        T operator [] ( const size_type n ) const { return (*view)( i, j + n, k ); }
+    };
+
+    template< class T >
+    struct _Scalar
+    {
+        T value;
+        T operator [] ( const size_type ) const { return value; }
+    };
+
+    template< class Operator, class Left, class Right >
+    struct _BinaryLine
+    {
+        Left  left;
+        Right right;
+        auto operator [] ( const size_type i ) const -> decltype( Operator()( left[ i ], right[ i ] ) )
+            { return Operator()( left[ i ], right[ i ] ); }
+    };
+
+    template< class Operator, class Operand >
+    struct _UnaryLine
+    {
+        Operand operand;
+        auto operator [] ( const size_type i ) const -> decltype( Operator()( operand[ i ] ) )
+            { return Operator()( operand[ i ] ); }
+    };
+
+    // Operand line cursors.  A missing overload means the operand cannot be broadcast over that destination, which is
+    // a compile-time error.  Frame and Stack derive from Block, so their flat overloads are deleted to keep them from
+    // silently matching the Block one.
+
+    template< class T > _Pointer< T > _line( const  Block< T >& src, _FlatLines , const size_type n );
+    template< class T > _Pointer< T > _line( const Column< T >& src, _FlatLines , const size_type n );
+    template< class T > _Pointer< T > _line( const    Row< T >& src, _FlatLines , const size_type n );
+    template< class T > void          _line( const  Frame< T >& src, _FlatLines , const size_type n ) = delete;
+    template< class T > void          _line( const  Stack< T >& src, _FlatLines , const size_type n ) = delete;
+
+    template< class T > _Pointer< T > _line( const  Frame< T >& src, _RowLines  , const size_type k );
+    template< class T > _Strided< T > _line( const   View< T >& src, _RowLines  , const size_type k );
+    template< class T > _Pointer< T > _line( const    Row< T >& src, _RowLines  , const size_type k );
+    template< class T > _Scalar < T > _line( const Column< T >& src, _RowLines  , const size_type k );
+
+    template< class T > _Pointer< T > _line( const  Stack< T >& src, _PixelLines, const size_type p );
+    template< class T > _Scalar < T > _line( const  Frame< T >& src, _PixelLines, const size_type p );
+    template< class T > _Scalar < T > _line( const   View< T >& src, _PixelLines, const size_type p );
+    template< class T > _Scalar < T > _line( const    Row< T >& src, _PixelLines, const size_type p );
+    template< class T > _Scalar < T > _line( const Column< T >& src, _PixelLines, const size_type p );
+    template< class T > _Strided< T > _line( const StackView< T >& src, _PixelLines, const size_type p );
+
+    template< class T > _Pointer< T > _line( const  Stack< T >& src, _RunLines  , const size_type n );
+    template< class T > _Pointer< T > _line( const  Frame< T >& src, _RunLines  , const size_type n );
+    template< class T > _Strided< T > _line( const   View< T >& src, _RunLines  , const size_type n );
+    template< class T > _Pointer< T > _line( const    Row< T >& src, _RunLines  , const size_type n );
+    template< class T > _Scalar < T > _line( const Column< T >& src, _RunLines  , const size_type n );
+    template< class T > _Gather < T > _line( const StackView< T >& src, _RunLines, const size_type n );
+
+    template< class T > _Strided< T > _line( const  Stack< T >& src, _FrameLines, const size_type p );
+    template< class T > _Strided< T > _line( const StackView< T >& src, _FrameLines, const size_type p );
+    template< class T > _Scalar < T > _line( const  Frame< T >& src, _FrameLines, const size_type p );
+    template< class T > _Scalar < T > _line( const   View< T >& src, _FrameLines, const size_type p );
+    template< class T > _Scalar < T > _line( const    Row< T >& src, _FrameLines, const size_type p );
+    template< class T > _Scalar < T > _line( const Column< T >& src, _FrameLines, const size_type p );
+
+    // Destination lines: traversal tag, number of lines, pixels per line, start of each line, and pixels from one
+    // pixel of a line to the next.
+
+    template< class T > _FlatLines  _lines( const  Block< T >& dest );
+    template< class T > _FlatLines  _lines( const Column< T >& dest );
+    template< class T > _FlatLines  _lines( const    Row< T >& dest );
+    template< class T > _RowLines   _lines( const  Frame< T >& dest );
+    template< class T > _RowLines   _lines( const   View< T >& dest );
+    template< class T > _PixelLines _lines( const  Stack< T >& dest );
+    template< class T > _FrameLines _lines( const StackView< T >& dest );
+
+    template< class Destination > size_type _line_count ( const Destination& dest, _FlatLines  );
+    template< class Destination > size_type _line_count ( const Destination& dest, _RowLines   );
+    template< class Destination > size_type _line_count ( const Destination& dest, _PixelLines );
+    template< class Destination > size_type _line_count ( const Destination& dest, _FrameLines );
+
+    template< class Destination > size_type _line_length( const Destination& dest, _FlatLines  );
+    template< class Destination > size_type _line_length( const Destination& dest, _RowLines   );
+    template< class Destination > size_type _line_length( const Destination& dest, _PixelLines );
+    template< class Destination > size_type _line_length( const Destination& dest, _FrameLines );
+
+    template< class T > T* _line_begin(  Block< T >& dest, const size_type n );
+    template< class T > T* _line_begin(  Frame< T >& dest, const size_type k );
+    template< class T > T* _line_begin(   View< T >& dest, const size_type k );
+    template< class T > T* _line_begin(  Stack< T >& dest, const size_type p );
+    template< class T > T* _line_begin( StackView< T >& dest, const size_type p );
+
+    template< class Container > size_type _line_step( const Container& dest );
+    template< class T > size_type _line_step( const View< T >& dest );
+    template< class T > size_type _line_step( const StackView< T >& dest );
+
+    // Congruence of every container operand in an expression with the destination.
+
+    template< class Destination, class Container >
+    bool _congruent( const Destination& dest, const _Leaf< Container >& node );
+
+    template< class Destination, class T >
+    bool _congruent( const Destination& dest, const _Pixel< T >& node );
+
+    template< class Destination, class Operator, class Left, class Right >
+    bool _congruent( const Destination& dest, const _Binary< Operator, Left, Right >& node );
+
+    template< class Destination, class Operator, class Operand >
+    bool _congruent( const Destination& dest, const _Unary< Operator, Operand >& node );
+
+}
+
+// Expression Node Definitions
+// ---------------------------
+
+template< class Container >
+class C3::_Leaf
+{
+
+    public :
+
+        using value_type = typename C3::ValueType< Container >::type;
+
+        explicit _Leaf( const Container& container ) : _container( container ) {}
+
+        const Container& container() const { return _container; }
+
+        template< class Lines >
+        auto line( const Lines lines, const C3::size_type n ) const -> decltype( C3::_line( std::declval< const Container& >(), lines, n ) )
+            { return C3::_line( _container, lines, n ); }
+
+    private :
+
+        const Container& _container;
+
+};
+
+template< class T >
+class C3::_Pixel
+{
+
+    public :
+
+        using value_type = T;
+
+        explicit _Pixel( const T pixel ) : _pixel( pixel ) {}
+
+        template< class Lines >
+        C3::_Scalar< T > line( const Lines, const C3::size_type ) const { return C3::_Scalar< T >{ _pixel }; }
+
+    private :
+
+        T _pixel;
+
+};
+
+template< class Operator, class Left, class Right >
+class C3::_Binary
+{
+
+    public :
+
+        using value_type = decltype( Operator()( std::declval< typename Left ::value_type >(),
+                                                 std::declval< typename Right::value_type >() ) );
+
+        _Binary( const Left& left, const Right& right ) : _left( left ), _right( right ) {}
+
+        const Left&  left()  const { return _left;  }
+        const Right& right() const { return _right; }
+
+        template< class Lines >
+        auto line( const Lines lines, const C3::size_type n ) const
+            -> C3::_BinaryLine< Operator, decltype( std::declval< const Left & >().line( lines, n ) ),
+                                          decltype( std::declval< const Right& >().line( lines, n ) ) >
+        {
+            using LeftLine  = decltype( _left .line( lines, n ) );
+            using RightLine = decltype( _right.line( lines, n ) );
+            return C3::_BinaryLine< Operator, LeftLine, RightLine >{ _left.line( lines, n ), _right.line( lines, n ) };
+        }
+
+    private :
+
+        Left    _left;
+        Right   _right;
+
+};
+
+template< class Operator, class Operand >
+class C3::_Unary
+{
+
+    public :
+
+        using value_type = decltype( Operator()( std::declval< typename Operand::value_type >() ) );
+
+        explicit _Unary( const Operand& operand ) : _operand( operand ) {}
+
+        const Operand& operand() const { return _operand; }
+
+        template< class Lines >
+        auto line( const Lines lines, const C3::size_type n ) const
+            -> C3::_UnaryLine< Operator, decltype( std::declval< const Operand& >().line( lines, n ) ) >
+        {
+            using OperandLine = decltype( _operand.line( lines, n ) );
+            return C3::_UnaryLine< Operator, OperandLine >{ _operand.line( lines, n ) };
+        }
+
+    private :
+
+        Operand _operand;
+
+};
+
+// Operand to Node Mapping
+// -----------------------
+
+template< class T >
+struct C3::_NodeOf< T, typename std::enable_if< C3::IsContainer< T >::value >::type >
+{
+    using type = C3::_Leaf< T >;
+    static type node( const T& src ) { return type( src ); }
+};
+
+template< class T >
+struct C3::_NodeOf< T, typename std::enable_if< C3::IsPixel< T >::value >::type >
+{
+    using type = C3::_Pixel< T >;
+    static type node( const T src ) { return type( src ); }
+};
+
+template< class Node >
+struct C3::_NodeOf< C3::Expression< Node > >
+{
+    using type = Node;
+    static const type& node( const C3::Expression< Node >& src ) { return src.node(); }
+};
+
+template< class Operator, class T, class U >
+struct C3::_BinaryExpression< Operator, T, U, typename std::enable_if< 
+    ( C3::_IsTerm< T >::value || C3::_IsTerm< U >::value ) &&
+    ( C3::_IsTerm< T >::value || C3::IsPixel< T >::value ) && 
+    ( C3::_IsTerm< U >::value || C3::IsPixel< U >::value ) >::type >
+{
+    using Node = C3::_Binary< Operator, typename C3::_NodeOf< T >::type, typename C3::_NodeOf< U >::type >;
+    using type = C3::Expression< Node >;
+    static type expression( const T& lsrc, const U& rsrc ) 
+        { return type( Node( C3::_NodeOf< T >::node( lsrc ), C3::_NodeOf< U >::node( rsrc ) ) ); }
+};
+
+template< class Operator, class T >
+struct C3::_UnaryExpression< Operator, T, typename std::enable_if< C3::_IsTerm< T >::value >::type >
+{
+    using Node = C3::_Unary< Operator, typename C3::_NodeOf< T >::type >;
+    using type = C3::Expression< Node >;
+    static type expression( const T& src ) { return type( Node( C3::_NodeOf< T >::node( src ) ) ); }
+};
+
+// Operand Line Cursor Definitions
+// -------------------------------
+
+// Flat destinations.
+
+template< class T >
+inline C3::_Pointer< T > C3::_line( const C3::Block< T >& src, C3::_FlatLines, const C3::size_type )
+{
+    return C3::_Pointer< T >{ src.data() };
+}
+
+template< class T >
+inline C3::_Pointer< T > C3::_line( const C3::Column< T >& src, C3::_FlatLines, const C3::size_type )
+{
+    return C3::_Pointer< T >{ src.data() };
+}
+
+template< class T >
+inline C3::_Pointer< T > C3::_line( const C3::Row< T >& src, C3::_FlatLines, const C3::size_type )
+{
+    return C3::_Pointer< T >{ src.data() };
+}
+
+// Frame and View destinations, line k is row k.
+
+template< class T >
+inline C3::_Pointer< T > C3::_line( const C3::Frame< T >& src, C3::_RowLines, const C3::size_type k )
+{
+    return C3::_Pointer< T >{ src.data() + src.pitch() * k };
+}
+
+template< class T >
+inline C3::_Strided< T > C3::_line( const C3::View< T >& src, C3::_RowLines, const C3::size_type k )
+{
+    return C3::_Strided< T >{ src.begin() + src.stride() * k, src.step() };
+}
+
+template< class T >
+inline C3::_Pointer< T > C3::_line( const C3::Row< T >& src, C3::_RowLines, const C3::size_type )
+{
+    return C3::_Pointer< T >{ src.data() };
+}
+
+template< class T >
+inline C3::_Scalar< T > C3::_line( const C3::Column< T >& src, C3::_RowLines, const C3::size_type k )
+{
+    return C3::_Scalar< T >{ src[ k ] };
+}
+
+// Stack destinations, line p is pixel position j + ncolumns * k.
+
+template< class T >
+inline C3::_Pointer< T > C3::_line( const C3::Stack< T >& src, C3::_PixelLines, const C3::size_type p )
+{
+    return C3::_Pointer< T >{ src.data() + src.nframes() * p };
+}
+
+template< class T >
+inline C3::_Scalar< T > C3::_line( const C3::Frame< T >& src, C3::_PixelLines lines, const C3::size_type p )
+{
+    return C3::_Scalar< T >{ src( p % lines.ncolumns, p / lines.ncolumns ) };
+}
+
+template< class T >
+inline C3::_Scalar< T > C3::_line( const C3::View< T >& src, C3::_PixelLines lines, const C3::size_type p )
+{
+    return C3::_Scalar< T >{ src( p % lines.ncolumns, p / lines.ncolumns ) };
+}
+
+template< class T >
+inline C3::_Scalar< T > C3::_line( const C3::Row< T >& src, C3::_PixelLines lines, const C3::size_type p )
+{
+    return C3::_Scalar< T >{ src[ p % lines.ncolumns ] };
+}
+
+template< class T >
+inline C3::_Scalar< T > C3::_line( const C3::Column< T >& src, C3::_PixelLines lines, const C3::size_type p )
+{
+    return C3::_Scalar< T >{ src[ p / lines.ncolumns ] };
+}
+
+template< class T >
+inline C3::_Strided< T > C3::_line( const C3::StackView< T >& src, C3::_PixelLines lines, const C3::size_type p )
+{
+    return C3::_Strided< T >{ src.data() + src.offset( 0, p % lines.ncolumns, p / lines.ncolumns ), src.frame_step() };
+}
+
+// Planar and tiled Stack destinations, line n is a run of columns from j in
+// row k of frame i.
+
+template< class T >
+inline C3::_Pointer< T > C3::_line( const C3::Stack< T >& src, C3::_RunLines lines, const C3::size_type )
+{
+    return C3::_Pointer< T >{ src.data() + src.offset( lines.i, lines.j, lines.k ) };
+}
+
+template< class T >
+inline C3::_Pointer< T > C3::_line( const C3::Frame< T >& src, C3::_RunLines lines, const C3::size_type )
+{
+    return C3::_Pointer< T >{ src.data() + src.pitch() * lines.k + lines.j };
+}
+
+template< class T >
+inline C3::_Strided< T > C3::_line( const C3::View< T >& src, C3::_RunLines lines, const C3::size_type )
+{
+    return C3::_Strided< T >{ src.begin() + src.stride() * lines.k + src.step() * lines.j, src.step() };
+}
+
+template< class T >
+inline C3::_Pointer< T > C3::_line( const C3::Row< T >& src, C3::_RunLines lines, const C3::size_type )
+{
+    return C3::_Pointer< T >{ src.data() + lines.j };
+}
+
+template< class T >
+inline C3::_Scalar< T > C3::_line( const C3::Column< T >& src, C3::_RunLines lines, const C3::size_type )
+{
+    return C3::_Scalar< T >{ src[ lines.k ] };
+}
+
+// Stack views may refer to stacks of any layout, so their runs of columns
+// are gathered pixel by pixel.
+
+template< class T >
+inline C3::_Gather< T > C3::_line( const C3::StackView< T >& src, C3::_RunLines lines, const C3::size_type )
+{
+    return C3::_Gather< T >{ &src, lines.i, lines.j, lines.k };
+}
+
+// StackView destinations, line p is pixel position j + ncolumns * k.  Stack
+// and stack view operands of any layout step from frame to frame.
+
+template< class T >
+inline C3::_Strided< T > C3::_line( const C3::Stack< T >& src, C3::_FrameLines lines, const C3::size_type p )
+{
+    return C3::_Strided< T >{ src.data() + src.offset( 0, p % lines.ncolumns, p / lines.ncolumns ), 
+        src.offset( 1, 0, 0 ) };
+}
+
+template< class T >
+inline C3::_Strided< T > C3::_line( const C3::StackView< T >& src, C3::_FrameLines lines, const C3::size_type p )
+{
+    return C3::_Strided< T >{ src.data() + src.offset( 0, p % lines.ncolumns, p / lines.ncolumns ), src.frame_step() };
+}
+
+template< class T >
+inline C3::_Scalar< T > C3::_line( const C3::Frame< T >& src, C3::_FrameLines lines, const C3::size_type p )
+{
+    return C3::_Scalar< T >{ src( p % lines.ncolumns, p / lines.ncolumns ) };
+}
+
+template< class T >
+inline C3::_Scalar< T > C3::_line( const C3::View< T >& src, C3::_FrameLines lines, const C3::size_type p )
+{
+    return C3::_Scalar< T >{ src( p % lines.ncolumns, p / lines.ncolumns ) };
+}
+
+template< class T >
+inline C3::_Scalar< T > C3::_line( const C3::Row< T >& src, C3::_FrameLines lines, const C3::size_type p )
+{
+    return C3::_Scalar< T >{ src[ p % lines.ncolumns ] };
+}
+
+template< class T >
+inline C3::_Scalar< T > C3::_line( const C3::Column< T >& src, C3::_FrameLines lines, const C3::size_type p )
+{
+    return C3::_Scalar< T >{ src[ p / lines.ncolumns ] };
+}
+
+// Destination Line Definitions
+// ----------------------------
+
+template< class T >
+inline C3::_FlatLines C3::_lines( const C3::Block< T >& )
+{
+    return C3::_FlatLines();
+}
+
+template< class T >
+inline C3::_FlatLines C3::_lines( const C3::Column< T >& )
+{
+    return C3::_FlatLines();
+}
+
+template< class T >
+inline C3::_FlatLines C3::_lines( const C3::Row< T >& )
+{
+    return C3::_FlatLines();
+}
+
+template< class T >
+inline C3::_RowLines C3::_lines( const C3::Frame< T >& )
+{
+    return C3::_RowLines();
+}
+
+template< class T >
+inline C3::_RowLines C3::_lines( const C3::View< T >& )
+{
+    return C3::_RowLines();
+}
+
+template< class T >
+inline C3::_PixelLines C3::_lines( const C3::Stack< T >& dest )
+{
+    return C3::_PixelLines{ dest.ncolumns() };
+}
+
+template< class T >
+inline C3::_FrameLines C3::_lines( const C3::StackView< T >& dest )
+{
+    return C3::_FrameLines{ dest.ncolumns() };
+}
+
+template< class Destination >
+inline C3::size_type C3::_line_count( const Destination&, C3::_FlatLines )
+{
+    return 1;
+}
+
+template< class Destination >
+inline C3::size_type C3::_line_count( const Destination& dest, C3::_RowLines )
+{
+    return dest.nrows();
+}
+
+template< class Destination >
+inline C3::size_type C3::_line_count( const Destination& dest, C3::_PixelLines )
+{
+    return dest.ncolumns() * dest.nrows();
+}
+
+template< class Destination >
+inline C3::size_type C3::_line_count( const Destination& dest, C3::_FrameLines )
+{
+    return dest.ncolumns() * dest.nrows();
+}
+
+template< class Destination >
+inline C3::size_type C3::_line_length( const Destination& dest, C3::_FlatLines )
+{
+    return dest.size();
+}
+
+template< class Destination >
+inline C3::size_type C3::_line_length( const Destination& dest, C3::_RowLines )
+{
+    return dest.ncolumns();
+}
+
+template< class Destination >
+inline C3::size_type C3::_line_length( const Destination& dest, C3::_PixelLines )
+{
+    return dest.nframes();
+}
+
+template< class Destination >
+inline C3::size_type C3::_line_length( const Destination& dest, C3::_FrameLines )
+{
+    return dest.nframes();
+}
+
+template< class T >
+inline T* C3::_line_begin( C3::Block< T >& dest, const C3::size_type )
+{
+    return dest.data();
+}
+
+template< class T >
+inline T* C3::_line_begin( C3::Frame< T >& dest, const C3::size_type k )
+{
+    return dest.data() + dest.pitch() * k;
+}
+
+template< class T >
+inline T* C3::_line_begin( C3::View< T >& dest, const C3::size_type k )
+{
+    return dest.begin() + dest.stride() * k;
+}
+
+template< class T >
+inline T* C3::_line_begin( C3::Stack< T >& dest, const C3::size_type p )
+{
+    return dest.data() + dest.nframes() * p;
+}
+
+template< class T >
+inline T* C3::_line_begin( C3::StackView< T >& dest, const C3::size_type p )
+{
+    return dest.data() + dest.offset( 0, p % dest.ncolumns(), p / dest.ncolumns() );
+}
+
+// Lines of most containers are contiguous.  Rows of a View step from column
+// to column, and lines of a StackView from frame to frame.
+
+template< class Container >
+inline C3::size_type C3::_line_step( const Container& )
+{
+    return 1;
+}
+
+template< class T >
+inline C3::size_type C3::_line_step( const C3::View< T >& dest )
+{
+    return dest.step();
+}
+
+template< class T >
+inline C3::size_type C3::_line_step( const C3::StackView< T >& dest )
+{
+    return dest.frame_step();
+}
+
+// Congruence Definitions
+// ----------------------
+
+template< class Destination, class Container >
+inline bool C3::_congruent( const Destination& dest, const C3::_Leaf< Container >& node )
+{
+    return C3::congruent( dest, node.container() );
+}
+
+template< class Destination, class T >
+inline bool C3::_congruent( const Destination&, const C3::_Pixel< T >& )
+{
+    return true;
+}
+
+template< class Destination, class Operator, class Left, class Right >
+inline bool C3::_congruent( const Destination& dest, const C3::_Binary< Operator, Left, Right >& node )
+{
+    return C3::_congruent( dest, node.left() ) && C3::_congruent( dest, node.right() );
+}
+
+template< class Destination, class Operator, class Operand >
+inline bool C3::_congruent( const Destination& dest, const C3::_Unary< Operator, Operand >& node )
+{
+    return C3::_congruent( dest, node.operand() );
+}
@@ -1,5 +1,11 @@
 
+#include <algorithm>
+#include <vector>
+
 #include "../C3_Block.hh"
+#include "../C3_Convert.hh"
+#include "../C3_Frame.hh"
+#include "../C3_MaskedFrame.hh"
 #include "../C3_FitsException.hh"
 #include "../C3_FitsTraits.hh"
 
@@ -35,18 +41,148 @@ inline void C3::FitsCreator::create( Block< U >& block, const std::string& extna
     fits_create_img( fits(), C3::FitsType< T >::bitpix, naxis, naxes, &cfitsio_status );
     C3::assert_fits_status( cfitsio_status );
 
-    long* fpixel = new long [ naxis ];
-    for( auto i = 0; i < naxis; ++ i ) fpixel[ i ] = 1;
+    _write< T >( block.data(), 1, block.size() );
+
+    _write_extname( extname );
+
+}
+
+// Create HDU and store unconverted frame in it.
+
+template< class T >
+inline void C3::FitsCreator::create( Frame< T >& frame, const std::string& extname, const int naxis, long* naxes )
+{
+    create< T, T >( frame, extname, naxis, naxes );
+}
 
-    fits_write_pix( fits(), C3::FitsType< U >::datatype, fpixel, block.size(), block.data(), &cfitsio_status );
+// Create HDU and store converted frame in it.  Padded frames are written one
+// row at a time, skipping the padding.
+
+template< class T, class U > 
+inline void C3::FitsCreator::create( Frame< U >& frame, const std::string& extname, const int naxis, long* naxes )
+{
+
+    if( frame.pitch() == frame.ncolumns() ) 
+    {
+        create< T, U >( static_cast< C3::Block< U >& >( frame ), extname, naxis, naxes );
+        return;
+    }
+
+    int cfitsio_status = 0;
+    fits_create_img( fits(), C3::FitsType< T >::bitpix, naxis, naxes, &cfitsio_status );
     C3::assert_fits_status( cfitsio_status );
 
-    delete [] fpixel;
+    for( C3::size_type k = 0; k < frame.nrows(); ++k )
+    {
+        _write< T >( frame.data() + frame.pitch() * k, 1 + frame.ncolumns() * k, frame.ncolumns() );
+    }
+
+    _write_extname( extname );
 
+}
+
+// Create HDUs and store unconverted masked frame planes in them.
+
+template< class T, class F >
+inline void C3::FitsCreator::create( MaskedFrame< T, F >& frame, const std::string& extname, const int naxis, 
+        long* naxes )
+{
+    create< T, T, F >( frame, extname, naxis, naxes );
+}
+
+// Create HDUs and store masked frame planes in them, flags unconverted.
+
+template< class T, class U, class F >
+inline void C3::FitsCreator::create( MaskedFrame< U, F >& frame, const std::string& extname, const int naxis,
+        long* naxes )
+{
+    create< T, U >( frame.data()  , extname            , naxis, naxes );
+    create< T, U >( frame.invvar(), extname + "_INVVAR", naxis, naxes );
+    create        ( frame.flags() , extname + "_FLAGS" , naxis, naxes );
+}
+
+// Create HDU without data.
+
+template< class T >
+inline void C3::FitsCreator::create( const std::string& extname, const int naxis, long* naxes )
+{
+
+    int cfitsio_status = 0;
+    fits_create_img( fits(), C3::FitsType< T >::bitpix, naxis, naxes, &cfitsio_status );
+    C3::assert_fits_status( cfitsio_status );
+
+    _write_extname( extname );
+
+}
+
+// Store unconverted frame as rows of the current HDU.
+
+template< class T >
+inline void C3::FitsCreator::store_rows( Frame< T >& frame, const C3::size_type first_row )
+{
+    store_rows< T, T >( frame, first_row );
+}
+
+// Store converted frame as rows of the current HDU.  Rows follow one another
+// in the HDU, so a packed frame is one write.
+
+template< class T, class U >
+inline void C3::FitsCreator::store_rows( Frame< U >& frame, const C3::size_type first_row )
+{
+    const long long first = 1 + frame.ncolumns() * first_row;
+    if( frame.pitch() == frame.ncolumns() )
+    {
+        _write< T >( frame.data(), first, frame.ncolumns() * frame.nrows() );
+        return;
+    }
+    for( C3::size_type k = 0; k < frame.nrows(); ++k )
+    {
+        _write< T >( frame.data() + frame.pitch() * k, first + frame.ncolumns() * k, frame.ncolumns() );
+    }
+}
+
+// Write pixels to the current HDU as value type T.
+
+template< class T, class U >
+inline void C3::FitsCreator::_write( U* src, const long long first, const C3::size_type count )
+{
+    _write< T >( src, first, count, std::is_same< T, U >() );
+}
+
+template< class T, class U >
+inline void C3::FitsCreator::_write( U* src, const long long first, const C3::size_type count, std::true_type )
+{
+    int cfitsio_status = 0;
+    fits_write_img( fits(), C3::FitsType< U >::datatype, first, count, src, &cfitsio_status );
+    C3::assert_fits_status( cfitsio_status );
+}
+
+// Pixels are converted a chunk at a time through an identity scale, which
+// rounds and saturates integers as CFITSIO does.
+
+template< class T, class U >
+inline void C3::FitsCreator::_write( U* src, const long long first, const C3::size_type count, std::false_type )
+{
+    const C3::size_type chunk = 65536;
+    std::vector< T > converted( std::min( count, chunk ) );
+    int cfitsio_status = 0;
+    for( C3::size_type i = 0; i < count; i += converted.size() )
+    {
+        const auto n = std::min( count - i, converted.size() );
+        C3::convert( converted.data(), src + i, n, 1.0, 0.0 );
+        fits_write_img( fits(), C3::FitsType< T >::datatype, first + i, n, converted.data(), &cfitsio_status );
+        C3::assert_fits_status( cfitsio_status );
+    }
+}
+
+// Set EXTNAME keyword of current HDU.
+
+inline void C3::FitsCreator::_write_extname( const std::string& extname )
+{
+    int cfitsio_status = 0;
     char value[ FLEN_VALUE ];
     std::copy( extname.begin(), extname.end(), value );
     value[ extname.size() ] = '\0';
     fits_write_key( fits(), TSTRING, "EXTNAME", value, 0, &cfitsio_status );
     C3::assert_fits_status( cfitsio_status );
-
 }
@@ -1,5 +1,12 @@
 
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
 #include "../C3_Block.hh"
+#include "../C3_Convert.hh"
+#include "../C3_Frame.hh"
+#include "../C3_MaskedFrame.hh"
 #include "../C3_FitsException.hh"
 #include "../C3_FitsTraits.hh"
 
@@ -27,12 +34,79 @@ inline C3::Block< T >& C3::FitsLoader::load( C3::Block< T >& block, const std::s
 template< class T >
 inline C3::Block< T >& C3::FitsLoader::load( C3::Block< T >& block )
 {
-    int cfitsio_status = 0;
-    fits_read_img( fits(), C3::FitsType< T >::datatype, 1, block.size(), 0, block.data(), 0, &cfitsio_status );
-    C3::assert_fits_status( cfitsio_status );
+    _read( block.data(), 1, block.size() );
     return block;
 }
 
+// Select HDU and load data into pre-allocated frame.
+
+template< class T >
+inline C3::Frame< T >& C3::FitsLoader::load( C3::Frame< T >& frame, const std::string& extname )
+{
+    select( extname );
+    load( frame );
+    return frame;
+}
+
+// Load data into pre-allocated frame from previously selected HDU.  Padded
+// frames are read one row at a time, skipping the padding.
+
+template< class T >
+inline C3::Frame< T >& C3::FitsLoader::load( C3::Frame< T >& frame )
+{
+    if( frame.pitch() == frame.ncolumns() ) 
+    {
+        load( static_cast< C3::Block< T >& >( frame ) );
+        return frame;
+    }
+    for( C3::size_type k = 0; k < frame.nrows(); ++k )
+    {
+        _read( frame.data() + frame.pitch() * k, 1 + frame.ncolumns() * k, frame.ncolumns() );
+    }
+    return frame;
+}
+
+// Select HDU and load rows into pre-allocated frame.
+
+template< class T >
+inline C3::Frame< T >& C3::FitsLoader::load_rows( C3::Frame< T >& frame, const std::string& extname,
+        const C3::size_type first_row )
+{
+    select( extname );
+    load_rows( frame, first_row );
+    return frame;
+}
+
+// Load rows into pre-allocated frame from previously selected HDU.  Rows
+// follow one another in the HDU, so a packed frame is one read.
+
+template< class T >
+inline C3::Frame< T >& C3::FitsLoader::load_rows( C3::Frame< T >& frame, const C3::size_type first_row )
+{
+    const long long first = 1 + frame.ncolumns() * first_row;
+    if( frame.pitch() == frame.ncolumns() ) 
+    {
+        _read( frame.data(), first, frame.ncolumns() * frame.nrows() );
+        return frame;
+    }
+    for( C3::size_type k = 0; k < frame.nrows(); ++k )
+    {
+        _read( frame.data() + frame.pitch() * k, first + frame.ncolumns() * k, frame.ncolumns() );
+    }
+    return frame;
+}
+
+// Load masked frame planes from their HDUs.
+
+template< class T, class F >
+inline C3::MaskedFrame< T, F >& C3::FitsLoader::load( C3::MaskedFrame< T, F >& frame, const std::string& extname )
+{
+    load( frame.data()  , extname );
+    load( frame.invvar(), extname + "_INVVAR" );
+    load( frame.flags() , extname + "_FLAGS"  );
+    return frame;
+}
+
 // Select HDU.
 
 inline void C3::FitsLoader::select( const std::string& extname )
@@ -44,3 +118,102 @@ inline void C3::FitsLoader::select( const std::string& extname )
     fits_movnam_hdu( fits(), IMAGE_HDU, value, 0, &cfitsio_status );
     C3::assert_fits_status( cfitsio_status );
 }
+
+// Columns of the selected HDU.
+
+inline C3::size_type C3::FitsLoader::ncolumns()
+{
+    return _axis( 0 );
+}
+
+// Rows of the selected HDU.
+
+inline C3::size_type C3::FitsLoader::nrows()
+{
+    return _axis( 1 );
+}
+
+// Read pixels of the current HDU.  Raw pixels of the common image types are
+// read unscaled and converted here, which vectorizes the conversion and
+// applies BSCALE and BZERO in the same pass.  Integer destinations keep the
+// CFITSIO conversion and its truncation.
+
+template< class T >
+inline void C3::FitsLoader::_read( T* dest, const long long first, const C3::size_type count )
+{
+    int cfitsio_status = 0;
+    int bitpix = 0;
+    fits_get_img_type( fits(), &bitpix, &cfitsio_status );
+    C3::assert_fits_status( cfitsio_status );
+    if( std::is_floating_point< T >::value )
+    {
+        const double scale = _read_scaling( "BSCALE", 1.0 );
+        const double zero  = _read_scaling( "BZERO" , 0.0 );
+        switch( bitpix )
+        {
+            case SHORT_IMG  : _read< short  >( dest, first, count, scale, zero ); return;
+            case LONG_IMG   : _read< int    >( dest, first, count, scale, zero ); return;
+            case FLOAT_IMG  : _read< float  >( dest, first, count, scale, zero ); return;
+            case DOUBLE_IMG : _read< double >( dest, first, count, scale, zero ); return;
+            default         : break;
+        }
+    }
+    fits_read_img( fits(), C3::FitsType< T >::datatype, first, count, 0, dest, 0, &cfitsio_status );
+    C3::assert_fits_status( cfitsio_status );
+}
+
+// Read raw pixels in chunks and convert them.  Unscaled pixels of the
+// destination value type are read in place.  CFITSIO scaling is switched off
+// for the raw reads and restored before any error is reported.
+
+template< class R, class T >
+inline void C3::FitsLoader::_read( T* dest, const long long first, const C3::size_type count, const double scale,
+        const double zero )
+{
+    int cfitsio_status = 0;
+    fits_set_bscale( fits(), 1.0, 0.0, &cfitsio_status );
+    C3::assert_fits_status( cfitsio_status );
+    if( std::is_same< R, T >::value && scale == 1.0 && zero == 0.0 )
+    {
+        fits_read_img( fits(), C3::FitsType< R >::datatype, first, count, 0, dest, 0, &cfitsio_status );
+    }
+    else
+    {
+        const C3::size_type chunk = 65536;
+        std::vector< R > raw( std::min( count, chunk ) );
+        for( C3::size_type i = 0; i < count; i += raw.size() )
+        {
+            const auto n = std::min( count - i, raw.size() );
+            fits_read_img( fits(), C3::FitsType< R >::datatype, first + i, n, 0, raw.data(), 0, &cfitsio_status );
+            if( cfitsio_status != 0 ) break;
+            C3::convert( dest + i, raw.data(), n, scale, zero );
+        }
+    }
+    int restore_status = 0;
+    fits_set_bscale( fits(), scale, zero, &restore_status );
+    C3::assert_fits_status( cfitsio_status );
+    C3::assert_fits_status( restore_status );
+}
+
+// Read a scaling keyword of the current HDU, or its default if absent.
+
+inline double C3::FitsLoader::_read_scaling( const char* keyword, const double default_value )
+{
+    int cfitsio_status = 0;
+    double value = default_value;
+    fits_read_key( fits(), TDOUBLE, keyword, &value, 0, &cfitsio_status );
+    if( cfitsio_status == KEY_NO_EXIST ) return default_value;
+    C3::assert_fits_status( cfitsio_status );
+    return value;
+}
+
+// Length of one axis of the current HDU.
+
+inline C3::size_type C3::FitsLoader::_axis( const int axis )
+{
+    int cfitsio_status = 0;
+    long naxes[ 2 ] = { 1, 1 };
+    fits_get_img_size( fits(), 2, naxes, &cfitsio_status );
+    C3::assert_fits_status( cfitsio_status );
+    return naxes[ axis ];
+}
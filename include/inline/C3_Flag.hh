@@ -0,0 +1,128 @@
+
+#include "../C3_Operator.hh"
+
+// Internal declarations
+
+namespace C3
+{
+
+    // Binary operator for assignment that ORs bits into a flag wherever its
+    // condition holds.  The bits are masked with the condition rather than
+    // selected by it, so the expression loops stay free of branches.
+
+    template< class F >
+    struct _SetFlags
+    {
+        F bits;
+        F operator () ( const F flags, const bool condition ) const;
+    };
+
+}
+
+// Pixel comparisons.
+
+template< class T, class U >
+inline bool C3::Less::operator () ( const T lhs, const U rhs ) const
+{
+    return lhs < rhs;
+}
+
+template< class T, class U >
+inline bool C3::LessEqual::operator () ( const T lhs, const U rhs ) const
+{
+    return lhs <= rhs;
+}
+
+template< class T, class U >
+inline bool C3::Greater::operator () ( const T lhs, const U rhs ) const
+{
+    return lhs > rhs;
+}
+
+template< class T, class U >
+inline bool C3::GreaterEqual::operator () ( const T lhs, const U rhs ) const
+{
+    return lhs >= rhs;
+}
+
+template< class T, class U >
+inline bool C3::Equal::operator () ( const T lhs, const U rhs ) const
+{
+    return lhs == rhs;
+}
+
+template< class T, class U >
+inline bool C3::NotEqual::operator () ( const T lhs, const U rhs ) const
+{
+    return lhs != rhs;
+}
+
+// Less than.
+
+template< class T, class U >
+inline typename C3::_BinaryExpression< C3::Less, T, U >::type C3::less( const T& lsrc, const U& rsrc )
+{
+    return C3::_BinaryExpression< C3::Less, T, U >::expression( lsrc, rsrc );
+}
+
+// Less than or equal.
+
+template< class T, class U >
+inline typename C3::_BinaryExpression< C3::LessEqual, T, U >::type C3::less_equal( const T& lsrc, const U& rsrc )
+{
+    return C3::_BinaryExpression< C3::LessEqual, T, U >::expression( lsrc, rsrc );
+}
+
+// Greater than.
+
+template< class T, class U >
+inline typename C3::_BinaryExpression< C3::Greater, T, U >::type C3::greater( const T& lsrc, const U& rsrc )
+{
+    return C3::_BinaryExpression< C3::Greater, T, U >::expression( lsrc, rsrc );
+}
+
+// Greater than or equal.
+
+template< class T, class U >
+inline typename C3::_BinaryExpression< C3::GreaterEqual, T, U >::type C3::greater_equal( const T& lsrc,
+        const U& rsrc )
+{
+    return C3::_BinaryExpression< C3::GreaterEqual, T, U >::expression( lsrc, rsrc );
+}
+
+// Equal.
+
+template< class T, class U >
+inline typename C3::_BinaryExpression< C3::Equal, T, U >::type C3::equal( const T& lsrc, const U& rsrc )
+{
+    return C3::_BinaryExpression< C3::Equal, T, U >::expression( lsrc, rsrc );
+}
+
+// Not equal.
+
+template< class T, class U >
+inline typename C3::_BinaryExpression< C3::NotEqual, T, U >::type C3::not_equal( const T& lsrc, const U& rsrc )
+{
+    return C3::_BinaryExpression< C3::NotEqual, T, U >::expression( lsrc, rsrc );
+}
+
+// Flagging.  The condition is always taken through an expression, even a
+// plain container, so that the pass runs in the expression kernels, which
+// dispatch to vector code whatever the operator (see C3_Assign.hh).
+
+template< class Flags, class Condition >
+inline Flags& C3::flag( Flags& flags, const typename C3::ValueType< Flags >::type bits, const Condition& condition )
+{
+    using F = typename C3::ValueType< Flags >::type;
+    static_assert( std::is_integral< F >::value && std::is_unsigned< F >::value,
+            "Flags must have an unsigned integer value type." );
+    return C3::assign( flags, C3::not_equal( condition, 0 ), C3::_SetFlags< F >{ bits } );
+}
+
+// Set bits where the condition holds.
+
+template< class F >
+inline F C3::_SetFlags< F >::operator () ( const F flags, const bool condition ) const
+{
+    return static_cast< F >( flags | ( bits & static_cast< F >( -static_cast< F >( condition ) ) ) );
+}
@@ -0,0 +1,220 @@
+
+#include <cassert>
+#include <iterator>
+#include <type_traits>
+
+#include "../C3_Congruent.hh"
+#include "../C3_Expression.hh"
+#include "../C3_Simd.hh"
+#include "../C3_Threads.hh"
+
+// Internal declarations
+
+namespace C3
+{
+
+    // For-Each Line Cursors
+    // ---------------------
+    // Pixels of one container along a line of the first container, by reference.  The lines are those of expression
+    // assignment (see C3_Expression.hh), with the first container as the destination.
+
+    template< class Pointer >
+    struct _EachLine
+    {
+        Pointer   data;
+        size_type step;
+        typename std::iterator_traits< Pointer >::reference operator [] ( const size_type i ) const
+            { return data[ step * i ]; }
+    };
+
+    // Pixel pointer of a container, to const pixels for a const container.
+
+    template< class Container >
+    struct _EachPointer
+    {
+        using T    = typename ValueType< typename std::remove_const< Container >::type >::type;
+        using type = typename std::conditional< std::is_const< Container >::value, const T*, T* >::type;
+    };
+
+    // Cursors for containers with the same lines as the first, and for broadcast operands.
+
+    template< class Container, class Lines >
+    auto _each_line( Container& container, const Lines lines, const size_type n )
+        -> typename std::enable_if< std::is_same< decltype( C3::_lines( container ) ), Lines >::value,
+                                    _EachLine< typename _EachPointer< Container >::type > >::type;
+
+    template< class T > _EachLine< const T* > _each_line( const    Row< T >& src, _RowLines, const size_type k );
+    template< class T > _EachLine< const T* > _each_line( const Column< T >& src, _RowLines, const size_type k );
+
+    // Congruence of every container with the first.  Single lines only need the same number of pixels.
+
+    template< class Lines, class Container >
+    bool _each_congruent( const Lines lines, const Container& container );
+
+    template< class Lines, class Container, class Other, class... Others >
+    bool _each_congruent( const Lines lines, const Container& container, const Other& other,
+            const Others&... others );
+
+    template< class Container, class Other >
+    bool _each_congruent_with( const Container& container, const Other& other, _FlatLines );
+
+    template< class Container, class Other >
+    bool _each_congruent_with( const Container& container, const Other& other, _RowLines );
+
+    // For-Each Kernels
+    // ----------------
+    // One line, dispatched like the expression kernels (see C3_Assign.hh).
+
+    template< class Function, class... Lines >
+    void _each_kernel( const size_type first, const size_type last, Function& op, const Lines&... lines );
+
+    template< class Function, class... Lines >
+    void _scalar_each_kernel( const size_type first, const size_type last, Function& op, const Lines&... lines );
+
+#ifdef C3_SIMD_X86
+
+    template< class Function, class... Lines >
+    C3_TARGET_AVX2 void _vector_each_kernel( detail::Avx2, const size_type first, const size_type last, Function& op,
+            const Lines&... lines );
+
+    template< class Function, class... Lines >
+    C3_TARGET_AVX512 void _vector_each_kernel( detail::Avx512, const size_type first, const size_type last,
+            Function& op, const Lines&... lines );
+
+#endif
+
+}
+
+// Lines are split into bands over threads, or for a single-line first
+// container the line itself is.
+
+template< class Function, class Container, class... Containers >
+inline void C3::for_each( Function op, Container& container, Containers&... containers )
+{
+    using T     = typename C3::ValueType< typename std::remove_const< Container >::type >::type;
+    using Lines = decltype( C3::_lines( container ) );
+    static_assert( std::is_same< Lines, C3::_FlatLines >::value || std::is_same< Lines, C3::_RowLines >::value,
+            "C3::for_each() takes a Block, Row, Column, Frame or View first" );
+    const auto lines  = C3::_lines( container );
+    assert( C3::_each_congruent( lines, container, containers... ) );
+    const auto count  = C3::_line_count( container, lines );
+    const auto length = C3::_line_length( container, lines );
+    if( count == 1 )
+    {
+        C3::detail::_parallel_for( length, length, C3::detail::_grain< T >(),
+            [ & ]( const C3::size_type first, const C3::size_type last )
+            {
+                C3::_each_kernel( first, last, op, C3::_each_line( container, lines, 0 ),
+                        C3::_each_line( containers, lines, 0 )... );
+            } );
+        return;
+    }
+    C3::detail::_parallel_for( count, count * length, 1,
+        [ & ]( const C3::size_type first, const C3::size_type last )
+        {
+            for( auto n = first; n < last; ++n )
+            {
+                C3::_each_kernel( 0, length, op, C3::_each_line( container, lines, n ),
+                        C3::_each_line( containers, lines, n )... );
+            }
+        } );
+}
+
+// Line of a container walked in step with the first one.  Line starts are
+// worked out as for destinations, so a const container goes through them
+// without its const, and gets its const back in the cursor.
+
+template< class Container, class Lines >
+inline auto C3::_each_line( Container& container, const Lines, const C3::size_type n )
+    -> typename std::enable_if< std::is_same< decltype( C3::_lines( container ) ), Lines >::value,
+                                C3::_EachLine< typename C3::_EachPointer< Container >::type > >::type
+{
+    auto& pixels = const_cast< typename std::remove_const< Container >::type& >( container );
+    return { C3::_line_begin( pixels, n ), C3::_line_step( container ) };
+}
+
+// A row broadcast over rows.
+
+template< class T >
+inline C3::_EachLine< const T* > C3::_each_line( const C3::Row< T >& src, C3::_RowLines, const C3::size_type )
+{
+    return { src.data(), 1 };
+}
+
+// A column broadcast over columns: one pixel per row.
+
+template< class T >
+inline C3::_EachLine< const T* > C3::_each_line( const C3::Column< T >& src, C3::_RowLines, const C3::size_type k )
+{
+    return { src.data() + k, 0 };
+}
+
+template< class Lines, class Container >
+inline bool C3::_each_congruent( const Lines, const Container& )
+{
+    return true;
+}
+
+template< class Lines, class Container, class Other, class... Others >
+inline bool C3::_each_congruent( const Lines lines, const Container& container, const Other& other,
+        const Others&... others )
+{
+    return C3::_each_congruent_with( container, other, lines ) && C3::_each_congruent( lines, container, others... );
+}
+
+template< class Container, class Other >
+inline bool C3::_each_congruent_with( const Container& container, const Other& other, C3::_FlatLines )
+{
+    return container.size() == other.size();
+}
+
+template< class Container, class Other >
+inline bool C3::_each_congruent_with( const Container& container, const Other& other, C3::_RowLines )
+{
+    return C3::congruent( container, other );
+}
+
+// For-each line, dispatched.
+
+template< class Function, class... Lines >
+inline void C3::_each_kernel( const C3::size_type first, const C3::size_type last, Function& op,
+        const Lines&... lines )
+{
+#ifdef C3_SIMD_X86
+    switch( C3::isa() )
+    {
+        case C3::Isa::AVX512 : C3::_vector_each_kernel( C3::detail::Avx512(), first, last, op, lines... ); return;
+        case C3::Isa::AVX2   : C3::_vector_each_kernel( C3::detail::Avx2()  , first, last, op, lines... ); return;
+        default              : break;
+    }
+#endif
+    C3::_scalar_each_kernel( first, last, op, lines... );
+}
+
+template< class Function, class... Lines >
+inline void C3::_scalar_each_kernel( const C3::size_type first, const C3::size_type last, Function& op,
+        const Lines&... lines )
+{
+    for( auto i = first; i < last; ++i ) op( lines[ i ]... );
+}
+
+#ifdef C3_SIMD_X86
+
+// As with expression kernels, the loop bodies are the scalar one.  The function and cursors are inlined into each
+// target-specific loop, which the compiler versions for unit steps and vectorizes.
+
+template< class Function, class... Lines >
+C3_TARGET_AVX2 inline void C3::_vector_each_kernel( C3::detail::Avx2, const C3::size_type first,
+        const C3::size_type last, Function& op, const Lines&... lines )
+{
+    for( auto i = first; i < last; ++i ) op( lines[ i ]... );
+}
+
+template< class Function, class... Lines >
+C3_TARGET_AVX512 inline void C3::_vector_each_kernel( C3::detail::Avx512, const C3::size_type first,
+        const C3::size_type last, Function& op, const Lines&... lines )
+{
+    for( auto i = first; i < last; ++i ) op( lines[ i ]... );
+}
+
+#endif
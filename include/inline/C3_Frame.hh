@@ -1,16 +1,36 @@
 
+#include <algorithm>
+
 // Constructor.
 
 template< class T >
-inline C3::Frame< T >::Frame( const C3::size_type ncolumns, const C3::size_type nrows ) noexcept : 
-    C3::Block< T >( ncolumns * nrows ), _ncolumns( ncolumns ), _nrows( nrows ) 
-{}
+inline C3::Frame< T >::Frame( const C3::size_type ncolumns, const C3::size_type nrows, 
+        const C3::RowPitch row_pitch ) : 
+    C3::Block< T >( _pitch_for( ncolumns, row_pitch ) * nrows, typename C3::Block< T >::Untouched() ), 
+    _ncolumns( ncolumns ), _nrows( nrows ), _row_pitch( row_pitch ), _pitch( _pitch_for( ncolumns, row_pitch ) )
+{
+    if( C3::first_touch() ) _fill( T() );
+    else _clear_padding();
+}
 
 // Initializing constructor.
 
 template< class T >
-inline C3::Frame< T >::Frame( const C3::size_type ncolumns, const C3::size_type nrows, const T pixel ) noexcept : 
-    C3::Block< T >( ncolumns * nrows, pixel ), _ncolumns( ncolumns ), _nrows( nrows ) 
+inline C3::Frame< T >::Frame( const C3::size_type ncolumns, const C3::size_type nrows, const T pixel, 
+        const C3::RowPitch row_pitch ) : 
+    C3::Block< T >( _pitch_for( ncolumns, row_pitch ) * nrows, typename C3::Block< T >::Untouched() ), 
+    _ncolumns( ncolumns ), _nrows( nrows ), _row_pitch( row_pitch ), _pitch( _pitch_for( ncolumns, row_pitch ) )
+{
+    _fill( pixel );
+}
+
+// Adopting constructor.
+
+template< class T >
+inline C3::Frame< T >::Frame( T* data, const C3::size_type ncolumns, const C3::size_type nrows, 
+        const C3::RowPitch row_pitch ) noexcept : 
+    C3::Block< T >( data, _pitch_for( ncolumns, row_pitch ) * nrows ), _ncolumns( ncolumns ), _nrows( nrows ),
+    _row_pitch( row_pitch ), _pitch( _pitch_for( ncolumns, row_pitch ) )
 {}
 
 // Pixel assignment.
@@ -21,12 +41,62 @@ inline C3::Frame< T >& C3::Frame< T >::operator = ( const T pixel ) noexcept
     return C3::assign( *this, pixel );
 }
 
+// Expression assignment.
+
+template< class T >
+template< class Node >
+inline C3::Frame< T >& C3::Frame< T >::operator = ( const C3::Expression< Node >& src )
+{
+    return C3::assign( *this, src );
+}
+
 // Value type conversion.
 
 template< class T >
 template< class U >
-inline C3::Frame< T >::operator C3::Frame< U >() const noexcept
+inline C3::Frame< T >::operator C3::Frame< U >() const
 {
-    C3::Frame< U > frame( ncolumns(), nrows() );
+    C3::Frame< U > frame( ncolumns(), nrows(), row_pitch() );
     return C3::assign( frame, *this );
 }
+
+// Row pitch.  Aligned rows round up to a whole number of alignment units, or
+// stay packed if a pixel does not divide the alignment.
+
+template< class T >
+inline C3::size_type C3::Frame< T >::_pitch_for( const C3::size_type ncolumns, const C3::RowPitch row_pitch )
+{
+    if( row_pitch == C3::RowPitch::PACKED || C3::alignment % sizeof( T ) != 0 ) return ncolumns;
+    const C3::size_type unit = C3::alignment / sizeof( T );
+    return ( ncolumns + unit - 1 ) / unit * unit;
+}
+
+// Zero the padding at the end of every row.
+
+template< class T >
+inline void C3::Frame< T >::_clear_padding()
+{
+    if( _pitch == _ncolumns ) return;
+    for( C3::size_type k = 0; k < _nrows; ++k ) 
+    {
+        std::fill( this->data() + _pitch * k + _ncolumns, this->data() + _pitch * ( k + 1 ), T( 0 ) );
+    }
+}
+
+// Fill rows in the same row bands as the assignment kernels, so each thread
+// first touches the pages it works on later.
+
+template< class T >
+inline void C3::Frame< T >::_fill( const T pixel )
+{
+    const auto data = this->data();
+    C3::detail::_parallel_for( _nrows, _ncolumns * _nrows, 1, 
+        [ & ]( const C3::size_type first, const C3::size_type last )
+        {
+            for( auto k = first; k < last; ++k )
+            {
+                std::fill( data + _pitch * k, data + _pitch * k + _ncolumns, pixel );
+                std::fill( data + _pitch * k + _ncolumns, data + _pitch * ( k + 1 ), T( 0 ) );
+            }
+        } );
+}
@@ -0,0 +1,257 @@
+#include <algorithm>
+#include <cassert>
+
+#include "../C3_Assign.hh"
+#include "../C3_Simd.hh"
+#include "../C3_Threads.hh"
+
+// Internal declarations.
+
+namespace C3
+{
+
+    // Transpose a tile: dest[ stride * c + i ] = src[ i ][ j + c ] for nframes frames i and ncolumns columns c.  The
+    // float and double overloads dispatch to vector versions.
+
+    template< class T, class U >
+    void _transpose_tile( T* dest, const size_type stride, const U* const* src, const size_type j, 
+            const size_type nframes, const size_type ncolumns );
+
+    void _transpose_tile( float* dest, const size_type stride, const float* const* src, const size_type j, 
+            const size_type nframes, const size_type ncolumns );
+
+    void _transpose_tile( double* dest, const size_type stride, const double* const* src, const size_type j, 
+            const size_type nframes, const size_type ncolumns );
+
+    template< class T, class U >
+    void _scalar_transpose_tile( T* dest, const size_type stride, const U* const* src, const size_type j, 
+            const size_type nframes, const size_type ncolumns );
+
+#ifdef C3_SIMD_X86
+
+    // Square blocks of one vector register per frame, then the scalar version for what is left.
+
+    template< class T >
+    C3_TARGET_AVX2 void _vector_transpose_tile( detail::Avx2, T* dest, const size_type stride, const T* const* src, 
+            const size_type j, const size_type nframes, const size_type ncolumns );
+
+    C3_TARGET_AVX2 void _transpose_block( detail::Avx2, float* dest, const size_type stride, const float* const* src, 
+            const size_type j );
+
+    C3_TARGET_AVX2 void _transpose_block( detail::Avx2, double* dest, const size_type stride, 
+            const double* const* src, const size_type j );
+
+#endif
+
+}
+
+// Batch of frames from pointers.
+
+template< class T, class Source >
+inline C3::Stack< T >& C3::insert( C3::Stack< T >& dest, const std::vector< const Source* >& frames, 
+        const C3::size_type first )
+{
+    using U = typename C3::ValueType< Source >::type;
+    assert( first + frames.size() <= dest.nframes() );
+    for( auto frame : frames ) assert( C3::congruent( dest, *frame ) );
+
+    const auto nframes = frames.size();
+    const auto dest_begin = dest.begin();
+
+    // Planar and tiled stacks: runs of each frame go straight in.
+
+    if( dest.layout() != C3::StackLayout::INTERLEAVED )
+    {
+        C3::detail::_parallel_for( dest.nrows(), nframes * dest.ncolumns() * dest.nrows(), 1,
+            [ & ]( const C3::size_type first_row, const C3::size_type last_row )
+            {
+                for( auto k = first_row; k < last_row; ++k )
+                {
+                    for( C3::size_type f = 0; f < nframes; ++f )
+                    {
+                        const auto src_row = C3::_line( *frames[ f ], C3::_RowLines(), k ).data;
+                        for( C3::size_type j = 0; j < dest.ncolumns(); j += dest.run() )
+                        {
+                            const auto length = std::min( dest.run(), dest.ncolumns() - j );
+                            C3::_assign_kernel_2( dest_begin + dest.offset( first + f, j, k ), src_row + j, 
+                                    src_row + j + length, C3::Identity() );
+                        }
+                    }
+                }
+            } );
+        return dest;
+    }
+
+    // Interleaved stacks: transpose a source cache line of columns at a time.
+
+    const auto block = C3::detail::_grain< U >();
+    C3::detail::_parallel_for( dest.nrows(), nframes * dest.ncolumns() * dest.nrows(), 1,
+        [ & ]( const C3::size_type first_row, const C3::size_type last_row )
+        {
+            std::vector< const U* > src_rows( nframes );
+            for( auto k = first_row; k < last_row; ++k )
+            {
+                for( C3::size_type f = 0; f < nframes; ++f ) src_rows[ f ] = C3::_line( *frames[ f ], C3::_RowLines(), k ).data;
+                for( C3::size_type j = 0; j < dest.ncolumns(); j += block )
+                {
+                    C3::_transpose_tile( dest_begin + dest.offset( first, j, k ), dest.nframes(), src_rows.data(), j,
+                            nframes, std::min( block, dest.ncolumns() - j ) );
+                }
+            }
+        } );
+    return dest;
+
+}
+
+// Batch of frames.
+
+template< class T, class Source >
+inline C3::Stack< T >& C3::insert( C3::Stack< T >& dest, const std::vector< Source >& frames, 
+        const C3::size_type first )
+{
+    std::vector< const Source* > pointers;
+    pointers.reserve( frames.size() );
+    for( auto& frame : frames ) pointers.push_back( &frame );
+    return C3::insert( dest, pointers, first );
+}
+
+// Tile, any value types.
+
+template< class T, class U >
+inline void C3::_transpose_tile( T* dest, const C3::size_type stride, const U* const* src, const C3::size_type j, 
+        const C3::size_type nframes, const C3::size_type ncolumns )
+{
+    C3::_scalar_transpose_tile( dest, stride, src, j, nframes, ncolumns );
+}
+
+// Float tile, dispatched.  The AVX2 version also serves AVX-512 processors;
+// the tile is only a cache line wide.
+
+inline void C3::_transpose_tile( float* dest, const C3::size_type stride, const float* const* src, 
+        const C3::size_type j, const C3::size_type nframes, const C3::size_type ncolumns )
+{
+#ifdef C3_SIMD_X86
+    if( C3::isa() >= C3::Isa::AVX2 ) 
+    {
+        C3::_vector_transpose_tile( C3::detail::Avx2(), dest, stride, src, j, nframes, ncolumns );
+        return;
+    }
+#endif
+    C3::_scalar_transpose_tile( dest, stride, src, j, nframes, ncolumns );
+}
+
+// Double tile, dispatched.
+
+inline void C3::_transpose_tile( double* dest, const C3::size_type stride, const double* const* src, 
+        const C3::size_type j, const C3::size_type nframes, const C3::size_type ncolumns )
+{
+#ifdef C3_SIMD_X86
+    if( C3::isa() >= C3::Isa::AVX2 ) 
+    {
+        C3::_vector_transpose_tile( C3::detail::Avx2(), dest, stride, src, j, nframes, ncolumns );
+        return;
+    }
+#endif
+    C3::_scalar_transpose_tile( dest, stride, src, j, nframes, ncolumns );
+}
+
+// Tile, pixel by pixel.  Frames run fastest so destination pixels are
+// written in order.
+
+template< class T, class U >
+inline void C3::_scalar_transpose_tile( T* dest, const C3::size_type stride, const U* const* src, 
+        const C3::size_type j, const C3::size_type nframes, const C3::size_type ncolumns )
+{
+    for( C3::size_type c = 0; c < ncolumns; ++c )
+    {
+        for( C3::size_type i = 0; i < nframes; ++i ) dest[ stride * c + i ] = static_cast< T >( src[ i ][ j + c ] );
+    }
+}
+
+#ifdef C3_SIMD_X86
+
+// Tile in square blocks of Pack::width frames by Pack::width columns.
+
+template< class T >
+C3_TARGET_AVX2 inline void C3::_vector_transpose_tile( C3::detail::Avx2, T* dest, const C3::size_type stride, 
+        const T* const* src, const C3::size_type j, const C3::size_type nframes, const C3::size_type ncolumns )
+{
+    const auto width = C3::detail::Pack< C3::detail::Avx2, T >::width;
+    C3::size_type i = 0;
+    for( ; i + width <= nframes; i += width )
+    {
+        C3::size_type c = 0;
+        for( ; c + width <= ncolumns; c += width ) 
+        {
+            C3::_transpose_block( C3::detail::Avx2(), dest + stride * c + i, stride, src + i, j + c );
+        }
+        C3::_scalar_transpose_tile( dest + stride * c + i, stride, src + i, j + c, width, ncolumns - c );
+    }
+    C3::_scalar_transpose_tile( dest + i, stride, src + i, j, nframes - i, ncolumns );
+}
+
+// 8 by 8 floats: interleave pairs of rows, then pairs of pairs, then swap
+// 128-bit lanes.
+
+C3_TARGET_AVX2 inline void C3::_transpose_block( C3::detail::Avx2, float* dest, const C3::size_type stride, 
+        const float* const* src, const C3::size_type j )
+{
+    const __m256 r0 = _mm256_loadu_ps( src[ 0 ] + j );
+    const __m256 r1 = _mm256_loadu_ps( src[ 1 ] + j );
+    const __m256 r2 = _mm256_loadu_ps( src[ 2 ] + j );
+    const __m256 r3 = _mm256_loadu_ps( src[ 3 ] + j );
+    const __m256 r4 = _mm256_loadu_ps( src[ 4 ] + j );
+    const __m256 r5 = _mm256_loadu_ps( src[ 5 ] + j );
+    const __m256 r6 = _mm256_loadu_ps( src[ 6 ] + j );
+    const __m256 r7 = _mm256_loadu_ps( src[ 7 ] + j );
+
+    const __m256 t0 = _mm256_unpacklo_ps( r0, r1 );
+    const __m256 t1 = _mm256_unpackhi_ps( r0, r1 );
+    const __m256 t2 = _mm256_unpacklo_ps( r2, r3 );
+    const __m256 t3 = _mm256_unpackhi_ps( r2, r3 );
+    const __m256 t4 = _mm256_unpacklo_ps( r4, r5 );
+    const __m256 t5 = _mm256_unpackhi_ps( r4, r5 );
+    const __m256 t6 = _mm256_unpacklo_ps( r6, r7 );
+    const __m256 t7 = _mm256_unpackhi_ps( r6, r7 );
+
+    const __m256 s0 = _mm256_shuffle_ps( t0, t2, _MM_SHUFFLE( 1, 0, 1, 0 ) );
+    const __m256 s1 = _mm256_shuffle_ps( t0, t2, _MM_SHUFFLE( 3, 2, 3, 2 ) );
+    const __m256 s2 = _mm256_shuffle_ps( t1, t3, _MM_SHUFFLE( 1, 0, 1, 0 ) );
+    const __m256 s3 = _mm256_shuffle_ps( t1, t3, _MM_SHUFFLE( 3, 2, 3, 2 ) );
+    const __m256 s4 = _mm256_shuffle_ps( t4, t6, _MM_SHUFFLE( 1, 0, 1, 0 ) );
+    const __m256 s5 = _mm256_shuffle_ps( t4, t6, _MM_SHUFFLE( 3, 2, 3, 2 ) );
+    const __m256 s6 = _mm256_shuffle_ps( t5, t7, _MM_SHUFFLE( 1, 0, 1, 0 ) );
+    const __m256 s7 = _mm256_shuffle_ps( t5, t7, _MM_SHUFFLE( 3, 2, 3, 2 ) );
+
+    _mm256_storeu_ps( dest             , _mm256_permute2f128_ps( s0, s4, 0x20 ) );
+    _mm256_storeu_ps( dest + stride    , _mm256_permute2f128_ps( s1, s5, 0x20 ) );
+    _mm256_storeu_ps( dest + stride * 2, _mm256_permute2f128_ps( s2, s6, 0x20 ) );
+    _mm256_storeu_ps( dest + stride * 3, _mm256_permute2f128_ps( s3, s7, 0x20 ) );
+    _mm256_storeu_ps( dest + stride * 4, _mm256_permute2f128_ps( s0, s4, 0x31 ) );
+    _mm256_storeu_ps( dest + stride * 5, _mm256_permute2f128_ps( s1, s5, 0x31 ) );
+    _mm256_storeu_ps( dest + stride * 6, _mm256_permute2f128_ps( s2, s6, 0x31 ) );
+    _mm256_storeu_ps( dest + stride * 7, _mm256_permute2f128_ps( s3, s7, 0x31 ) );
+}
+
+// 4 by 4 doubles: interleave pairs of rows, then swap 128-bit lanes.
+
+C3_TARGET_AVX2 inline void C3::_transpose_block( C3::detail::Avx2, double* dest, const C3::size_type stride, 
+        const double* const* src, const C3::size_type j )
+{
+    const __m256d r0 = _mm256_loadu_pd( src[ 0 ] + j );
+    const __m256d r1 = _mm256_loadu_pd( src[ 1 ] + j );
+    const __m256d r2 = _mm256_loadu_pd( src[ 2 ] + j );
+    const __m256d r3 = _mm256_loadu_pd( src[ 3 ] + j );
+
+    const __m256d t0 = _mm256_unpacklo_pd( r0, r1 );
+    const __m256d t1 = _mm256_unpackhi_pd( r0, r1 );
+    const __m256d t2 = _mm256_unpacklo_pd( r2, r3 );
+    const __m256d t3 = _mm256_unpackhi_pd( r2, r3 );
+
+    _mm256_storeu_pd( dest             , _mm256_permute2f128_pd( t0, t2, 0x20 ) );
+    _mm256_storeu_pd( dest + stride    , _mm256_permute2f128_pd( t1, t3, 0x20 ) );
+    _mm256_storeu_pd( dest + stride * 2, _mm256_permute2f128_pd( t0, t2, 0x31 ) );
+    _mm256_storeu_pd( dest + stride * 3, _mm256_permute2f128_pd( t1, t3, 0x31 ) );
+}
+
+#endif
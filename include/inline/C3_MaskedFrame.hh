@@ -0,0 +1,371 @@
+
+#include <cassert>
+
+#include "../C3_Congruent.hh"
+#include "../C3_Expression.hh"
+#include "../C3_Simd.hh"
+#include "../C3_Threads.hh"
+
+// Internal declarations
+
+namespace C3
+{
+
+    // Masked Line Cursors
+    // -------------------
+    // One row of a masked frame operand, and one row of an exact operand (any expression line cursor).
+
+    template< class U, class G >
+    struct _MaskedLine
+    {
+        const U* data;
+        const U* invvar;
+        const G* flags;
+    };
+
+    template< class Line >
+    struct _ExactLine
+    {
+        Line data;
+    };
+
+    // Fused passes over all three planes.
+
+    template< class T, class F, class U, class G, class Operator >
+    MaskedFrame< T, F >& _masked_apply( MaskedFrame< T, F >& dest, const MaskedFrame< U, G >& src, Operator op );
+
+    template< class T, class F, class Source, class Operator >
+    MaskedFrame< T, F >& _masked_apply_exact( MaskedFrame< T, F >& dest, const Source& src, Operator op );
+
+    // Ratio of inverse variance terms, zero unless the denominator is positive.
+
+    template< class T >
+    T _guarded_ratio( const T numerator, const T denominator );
+
+    // Propagation of one pixel.  Inverse variances are combined without
+    // dividing by either one, so zero (no information) propagates as zero.
+
+    template< class T, class F, class U, class G >
+    void _masked_combine( T& data, T& invvar, F& flags, const _MaskedLine< U, G >& src, const size_type i, Plus );
+
+    template< class T, class F, class U, class G >
+    void _masked_combine( T& data, T& invvar, F& flags, const _MaskedLine< U, G >& src, const size_type i, Minus );
+
+    template< class T, class F, class U, class G >
+    void _masked_combine( T& data, T& invvar, F& flags, const _MaskedLine< U, G >& src, const size_type i,
+            Multiplies );
+
+    template< class T, class F, class U, class G >
+    void _masked_combine( T& data, T& invvar, F& flags, const _MaskedLine< U, G >& src, const size_type i,
+            Divides );
+
+    template< class T, class F, class Line >
+    void _masked_combine( T& data, T& invvar, F& flags, const _ExactLine< Line >& src, const size_type i, Plus );
+
+    template< class T, class F, class Line >
+    void _masked_combine( T& data, T& invvar, F& flags, const _ExactLine< Line >& src, const size_type i, Minus );
+
+    template< class T, class F, class Line >
+    void _masked_combine( T& data, T& invvar, F& flags, const _ExactLine< Line >& src, const size_type i,
+            Multiplies );
+
+    template< class T, class F, class Line >
+    void _masked_combine( T& data, T& invvar, F& flags, const _ExactLine< Line >& src, const size_type i,
+            Divides );
+
+    // Masked Kernels
+    // --------------
+    // One row of all three planes, dispatched like the expression kernels (see C3_Assign.hh).
+
+    template< class T, class F, class Line, class Operator >
+    void _masked_kernel( T* data, T* invvar, F* flags, const Line& src, const size_type length, Operator op );
+
+    template< class T, class F, class Line, class Operator >
+    void _scalar_masked_kernel( T* data, T* invvar, F* flags, const Line& src, const size_type length, Operator op );
+
+#ifdef C3_SIMD_X86
+
+    template< class T, class F, class Line, class Operator >
+    C3_TARGET_AVX2 void _vector_masked_kernel( detail::Avx2, T* data, T* invvar, F* flags, const Line& src,
+            const size_type length, Operator op );
+
+    template< class T, class F, class Line, class Operator >
+    C3_TARGET_AVX512 void _vector_masked_kernel( detail::Avx512, T* data, T* invvar, F* flags, const Line& src,
+            const size_type length, Operator op );
+
+#endif
+
+}
+
+// Constructor.
+
+template< class T, class F >
+inline C3::MaskedFrame< T, F >::MaskedFrame( const C3::size_type ncolumns, const C3::size_type nrows,
+        const C3::RowPitch row_pitch ) :
+    _data( ncolumns, nrows, row_pitch ), _invvar( ncolumns, nrows, row_pitch ), _flags( ncolumns, nrows, row_pitch )
+{}
+
+// Initializing constructor.
+
+template< class T, class F >
+inline C3::MaskedFrame< T, F >::MaskedFrame( const C3::size_type ncolumns, const C3::size_type nrows, const T pixel,
+        const T invvar, const F flags, const C3::RowPitch row_pitch ) :
+    _data( ncolumns, nrows, pixel, row_pitch ), _invvar( ncolumns, nrows, invvar, row_pitch ),
+    _flags( ncolumns, nrows, flags, row_pitch )
+{}
+
+// Addition assignment, masked frame operand.
+
+template< class T, class F, class U, class G >
+inline C3::MaskedFrame< T, F >& C3::operator += ( C3::MaskedFrame< T, F >& dest, const C3::MaskedFrame< U, G >& src )
+{
+    return C3::_masked_apply( dest, src, C3::Plus() );
+}
+
+// Subtraction assignment, masked frame operand.
+
+template< class T, class F, class U, class G >
+inline C3::MaskedFrame< T, F >& C3::operator -= ( C3::MaskedFrame< T, F >& dest, const C3::MaskedFrame< U, G >& src )
+{
+    return C3::_masked_apply( dest, src, C3::Minus() );
+}
+
+// Multiplication assignment, masked frame operand.
+
+template< class T, class F, class U, class G >
+inline C3::MaskedFrame< T, F >& C3::operator *= ( C3::MaskedFrame< T, F >& dest, const C3::MaskedFrame< U, G >& src )
+{
+    return C3::_masked_apply( dest, src, C3::Multiplies() );
+}
+
+// Division assignment, masked frame operand.
+
+template< class T, class F, class U, class G >
+inline C3::MaskedFrame< T, F >& C3::operator /= ( C3::MaskedFrame< T, F >& dest, const C3::MaskedFrame< U, G >& src )
+{
+    return C3::_masked_apply( dest, src, C3::Divides() );
+}
+
+// Addition assignment, exact operand.
+
+template< class T, class F, class Source >
+inline C3::MaskedFrame< T, F >& C3::operator += ( C3::MaskedFrame< T, F >& dest, const Source& src )
+{
+    return C3::_masked_apply_exact( dest, src, C3::Plus() );
+}
+
+// Subtraction assignment, exact operand.
+
+template< class T, class F, class Source >
+inline C3::MaskedFrame< T, F >& C3::operator -= ( C3::MaskedFrame< T, F >& dest, const Source& src )
+{
+    return C3::_masked_apply_exact( dest, src, C3::Minus() );
+}
+
+// Multiplication assignment, exact operand.
+
+template< class T, class F, class Source >
+inline C3::MaskedFrame< T, F >& C3::operator *= ( C3::MaskedFrame< T, F >& dest, const Source& src )
+{
+    return C3::_masked_apply_exact( dest, src, C3::Multiplies() );
+}
+
+// Division assignment, exact operand.
+
+template< class T, class F, class Source >
+inline C3::MaskedFrame< T, F >& C3::operator /= ( C3::MaskedFrame< T, F >& dest, const Source& src )
+{
+    return C3::_masked_apply_exact( dest, src, C3::Divides() );
+}
+
+// Fused pass with a masked frame operand, in row bands over threads.
+
+template< class T, class F, class U, class G, class Operator >
+inline C3::MaskedFrame< T, F >& C3::_masked_apply( C3::MaskedFrame< T, F >& dest, const C3::MaskedFrame< U, G >& src,
+        Operator op )
+{
+    assert( C3::congruent( dest.data(), src.data() ) );
+    const auto ncolumns = dest.ncolumns();
+    C3::detail::_parallel_for( dest.nrows(), dest.nrows() * ncolumns, 1,
+        [ & ]( const C3::size_type first, const C3::size_type last )
+        {
+            for( auto k = first; k < last; ++k )
+            {
+                const auto line = C3::_MaskedLine< U, G >{ src.data().data() + src.data().pitch() * k,
+                    src.invvar().data() + src.invvar().pitch() * k, src.flags().data() + src.flags().pitch() * k };
+                C3::_masked_kernel( &dest.data()( 0, k ), &dest.invvar()( 0, k ), &dest.flags()( 0, k ), line, 
+                        ncolumns, op );
+            }
+        } );
+    return dest;
+}
+
+// Fused pass with an exact operand, in row bands over threads.  The operand
+// is read through the same row cursors as an expression assigned to the
+// data plane.
+
+template< class T, class F, class Source, class Operator >
+inline C3::MaskedFrame< T, F >& C3::_masked_apply_exact( C3::MaskedFrame< T, F >& dest, const Source& src, 
+        Operator op )
+{
+    const auto node = C3::_NodeOf< Source >::node( src );
+    assert( C3::_congruent( dest.data(), node ) );
+    const auto ncolumns = dest.ncolumns();
+    C3::detail::_parallel_for( dest.nrows(), dest.nrows() * ncolumns, 1,
+        [ & ]( const C3::size_type first, const C3::size_type last )
+        {
+            for( auto k = first; k < last; ++k )
+            {
+                using Line = decltype( node.line( C3::_RowLines(), k ) );
+                const auto line = C3::_ExactLine< Line >{ node.line( C3::_RowLines(), k ) };
+                C3::_masked_kernel( &dest.data()( 0, k ), &dest.invvar()( 0, k ), &dest.flags()( 0, k ), line, 
+                        ncolumns, op );
+            }
+        } );
+    return dest;
+}
+
+// Written as arithmetic on a 0 or 1 mask rather than with selects: the
+// division happens whatever the denominator, by one where it is not positive,
+// so that the compiler need not branch around a division that could trap and
+// the loops vectorize.
+
+template< class T >
+inline T C3::_guarded_ratio( const T numerator, const T denominator )
+{
+    const T positive = T( denominator > T( 0 ) );
+    return positive * ( numerator / ( denominator + ( T( 1 ) - positive ) ) );
+}
+
+// Sum or difference: variances add, flags OR.
+
+template< class T, class F, class U, class G >
+inline void C3::_masked_combine( T& data, T& invvar, F& flags, const C3::_MaskedLine< U, G >& src,
+        const C3::size_type i, C3::Plus )
+{
+    const T a = invvar, b = src.invvar[ i ];
+    data   = data + src.data[ i ];
+    invvar = C3::_guarded_ratio( a * b, a + b );
+    flags  = flags | src.flags[ i ];
+}
+
+template< class T, class F, class U, class G >
+inline void C3::_masked_combine( T& data, T& invvar, F& flags, const C3::_MaskedLine< U, G >& src,
+        const C3::size_type i, C3::Minus )
+{
+    const T a = invvar, b = src.invvar[ i ];
+    data   = data - src.data[ i ];
+    invvar = C3::_guarded_ratio( a * b, a + b );
+    flags  = flags | src.flags[ i ];
+}
+
+// Product x y: var = y^2 var(x) + x^2 var(y), so
+// invvar = a b / ( y^2 b + x^2 a ) for inverse variances a and b.
+
+template< class T, class F, class U, class G >
+inline void C3::_masked_combine( T& data, T& invvar, F& flags, const C3::_MaskedLine< U, G >& src,
+        const C3::size_type i, C3::Multiplies )
+{
+    const T x = data, y = src.data[ i ], a = invvar, b = src.invvar[ i ];
+    const T denominator = y * y * b + x * x * a;
+    data   = x * y;
+    invvar = C3::_guarded_ratio( a * b, denominator );
+    flags  = flags | src.flags[ i ];
+}
+
+// Quotient x / y: var = var(x) / y^2 + x^2 var(y) / y^4, so
+// invvar = y^4 a b / ( y^2 b + x^2 a ).
+
+template< class T, class F, class U, class G >
+inline void C3::_masked_combine( T& data, T& invvar, F& flags, const C3::_MaskedLine< U, G >& src,
+        const C3::size_type i, C3::Divides )
+{
+    const T x = data, y = src.data[ i ], a = invvar, b = src.invvar[ i ];
+    const T denominator = y * y * b + x * x * a;
+    data   = x / y;
+    invvar = C3::_guarded_ratio( y * y * y * y * a * b, denominator );
+    flags  = flags | src.flags[ i ];
+}
+
+// Exact sum or difference: variance unchanged.
+
+template< class T, class F, class Line >
+inline void C3::_masked_combine( T& data, T&, F&, const C3::_ExactLine< Line >& src, const C3::size_type i,
+        C3::Plus )
+{
+    data = data + src.data[ i ];
+}
+
+template< class T, class F, class Line >
+inline void C3::_masked_combine( T& data, T&, F&, const C3::_ExactLine< Line >& src, const C3::size_type i,
+        C3::Minus )
+{
+    data = data - src.data[ i ];
+}
+
+// Exact scaling: inverse variance scales by the inverse square.
+
+template< class T, class F, class Line >
+inline void C3::_masked_combine( T& data, T& invvar, F&, const C3::_ExactLine< Line >& src, const C3::size_type i,
+        C3::Multiplies )
+{
+    const T y = src.data[ i ];
+    data   = data * y;
+    invvar = invvar / ( y * y );
+}
+
+template< class T, class F, class Line >
+inline void C3::_masked_combine( T& data, T& invvar, F&, const C3::_ExactLine< Line >& src, const C3::size_type i,
+        C3::Divides )
+{
+    const T y = src.data[ i ];
+    data   = data / y;
+    invvar = invvar * ( y * y );
+}
+
+// Masked row, dispatched.
+
+template< class T, class F, class Line, class Operator >
+inline void C3::_masked_kernel( T* data, T* invvar, F* flags, const Line& src, const C3::size_type length,
+        Operator op )
+{
+#ifdef C3_SIMD_X86
+    switch( C3::isa() )
+    {
+        case C3::Isa::AVX512 : C3::_vector_masked_kernel( C3::detail::Avx512(), data, invvar, flags, src, length, op );
+                               return;
+        case C3::Isa::AVX2   : C3::_vector_masked_kernel( C3::detail::Avx2()  , data, invvar, flags, src, length, op );
+                               return;
+        default              : break;
+    }
+#endif
+    C3::_scalar_masked_kernel( data, invvar, flags, src, length, op );
+}
+
+template< class T, class F, class Line, class Operator >
+inline void C3::_scalar_masked_kernel( T* data, T* invvar, F* flags, const Line& src, const C3::size_type length,
+        Operator op )
+{
+    for( C3::size_type i = 0; i < length; ++i ) C3::_masked_combine( data[ i ], invvar[ i ], flags[ i ], src, i, op );
+}
+
+#ifdef C3_SIMD_X86
+
+// As with expression kernels, the loop bodies are the scalar one compiled for each instruction set.  The guarded
+// inverse variance ratios keep them free of branches.
+
+template< class T, class F, class Line, class Operator >
+C3_TARGET_AVX2 inline void C3::_vector_masked_kernel( C3::detail::Avx2, T* data, T* invvar, F* flags, const Line& src,
+        const C3::size_type length, Operator op )
+{
+    for( C3::size_type i = 0; i < length; ++i ) C3::_masked_combine( data[ i ], invvar[ i ], flags[ i ], src, i, op );
+}
+
+template< class T, class F, class Line, class Operator >
+C3_TARGET_AVX512 inline void C3::_vector_masked_kernel( C3::detail::Avx512, T* data, T* invvar, F* flags,
+        const Line& src, const C3::size_type length, Operator op )
+{
+    for( C3::size_type i = 0; i < length; ++i ) C3::_masked_combine( data[ i ], invvar[ i ], flags[ i ], src, i, op );
+}
+
+#endif
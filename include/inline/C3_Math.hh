@@ -0,0 +1,464 @@
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include "../C3_Operator.hh"
+
+// Internal declarations
+
+namespace C3
+{
+
+    template< class T >
+    struct _Real
+    {
+        using type = typename std::conditional< std::is_floating_point< T >::value, T, double >::type;
+    };
+
+    // Math Routines
+    // -------------
+    // Pixel functions written without branches or library calls, so that expression loops calling them vectorize
+    // (see C3_Assign.hh).  Special cases are blended in with _select() at the end, since a conditional on an input
+    // lets the compiler move the work it guards under a branch.
+
+    // Bit layout of floating-point value types.
+
+    template< class T >
+    struct _FloatBits;
+
+    template< class T > typename _FloatBits< T >::type _to_bits( const T src );
+    template< class T > T _from_bits( const typename _FloatBits< T >::type src );
+
+    // Branch-free condition ? lhs : rhs.
+
+    template< class T > T _select( const bool condition, const T lhs, const T rhs );
+    template< class T > T _select( const bool condition, const T lhs, const T rhs, std::true_type );
+    template< class T > T _select( const bool condition, const T lhs, const T rhs, std::false_type );
+
+    // Nearest integer, for |src| < 2^(mantissa bits - 1), and 2^n for integral n in the range of exponents.
+
+    template< class T > T _round( const T src );
+    template< class T > T _round_shift();
+    template< class T > T _pow2( const T n );
+
+    // Polynomial in Horner form, lowest order coefficient first.
+
+    template< class T > T _horner( const T, const T c );
+
+    template< class T, class... Coefficients >
+    T _horner( const T x, const T c, const Coefficients... coefficients );
+
+    // Constants for each floating-point value type.
+
+    template< class T > struct _ExpConstants;
+    template< class T > struct _LogConstants;
+    template< class T > struct _SqrtConstants;
+
+    // Routines.
+
+    template< class T > T _sqrt( const T src );
+    template< class T > T _log( const T src );
+    template< class T > T _exp( const T src );
+
+    template< class T > T _abs( const T src );
+    float  _abs( const float  src );
+    double _abs( const double src );
+
+}
+
+// Square root.
+
+template< class T >
+inline typename C3::_Real< T >::type C3::Sqrt::operator () ( const T src ) const
+{
+    return C3::_sqrt( static_cast< typename C3::_Real< T >::type >( src ) );
+}
+
+// Absolute value.
+
+template< class T >
+inline T C3::Abs::operator () ( const T src ) const
+{
+    return C3::_abs( src );
+}
+
+// Reciprocal.
+
+template< class T >
+inline typename C3::_Real< T >::type C3::Reciprocal::operator () ( const T src ) const
+{
+    using R = typename C3::_Real< T >::type;
+    return R( 1 ) / static_cast< R >( src );
+}
+
+// Natural logarithm.
+
+template< class T >
+inline typename C3::_Real< T >::type C3::Log::operator () ( const T src ) const
+{
+    return C3::_log( static_cast< typename C3::_Real< T >::type >( src ) );
+}
+
+// Exponential.
+
+template< class T >
+inline typename C3::_Real< T >::type C3::Exp::operator () ( const T src ) const
+{
+    return C3::_exp( static_cast< typename C3::_Real< T >::type >( src ) );
+}
+
+// Power.
+
+template< class T, class U >
+inline auto C3::Power::operator () ( const T base, const U exponent ) const
+    -> typename C3::_Real< decltype( base + exponent ) >::type
+{
+    using R = typename C3::_Real< decltype( base + exponent ) >::type;
+    return C3::_exp( static_cast< R >( exponent ) * C3::_log( static_cast< R >( base ) ) );
+}
+
+// Lesser of two pixels.
+
+template< class T, class U >
+inline auto C3::Minimum::operator () ( const T lhs, const U rhs ) const -> decltype( lhs + rhs )
+{
+    using R = decltype( lhs + rhs );
+    return C3::_select( rhs < lhs, static_cast< R >( rhs ), static_cast< R >( lhs ) );
+}
+
+// Greater of two pixels.
+
+template< class T, class U >
+inline auto C3::Maximum::operator () ( const T lhs, const U rhs ) const -> decltype( lhs + rhs )
+{
+    using R = decltype( lhs + rhs );
+    return C3::_select( lhs < rhs, static_cast< R >( rhs ), static_cast< R >( lhs ) );
+}
+
+// Square root.
+
+template< class T >
+inline typename C3::_UnaryExpression< C3::Sqrt, T >::type C3::sqrt( const T& src )
+{
+    return C3::_UnaryExpression< C3::Sqrt, T >::expression( src );
+}
+
+// Absolute value.
+
+template< class T >
+inline typename C3::_UnaryExpression< C3::Abs, T >::type C3::abs( const T& src )
+{
+    return C3::_UnaryExpression< C3::Abs, T >::expression( src );
+}
+
+// Reciprocal.
+
+template< class T >
+inline typename C3::_UnaryExpression< C3::Reciprocal, T >::type C3::reciprocal( const T& src )
+{
+    return C3::_UnaryExpression< C3::Reciprocal, T >::expression( src );
+}
+
+// Natural logarithm.
+
+template< class T >
+inline typename C3::_UnaryExpression< C3::Log, T >::type C3::log( const T& src )
+{
+    return C3::_UnaryExpression< C3::Log, T >::expression( src );
+}
+
+// Exponential.
+
+template< class T >
+inline typename C3::_UnaryExpression< C3::Exp, T >::type C3::exp( const T& src )
+{
+    return C3::_UnaryExpression< C3::Exp, T >::expression( src );
+}
+
+// Power.
+
+template< class T, class U >
+inline typename C3::_BinaryExpression< C3::Power, T, U >::type C3::pow( const T& base, const U& exponent )
+{
+    return C3::_BinaryExpression< C3::Power, T, U >::expression( base, exponent );
+}
+
+// Lesser of two operands.
+
+template< class T, class U >
+inline typename C3::_BinaryExpression< C3::Minimum, T, U >::type C3::min( const T& lsrc, const U& rsrc )
+{
+    return C3::_BinaryExpression< C3::Minimum, T, U >::expression( lsrc, rsrc );
+}
+
+// Greater of two operands.
+
+template< class T, class U >
+inline typename C3::_BinaryExpression< C3::Maximum, T, U >::type C3::max( const T& lsrc, const U& rsrc )
+{
+    return C3::_BinaryExpression< C3::Maximum, T, U >::expression( lsrc, rsrc );
+}
+
+// Operand clipped to a range.
+
+template< class T, class U, class V >
+inline auto C3::clamp( const T& src, const U& low, const V& high )
+    -> decltype( C3::min( C3::max( src, low ), high ) )
+{
+    return C3::min( C3::max( src, low ), high );
+}
+
+// Math Routine Definitions
+// ------------------------
+
+template<>
+struct C3::_FloatBits< float >
+{
+    using type = std::uint32_t;
+    static const int mantissa = 23;
+    static const int bias     = 127;
+};
+
+template<>
+struct C3::_FloatBits< double >
+{
+    using type = std::uint64_t;
+    static const int mantissa = 52;
+    static const int bias     = 1023;
+};
+
+// Copies through memcpy compile to register moves, or to nothing.
+
+template< class T >
+inline typename C3::_FloatBits< T >::type C3::_to_bits( const T src )
+{
+    typename C3::_FloatBits< T >::type bits;
+    std::memcpy( &bits, &src, sizeof( bits ) );
+    return bits;
+}
+
+template< class T >
+inline T C3::_from_bits( const typename C3::_FloatBits< T >::type src )
+{
+    T value;
+    std::memcpy( &value, &src, sizeof( value ) );
+    return value;
+}
+
+// Selection through an all-ones or all-zeros mask.
+
+template< class T >
+inline T C3::_select( const bool condition, const T lhs, const T rhs )
+{
+    return C3::_select( condition, lhs, rhs, std::is_floating_point< T >() );
+}
+
+template< class T >
+inline T C3::_select( const bool condition, const T lhs, const T rhs, std::true_type )
+{
+    using B = typename C3::_FloatBits< T >::type;
+    const B mask = B( 0 ) - B( condition );
+    return C3::_from_bits< T >( ( C3::_to_bits( lhs ) & mask ) | ( C3::_to_bits( rhs ) & ~mask ) );
+}
+
+template< class T >
+inline T C3::_select( const bool condition, const T lhs, const T rhs, std::false_type )
+{
+    using B = typename std::make_unsigned< T >::type;
+    const B mask = B( 0 ) - B( condition );
+    return static_cast< T >( ( B( lhs ) & mask ) | ( B( rhs ) & B( ~mask ) ) );
+}
+
+// Adding and subtracting 1.5 * 2^(mantissa bits) rounds to nearest integer.
+
+template< class T >
+inline T C3::_round_shift()
+{
+    return T( 1.5 ) * T( typename C3::_FloatBits< T >::type( 1 ) << C3::_FloatBits< T >::mantissa );
+}
+
+template< class T >
+inline T C3::_round( const T src )
+{
+    return ( src + C3::_round_shift< T >() ) - C3::_round_shift< T >();
+}
+
+// With the shift added, the biased exponent n + bias sits in the low bits of
+// the mantissa, and moves up into the exponent field.
+
+template< class T >
+inline T C3::_pow2( const T n )
+{
+    const auto bits = C3::_to_bits( n + ( C3::_round_shift< T >() + T( C3::_FloatBits< T >::bias ) ) );
+    return C3::_from_bits< T >( bits << C3::_FloatBits< T >::mantissa );
+}
+
+template< class T >
+inline T C3::_horner( const T, const T c )
+{
+    return c;
+}
+
+template< class T, class... Coefficients >
+inline T C3::_horner( const T x, const T c, const Coefficients... coefficients )
+{
+    return c + x * C3::_horner( x, T( coefficients )... );
+}
+
+// Cody-Waite split of log(2), Taylor coefficients of (exp(r) - 1 - r) / r^2
+// to below the rounding error for |r| < log(2) / 2, and the clip on inputs
+// that keeps 2^n in range in two factors.
+
+template<>
+struct C3::_ExpConstants< float >
+{
+    static float limit()  { return 120.0f; }
+    static float ln2_hi() { return 0.693359375f; }
+    static float ln2_lo() { return -2.12194440e-4f; }
+    static float poly( const float r )
+        { return C3::_horner( r, 1.0f / 2, 1.0f / 6, 1.0f / 24, 1.0f / 120, 1.0f / 720, 1.0f / 5040 ); }
+};
+
+template<>
+struct C3::_ExpConstants< double >
+{
+    static double limit()  { return 1000.0; }
+    static double ln2_hi() { return 6.93147180369123816490e-01; }
+    static double ln2_lo() { return 1.90821492927058770002e-10; }
+    static double poly( const double r )
+    {
+        return C3::_horner( r, 1.0 / 2, 1.0 / 6, 1.0 / 24, 1.0 / 120, 1.0 / 720, 1.0 / 5040, 1.0 / 40320,
+                1.0 / 362880, 1.0 / 3628800, 1.0 / 39916800, 1.0 / 479001600, 1.0 / 6227020800 );
+    }
+};
+
+// Series of log(m) = 2 atanh(s) in z = s^2, for s = (m - 1) / (m + 1) with m
+// in [sqrt(1/2), sqrt(2)), and the scale that makes subnormal inputs normal.
+
+template<>
+struct C3::_LogConstants< float >
+{
+    static float scale()          { return 33554432.0f; }
+    static float scale_exponent() { return 25.0f; }
+    static float poly( const float z )
+        { return C3::_horner( z, 2.0f / 3, 2.0f / 5, 2.0f / 7, 2.0f / 9, 2.0f / 11 ); }
+};
+
+template<>
+struct C3::_LogConstants< double >
+{
+    static double scale()          { return 18014398509481984.0; }
+    static double scale_exponent() { return 54.0; }
+    static double poly( const double z )
+    {
+        return C3::_horner( z, 2.0 / 3, 2.0 / 5, 2.0 / 7, 2.0 / 9, 2.0 / 11, 2.0 / 13, 2.0 / 15, 2.0 / 17, 2.0 / 19,
+                2.0 / 21, 2.0 / 23 );
+    }
+};
+
+// Initial reciprocal square root estimate, Newton iterations to reach half
+// the mantissa, and the scale that makes subnormal inputs normal, with its
+// square root.
+
+template<>
+struct C3::_SqrtConstants< float >
+{
+    static std::uint32_t magic() { return 0x5f375a86u; }
+    static const int iterations = 2;
+    static float scale()   { return 16777216.0f; }
+    static float unscale() { return 0.000244140625f; }
+};
+
+template<>
+struct C3::_SqrtConstants< double >
+{
+    static std::uint64_t magic() { return 0x5fe6eb50c7b537a9ull; }
+    static const int iterations = 3;
+    static double scale()   { return 18014398509481984.0; }
+    static double unscale() { return 7.450580596923828125e-09; }
+};
+
+// Square root from a reciprocal square root estimate refined by Newton's
+// method, with a final correction from the residual.  Where the compiler
+// fuses the correction into multiply-adds the result is nearly always
+// correctly rounded, and otherwise within 1 ulp.
+
+template< class T >
+inline T C3::_sqrt( const T src )
+{
+    using C = C3::_SqrtConstants< T >;
+    const bool tiny = src < std::numeric_limits< T >::min();
+    const T    x    = src * C3::_select( tiny, C::scale(), T( 1 ) );
+    const T    half = T( 0.5 ) * x;
+    T r = C3::_from_bits< T >( C::magic() - ( C3::_to_bits( x ) >> 1 ) );
+    for( int i = 0; i < C::iterations; ++i ) r = r * ( T( 1.5 ) - half * r * r );
+    const T g = x * r;
+    const T s = ( g + T( 0.5 ) * r * ( x - g * g ) ) * C3::_select( tiny, C::unscale(), T( 1 ) );
+    const T inf = std::numeric_limits< T >::infinity();
+    return C3::_select( src < T( 0 ), std::numeric_limits< T >::quiet_NaN(),
+           C3::_select( src == inf || src == T( 0 ), src, s ) );
+}
+
+// Logarithm from exponent and mantissa, log(x) = k log(2) + log(m).
+
+template< class T >
+inline T C3::_log( const T src )
+{
+    using B = typename C3::_FloatBits< T >::type;
+    using C = C3::_LogConstants< T >;
+    const int  mantissa = C3::_FloatBits< T >::mantissa;
+    const bool tiny     = src < std::numeric_limits< T >::min();
+    const B    bits     = C3::_to_bits( src * C3::_select( tiny, C::scale(), T( 1 ) ) );
+    const T    exponent = C3::_from_bits< T >( C3::_to_bits( C3::_round_shift< T >() ) | ( bits >> mantissa ) )
+        - C3::_round_shift< T >() - T( C3::_FloatBits< T >::bias ) - C3::_select( tiny, C::scale_exponent(), T( 0 ) );
+    const T    fraction = C3::_from_bits< T >( ( bits & ( ( B( 1 ) << mantissa ) - 1 ) ) | C3::_to_bits( T( 1 ) ) );
+    const bool high     = fraction > T( 1.41421356237309504880 );
+    const T    m = fraction * C3::_select( high, T( 0.5 ), T( 1 ) );
+    const T    k = exponent + C3::_select( high, T( 1 ), T( 0 ) );
+    const T    s = ( m - T( 1 ) ) / ( m + T( 1 ) );
+    const T    z = s * s;
+    const T    log_m = T( 2 ) * s + s * z * C::poly( z );
+    const T    log_x = ( k * C3::_ExpConstants< T >::ln2_lo() + log_m ) + k * C3::_ExpConstants< T >::ln2_hi();
+    const T    inf   = std::numeric_limits< T >::infinity();
+    return C3::_select( src != src || src == inf, src,
+           C3::_select( src < T( 0 ), std::numeric_limits< T >::quiet_NaN(),
+           C3::_select( src == T( 0 ), -inf, log_x ) ) );
+}
+
+// Exponential from exp(x) = 2^n exp(r), x = n log(2) + r.  Overflow and
+// underflow come out of the scaling by 2^n, done in two factors so that each
+// stays a normal number.
+
+template< class T >
+inline T C3::_exp( const T src )
+{
+    using C = C3::_ExpConstants< T >;
+    const T limit = C::limit();
+    const T x = C3::_select( src > limit, limit, C3::_select( src < -limit, -limit, src ) );
+    const T n = C3::_round( x * T( 1.44269504088896340736 ) );
+    const T r = ( x - n * C::ln2_hi() ) - n * C::ln2_lo();
+    const T p = r * r * C::poly( r ) + r + T( 1 );
+    const T h = C3::_round( n * T( 0.5 ) );
+    return p * C3::_pow2( h ) * C3::_pow2( n - h );
+}
+
+// Absolute value: floating-point ones clear the sign bit.
+
+template< class T >
+inline T C3::_abs( const T src )
+{
+    return C3::_select( src < T( 0 ), static_cast< T >( -src ), src );
+}
+
+inline float C3::_abs( const float src )
+{
+    return std::fabs( src );
+}
+
+inline double C3::_abs( const double src )
+{
+    return std::fabs( src );
+}
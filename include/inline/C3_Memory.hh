@@ -0,0 +1,378 @@
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <sstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "../C3_Exception.hh"
+
+namespace C3
+{
+
+    namespace detail
+    {
+
+        // Current memory resource selection.
+
+        MemoryResource*& _memory_resource();
+
+    }
+
+}
+
+// Storage from posix_memalign().  Zero bytes still gets a distinct pointer.
+
+inline void* C3::AlignedResource::allocate( const C3::size_type bytes )
+{
+    void* data = nullptr;
+    if( posix_memalign( &data, C3::alignment, bytes > 0 ? bytes : C3::alignment ) != 0 ) throw std::bad_alloc();
+    return data;
+}
+
+// Return storage to the system.
+
+inline void C3::AlignedResource::deallocate( void* data, const C3::size_type )
+{
+    free( data );
+}
+
+// Constructor.
+
+inline C3::BufferPool::BufferPool( C3::MemoryResource* upstream ) :
+    _upstream( upstream ? upstream : &_aligned )
+{}
+
+// Destructor.
+
+inline C3::BufferPool::~BufferPool()
+{
+    release();
+}
+
+// Storage for a number of bytes: a cached buffer of that size if there is
+// one, otherwise a new one, counted once the upstream resource has handed it
+// out.
+
+inline void* C3::BufferPool::allocate( const C3::size_type bytes )
+{
+    {
+        std::lock_guard< std::mutex > lock( _mutex );
+        auto& buffers = _cache[ bytes ];
+        if( ! buffers.empty() )
+        {
+            void* data = buffers.back();
+            buffers.pop_back();
+            ++ _statistics.hits;
+            _statistics.bytes_in_use += bytes;
+            _statistics.bytes_cached -= bytes;
+            return data;
+        }
+    }
+    void* data = _upstream->allocate( bytes );
+    std::lock_guard< std::mutex > lock( _mutex );
+    ++ _statistics.misses;
+    _statistics.bytes_in_use += bytes;
+    return data;
+}
+
+// Keep storage for reuse.
+
+inline void C3::BufferPool::deallocate( void* data, const C3::size_type bytes )
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+    _cache[ bytes ].push_back( data );
+    _statistics.bytes_in_use -= bytes;
+    _statistics.bytes_cached += bytes;
+}
+
+// Return cached buffers to the system.
+
+inline void C3::BufferPool::release()
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+    for( auto& entry : _cache )
+    {
+        for( auto data : entry.second ) _upstream->deallocate( data, entry.first );
+    }
+    _cache.clear();
+    _statistics.bytes_cached = 0;
+}
+
+// Current statistics.
+
+inline C3::BufferPool::Statistics C3::BufferPool::statistics() const
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+    return _statistics;
+}
+
+// Reset hit and miss counts.
+
+inline void C3::BufferPool::reset_statistics()
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+    _statistics.hits   = 0;
+    _statistics.misses = 0;
+}
+
+// Constructor.
+
+inline C3::HugePageResource::HugePageResource( const C3::HugePageResource::Mode mode ) :
+    _mode( mode )
+{}
+
+// Storage for a number of bytes.  Reserved huge pages first if asked for,
+// then an aligned ordinary mapping with advice to use transparent huge pages.
+// Advice the kernel turns down leaves ordinary pages, which still work.
+
+inline void* C3::HugePageResource::allocate( const C3::size_type bytes )
+{
+
+    if( bytes < C3::huge_page_size ) return _small.allocate( bytes );
+
+    const auto extent = _extent( bytes );
+
+#ifdef MAP_HUGETLB
+    if( _mode == RESERVED )
+    {
+        void* data = mmap( nullptr, extent, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0 );
+        if( data != MAP_FAILED )
+        {
+            std::lock_guard< std::mutex > lock( _mutex );
+            ++ _statistics.reserved;
+            return data;
+        }
+    }
+#endif
+
+    void* data = _map_aligned( extent );
+    if( ! data ) throw std::bad_alloc();
+
+#ifdef MADV_HUGEPAGE
+    const bool advised = madvise( data, extent, MADV_HUGEPAGE ) == 0;
+#else
+    const bool advised = false;
+#endif
+
+    std::lock_guard< std::mutex > lock( _mutex );
+    ++ ( advised ? _statistics.transparent : _statistics.fallbacks );
+    return data;
+
+}
+
+// Return storage.  Large allocations are mappings of whole huge pages
+// whichever way they were made, small ones go back where they came from.
+
+inline void C3::HugePageResource::deallocate( void* data, const C3::size_type bytes )
+{
+    if( bytes < C3::huge_page_size ) return _small.deallocate( data, bytes );
+    munmap( data, _extent( bytes ) );
+}
+
+// Current statistics.
+
+inline C3::HugePageResource::Statistics C3::HugePageResource::statistics() const
+{
+    std::lock_guard< std::mutex > lock( _mutex );
+    return _statistics;
+}
+
+// Round up to whole huge pages.
+
+inline C3::size_type C3::HugePageResource::_extent( const C3::size_type bytes )
+{
+    return ( bytes + C3::huge_page_size - 1 ) & ~( C3::huge_page_size - 1 );
+}
+
+// Map one huge page more than needed, then unmap the ragged ends, so the
+// rest starts on a huge page boundary where the kernel can put huge pages.
+
+inline void* C3::HugePageResource::_map_aligned( const C3::size_type extent )
+{
+
+    void* region = mmap( nullptr, extent + C3::huge_page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, 
+            -1, 0 );
+    if( region == MAP_FAILED ) return nullptr;
+
+    const auto start = reinterpret_cast< std::uintptr_t >( region );
+    const auto first = ( start + C3::huge_page_size - 1 ) & ~std::uintptr_t( C3::huge_page_size - 1 );
+    const auto head  = first - start;
+    const auto tail  = C3::huge_page_size - head;
+
+    if( head > 0 ) munmap( region, head );
+    if( tail > 0 ) munmap( reinterpret_cast< char* >( first ) + extent, tail );
+    return reinterpret_cast< void* >( first );
+
+}
+
+// Constructor.
+
+inline C3::MappedResource::MappedResource( const std::string& directory, const C3::MappedResource::Advice advice ) :
+    _directory( directory ), _backing( SCRATCH ), _advice( advice )
+{}
+
+// Constructor with a backing.
+
+inline C3::MappedResource::MappedResource( const std::string& path, const C3::MappedResource::Backing backing,
+        const C3::MappedResource::Advice advice ) :
+    _directory( path ), _backing( backing ), _advice( advice )
+{
+    if( backing == NAMED && path.empty() ) throw C3::Exception::create( "Named mapped resource needs a file" );
+}
+
+// Map storage.  Zero bytes still maps a page, so each block gets a distinct
+// pointer.  File descriptors are not needed once the file is mapped.  In a
+// named file the next allocation starts at the page after this one.
+
+inline void* C3::MappedResource::allocate( const C3::size_type bytes )
+{
+    const auto length = bytes > 0 ? bytes : 1;
+    void* data = nullptr;
+    if( _directory.empty() )
+    {
+        data = mmap( nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0 );
+    }
+    else if( _backing == NAMED )
+    {
+        const auto page = static_cast< C3::size_type >( sysconf( _SC_PAGESIZE ) );
+        std::lock_guard< std::mutex > lock( _mutex );
+        const auto fd = _named( length, _end );
+        data = mmap( nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, static_cast< off_t >( _end ) );
+        close( fd );
+        if( data != MAP_FAILED ) _end += ( length + page - 1 ) / page * page;
+    }
+    else
+    {
+        const auto fd = _scratch( length );
+        data = mmap( nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+        close( fd );
+    }
+    if( data == MAP_FAILED ) throw C3::Exception::create( "Can't map", bytes, "bytes:", strerror( errno ) );
+
+    static const int advice[] = { MADV_NORMAL, MADV_SEQUENTIAL, MADV_RANDOM };
+    madvise( data, length, advice[ _advice ] );
+    return data;
+}
+
+// Unmap storage.  A scratch file goes with its mapping, a named file stays.
+
+inline void C3::MappedResource::deallocate( void* data, const C3::size_type bytes )
+{
+    munmap( data, bytes > 0 ? bytes : 1 );
+}
+
+// Open an unlinked scratch file of a number of bytes.
+
+inline int C3::MappedResource::_scratch( const C3::size_type bytes ) const
+{
+    std::string path = _directory + "/C3-XXXXXX";
+    const auto fd = mkstemp( &path[ 0 ] );
+    if( fd < 0 ) throw C3::Exception::create( "Can't create scratch file in", _directory + ":", strerror( errno ) );
+    unlink( path.c_str() );
+    if( ftruncate( fd, static_cast< off_t >( bytes ) ) != 0 )
+    {
+        const auto error = errno;
+        close( fd );
+        throw C3::Exception::create( "Can't extend scratch file to", bytes, "bytes:", strerror( error ) );
+    }
+    return fd;
+}
+
+// Open the named file, growing it to hold the allocation but never
+// shrinking it.
+
+inline int C3::MappedResource::_named( const C3::size_type bytes, const C3::size_type offset ) const
+{
+    const auto fd = open( _directory.c_str(), O_RDWR | O_CREAT, 0644 );
+    if( fd < 0 ) throw C3::Exception::create( "Can't open", _directory + ":", strerror( errno ) );
+    struct stat status;
+    const auto size = offset + bytes;
+    if( fstat( fd, &status ) != 0 || ( static_cast< C3::size_type >( status.st_size ) < size
+                && ftruncate( fd, static_cast< off_t >( size ) ) != 0 ) )
+    {
+        const auto error = errno;
+        close( fd );
+        throw C3::Exception::create( "Can't extend", _directory, "to", size, "bytes:", strerror( error ) );
+    }
+    return fd;
+}
+
+// Context buffer pool.
+
+inline std::unique_ptr< C3::BufferPool > C3::context_pool( const std::string& setting,
+        std::unique_ptr< C3::HugePageResource >& huge_pages )
+{
+    if( setting == "transparent" )
+    {
+        huge_pages.reset( new C3::HugePageResource( C3::HugePageResource::TRANSPARENT ) );
+    }
+    else if( setting == "reserved" )
+    {
+        huge_pages.reset( new C3::HugePageResource( C3::HugePageResource::RESERVED ) );
+    }
+    else if( setting != "off" )
+    {
+        throw C3::Exception::create( "Bad huge_pages in config:", setting, "... Use off, transparent, or reserved." );
+    }
+    return std::unique_ptr< C3::BufferPool >( new C3::BufferPool( huge_pages.get() ) );
+}
+
+// NUMA node of each page.  The system call is used directly so applications
+// need not link libnuma.
+
+inline std::vector< int > C3::page_nodes( const void* data, const C3::size_type bytes )
+{
+    const auto page  = static_cast< std::uintptr_t >( sysconf( _SC_PAGESIZE ) );
+    const auto begin = reinterpret_cast< std::uintptr_t >( data ) & ~( page - 1 );
+    const auto end   = reinterpret_cast< std::uintptr_t >( data ) + bytes;
+
+    std::vector< void* > pages;
+    for( auto address = begin; address < end; address += page ) pages.push_back( reinterpret_cast< void* >( address ) );
+    std::vector< int > nodes( pages.size() );
+    if( pages.empty() ) return nodes;
+
+#ifdef SYS_move_pages
+    if( syscall( SYS_move_pages, 0, pages.size(), pages.data(), nullptr, nodes.data(), 0 ) == 0 ) return nodes;
+#endif
+    return std::vector< int >();
+}
+
+// System allocation resource.
+
+inline C3::MemoryResource& C3::default_resource()
+{
+    static C3::AlignedResource resource;
+    return resource;
+}
+
+// Memory resource new Blocks allocate from.
+
+inline C3::MemoryResource& C3::memory_resource()
+{
+    return *C3::detail::_memory_resource();
+}
+
+// Select memory resource.
+
+inline C3::MemoryResource& C3::select_memory_resource( C3::MemoryResource* resource )
+{
+    auto& previous = C3::memory_resource();
+    C3::detail::_memory_resource() = resource ? resource : &C3::default_resource();
+    return previous;
+}
+
+// Current memory resource selection.
+
+inline C3::MemoryResource*& C3::detail::_memory_resource()
+{
+    static C3::MemoryResource* resource = &C3::default_resource();
+    return resource;
+}
@@ -2,79 +2,84 @@
 #include <mpi.h>
 
 template<>
-struct C3::MpiType< char >
+struct C3::MpiType< char > : C3::_MpiDatatype< C3::MpiType< char > >
 {
-    static const MPI_Datatype datatype = MPI_CHAR;
+    static MPI_Datatype handle() { return MPI_CHAR; }
 };
 
 template<>
-struct C3::MpiType< unsigned char >
+struct C3::MpiType< unsigned char > : C3::_MpiDatatype< C3::MpiType< unsigned char > >
 {
-    static const MPI_Datatype datatype = MPI_UNSIGNED_CHAR;
+    static MPI_Datatype handle() { return MPI_UNSIGNED_CHAR; }
 };
 
 template<>
-struct C3::MpiType< signed char >
+struct C3::MpiType< signed char > : C3::_MpiDatatype< C3::MpiType< signed char > >
 {
-    static const MPI_Datatype datatype = MPI_SIGNED_CHAR;
+    static MPI_Datatype handle() { return MPI_SIGNED_CHAR; }
 };
 
 //template<>
-//struct C3::MpiType< bool >
+//struct C3::MpiType< bool > : C3::_MpiDatatype< C3::MpiType< bool > >
 //{
-//    static const MPI_Datatype datatype = MPI_C_BOOL;      /// BOOL?
+//    static MPI_Datatype handle() { return MPI_C_BOOL; }      /// BOOL?
 //};
 
 template<>
-struct C3::MpiType< unsigned short int >
+struct C3::MpiType< unsigned short int > : C3::_MpiDatatype< C3::MpiType< unsigned short int > >
 {
-    static const MPI_Datatype datatype = MPI_UNSIGNED_SHORT;
+    static MPI_Datatype handle() { return MPI_UNSIGNED_SHORT; }
 };
 
 template<>
-struct C3::MpiType< signed short int >
+struct C3::MpiType< signed short int > : C3::_MpiDatatype< C3::MpiType< signed short int > >
 {
-    static const MPI_Datatype datatype = MPI_SHORT;
+    static MPI_Datatype handle() { return MPI_SHORT; }
 };
 
 template<>
-struct C3::MpiType< unsigned int >
+struct C3::MpiType< unsigned int > : C3::_MpiDatatype< C3::MpiType< unsigned int > >
 {
-    static const MPI_Datatype datatype = MPI_UNSIGNED;
+    static MPI_Datatype handle() { return MPI_UNSIGNED; }
 };
 
 template<>
-struct C3::MpiType< signed int >
+struct C3::MpiType< signed int > : C3::_MpiDatatype< C3::MpiType< signed int > >
 {
-    static const MPI_Datatype datatype = MPI_INT;
+    static MPI_Datatype handle() { return MPI_INT; }
 };
 
 template<>
-struct C3::MpiType< unsigned long int >
+struct C3::MpiType< unsigned long int > : C3::_MpiDatatype< C3::MpiType< unsigned long int > >
 {
-    static const MPI_Datatype datatype = MPI_UNSIGNED_LONG;
+    static MPI_Datatype handle() { return MPI_UNSIGNED_LONG; }
 };
 
 template<>
-struct C3::MpiType< signed long int >
+struct C3::MpiType< signed long int > : C3::_MpiDatatype< C3::MpiType< signed long int > >
 {
-    static const MPI_Datatype datatype = MPI_LONG;
+    static MPI_Datatype handle() { return MPI_LONG; }
 };
 
 template<>
-struct C3::MpiType< float >
+struct C3::MpiType< float > : C3::_MpiDatatype< C3::MpiType< float > >
 {
-    static const MPI_Datatype datatype = MPI_FLOAT;
+    static MPI_Datatype handle() { return MPI_FLOAT; }
 };
 
 template<>
-struct C3::MpiType< signed long long int >
+struct C3::MpiType< signed long long int > : C3::_MpiDatatype< C3::MpiType< signed long long int > >
 {
-    static const MPI_Datatype datatype = MPI_LONG_LONG_INT;
+    static MPI_Datatype handle() { return MPI_LONG_LONG_INT; }
 };
 
 template<>
-struct C3::MpiType< double >
+struct C3::MpiType< double > : C3::_MpiDatatype< C3::MpiType< double > >
 {
-    static const MPI_Datatype datatype = MPI_DOUBLE;
+    static MPI_Datatype handle() { return MPI_DOUBLE; }
 };
+
+// Datatype of each specialization.
+
+template< class M >
+const MPI_Datatype C3::_MpiDatatype< M >::datatype = M::handle();
@@ -38,42 +38,42 @@ inline Destination& C3::operator /= ( Destination& dest, const Source& src )
     return C3::assign( dest, src, std::divides< T >() ); 
 }
 
-// // Unary minus.
-// 
-// template< class T > 
-// inline T C3::operator - ( const T& src )
-// {
-//     return C3::assign( src, std::negate< typename C3::ValueType< T >::type >() );
-// }
-// 
-// // Addition.
-// 
-// template< class T, class U > 
-// inline T C3::operator + ( const T& lsrc, const U& rsrc )
-// {
-//     return C3::assign( lsrc, rsrc, std::plus< typename C3::ValueType< T >::type >() );
-// }
-// 
-// // Subtraction.
-// 
-// template< class T, class U > 
-// inline T C3::operator - ( const T& lsrc, const U& rsrc )
-// {
-//     return C3::assign( lsrc, rsrc, std::minus< typename C3::ValueType< T >::type >() );
-// }
-// 
-// // Multiplication.
-// 
-// template< class T, class U > 
-// inline T C3::operator * ( const T& lsrc, const U& rsrc )
-// {
-//     return C3::assign( lsrc, rsrc, std::multiplies< typename C3::ValueType< T >::type >() );
-// }
-// 
-// // Division.
-// 
-// template< class T, class U > 
-// inline T C3::operator / ( const T& lsrc, const U& rsrc )
-// {
-//     return C3::assign( lsrc, rsrc, std::divides< typename C3::ValueType< T >::type >() );
-// }
+// Unary minus.
+
+template< class T >
+inline typename C3::_UnaryExpression< C3::Negate, T >::type C3::operator - ( const T& src )
+{
+    return C3::_UnaryExpression< C3::Negate, T >::expression( src );
+}
+
+// Addition.
+
+template< class T, class U >
+inline typename C3::_BinaryExpression< C3::Plus, T, U >::type C3::operator + ( const T& lsrc, const U& rsrc )
+{
+    return C3::_BinaryExpression< C3::Plus, T, U >::expression( lsrc, rsrc );
+}
+
+// Subtraction.
+
+template< class T, class U >
+inline typename C3::_BinaryExpression< C3::Minus, T, U >::type C3::operator - ( const T& lsrc, const U& rsrc )
+{
+    return C3::_BinaryExpression< C3::Minus, T, U >::expression( lsrc, rsrc );
+}
+
+// Multiplication.
+
+template< class T, class U >
+inline typename C3::_BinaryExpression< C3::Multiplies, T, U >::type C3::operator * ( const T& lsrc, const U& rsrc )
+{
+    return C3::_BinaryExpression< C3::Multiplies, T, U >::expression( lsrc, rsrc );
+}
+
+// Division.
+
+template< class T, class U >
+inline typename C3::_BinaryExpression< C3::Divides, T, U >::type C3::operator / ( const T& lsrc, const U& rsrc )
+{
+    return C3::_BinaryExpression< C3::Divides, T, U >::expression( lsrc, rsrc );
+}
@@ -9,7 +9,9 @@
 #include "../C3_Exception.hh"
 #include "../C3_FitsCreator.hh"
 #include "../C3_FitsLoader.hh"
+#include "../C3_MaskedFrame.hh"
 #include "../C3_MpiTraits.hh"
+#include "../C3_Threads.hh"
 
 // Initialize command line, config, validation, tasks, etc.
 
@@ -31,6 +33,7 @@ inline void C3::Parallel< InstrumentTraits >::init( int& argc, char**& argv )
     _init_exposure();
     _init_logger();
     _init_openmp();
+    _init_pool();
     _init_task_queue( argc, argv );
 
     logger().info( "Parallel context initialization complete." );
@@ -43,6 +46,15 @@ template< class InstrumentTraits >
 inline int C3::Parallel< InstrumentTraits >::finalize()
 {
     logger().info( "Parallel context finalizing." );
+    auto statistics = pool().statistics();
+    logger().info( "Buffer pool hits / misses :", statistics.hits, "/", statistics.misses );
+    if( _huge_pages )
+    {
+        auto pages = _huge_pages->statistics();
+        logger().info( "Huge page reserved / transparent / fallback :", pages.reserved, "/", pages.transparent, "/", 
+                pages.fallbacks );
+    }
+    C3::select_memory_resource( nullptr );
     int status = MPI_Finalize();
     C3::assert_mpi_status( status );
     logger().info( "Goodbye!" );
@@ -157,6 +169,22 @@ void C3::Parallel< InstrumentTraits >::load( C3::Frame< T >& input, const std::s
 
 }
 
+// Load masked frame planes.
+
+template< class InstrumentTraits >
+template< class T, class F >
+inline void C3::Parallel< InstrumentTraits >::load( C3::MaskedFrame< T, F >& input, const std::string& path )
+{
+
+    logger().debug( "Loading masked frame", frame(), "from", path, "[START]" );
+
+    C3::FitsLoader loader( path );
+    loader.load( input, frame() );
+
+    logger().debug( "Loading masked frame", frame(), "from", path, "[DONE]" );
+
+}
+
 // Save unconverted frame.
 
 template< class InstrumentTraits >
@@ -211,7 +239,7 @@ inline void C3::Parallel< InstrumentTraits >::save( C3::Frame< U >& output, cons
     {
         /// FIXME Check statuses
         MPI_Send(         naxes,         naxis, C3::MpiType< long >::datatype, 0, 0, exposure_comm().comm() );
-        MPI_Send( output.data(), output.size(), C3::MpiType< U    >::datatype, 0, 0, exposure_comm().comm() );
+        _send_to_root( output );
     }
 
 }
@@ -283,13 +311,49 @@ void C3::Parallel< InstrumentTraits >::save( C3::Frame< U >& output, C3::Frame<
     {
         /// FIXME Check statuses
         MPI_Send(         naxes,         naxis, C3::MpiType< long >::datatype, 0, 0, exposure_comm().comm() );
-        MPI_Send( output.data(), output.size(), C3::MpiType< U    >::datatype, 0, 0, exposure_comm().comm() );
-        MPI_Send( invvar.data(), invvar.size(), C3::MpiType< U    >::datatype, 0, 0, exposure_comm().comm() );
-        MPI_Send(  flags.data(),  flags.size(), C3::MpiType< V    >::datatype, 0, 0, exposure_comm().comm() );
+        _send_to_root( output );
+        _send_to_root( invvar );
+        _send_to_root(  flags );
     }
 
 }
 
+// Save masked frame planes without conversion.
+
+template< class InstrumentTraits >
+template< class T, class F >
+inline void C3::Parallel< InstrumentTraits >::save( C3::MaskedFrame< T, F >& output, const std::string& path )
+{
+    save< T, T, F >( output, path );
+}
+
+// Save masked frame planes with conversion of data and inverse variance.
+
+template< class InstrumentTraits >
+template< class T, class U, class F >
+inline void C3::Parallel< InstrumentTraits >::save( C3::MaskedFrame< U, F >& output, const std::string& path )
+{
+    save< T, U, F >( output.data(), output.invvar(), output.flags(), path );
+}
+
+// Send frame pixels to the exposure-lane root.  A strided datatype skips row
+// padding, so the root receives packed rows whatever the frame's row pitch.
+
+template< class InstrumentTraits >
+template< class T >
+inline void C3::Parallel< InstrumentTraits >::_send_to_root( C3::Frame< T >& frame )
+{
+    MPI_Datatype rows;
+    int status = MPI_Type_vector( frame.nrows(), frame.ncolumns(), frame.pitch(), C3::MpiType< T >::datatype, &rows );
+    C3::assert_mpi_status( status );
+    status = MPI_Type_commit( &rows );
+    C3::assert_mpi_status( status );
+    status = MPI_Send( frame.data(), 1, rows, 0, 0, exposure_comm().comm() );
+    C3::assert_mpi_status( status );
+    status = MPI_Type_free( &rows );
+    C3::assert_mpi_status( status );
+}
+
 // Usual MPI launch.
 
 template< class InstrumentTraits >
@@ -570,6 +634,15 @@ inline void C3::Parallel< InstrumentTraits >::_init_exposure()
 
     _exposure_comm.reset( new C3::Communicator( exposure ) );
 
+    // Split again the other way to connect the MPI processes handling the same
+    // frame in every exposure lane, for reductions across lanes.
+
+    MPI_Comm cross_lane;
+    status = MPI_Comm_split( frame_comm().comm(), key, _exposure_lane, &cross_lane );
+    C3::assert_mpi_status( status );
+
+    _cross_lane_comm.reset( new C3::Communicator( cross_lane ) );
+
 }
 
 // Initiate file logger.  If the config doesn't contain a logger then we set up
@@ -623,13 +696,32 @@ template< class InstrumentTraits >
 inline void C3::Parallel< InstrumentTraits >::_init_openmp()
 {
 
-    // Suggests utilization of all threads per MPI process.
+    // Suggests utilization of all threads per MPI process.  Assignment kernels
+    // use them above the thread threshold.
 
     _threads_per_mpi_process = omp_get_max_threads();
+    C3::select_threads( _threads_per_mpi_process );
 
     // Debug messages.
 
     logger().debug( "OpenMP threads per MPI process   :", _threads_per_mpi_process );
+    logger().debug( "Assignment thread threshold      :", C3::thread_threshold() );
+
+}
+
+// Blocks allocate from the context's buffer pool from now on, so frames
+// built for every task, and receive buffers in save(), recycle storage.
+// With huge_pages in the config ("transparent" or "reserved"; "off" is the
+// default), the pool takes new buffers from huge pages.
+
+template< class InstrumentTraits >
+inline void C3::Parallel< InstrumentTraits >::_init_pool()
+{
+
+    auto huge_pages = _config[ "huge_pages" ] ? _config[ "huge_pages" ].template as< std::string >() : "off";
+    _pool = C3::context_pool( huge_pages, _huge_pages );
+    C3::select_memory_resource( _pool.get() );
+    logger().debug( "Block storage from buffer pool, huge pages:", huge_pages );
 
 }
 
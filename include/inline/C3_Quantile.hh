@@ -0,0 +1,469 @@
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../C3_Block.hh"
+#include "../C3_Math.hh"
+#include "../C3_Simd.hh"
+
+// Internal declarations
+
+namespace C3
+{
+
+    // Positions in sorted order of the two pixels a quantile interpolates
+    // between, and the weight of the upper one.
+
+    struct _Rank
+    {
+        size_type   lower;
+        size_type   upper;
+        double      fraction;
+    };
+
+    _Rank _rank( const double q, const size_type n );
+
+    template< class T, class U >
+    T _interpolate( const U lower, const U upper, const double fraction );
+
+    // Sorting Networks
+    // ----------------
+    // Comparators of Batcher's odd-even merge sort for 16 inputs, each pair putting the lesser value first.  Inputs
+    // past the number of pixels act as +infinity, which never moves, so comparators reaching them are dropped.
+    // Comparators whose outputs never reach the ranks wanted are dropped too.
+
+    const size_type _network_size = 16;
+
+    using _Comparator = std::pair< unsigned char, unsigned char >;
+
+    const std::vector< _Comparator >& _batcher_network();
+
+    // Trimmed networks for every n and ranks, built once, and the trimming itself.
+
+    const std::vector< _Comparator >& _quantile_network( const size_type n, const _Rank& rank );
+
+    std::vector< _Comparator > _trim_network( const size_type n, const size_type lower, const size_type upper );
+
+    // Compare and exchange, without branches.
+
+    template< class U >
+    void _compare_exchange( U& lesser, U& greater );
+
+    // Network Kernels
+    // ---------------
+    // Quantiles of count ranges of length pixels each, _network_size ranges at a time, one per lane: the ranges are
+    // transposed into wires of lanes and each comparator works on whole wires.  Dispatched like the expression
+    // kernels (see C3_Assign.hh).
+
+    template< class T, class U >
+    void _network_kernel( T* dest, const U* src, const size_type count, const size_type length,
+            const std::vector< _Comparator >& network, const _Rank& rank );
+
+    template< class T, class U >
+    C3_NO_FP_CONTRACT void _scalar_network_kernel( T* dest, const U* src, const size_type count, const size_type length,
+            const std::vector< _Comparator >& network, const _Rank& rank );
+
+#ifdef C3_SIMD_X86
+
+    template< class T, class U >
+    C3_TARGET_AVX2 void _vector_network_kernel( detail::Avx2, T* dest, const U* src, const size_type count,
+            const size_type length, const std::vector< _Comparator >& network, const _Rank& rank );
+
+    template< class T, class U >
+    C3_TARGET_AVX512 void _vector_network_kernel( detail::Avx512, T* dest, const U* src, const size_type count,
+            const size_type length, const std::vector< _Comparator >& network, const _Rank& rank );
+
+#endif
+
+    // Loop over groups of ranges shared by the scalar and vector versions.
+
+    template< class T, class U >
+    C3_SHARED_BODY void _network_groups( T* dest, const U* src, const size_type count, const size_type length,
+            const std::vector< _Comparator >& network, const _Rank& rank );
+
+    // Steps of the loop on one group of ranges: load the ranges from first to last into wires, sort the wires, and
+    // store the quantiles.  Like the loop, they are compiled inline for each instruction set.
+
+    template< class U >
+    using _Wires = U[ _network_size ][ _network_size ];
+
+    template< class U >
+    C3_SHARED_BODY void _load_wires( _Wires< U >& wires, const U* src, const size_type first, const size_type last,
+            const size_type length );
+
+    template< class U >
+    C3_SHARED_BODY void _sort_wires( _Wires< U >& wires, const std::vector< _Comparator >& network );
+
+    template< class T, class U >
+    C3_SHARED_BODY void _store_wires( T* dest, const _Wires< U >& wires, const size_type first, const size_type last,
+            const _Rank& rank );
+
+    // Selection
+    // ---------
+    // Pixel of a given rank in sorted order, by counting for integers of one or two bytes, and otherwise with
+    // std::nth_element on a copy in a buffer kept per thread.
+
+    const size_type _counting_threshold = 1024;
+
+    template< class U >
+    struct _Countable : std::integral_constant< bool,
+        std::is_integral< U >::value && ! std::is_same< U, bool >::value && sizeof( U ) <= 2 > {};
+
+    template< class U >
+    std::pair< U, U > _select_ranks( const U* src, const size_type n, const _Rank& rank, std::true_type );
+
+    template< class U >
+    std::pair< U, U > _select_ranks( const U* src, const size_type n, const _Rank& rank, std::false_type );
+
+    template< class U >
+    U _counting_select( const U* src, const size_type n, size_type rank );
+
+}
+
+// Constructor.
+
+inline C3::Quantile::Quantile( const double q ) : q( q )
+{
+    assert( q >= 0.0 && q <= 1.0 );
+}
+
+// Quantile of one range.
+
+template< class T, class U >
+C3_NO_FP_CONTRACT inline void C3::Quantile::operator () ( T& dest, const U* begin, const U* end ) const
+{
+    assert( begin < end );
+    const C3::size_type n = end - begin;
+    const auto rank = C3::_rank( q, n );
+    if( n <= C3::_network_size )
+    {
+        U values[ C3::_network_size ];
+        std::copy( begin, end, values );
+        for( const auto& comparator : C3::_quantile_network( n, rank ) )
+        {
+            C3::_compare_exchange( values[ comparator.first ], values[ comparator.second ] );
+        }
+        dest = C3::_interpolate< T >( values[ rank.lower ], values[ rank.upper ], rank.fraction );
+        return;
+    }
+    const auto selected = C3::_select_ranks( begin, n, rank,
+            std::integral_constant< bool, C3::_Countable< U >::value >() );
+    dest = C3::_interpolate< T >( selected.first, selected.second, rank.fraction );
+}
+
+// Quantiles of many ranges, across ranges if they are short enough for the
+// sorting network.
+
+template< class T, class U >
+inline void C3::Quantile::batch( T* dest, const U* src, const C3::size_type count, const C3::size_type length ) const
+{
+    assert( length > 0 );
+    if( length > C3::_network_size )
+    {
+        for( C3::size_type c = 0; c < count; ++c ) (*this)( dest[ c ], src + length * c, src + length * ( c + 1 ) );
+        return;
+    }
+    const auto rank = C3::_rank( q, length );
+    C3::_network_kernel( dest, src, count, length, C3::_quantile_network( length, rank ), rank );
+}
+
+// Quantiles of columns, a group of columns gathered a row at a time and then
+// reduced as a batch.
+
+template< class T, class U >
+inline void C3::Quantile::columns( T* dest, const U* src, const C3::size_type ncolumns, const C3::size_type nrows,
+        const C3::size_type stride ) const
+{
+    assert( nrows > 0 );
+    const auto group = std::min( ncolumns, C3::_network_size );
+    C3::Block< U > gathered( group * nrows );
+    for( C3::size_type first = 0; first < ncolumns; first += group )
+    {
+        const auto count = std::min( group, ncolumns - first );
+        for( C3::size_type i = 0; i < nrows; ++i )
+        {
+            const U* row = src + stride * i + first;
+            for( C3::size_type j = 0; j < count; ++j ) gathered[ nrows * j + i ] = row[ j ];
+        }
+        batch( dest + first, gathered.data(), count, nrows );
+    }
+}
+
+// Ranks of a quantile.
+
+inline C3::_Rank C3::_rank( const double q, const C3::size_type n )
+{
+    const double position = q * ( n - 1 );
+    const auto lower = std::min( static_cast< C3::size_type >( std::floor( position ) ), n - 1 );
+    const double fraction = position - lower;
+    const auto upper = fraction > 0.0 ? std::min( lower + 1, n - 1 ) : lower;
+    return C3::_Rank{ lower, upper, fraction };
+}
+
+// Linear interpolation, exact at the lower pixel.  The step is a statement
+// of its own so that no compiler contracts it within the expression.
+
+template< class T, class U >
+inline T C3::_interpolate( const U lower, const U upper, const double fraction )
+{
+    using R = typename C3::_Real< T >::type;
+    const R low  = static_cast< R >( lower );
+    const R step = static_cast< R >( fraction ) * ( static_cast< R >( upper ) - low );
+    return static_cast< T >( low + step );
+}
+
+// Batcher's network for 16 inputs, built once.
+
+inline const std::vector< C3::_Comparator >& C3::_batcher_network()
+{
+    static const std::vector< C3::_Comparator > network = []()
+        {
+            const C3::size_type n = C3::_network_size;
+            std::vector< C3::_Comparator > pairs;
+            for( C3::size_type p = 1; p < n; p *= 2 )
+            {
+                for( C3::size_type k = p; k >= 1; k /= 2 )
+                {
+                    for( C3::size_type j = k % p; j + k < n; j += 2 * k )
+                    {
+                        for( C3::size_type i = 0; i < std::min( k, n - j - k ); ++i )
+                        {
+                            if( ( i + j ) / ( 2 * p ) == ( i + j + k ) / ( 2 * p ) )
+                            {
+                                pairs.emplace_back( i + j, i + j + k );
+                            }
+                        }
+                    }
+                }
+            }
+            return pairs;
+        }();
+    return network;
+}
+
+// Trimmed networks, looked up by n, lower rank and whether the upper rank is
+// the next one.  Quantile::operator() trims for every range it reduces, so
+// the networks are all built once rather than for every call.
+
+inline const std::vector< C3::_Comparator >& C3::_quantile_network( const C3::size_type n, const C3::_Rank& rank )
+{
+    static const std::vector< std::vector< C3::_Comparator > > networks = []()
+        {
+            const C3::size_type size = C3::_network_size;
+            std::vector< std::vector< C3::_Comparator > > trimmed( 2 * size * size );
+            for( C3::size_type m = 1; m <= size; ++m )
+            {
+                for( C3::size_type lower = 0; lower < m; ++lower )
+                {
+                    trimmed[ 2 * ( size * ( m - 1 ) + lower ) ]     = C3::_trim_network( m, lower, lower );
+                    trimmed[ 2 * ( size * ( m - 1 ) + lower ) + 1 ] = C3::_trim_network( m, lower,
+                            std::min( lower + 1, m - 1 ) );
+                }
+            }
+            return trimmed;
+        }();
+    assert( n >= 1 && n <= C3::_network_size && rank.upper < n && rank.upper - rank.lower <= 1 );
+    return networks[ 2 * ( C3::_network_size * ( n - 1 ) + rank.lower ) + ( rank.upper > rank.lower ? 1 : 0 ) ];
+}
+
+// Network trimmed to n inputs and the ranks wanted, working back from the
+// outputs wanted to the comparators that feed them.
+
+inline std::vector< C3::_Comparator > C3::_trim_network( const C3::size_type n, const C3::size_type lower,
+        const C3::size_type upper )
+{
+    const auto& full = C3::_batcher_network();
+    unsigned needed = ( 1u << lower ) | ( 1u << upper );
+    std::vector< C3::_Comparator > network;
+    for( auto comparator = full.rbegin(); comparator != full.rend(); ++comparator )
+    {
+        if( comparator->second >= n ) continue;
+        const unsigned wires = ( 1u << comparator->first ) | ( 1u << comparator->second );
+        if( ( needed & wires ) == 0 ) continue;
+        needed |= wires;
+        network.push_back( *comparator );
+    }
+    std::reverse( network.begin(), network.end() );
+    return network;
+}
+
+// Compare and exchange.
+
+template< class U >
+inline void C3::_compare_exchange( U& lesser, U& greater )
+{
+    const U a = lesser, b = greater;
+    const bool swap = b < a;
+    lesser  = C3::_select( swap, b, a );
+    greater = C3::_select( swap, a, b );
+}
+
+// Network kernel, dispatched.
+
+template< class T, class U >
+inline void C3::_network_kernel( T* dest, const U* src, const C3::size_type count, const C3::size_type length,
+        const std::vector< C3::_Comparator >& network, const C3::_Rank& rank )
+{
+#ifdef C3_SIMD_X86
+    switch( C3::isa() )
+    {
+        case C3::Isa::AVX512 : C3::_vector_network_kernel( C3::detail::Avx512(), dest, src, count, length, network,
+                                       rank );
+                               return;
+        case C3::Isa::AVX2   : C3::_vector_network_kernel( C3::detail::Avx2()  , dest, src, count, length, network,
+                                       rank );
+                               return;
+        default              : break;
+    }
+#endif
+    C3::_scalar_network_kernel( dest, src, count, length, network, rank );
+}
+
+template< class T, class U >
+C3_NO_FP_CONTRACT inline void C3::_scalar_network_kernel( T* dest, const U* src, const C3::size_type count,
+        const C3::size_type length, const std::vector< C3::_Comparator >& network, const C3::_Rank& rank )
+{
+    C3::_network_groups( dest, src, count, length, network, rank );
+}
+
+#ifdef C3_SIMD_X86
+
+template< class T, class U >
+C3_TARGET_AVX2 inline void C3::_vector_network_kernel( C3::detail::Avx2, T* dest, const U* src,
+        const C3::size_type count, const C3::size_type length, const std::vector< C3::_Comparator >& network,
+        const C3::_Rank& rank )
+{
+    C3::_network_groups( dest, src, count, length, network, rank );
+}
+
+template< class T, class U >
+C3_TARGET_AVX512 inline void C3::_vector_network_kernel( C3::detail::Avx512, T* dest, const U* src,
+        const C3::size_type count, const C3::size_type length, const std::vector< C3::_Comparator >& network,
+        const C3::_Rank& rank )
+{
+    C3::_network_groups( dest, src, count, length, network, rank );
+}
+
+#endif
+
+// Groups of _network_size ranges, one lane per range.
+
+template< class T, class U >
+C3_SHARED_BODY inline void C3::_network_groups( T* dest, const U* src, const C3::size_type count,
+        const C3::size_type length, const std::vector< C3::_Comparator >& network, const C3::_Rank& rank )
+{
+    C3::_Wires< U > wires;
+    for( C3::size_type first = 0; first < count; first += C3::_network_size )
+    {
+        const auto last = std::min( count, first + C3::_network_size );
+        C3::_load_wires( wires, src, first, last, length );
+        C3::_sort_wires( wires, network );
+        C3::_store_wires( dest, wires, first, last, rank );
+    }
+}
+
+// Ranges transposed into wires, one lane per range.  Lanes past the last
+// range of the final group repeat it.
+
+template< class U >
+C3_SHARED_BODY inline void C3::_load_wires( C3::_Wires< U >& wires, const U* src, const C3::size_type first,
+        const C3::size_type last, const C3::size_type length )
+{
+    for( C3::size_type f = 0; f < length; ++f )
+    {
+        for( C3::size_type l = 0; l < C3::_network_size; ++l )
+        {
+            wires[ f ][ l ] = src[ length * std::min( first + l, last - 1 ) + f ];
+        }
+    }
+}
+
+// Comparators on whole wires.  Both wires are read before either is written
+// so that the lanes can go into vectors without checks for aliasing.
+
+template< class U >
+C3_SHARED_BODY inline void C3::_sort_wires( C3::_Wires< U >& wires, const std::vector< C3::_Comparator >& network )
+{
+    for( const auto& comparator : network )
+    {
+        U* lesser  = wires[ comparator.first  ];
+        U* greater = wires[ comparator.second ];
+        U low[ C3::_network_size ], high[ C3::_network_size ];
+        for( C3::size_type l = 0; l < C3::_network_size; ++l )
+        {
+            low[ l ]  = lesser[ l ];
+            high[ l ] = greater[ l ];
+            C3::_compare_exchange( low[ l ], high[ l ] );
+        }
+        std::copy( low , low  + C3::_network_size, lesser  );
+        std::copy( high, high + C3::_network_size, greater );
+    }
+}
+
+// Quantiles of the lanes in use.
+
+template< class T, class U >
+C3_SHARED_BODY inline void C3::_store_wires( T* dest, const C3::_Wires< U >& wires, const C3::size_type first,
+        const C3::size_type last, const C3::_Rank& rank )
+{
+    for( C3::size_type l = 0; l < last - first; ++l )
+    {
+        dest[ first + l ] = C3::_interpolate< T >( wires[ rank.lower ][ l ], wires[ rank.upper ][ l ], rank.fraction );
+    }
+}
+
+// Ranks by counting.
+
+template< class U >
+inline std::pair< U, U > C3::_select_ranks( const U* src, const C3::size_type n, const C3::_Rank& rank,
+        std::true_type )
+{
+    if( n < C3::_counting_threshold ) return C3::_select_ranks( src, n, rank, std::false_type() );
+    const U lower = C3::_counting_select( src, n, rank.lower );
+    return std::make_pair( lower, rank.upper == rank.lower ? lower : C3::_counting_select( src, n, rank.upper ) );
+}
+
+// Ranks by partial sorting of a copy.  The upper rank is the least pixel
+// after the lower one once that is in place.
+
+template< class U >
+inline std::pair< U, U > C3::_select_ranks( const U* src, const C3::size_type n, const C3::_Rank& rank,
+        std::false_type )
+{
+    static thread_local std::vector< U > buffer;
+    buffer.assign( src, src + n );
+    const auto lower = buffer.begin() + rank.lower;
+    std::nth_element( buffer.begin(), lower, buffer.end() );
+    return std::make_pair( *lower, rank.upper == rank.lower ? *lower : *std::min_element( lower + 1, buffer.end() ) );
+}
+
+// Counting selection, a byte at a time from the most significant.  Keys
+// flip the sign bit of signed pixels so that they sort as unsigned.  Each
+// pass counts the next byte of pixels whose bytes so far match the prefix
+// found, and the bin holding the rank extends the prefix.
+
+template< class U >
+inline U C3::_counting_select( const U* src, const C3::size_type n, C3::size_type rank )
+{
+    using K = typename std::make_unsigned< U >::type;
+    const K flip = std::is_signed< U >::value ? static_cast< K >( K( 1 ) << ( 8 * sizeof( U ) - 1 ) ) : K( 0 );
+    unsigned prefix = 0;
+    for( C3::size_type level = 0; level < sizeof( U ); ++level )
+    {
+        const unsigned shift = 8 * ( sizeof( U ) - 1 - level );
+        C3::size_type counts[ 256 ] = {};
+        for( C3::size_type i = 0; i < n; ++i )
+        {
+            const unsigned key = static_cast< K >( static_cast< K >( src[ i ] ) ^ flip );
+            counts[ ( key >> shift ) & 255u ] += ( key >> ( shift + 8 ) ) == ( prefix >> ( shift + 8 ) );
+        }
+        unsigned bin = 0;
+        while( rank >= counts[ bin ] ) rank -= counts[ bin++ ];
+        prefix |= bin << shift;
+    }
+    return static_cast< U >( static_cast< K >( prefix ) ^ flip );
+}
@@ -0,0 +1,193 @@
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+#include "../C3_MaskedFrame.hh"
+#include "../C3_Threads.hh"
+
+// Internal declarations
+
+namespace C3
+{
+
+    // Numbers kept per pixel.
+
+    const size_type _sketch_state = 9;
+
+    // One pixel x into the state of its position, for quantile q.
+
+    template< class T >
+    void _sketch_add( T* state, const T x, const T q );
+
+    // Estimate from the state of one position.
+
+    template< class T >
+    T _sketch_estimate( const T* state, const T q );
+
+}
+
+// Constructor.
+
+template< class T >
+inline C3::QuantileSketch< T >::QuantileSketch( const C3::size_type ncolumns, const C3::size_type nrows,
+        const double q ) noexcept :
+    _ncolumns( ncolumns ), _nrows( nrows ), _q( q ), _state( C3::_sketch_state * ncolumns * nrows, T( 0 ) )
+{
+    assert( q >= 0.0 && q <= 1.0 );
+}
+
+// Add frame.
+
+template< class T >
+template< class U >
+inline C3::QuantileSketch< T >& C3::QuantileSketch< T >::add( const C3::Frame< U >& frame )
+{
+    _add( frame, []( const C3::size_type, const C3::size_type ) { return true; } );
+    return *this;
+}
+
+// Add masked frame.
+
+template< class T >
+template< class U, class F >
+inline C3::QuantileSketch< T >& C3::QuantileSketch< T >::add( const C3::MaskedFrame< U, F >& frame )
+{
+    _add( frame.data(), [ & ]( const C3::size_type j, const C3::size_type k )
+        {
+            return frame.flags()( j, k ) == F( 0 ) && frame.invvar()( j, k ) > U( 0 );
+        } );
+    return *this;
+}
+
+// Estimate.
+
+template< class T >
+inline C3::Frame< T > C3::QuantileSketch< T >::estimate() const
+{
+    C3::Frame< T > estimate( _ncolumns, _nrows );
+    C3::detail::_parallel_for( _nrows, _nrows * _ncolumns, 1,
+        [ & ]( const C3::size_type first, const C3::size_type last )
+        {
+            for( auto k = first; k < last; ++k )
+            {
+                for( C3::size_type j = 0; j < _ncolumns; ++j )
+                {
+                    estimate( j, k ) = C3::_sketch_estimate( _state.data() + C3::_sketch_state * ( j + _ncolumns * k ),
+                            T( _q ) );
+                }
+            }
+        } );
+    return estimate;
+}
+
+// Add pixels, in row bands over threads.
+
+template< class T >
+template< class Source, class Keep >
+inline void C3::QuantileSketch< T >::_add( const Source& src, Keep keep )
+{
+    assert( src.ncolumns() == _ncolumns && src.nrows() == _nrows );
+    C3::detail::_parallel_for( _nrows, _nrows * _ncolumns, 1,
+        [ & ]( const C3::size_type first, const C3::size_type last )
+        {
+            for( auto k = first; k < last; ++k )
+            {
+                for( C3::size_type j = 0; j < _ncolumns; ++j )
+                {
+                    if( ! keep( j, k ) ) continue;
+                    C3::_sketch_add( _state.data() + C3::_sketch_state * ( j + _ncolumns * k ),
+                            static_cast< T >( src( j, k ) ), T( _q ) );
+                }
+            }
+        } );
+}
+
+// P-square update.  Until there are five pixels the heights are the pixels
+// themselves, kept sorted.  After that, marker positions count from zero:
+// the outer markers sit at 0 and count - 1, and marker i should sit at
+// ( count - 1 ) times 0, q / 2, q, ( 1 + q ) / 2 and 1.
+
+template< class T >
+inline void C3::_sketch_add( T* state, const T x, const T q )
+{
+    T& count  = state[ 0 ];
+    T* height = state + 1;
+    T* inner  = state + 6;
+
+    const auto n = static_cast< C3::size_type >( count );
+    if( n < 5 )
+    {
+        auto i = n;
+        for( ; i > 0 && x < height[ i - 1 ]; --i ) height[ i ] = height[ i - 1 ];
+        height[ i ] = x;
+        count += T( 1 );
+        for( C3::size_type m = 0; m < 3; ++m ) inner[ m ] = T( m + 1 );
+        return;
+    }
+
+    // Cell holding x, stretching the outer markers if x is beyond them.
+
+    C3::size_type cell = 0;
+    if( x < height[ 0 ] )
+    {
+        height[ 0 ] = x;
+    }
+    else if( x >= height[ 4 ] )
+    {
+        height[ 4 ] = x;
+        cell = 3;
+    }
+    else
+    {
+        while( x >= height[ cell + 1 ] ) ++cell;
+    }
+
+    count += T( 1 );
+    const T last = count - T( 1 );
+    T position[ 5 ] = { T( 0 ), inner[ 0 ], inner[ 1 ], inner[ 2 ], last };
+    for( C3::size_type m = cell + 1; m < 4; ++m ) position[ m ] += T( 1 );
+    const T desired[ 5 ] = { T( 0 ), q / T( 2 ) * last, q * last, ( T( 1 ) + q ) / T( 2 ) * last, last };
+
+    // Inner markers a position along, parabolic heights if they stay between
+    // their neighbours' and linear ones otherwise.
+
+    for( C3::size_type m = 1; m < 4; ++m )
+    {
+        const T d = desired[ m ] - position[ m ];
+        const T below = position[ m ] - position[ m - 1 ], above = position[ m + 1 ] - position[ m ];
+        if( ! ( ( d >= T( 1 ) && above > T( 1 ) ) || ( d <= T( -1 ) && below > T( 1 ) ) ) ) continue;
+        const T s = d > T( 0 ) ? T( 1 ) : T( -1 );
+        const T parabolic = height[ m ] + s / ( above + below )
+            * ( ( below + s ) * ( height[ m + 1 ] - height[ m ] ) / above
+              + ( above - s ) * ( height[ m ] - height[ m - 1 ] ) / below );
+        if( height[ m - 1 ] < parabolic && parabolic < height[ m + 1 ] )
+        {
+            height[ m ] = parabolic;
+        }
+        else
+        {
+            const auto other = s > T( 0 ) ? m + 1 : m - 1;
+            height[ m ] += s * ( height[ other ] - height[ m ] ) / ( position[ other ] - position[ m ] );
+        }
+        position[ m ] += s;
+    }
+
+    for( C3::size_type m = 0; m < 3; ++m ) inner[ m ] = position[ m + 1 ];
+}
+
+// Estimate, interpolated like C3::Quantile up to five pixels.
+
+template< class T >
+inline T C3::_sketch_estimate( const T* state, const T q )
+{
+    const auto n = static_cast< C3::size_type >( state[ 0 ] );
+    const T* height = state + 1;
+    if( n == 0 ) return std::numeric_limits< T >::quiet_NaN();
+    if( n > 5 ) return height[ 2 ];
+    const T position = q * T( n - 1 );
+    const auto lower = std::min( static_cast< C3::size_type >( std::floor( position ) ), n - 1 );
+    const auto upper = std::min( lower + 1, n - 1 );
+    return height[ lower ] + ( position - T( lower ) ) * ( height[ upper ] - height[ lower ] );
+}
@@ -0,0 +1,1039 @@
+
+#include <cassert>
+#include <type_traits>
+
+#include "../C3_Block.hh"
+#include "../C3_Column.hh"
+#include "../C3_Congruent.hh"
+#include "../C3_Frame.hh"
+#include "../C3_Math.hh"
+#include "../C3_Row.hh"
+#include "../C3_Simd.hh"
+#include "../C3_Stack.hh"
+#include "../C3_Threads.hh"
+#include "../C3_TypeTraits.hh"
+#include "../C3_View.hh"
+
+// Internal implementation declarations.
+
+namespace C3
+{
+
+    // Allowed reductions, as in the table in C3_Reduce.hh.
+
+    template< class Destination, class Source >
+    struct _CanReduce;
+
+    // Creates requested container with right dimensions for reduction operation.
+
+    template< class Destination >
+    struct _CreateReduce;
+
+    // Reduce Driver Declarations
+    // --------------------------
+    // Invoked directly by public reduce() functions, reduce drivers describe the source as lines of pixels, one line
+    // per destination pixel, and pass these to _reduce_lines() along with the reduce operator supplied by the caller.
+
+    // Pixel from any container.
+    template< class T, class Source, class Operator >
+    T& _reduce( T& dest, const Source& src, Operator op );
+
+    // Column from Frame.
+    template< class T, class U, class Operator >
+    Column< T >& _reduce( Column< T >& dest, const Frame< U >& src, Operator op );
+
+    // Column from View.
+    template< class T, class U, class Operator >
+    Column< T >& _reduce( Column< T >& dest, const View< U >& src, Operator op );
+
+    // Row from Frame.
+    template< class T, class U, class Operator >
+    Row< T >& _reduce( Row< T >& dest, const Frame< U >& src, Operator op );
+
+    // Row from View.
+    template< class T, class U, class Operator >
+    Row< T >& _reduce( Row< T >& dest, const View< U >& src, Operator op );
+
+    // Frame from Stack.
+    template< class T, class U, class Operator >
+    Frame< T >& _reduce( Frame< T >& dest, const Stack< U >& src, Operator op );
+
+    // View from Stack.
+    template< class T, class U, class Operator >
+    View< T >& _reduce( View< T >& dest, const Stack< U >& src, Operator op );
+
+    // Pixel Reduce Declarations
+    // -------------------------
+    // A pixel reduction hands the operator all source pixels as one contiguous range.  Containers with padding or
+    // strides are copied into a packed container first.
+
+    template< class T, class U, class Operator >
+    void _reduce_pixel( T& dest, const Block< U >& src, Operator op );
+
+    template< class T, class U, class Operator >
+    void _reduce_pixel( T& dest, const Column< U >& src, Operator op );
+
+    template< class T, class U, class Operator >
+    void _reduce_pixel( T& dest, const Row< U >& src, Operator op );
+
+    template< class T, class U, class Operator >
+    void _reduce_pixel( T& dest, const Frame< U >& src, Operator op );
+
+    template< class T, class U, class Operator >
+    void _reduce_pixel( T& dest, const View< U >& src, Operator op );
+
+    template< class T, class U, class Operator >
+    void _reduce_pixel( T& dest, const Stack< U >& src, Operator op );
+
+    // Reduce Pattern Declaration
+    // --------------------------
+    // Count lines of length pixels each, in bands over threads.  Destination pixel n is dest( n ).  Line n is
+    // line( n, buffer ), a pointer to its pixels, gathered into the buffer first if they are not contiguous in the
+    // source.  Buffers of length pixels are only set up, one per band, when gather is true.
+
+    template< class U, class Destination, class Line, class Operator >
+    void _reduce_lines( const size_type count, const size_type length, const bool gather, Destination dest,
+            Line line, Operator op );
+
+    // Rows of an interleaved stack, one batch call per row, in bands over threads.  Destination row k starts at
+    // dest( k ).  Returns false without doing anything for operators without a batch reduction.
+
+    template< class Operator, class T, class U >
+    struct _HasBatch;
+
+    template< class U, class Destination, class Operator >
+    bool _reduce_rows( const Stack< U >& src, Destination dest, Operator op, std::true_type );
+
+    template< class U, class Destination, class Operator >
+    bool _reduce_rows( const Stack< U >&, Destination, Operator, std::false_type );
+
+    // Bands of adjacent columns, rows stride apart from src, one column reduction call per band, in bands over
+    // threads.  Destination column j is dest[ j ].  Returns false without doing anything for operators without a
+    // column reduction.
+
+    template< class Operator, class T, class U >
+    struct _HasColumns;
+
+    template< class T, class U, class Operator >
+    bool _reduce_column_bands( T* dest, const U* src, const size_type ncolumns, const size_type nrows,
+            const size_type stride, Operator op, std::true_type );
+
+    template< class T, class U, class Operator >
+    bool _reduce_column_bands( T*, const U*, const size_type, const size_type, const size_type, Operator,
+            std::false_type );
+
+    // Range Reduction Declarations
+    // ----------------------------
+    // Deterministic reduction of a range, used by the reduction operators.  A transform maps each pixel to the value
+    // type T of the result, and a combine object merges two values of type T.  Pixels are taken in blocks of
+    // _reduce_block_size, each reduced into _reduce_lanes interleaved partial results combined in a fixed tree.
+    // Ranges longer than a block reduce their blocks over threads into partial results, which are then reduced the
+    // same way.  The order of operations only depends on the length of the range.
+
+    const size_type _reduce_lanes      = 16;
+    const size_type _reduce_block_size = 512;
+
+    template< class T, class U, class Transform, class Combine >
+    T _reduce_range( const U* begin, const U* end, Transform transform, Combine combine );
+
+    template< class T, class U, class Transform, class Combine >
+    T _reduce_block( const U* src, const size_type length, Transform transform, Combine combine );
+
+    template< class T, class U, class Transform, class Combine >
+    C3_NO_FP_CONTRACT T _scalar_reduce_block( const U* src, const size_type length, Transform transform,
+            Combine combine );
+
+#ifdef C3_SIMD_X86
+
+    template< class T, class U, class Transform, class Combine >
+    C3_TARGET_AVX2 T _vector_reduce_block( detail::Avx2, const U* src, const size_type length, Transform transform,
+            Combine combine );
+
+    template< class T, class U, class Transform, class Combine >
+    C3_TARGET_AVX512 T _vector_reduce_block( detail::Avx512, const U* src, const size_type length,
+            Transform transform, Combine combine );
+
+#endif
+
+    // Block body shared by the scalar and vector versions.  The loop over
+    // lanes has no dependence from one lane to the next, so it vectorizes
+    // without reordering any operation.
+
+    template< class T, class U, class Transform, class Combine >
+    C3_SHARED_BODY T _fold_block( const U* src, const size_type length, Transform transform, Combine combine );
+
+    // Column Reduction Declarations
+    // -----------------------------
+    // Deterministic reduction of each of ncolumns columns of nrows pixels, rows stride pixels apart from src, into
+    // dest[ j ], with the order of operations of _reduce_range() on the column gathered, and so the same result.
+    // Columns go a tile of _reduce_tile at a time.  The lanes of a block are kept for every column of the tile side
+    // by side and filled a row at a time, so rows are read contiguously and the loop over columns vectorizes.  Block
+    // results of a tile are then reduced the same way.  Transforms also take the index of the column, counted from
+    // first.
+
+    const size_type _reduce_tile = 64;
+
+    template< class T, class U, class Transform, class Combine >
+    void _reduce_columns( T* dest, const U* src, const size_type ncolumns, const size_type nrows,
+            const size_type stride, Transform transform, Combine combine );
+
+    template< class T, class U, class Transform, class Combine >
+    void _reduce_column_tile( T* dest, const U* src, const size_type first, const size_type ncolumns,
+            const size_type nrows, const size_type stride, Transform transform, Combine combine );
+
+    template< class T, class U, class Transform, class Combine >
+    void _reduce_column_block( T* dest, const U* src, const size_type first, const size_type ncolumns,
+            const size_type nrows, const size_type stride, Transform transform, Combine combine );
+
+    template< class T, class U, class Transform, class Combine >
+    C3_NO_FP_CONTRACT void _scalar_reduce_column_block( T* dest, const U* src, const size_type first,
+            const size_type ncolumns, const size_type nrows, const size_type stride, Transform transform,
+            Combine combine );
+
+#ifdef C3_SIMD_X86
+
+    template< class T, class U, class Transform, class Combine >
+    C3_TARGET_AVX2 void _vector_reduce_column_block( detail::Avx2, T* dest, const U* src, const size_type first,
+            const size_type ncolumns, const size_type nrows, const size_type stride, Transform transform,
+            Combine combine );
+
+    template< class T, class U, class Transform, class Combine >
+    C3_TARGET_AVX512 void _vector_reduce_column_block( detail::Avx512, T* dest, const U* src, const size_type first,
+            const size_type ncolumns, const size_type nrows, const size_type stride, Transform transform,
+            Combine combine );
+
+#endif
+
+    // Column block body shared by the scalar and vector versions.
+
+    template< class T, class U, class Transform, class Combine >
+    C3_SHARED_BODY void _fold_columns( T* dest, const U* src, const size_type first, const size_type ncolumns,
+            const size_type nrows, const size_type stride, Transform transform, Combine combine );
+
+    // Transforms.  Column transforms take the index of the column as well.
+
+    template< class T >
+    struct _ToValue
+    {
+        template< class U > T operator () ( const U src ) const;
+        template< class U > T operator () ( const U src, const size_type ) const;
+    };
+
+    template< class T >
+    struct _SquaredDeviation
+    {
+        T center;
+        template< class U > T operator () ( const U src ) const;
+    };
+
+    template< class T >
+    struct _SquaredDeviations
+    {
+        const T* centers;
+        template< class U > T operator () ( const U src, const size_type j ) const;
+    };
+
+    // Combines.  Each gives the value lanes start from, given the first
+    // transformed pixel.
+
+    template< class T >
+    struct _Add
+    {
+        T start( const T ) const;
+        T operator () ( const T lhs, const T rhs ) const;
+    };
+
+    template< class T >
+    struct _Lesser
+    {
+        T start( const T first ) const;
+        T operator () ( const T lhs, const T rhs ) const;
+    };
+
+    template< class T >
+    struct _Greater
+    {
+        T start( const T first ) const;
+        T operator () ( const T lhs, const T rhs ) const;
+    };
+
+}
+
+// Allowed reductions.
+
+template< class Destination, class Source >
+struct C3::_CanReduce
+{
+
+    static const bool  src_container  = C3::IsContainer< Source >::value && ! C3::IsStackView< Source >::value;
+    static const bool dest_pixel      = C3::IsPixel< Destination >::value;
+    static const bool  src_frame_view = C3::IsFrameOrView< Source >::value;
+    static const bool dest_column_row = C3::IsColumn< Destination >::value || C3::IsRow< Destination >::value;
+    static const bool  src_stack      = C3::IsStack< Source >::value;
+    static const bool dest_frame_view = C3::IsFrameOrView< Destination >::value;
+
+    static const bool value = ( src_container && dest_pixel )
+        || ( src_frame_view && dest_column_row )
+        || ( src_stack && dest_frame_view );
+
+};
+
+// Create reduced container.
+
+template< template< class > class Destination, template< class > class Source, class T, class Operator >
+inline Destination< T > C3::reduce( const Source< T >& src, Operator op )
+{
+    static_assert( C3::_CanReduce< Destination< T >, Source< T > >::value, "Reduction not defined for containers." );
+    auto dest = C3::_CreateReduce< Destination< T > >::create( src );
+    C3::_reduce( dest, src, op );
+    return dest;
+}
+
+// Reduce to pixel.
+
+template< template< class > class Source, class T, class Operator >
+inline T C3::reduce( const Source< T >& src, Operator op )
+{
+    static_assert( C3::_CanReduce< T, Source< T > >::value, "Reduction not defined for containers." );
+    auto dest = T();
+    return C3::_reduce( dest, src, op );
+}
+
+// Create reduced container, with conversion.
+
+template< template< class > class Destination, class T, template< class > class Source, class U, class Operator >
+inline Destination< T > C3::reduce( const Source< U >& src, Operator op )
+{
+    static_assert( C3::_CanReduce< Destination< T >, Source< U > >::value, "Reduction not defined for containers." );
+    auto dest = C3::_CreateReduce< Destination< T > >::create( src );
+    C3::_reduce( dest, src, op );
+    return dest;
+}
+
+// Reduce to pixel, with conversion.
+
+template< class T, template< class > class Source, class U, class Operator >
+inline T C3::reduce( const Source< U >& src, Operator op )
+{
+    static_assert( C3::_CanReduce< T, Source< U > >::value, "Reduction not defined for containers." );
+    auto dest = T();
+    return C3::_reduce( dest, src, op );
+}
+
+// Reduce into existing destination.
+
+template< class Destination, class Source, class Operator >
+inline Destination& C3::reduce( Destination& dest, const Source& src, Operator op )
+{
+    static_assert( C3::_CanReduce< Destination, Source >::value, "Reduction not defined for containers." );
+    assert( C3::congruent( dest, src ) );
+    return C3::_reduce( dest, src, op );
+}
+
+// Reduce Destination Creator Definition
+// -------------------------------------
+
+// Primary template.
+
+template< class Destination >
+struct C3::_CreateReduce {};
+
+// View or frame to column.
+
+template< class T >
+struct C3::_CreateReduce< C3::Column< T > >
+{
+    template< class Source >
+    static C3::Column< T > create( const Source& src ) { return C3::Column< T >( src.nrows() ); }
+};
+
+// View or frame to row.
+
+template< class T >
+struct C3::_CreateReduce< C3::Row< T > >
+{
+    template< class Source >
+    static C3::Row< T > create( const Source& src ) { return C3::Row< T >( src.ncolumns() ); }
+};
+
+// Stack to frame.
+
+template< class T >
+struct C3::_CreateReduce< C3::Frame< T > >
+{
+    template< class U >
+    static C3::Frame< T > create( const C3::Stack< U >& src ) { return C3::Frame< T >( src.ncolumns(), src.nrows() ); }
+};
+
+// Reduction Operator Definitions
+// ------------------------------
+
+// Sum.
+
+template< class T, class U >
+inline void C3::Sum::operator () ( T& dest, const U* begin, const U* end ) const
+{
+    dest = C3::_reduce_range< T >( begin, end, C3::_ToValue< T >(), C3::_Add< T >() );
+}
+
+// Mean.
+
+template< class T, class U >
+inline void C3::Mean::operator () ( T& dest, const U* begin, const U* end ) const
+{
+    assert( begin < end );
+    dest = C3::_reduce_range< T >( begin, end, C3::_ToValue< T >(), C3::_Add< T >() ) / static_cast< T >( end - begin );
+}
+
+// Variance, about the mean.
+
+template< class T, class U >
+inline void C3::Variance::operator () ( T& dest, const U* begin, const U* end ) const
+{
+    assert( end - begin > 1 );
+    T mean;
+    C3::Mean()( mean, begin, end );
+    dest = C3::_reduce_range< T >( begin, end, C3::_SquaredDeviation< T >{ mean }, C3::_Add< T >() )
+        / static_cast< T >( end - begin - 1 );
+}
+
+// Smallest.
+
+template< class T, class U >
+inline void C3::Min::operator () ( T& dest, const U* begin, const U* end ) const
+{
+    assert( begin < end );
+    dest = C3::_reduce_range< T >( begin, end, C3::_ToValue< T >(), C3::_Lesser< T >() );
+}
+
+// Largest.
+
+template< class T, class U >
+inline void C3::Max::operator () ( T& dest, const U* begin, const U* end ) const
+{
+    assert( begin < end );
+    dest = C3::_reduce_range< T >( begin, end, C3::_ToValue< T >(), C3::_Greater< T >() );
+}
+
+// Column sums.
+
+template< class T, class U >
+inline void C3::Sum::columns( T* dest, const U* src, const C3::size_type ncolumns, const C3::size_type nrows,
+        const C3::size_type stride ) const
+{
+    C3::_reduce_columns( dest, src, ncolumns, nrows, stride, C3::_ToValue< T >(), C3::_Add< T >() );
+}
+
+// Column means.
+
+template< class T, class U >
+inline void C3::Mean::columns( T* dest, const U* src, const C3::size_type ncolumns, const C3::size_type nrows,
+        const C3::size_type stride ) const
+{
+    assert( nrows > 0 );
+    C3::_reduce_columns( dest, src, ncolumns, nrows, stride, C3::_ToValue< T >(), C3::_Add< T >() );
+    for( C3::size_type j = 0; j < ncolumns; ++j ) dest[ j ] /= static_cast< T >( nrows );
+}
+
+// Column variances, about the column means.
+
+template< class T, class U >
+inline void C3::Variance::columns( T* dest, const U* src, const C3::size_type ncolumns, const C3::size_type nrows,
+        const C3::size_type stride ) const
+{
+    assert( nrows > 1 );
+    C3::Block< T > means( ncolumns );
+    C3::Mean().columns( means.data(), src, ncolumns, nrows, stride );
+    C3::_reduce_columns( dest, src, ncolumns, nrows, stride, C3::_SquaredDeviations< T >{ means.data() },
+            C3::_Add< T >() );
+    for( C3::size_type j = 0; j < ncolumns; ++j ) dest[ j ] /= static_cast< T >( nrows - 1 );
+}
+
+// Column minima.
+
+template< class T, class U >
+inline void C3::Min::columns( T* dest, const U* src, const C3::size_type ncolumns, const C3::size_type nrows,
+        const C3::size_type stride ) const
+{
+    assert( nrows > 0 );
+    C3::_reduce_columns( dest, src, ncolumns, nrows, stride, C3::_ToValue< T >(), C3::_Lesser< T >() );
+}
+
+// Column maxima.
+
+template< class T, class U >
+inline void C3::Max::columns( T* dest, const U* src, const C3::size_type ncolumns, const C3::size_type nrows,
+        const C3::size_type stride ) const
+{
+    assert( nrows > 0 );
+    C3::_reduce_columns( dest, src, ncolumns, nrows, stride, C3::_ToValue< T >(), C3::_Greater< T >() );
+}
+
+// Reduce Driver Definitions
+// -------------------------
+
+// Pixel from any container.
+
+template< class T, class Source, class Operator >
+inline T& C3::_reduce( T& dest, const Source& src, Operator op )
+{
+    C3::_reduce_pixel( dest, src, op );
+    return dest;
+}
+
+// Column from Frame: rows in place.
+
+template< class T, class U, class Operator >
+inline C3::Column< T >& C3::_reduce( C3::Column< T >& dest, const C3::Frame< U >& src, Operator op )
+{
+    C3::_reduce_lines< U >( src.nrows(), src.ncolumns(), false,
+        [ & ]( const C3::size_type k ) -> T& { return dest( k ); },
+        [ & ]( const C3::size_type k, U* ) { return src.data() + src.pitch() * k; }, op );
+    return dest;
+}
+
+// Column from View: rows in place unless columns are strided.
+
+template< class T, class U, class Operator >
+inline C3::Column< T >& C3::_reduce( C3::Column< T >& dest, const C3::View< U >& src, Operator op )
+{
+    const bool gather = src.step() != 1;
+    C3::_reduce_lines< U >( src.nrows(), src.ncolumns(), gather,
+        [ & ]( const C3::size_type k ) -> T& { return dest( k ); },
+        [ & ]( const C3::size_type k, U* buffer ) -> const U*
+        {
+            if( ! gather ) return src.begin() + src.stride() * k;
+            for( C3::size_type j = 0; j < src.ncolumns(); ++j ) buffer[ j ] = src( j, k );
+            return buffer;
+        }, op );
+    return dest;
+}
+
+// Row from Frame: bands of columns to a column reduction, otherwise columns
+// gathered.
+
+template< class T, class U, class Operator >
+inline C3::Row< T >& C3::_reduce( C3::Row< T >& dest, const C3::Frame< U >& src, Operator op )
+{
+    if( C3::_reduce_column_bands( &dest( 0 ), src.data(), src.ncolumns(), src.nrows(), src.pitch(), op,
+                typename C3::_HasColumns< Operator, T, U >::type() ) ) return dest;
+    C3::_reduce_lines< U >( src.ncolumns(), src.nrows(), true,
+        [ & ]( const C3::size_type j ) -> T& { return dest( j ); },
+        [ & ]( const C3::size_type j, U* buffer ) -> const U*
+        {
+            for( C3::size_type k = 0; k < src.nrows(); ++k ) buffer[ k ] = src( j, k );
+            return buffer;
+        }, op );
+    return dest;
+}
+
+// Row from View: bands of columns to a column reduction if the view has no
+// column step, otherwise columns gathered.
+
+template< class T, class U, class Operator >
+inline C3::Row< T >& C3::_reduce( C3::Row< T >& dest, const C3::View< U >& src, Operator op )
+{
+    if( src.step() == 1 && C3::_reduce_column_bands( &dest( 0 ), src.begin(), src.ncolumns(), src.nrows(),
+                src.stride(), op, typename C3::_HasColumns< Operator, T, U >::type() ) ) return dest;
+    C3::_reduce_lines< U >( src.ncolumns(), src.nrows(), true,
+        [ & ]( const C3::size_type j ) -> T& { return dest( j ); },
+        [ & ]( const C3::size_type j, U* buffer ) -> const U*
+        {
+            for( C3::size_type k = 0; k < src.nrows(); ++k ) buffer[ k ] = src( j, k );
+            return buffer;
+        }, op );
+    return dest;
+}
+
+// Frame from Stack: whole rows to a batch operator or pixels in place if
+// interleaved, otherwise gathered.
+
+template< class T, class U, class Operator >
+inline C3::Frame< T >& C3::_reduce( C3::Frame< T >& dest, const C3::Stack< U >& src, Operator op )
+{
+    const bool gather = src.layout() != C3::StackLayout::INTERLEAVED;
+    if( ! gather && C3::_reduce_rows( src, [ & ]( const C3::size_type k ) { return &dest( 0, k ); }, op,
+                typename C3::_HasBatch< Operator, T, U >::type() ) ) return dest;
+    const auto ncolumns = src.ncolumns();
+    C3::_reduce_lines< U >( src.nrows() * ncolumns, src.nframes(), gather,
+        [ & ]( const C3::size_type n ) -> T& { return dest( n % ncolumns, n / ncolumns ); },
+        [ & ]( const C3::size_type n, U* buffer ) -> const U*
+        {
+            const auto j = n % ncolumns, k = n / ncolumns;
+            if( ! gather ) return src.data() + src.offset( 0, j, k );
+            for( C3::size_type i = 0; i < src.nframes(); ++i ) buffer[ i ] = src( i, j, k );
+            return buffer;
+        }, op );
+    return dest;
+}
+
+// View from Stack: whole rows to a batch operator or pixels in place if
+// interleaved and the view has no column step, otherwise gathered.
+
+template< class T, class U, class Operator >
+inline C3::View< T >& C3::_reduce( C3::View< T >& dest, const C3::Stack< U >& src, Operator op )
+{
+    const bool gather = src.layout() != C3::StackLayout::INTERLEAVED;
+    if( ! gather && dest.step() == 1 && C3::_reduce_rows( src, [ & ]( const C3::size_type k ) { return &dest( 0, k ); },
+                op, typename C3::_HasBatch< Operator, T, U >::type() ) ) return dest;
+    const auto ncolumns = src.ncolumns();
+    C3::_reduce_lines< U >( src.nrows() * ncolumns, src.nframes(), gather,
+        [ & ]( const C3::size_type n ) -> T& { return dest( n % ncolumns, n / ncolumns ); },
+        [ & ]( const C3::size_type n, U* buffer ) -> const U*
+        {
+            const auto j = n % ncolumns, k = n / ncolumns;
+            if( ! gather ) return src.data() + src.offset( 0, j, k );
+            for( C3::size_type i = 0; i < src.nframes(); ++i ) buffer[ i ] = src( i, j, k );
+            return buffer;
+        }, op );
+    return dest;
+}
+
+// Pixel Reduce Definitions
+// ------------------------
+
+// Pixel from Block, Column or Row, in place.
+
+template< class T, class U, class Operator >
+inline void C3::_reduce_pixel( T& dest, const C3::Block< U >& src, Operator op )
+{
+    op( dest, src.data(), src.data() + src.size() );
+}
+
+template< class T, class U, class Operator >
+inline void C3::_reduce_pixel( T& dest, const C3::Column< U >& src, Operator op )
+{
+    op( dest, src.data(), src.data() + src.size() );
+}
+
+template< class T, class U, class Operator >
+inline void C3::_reduce_pixel( T& dest, const C3::Row< U >& src, Operator op )
+{
+    op( dest, src.data(), src.data() + src.size() );
+}
+
+// Pixel from Frame, in place unless rows are padded.
+
+template< class T, class U, class Operator >
+inline void C3::_reduce_pixel( T& dest, const C3::Frame< U >& src, Operator op )
+{
+    if( src.pitch() == src.ncolumns() ) return op( dest, src.data(), src.data() + src.size() );
+    C3::Frame< U > packed( src.ncolumns(), src.nrows() );
+    C3::assign( packed, src );
+    op( dest, packed.data(), packed.data() + packed.size() );
+}
+
+// Pixel from View, copied into a packed Frame.
+
+template< class T, class U, class Operator >
+inline void C3::_reduce_pixel( T& dest, const C3::View< U >& src, Operator op )
+{
+    C3::Frame< U > packed( src.ncolumns(), src.nrows() );
+    C3::assign( packed, src );
+    op( dest, packed.data(), packed.data() + packed.size() );
+}
+
+// Pixel from Stack, in place unless tiled rows are padded.
+
+template< class T, class U, class Operator >
+inline void C3::_reduce_pixel( T& dest, const C3::Stack< U >& src, Operator op )
+{
+    if( src.size() == src.nframes() * src.ncolumns() * src.nrows() )
+    {
+        return op( dest, src.data(), src.data() + src.size() );
+    }
+    C3::Stack< U > packed( src.nframes(), src.ncolumns(), src.nrows() );
+    C3::assign( packed, src );
+    op( dest, packed.data(), packed.data() + packed.size() );
+}
+
+// Reduce Pattern Definition
+// -------------------------
+
+template< class U, class Destination, class Line, class Operator >
+inline void C3::_reduce_lines( const C3::size_type count, const C3::size_type length, const bool gather,
+        Destination dest, Line line, Operator op )
+{
+    using T = typename std::remove_reference< decltype( dest( 0 ) ) >::type;
+    C3::detail::_parallel_for( count, count * length, C3::detail::_grain< T >(),
+        [ & ]( const C3::size_type first, const C3::size_type last )
+        {
+            C3::Block< U > buffer( gather ? length : 0 );
+            for( auto n = first; n < last; ++n )
+            {
+                const U* begin = line( n, buffer.data() );
+                op( dest( n ), begin, begin + length );
+            }
+        } );
+}
+
+// Batch reduction detection.
+
+template< class Operator, class T, class U >
+struct C3::_HasBatch
+{
+
+    template< class O >
+    static auto test( int ) -> decltype( std::declval< const O& >().batch( std::declval< T* >(),
+            std::declval< const U* >(), C3::size_type(), C3::size_type() ), std::true_type() );
+
+    template< class O >
+    static std::false_type test( ... );
+
+    using type = decltype( test< Operator >( 0 ) );
+    static const bool value = type::value;
+
+};
+
+// Rows of an interleaved stack to a batch reduction.
+
+template< class U, class Destination, class Operator >
+inline bool C3::_reduce_rows( const C3::Stack< U >& src, Destination dest, Operator op, std::true_type )
+{
+    const auto length = src.ncolumns() * src.nframes();
+    C3::detail::_parallel_for( src.nrows(), src.nrows() * length, 1,
+        [ & ]( const C3::size_type first, const C3::size_type last )
+        {
+            for( auto k = first; k < last; ++k )
+            {
+                op.batch( dest( k ), src.data() + src.offset( 0, 0, k ), src.ncolumns(), src.nframes() );
+            }
+        } );
+    return true;
+}
+
+template< class U, class Destination, class Operator >
+inline bool C3::_reduce_rows( const C3::Stack< U >&, Destination, Operator, std::false_type )
+{
+    return false;
+}
+
+// Column reduction detection.
+
+template< class Operator, class T, class U >
+struct C3::_HasColumns
+{
+
+    template< class O >
+    static auto test( int ) -> decltype( std::declval< const O& >().columns( std::declval< T* >(),
+            std::declval< const U* >(), C3::size_type(), C3::size_type(), C3::size_type() ), std::true_type() );
+
+    template< class O >
+    static std::false_type test( ... );
+
+    using type = decltype( test< Operator >( 0 ) );
+    static const bool value = type::value;
+
+};
+
+// Bands of columns to a column reduction, bands starting on whole tiles.
+
+template< class T, class U, class Operator >
+inline bool C3::_reduce_column_bands( T* dest, const U* src, const C3::size_type ncolumns, const C3::size_type nrows,
+        const C3::size_type stride, Operator op, std::true_type )
+{
+    C3::detail::_parallel_for( ncolumns, ncolumns * nrows, C3::_reduce_tile,
+        [ & ]( const C3::size_type first, const C3::size_type last )
+        {
+            op.columns( dest + first, src + first, last - first, nrows, stride );
+        } );
+    return true;
+}
+
+template< class T, class U, class Operator >
+inline bool C3::_reduce_column_bands( T*, const U*, const C3::size_type, const C3::size_type, const C3::size_type,
+        Operator, std::false_type )
+{
+    return false;
+}
+
+// Range Reduction Definitions
+// ---------------------------
+
+// Range, one block directly or blocks over threads and then their results.
+
+template< class T, class U, class Transform, class Combine >
+inline T C3::_reduce_range( const U* begin, const U* end, Transform transform, Combine combine )
+{
+    const C3::size_type length = end - begin;
+    if( length <= C3::_reduce_block_size ) return C3::_reduce_block< T >( begin, length, transform, combine );
+    const auto nblocks = ( length + C3::_reduce_block_size - 1 ) / C3::_reduce_block_size;
+    C3::Block< T > partials( nblocks );
+    C3::detail::_parallel_for( nblocks, length, C3::detail::_grain< T >(),
+        [ & ]( const C3::size_type first, const C3::size_type last )
+        {
+            for( auto b = first; b < last; ++b )
+            {
+                const auto offset = C3::_reduce_block_size * b;
+                partials[ b ] = C3::_reduce_block< T >( begin + offset,
+                        std::min( C3::_reduce_block_size, length - offset ), transform, combine );
+            }
+        } );
+    return C3::_reduce_range< T >( partials.data(), partials.data() + nblocks, C3::_ToValue< T >(), combine );
+}
+
+// Block, dispatched.
+
+template< class T, class U, class Transform, class Combine >
+inline T C3::_reduce_block( const U* src, const C3::size_type length, Transform transform, Combine combine )
+{
+#ifdef C3_SIMD_X86
+    switch( C3::isa() )
+    {
+        case C3::Isa::AVX512 : return C3::_vector_reduce_block< T >( C3::detail::Avx512(), src, length, transform,
+                                       combine );
+        case C3::Isa::AVX2   : return C3::_vector_reduce_block< T >( C3::detail::Avx2()  , src, length, transform,
+                                       combine );
+        default              : break;
+    }
+#endif
+    return C3::_scalar_reduce_block< T >( src, length, transform, combine );
+}
+
+template< class T, class U, class Transform, class Combine >
+C3_NO_FP_CONTRACT inline T C3::_scalar_reduce_block( const U* src, const C3::size_type length, Transform transform,
+        Combine combine )
+{
+    return C3::_fold_block< T >( src, length, transform, combine );
+}
+
+#ifdef C3_SIMD_X86
+
+template< class T, class U, class Transform, class Combine >
+C3_TARGET_AVX2 inline T C3::_vector_reduce_block( C3::detail::Avx2, const U* src, const C3::size_type length,
+        Transform transform, Combine combine )
+{
+    return C3::_fold_block< T >( src, length, transform, combine );
+}
+
+template< class T, class U, class Transform, class Combine >
+C3_TARGET_AVX512 inline T C3::_vector_reduce_block( C3::detail::Avx512, const U* src, const C3::size_type length,
+        Transform transform, Combine combine )
+{
+    return C3::_fold_block< T >( src, length, transform, combine );
+}
+
+#endif
+
+// Block body: whole rounds of lanes, what is left over into the first lanes,
+// then lanes combined pairwise.
+
+template< class T, class U, class Transform, class Combine >
+C3_SHARED_BODY inline T C3::_fold_block( const U* src, const C3::size_type length, Transform transform,
+        Combine combine )
+{
+    const auto nlanes = C3::_reduce_lanes;
+    const T start = combine.start( transform( src[ 0 ] ) );
+    T lanes[ nlanes ];
+    for( C3::size_type l = 0; l < nlanes; ++l ) lanes[ l ] = start;
+    const auto whole = length - length % nlanes;
+    for( C3::size_type i = 0; i < whole; i += nlanes )
+    {
+        for( C3::size_type l = 0; l < nlanes; ++l ) lanes[ l ] = combine( lanes[ l ], transform( src[ i + l ] ) );
+    }
+    for( C3::size_type i = whole; i < length; ++i )
+    {
+        lanes[ i - whole ] = combine( lanes[ i - whole ], transform( src[ i ] ) );
+    }
+    for( C3::size_type width = nlanes / 2; width > 0; width /= 2 )
+    {
+        for( C3::size_type l = 0; l < width; ++l ) lanes[ l ] = combine( lanes[ l ], lanes[ l + width ] );
+    }
+    return lanes[ 0 ];
+}
+
+// Column Reduction Definitions
+// ----------------------------
+
+// Columns, a tile at a time.
+
+template< class T, class U, class Transform, class Combine >
+inline void C3::_reduce_columns( T* dest, const U* src, const C3::size_type ncolumns, const C3::size_type nrows,
+        const C3::size_type stride, Transform transform, Combine combine )
+{
+    for( C3::size_type first = 0; first < ncolumns; first += C3::_reduce_tile )
+    {
+        C3::_reduce_column_tile( dest + first, src + first, first, std::min( C3::_reduce_tile, ncolumns - first ),
+                nrows, stride, transform, combine );
+    }
+}
+
+// Tile, one block of rows directly or blocks and then their results, as in
+// _reduce_range().
+
+template< class T, class U, class Transform, class Combine >
+inline void C3::_reduce_column_tile( T* dest, const U* src, const C3::size_type first, const C3::size_type ncolumns,
+        const C3::size_type nrows, const C3::size_type stride, Transform transform, Combine combine )
+{
+    if( nrows <= C3::_reduce_block_size )
+    {
+        C3::_reduce_column_block( dest, src, first, ncolumns, nrows, stride, transform, combine );
+        return;
+    }
+    const auto nblocks = ( nrows + C3::_reduce_block_size - 1 ) / C3::_reduce_block_size;
+    C3::Block< T > partials( nblocks * ncolumns );
+    for( C3::size_type b = 0; b < nblocks; ++b )
+    {
+        const auto offset = C3::_reduce_block_size * b;
+        C3::_reduce_column_block( partials.data() + ncolumns * b, src + stride * offset, first, ncolumns,
+                std::min( C3::_reduce_block_size, nrows - offset ), stride, transform, combine );
+    }
+    C3::_reduce_column_tile( dest, partials.data(), 0, ncolumns, nblocks, ncolumns, C3::_ToValue< T >(), combine );
+}
+
+// Column block, dispatched.
+
+template< class T, class U, class Transform, class Combine >
+inline void C3::_reduce_column_block( T* dest, const U* src, const C3::size_type first, const C3::size_type ncolumns,
+        const C3::size_type nrows, const C3::size_type stride, Transform transform, Combine combine )
+{
+#ifdef C3_SIMD_X86
+    switch( C3::isa() )
+    {
+        case C3::Isa::AVX512 : C3::_vector_reduce_column_block( C3::detail::Avx512(), dest, src, first, ncolumns,
+                                       nrows, stride, transform, combine );
+                               return;
+        case C3::Isa::AVX2   : C3::_vector_reduce_column_block( C3::detail::Avx2()  , dest, src, first, ncolumns,
+                                       nrows, stride, transform, combine );
+                               return;
+        default              : break;
+    }
+#endif
+    C3::_scalar_reduce_column_block( dest, src, first, ncolumns, nrows, stride, transform, combine );
+}
+
+template< class T, class U, class Transform, class Combine >
+C3_NO_FP_CONTRACT inline void C3::_scalar_reduce_column_block( T* dest, const U* src, const C3::size_type first,
+        const C3::size_type ncolumns, const C3::size_type nrows, const C3::size_type stride, Transform transform,
+        Combine combine )
+{
+    C3::_fold_columns( dest, src, first, ncolumns, nrows, stride, transform, combine );
+}
+
+#ifdef C3_SIMD_X86
+
+template< class T, class U, class Transform, class Combine >
+C3_TARGET_AVX2 inline void C3::_vector_reduce_column_block( C3::detail::Avx2, T* dest, const U* src,
+        const C3::size_type first, const C3::size_type ncolumns, const C3::size_type nrows,
+        const C3::size_type stride, Transform transform, Combine combine )
+{
+    C3::_fold_columns( dest, src, first, ncolumns, nrows, stride, transform, combine );
+}
+
+template< class T, class U, class Transform, class Combine >
+C3_TARGET_AVX512 inline void C3::_vector_reduce_column_block( C3::detail::Avx512, T* dest, const U* src,
+        const C3::size_type first, const C3::size_type ncolumns, const C3::size_type nrows,
+        const C3::size_type stride, Transform transform, Combine combine )
+{
+    C3::_fold_columns( dest, src, first, ncolumns, nrows, stride, transform, combine );
+}
+
+#endif
+
+// Column block body.  Row i goes into lane i modulo the number of lanes,
+// which is where _fold_block() puts pixel i, tail included, before the same
+// tree combines the lanes.
+
+template< class T, class U, class Transform, class Combine >
+C3_SHARED_BODY inline void C3::_fold_columns( T* dest, const U* src, const C3::size_type first,
+        const C3::size_type ncolumns, const C3::size_type nrows, const C3::size_type stride, Transform transform,
+        Combine combine )
+{
+    const auto nlanes = C3::_reduce_lanes;
+    T lanes[ nlanes ][ C3::_reduce_tile ];
+    for( C3::size_type j = 0; j < ncolumns; ++j )
+    {
+        const T start = combine.start( transform( src[ j ], first + j ) );
+        for( C3::size_type l = 0; l < nlanes; ++l ) lanes[ l ][ j ] = start;
+    }
+    for( C3::size_type i = 0; i < nrows; ++i )
+    {
+        const U* row  = src + stride * i;
+        T*       lane = lanes[ i % nlanes ];
+        for( C3::size_type j = 0; j < ncolumns; ++j )
+        {
+            lane[ j ] = combine( lane[ j ], transform( row[ j ], first + j ) );
+        }
+    }
+    for( C3::size_type width = nlanes / 2; width > 0; width /= 2 )
+    {
+        for( C3::size_type l = 0; l < width; ++l )
+        {
+            for( C3::size_type j = 0; j < ncolumns; ++j )
+            {
+                lanes[ l ][ j ] = combine( lanes[ l ][ j ], lanes[ l + width ][ j ] );
+            }
+        }
+    }
+    for( C3::size_type j = 0; j < ncolumns; ++j ) dest[ j ] = lanes[ 0 ][ j ];
+}
+
+// Transforms.
+
+template< class T >
+template< class U >
+inline T C3::_ToValue< T >::operator () ( const U src ) const
+{
+    return static_cast< T >( src );
+}
+
+template< class T >
+template< class U >
+inline T C3::_ToValue< T >::operator () ( const U src, const C3::size_type ) const
+{
+    return static_cast< T >( src );
+}
+
+template< class T >
+template< class U >
+inline T C3::_SquaredDeviation< T >::operator () ( const U src ) const
+{
+    const T deviation = static_cast< T >( src ) - center;
+    return deviation * deviation;
+}
+
+template< class T >
+template< class U >
+inline T C3::_SquaredDeviations< T >::operator () ( const U src, const C3::size_type j ) const
+{
+    const T deviation = static_cast< T >( src ) - centers[ j ];
+    return deviation * deviation;
+}
+
+// Combines.
+
+template< class T >
+inline T C3::_Add< T >::start( const T ) const
+{
+    return T( 0 );
+}
+
+template< class T >
+inline T C3::_Add< T >::operator () ( const T lhs, const T rhs ) const
+{
+    return lhs + rhs;
+}
+
+template< class T >
+inline T C3::_Lesser< T >::start( const T first ) const
+{
+    return first;
+}
+
+template< class T >
+inline T C3::_Lesser< T >::operator () ( const T lhs, const T rhs ) const
+{
+    return C3::_select( rhs < lhs, rhs, lhs );
+}
+
+template< class T >
+inline T C3::_Greater< T >::start( const T first ) const
+{
+    return first;
+}
+
+template< class T >
+inline T C3::_Greater< T >::operator () ( const T lhs, const T rhs ) const
+{
+    return C3::_select( lhs < rhs, rhs, lhs );
+}
@@ -2,17 +2,24 @@
 // Constructor.
 
 template< class T >
-inline C3::Row< T >::Row( const C3::size_type ncolumns ) noexcept : 
+inline C3::Row< T >::Row( const C3::size_type ncolumns ) : 
     C3::Block< T >( ncolumns ) 
 {}
 
 // Initializing constructor.
 
 template< class T >
-inline C3::Row< T >::Row( const C3::size_type ncolumns, const T pixel ) noexcept : 
+inline C3::Row< T >::Row( const C3::size_type ncolumns, const T pixel ) : 
     C3::Block< T >( ncolumns, pixel ) 
 {}
 
+// Adopting constructor.
+
+template< class T >
+inline C3::Row< T >::Row( T* data, const C3::size_type ncolumns ) noexcept : 
+    C3::Block< T >( data, ncolumns ) 
+{}
+
 // Pixel assignment.
 
 template< class T >
@@ -21,11 +28,20 @@ inline C3::Row< T >& C3::Row< T >::operator = ( const T pixel ) noexcept
     return C3::assign( *this, pixel );
 }
 
+// Expression assignment.
+
+template< class T >
+template< class Node >
+inline C3::Row< T >& C3::Row< T >::operator = ( const C3::Expression< Node >& src )
+{
+    return C3::assign( *this, src );
+}
+
 // Value type conversion.
 
 template< class T >
 template< class U >
-inline C3::Row< T >::operator C3::Row< U >() const noexcept
+inline C3::Row< T >::operator C3::Row< U >() const
 {
     C3::Row< U > row( ncolumns() );
     return C3::assign( row, *this );
@@ -5,6 +5,7 @@
 #include "../C3_FileLogger.hh"
 #include "../C3_FitsCreator.hh"
 #include "../C3_FitsLoader.hh"
+#include "../C3_MaskedFrame.hh"
 #include "../C3_Frame.hh"
 #include "../C3_StandardLogger.hh"
 
@@ -21,6 +22,7 @@ inline void C3::Serial< InstrumentTraits >::init( int& argc, char**& argv )
     _validate_frame();
     _init_logger();
     _init_task_queue( argc, argv );
+    _init_pool();
 
     logger().info( "Serial context initialization complete." );
 
@@ -32,6 +34,15 @@ template< class InstrumentTraits >
 inline int C3::Serial< InstrumentTraits >::finalize() 
 { 
     logger().info( "Serial context finalizing." );
+    auto statistics = pool().statistics();
+    logger().info( "Buffer pool hits / misses :", statistics.hits, "/", statistics.misses );
+    if( _huge_pages )
+    {
+        auto pages = _huge_pages->statistics();
+        logger().info( "Huge page reserved / transparent / fallback :", pages.reserved, "/", pages.transparent, "/", 
+                pages.fallbacks );
+    }
+    C3::select_memory_resource( nullptr );
     logger().info( "Goodbye!" );
     return EXIT_SUCCESS; 
 }
@@ -83,6 +94,22 @@ inline void C3::Serial< InstrumentTraits >::load( C3::Frame< T >& input, const s
 
 }
 
+// Load masked frame planes.
+
+template< class InstrumentTraits >
+template< class T, class F >
+inline void C3::Serial< InstrumentTraits >::load( C3::MaskedFrame< T, F >& input, const std::string& path )
+{
+
+    logger().debug( "Loading masked frame", frame(), "from", path, "[START]" );
+
+    C3::FitsLoader loader( path );
+    loader.load( input, frame() );
+
+    logger().debug( "Loading masked frame", frame(), "from", path, "[DONE]" );
+
+}
+
 // Save unconverted frame.
 
 template< class InstrumentTraits >
@@ -105,10 +132,10 @@ inline void C3::Serial< InstrumentTraits >::save( C3::Frame< U >& output, const
 
     int  naxis = 2;
     long naxes[ 2 ] { output.ncolumns(), output.nrows() };
-    creator.create< T, U >( output.block(), frame(), naxis, naxes );
+    creator.create< T, U >( output, frame(), naxis, naxes );
 
     logger().debug( "Saving frame", frame(), "to", path, "[DONE]" );
-    logger().debug( "Output", output.block().size(), "pixels,", output.ncolumns(), "columns x", output.nrows() );
+    logger().debug( "Output", output.ncolumns() * output.nrows(), "pixels,", output.ncolumns(), "columns x", output.nrows() );
 }
 
 // Save frame tuple without conversion of output and inverse variance.
@@ -138,7 +165,41 @@ inline void C3::Serial< InstrumentTraits >::save( C3::Frame< U >& output, C3::Fr
     creator.create        (  flags, frame() + "_FLAGS" , naxis, naxes );
 
     logger().debug( "Saving frame tuple", frame(), "to", path, "[DONE]" );
-    logger().debug( "Output 3 x", output.size(), "pixels, each", output.ncolumns(), "columns x", output.nrows(), "rows" );
+    logger().debug( "Output 3 x", output.ncolumns() * output.nrows(), "pixels, each", output.ncolumns(), "columns x", output.nrows(), "rows" );
+
+}
+
+// Save masked frame planes without conversion.
+
+template< class InstrumentTraits >
+template< class T, class F >
+inline void C3::Serial< InstrumentTraits >::save( C3::MaskedFrame< T, F >& output, const std::string& path )
+{
+    save< T, T, F >( output, path );
+}
+
+// Save masked frame planes with conversion of data and inverse variance.
+
+template< class InstrumentTraits >
+template< class T, class U, class F >
+inline void C3::Serial< InstrumentTraits >::save( C3::MaskedFrame< U, F >& output, const std::string& path )
+{
+    save< T, U, F >( output.data(), output.invvar(), output.flags(), path );
+}
+
+// Blocks allocate from the context's buffer pool from now on, so frames
+// built for every task recycle storage of the previous task.  With
+// huge_pages in the config ("transparent" or "reserved"; "off" is the
+// default), the pool takes new buffers from huge pages.
+
+template< class InstrumentTraits >
+inline void C3::Serial< InstrumentTraits >::_init_pool()
+{
+
+    auto huge_pages = _config[ "huge_pages" ] ? _config[ "huge_pages" ].template as< std::string >() : "off";
+    _pool = C3::context_pool( huge_pages, _huge_pages );
+    C3::select_memory_resource( _pool.get() );
+    logger().debug( "Block storage from buffer pool, huge pages:", huge_pages );
 
 }
 
@@ -0,0 +1,167 @@
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+#include "../C3_Math.hh"
+
+// Internal declarations
+
+namespace C3
+{
+
+    // Statistics of the pixels kept by clipping.
+
+    template< class R >
+    struct _Clipped
+    {
+        R   mean;
+        R   median;
+    };
+
+    // Clip pixels first to last in place, leaving the pixels kept between the pixels left out below and above.
+
+    template< class R, class U >
+    _Clipped< R > _sigma_clip( U* first, U* last, const double nsigma, const size_type iterations );
+
+    // Sums of the deviations of first to last from shift and of their squares.
+
+    template< class U >
+    void _clip_sums( double& sum, double& squares, const U* first, const U* last, const double shift );
+
+    // Median of first to last, selected in place.  Gives the position of the upper middle pixel, with pixels no
+    // greater before it and no lesser after it.
+
+    template< class R, class U >
+    U* _clip_median( U* first, U* last, R& median );
+
+    // Copy of a range in a buffer kept per thread.
+
+    template< class U >
+    std::vector< U >& _clip_buffer( const U* begin, const U* end );
+
+}
+
+// Constructor.
+
+inline C3::SigmaClip::SigmaClip( const double nsigma, const C3::size_type iterations ) :
+    nsigma( nsigma ), iterations( iterations )
+{
+    assert( nsigma > 0.0 );
+}
+
+// Clipped mean.
+
+template< class T, class U >
+inline void C3::ClippedMean::operator () ( T& dest, const U* begin, const U* end ) const
+{
+    assert( begin < end );
+    using R = typename C3::_Real< T >::type;
+    auto& buffer = C3::_clip_buffer( begin, end );
+    dest = static_cast< T >( C3::_sigma_clip< R >( buffer.data(), buffer.data() + buffer.size(), nsigma,
+                iterations ).mean );
+}
+
+// Clipped median.
+
+template< class T, class U >
+inline void C3::ClippedMedian::operator () ( T& dest, const U* begin, const U* end ) const
+{
+    assert( begin < end );
+    using R = typename C3::_Real< T >::type;
+    auto& buffer = C3::_clip_buffer( begin, end );
+    dest = static_cast< T >( C3::_sigma_clip< R >( buffer.data(), buffer.data() + buffer.size(), nsigma,
+                iterations ).median );
+}
+
+// Clipping passes.  Pixels below the median are no greater than the upper
+// middle pixel, so only those before it can fall below the lower bound, and
+// only those from it on can rise above the upper bound unless the bound is
+// below it.  Sums are in double of deviations from the first median, and are
+// taken again over the window kept when the pixels left out made up most of
+// the sum of squares.
+
+template< class R, class U >
+inline C3::_Clipped< R > C3::_sigma_clip( U* first, U* last, const double nsigma, const C3::size_type iterations )
+{
+    R median;
+    auto middle = C3::_clip_median( first, last, median );
+    const double shift = static_cast< double >( median );
+    double sum, squares;
+    C3::_clip_sums( sum, squares, first, last, shift );
+
+    for( C3::size_type iteration = 0; iteration < iterations && last - first > 1; ++iteration )
+    {
+        const double n      = static_cast< double >( last - first );
+        const double sigma  = std::sqrt( std::max( 0.0, ( squares - sum * sum / n ) / ( n - 1.0 ) ) );
+        const double lower  = static_cast< double >( median ) - nsigma * sigma;
+        const double upper  = static_cast< double >( median ) + nsigma * sigma;
+
+        auto kept_first = std::partition( first, middle,
+                [ & ]( const U x ) { return static_cast< double >( x ) < lower; } );
+        auto from = static_cast< double >( *middle ) <= upper ? middle : kept_first;
+        auto kept_last = std::partition( from, last,
+                [ & ]( const U x ) { return static_cast< double >( x ) <= upper; } );
+        if( kept_first == first && kept_last == last ) break;
+
+        double removed_sum, removed_squares, above_sum, above_squares;
+        C3::_clip_sums( removed_sum, removed_squares, first, kept_first, shift );
+        C3::_clip_sums( above_sum, above_squares, kept_last, last, shift );
+        removed_sum     += above_sum;
+        removed_squares += above_squares;
+        first = kept_first;
+        last  = kept_last;
+        if( first == last ) break;
+        if( removed_squares > 0.5 * squares )
+        {
+            C3::_clip_sums( sum, squares, first, last, shift );
+        }
+        else
+        {
+            sum     -= removed_sum;
+            squares -= removed_squares;
+        }
+        middle = C3::_clip_median( first, last, median );
+    }
+
+    return C3::_Clipped< R >{ first == last ? median
+        : static_cast< R >( shift + sum / static_cast< double >( last - first ) ), median };
+}
+
+// Sums of deviations and their squares.
+
+template< class U >
+inline void C3::_clip_sums( double& sum, double& squares, const U* first, const U* last, const double shift )
+{
+    sum = squares = 0.0;
+    for( auto p = first; p != last; ++p )
+    {
+        const double deviation = static_cast< double >( *p ) - shift;
+        sum     += deviation;
+        squares += deviation * deviation;
+    }
+}
+
+// Median selected in place.
+
+template< class R, class U >
+inline U* C3::_clip_median( U* first, U* last, R& median )
+{
+    const auto n = last - first;
+    const auto middle = first + n / 2;
+    std::nth_element( first, middle, last );
+    median = n % 2 ? static_cast< R >( *middle )
+        : ( static_cast< R >( *std::max_element( first, middle ) ) + static_cast< R >( *middle ) ) / R( 2 );
+    return middle;
+}
+
+// Buffer per thread.
+
+template< class U >
+inline std::vector< U >& C3::_clip_buffer( const U* begin, const U* end )
+{
+    static thread_local std::vector< U > buffer;
+    buffer.assign( begin, end );
+    return buffer;
+}
@@ -0,0 +1,309 @@
+
+#include <cctype>
+#include <cstdlib>
+#include <type_traits>
+
+#ifdef C3_SIMD_X86
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+namespace C3
+{
+
+    namespace detail
+    {
+
+        // Instruction set detection and current selection.
+
+        Isa _detect_isa();
+        Isa _initial_isa();
+        Isa& _isa();
+
+#ifdef C3_SIMD_X86
+
+        // Instruction set tags used to select vector kernel overloads.
+
+        struct Avx2   {};
+        struct Avx512 {};
+
+        /// A Pack wraps one vector register worth of pixels of value type T
+        /// for a given instruction set: loads (converting from other value
+        /// types where the instruction set can do it in registers), stores,
+        /// broadcasts, and arithmetic.  The primary template is empty.  Value
+        /// types without a specialization, and load conversions not listed,
+        /// are simply not vectorized and kernels use their scalar versions.
+
+        template< class Target, class T >
+        struct Pack {};
+
+        // AVX2 double.
+
+        template<>
+        struct Pack< Avx2, double >
+        {
+            using type = __m256d;
+            static constexpr size_type width = 4;
+            C3_TARGET_AVX2 static type load( const double* p ) { return _mm256_loadu_pd( p ); }
+            C3_TARGET_AVX2 static type load( const float*  p ) { return _mm256_cvtps_pd( _mm_loadu_ps( p ) ); }
+            C3_TARGET_AVX2 static type load( const int*    p )
+                { return _mm256_cvtepi32_pd( _mm_loadu_si128( reinterpret_cast< const __m128i* >( p ) ) ); }
+            C3_TARGET_AVX2 static void store( double* p, const type v ) { _mm256_storeu_pd( p, v ); }
+            C3_TARGET_AVX2 static type broadcast( const double x ) { return _mm256_set1_pd( x ); }
+            C3_TARGET_AVX2 static type add( const type a, const type b ) { return _mm256_add_pd( a, b ); }
+            C3_TARGET_AVX2 static type sub( const type a, const type b ) { return _mm256_sub_pd( a, b ); }
+            C3_TARGET_AVX2 static type mul( const type a, const type b ) { return _mm256_mul_pd( a, b ); }
+            C3_TARGET_AVX2 static type div( const type a, const type b ) { return _mm256_div_pd( a, b ); }
+        };
+
+        // AVX2 float.
+
+        template<>
+        struct Pack< Avx2, float >
+        {
+            using type = __m256;
+            static constexpr size_type width = 8;
+            C3_TARGET_AVX2 static type load( const float*  p ) { return _mm256_loadu_ps( p ); }
+            C3_TARGET_AVX2 static type load( const double* p )
+            {
+                const __m128 lo = _mm256_cvtpd_ps( _mm256_loadu_pd( p     ) );
+                const __m128 hi = _mm256_cvtpd_ps( _mm256_loadu_pd( p + 4 ) );
+                return _mm256_insertf128_ps( _mm256_castps128_ps256( lo ), hi, 1 );
+            }
+            C3_TARGET_AVX2 static type load( const int*    p )
+                { return _mm256_cvtepi32_ps( _mm256_loadu_si256( reinterpret_cast< const __m256i* >( p ) ) ); }
+            C3_TARGET_AVX2 static void store( float* p, const type v ) { _mm256_storeu_ps( p, v ); }
+            C3_TARGET_AVX2 static type broadcast( const float x ) { return _mm256_set1_ps( x ); }
+            C3_TARGET_AVX2 static type add( const type a, const type b ) { return _mm256_add_ps( a, b ); }
+            C3_TARGET_AVX2 static type sub( const type a, const type b ) { return _mm256_sub_ps( a, b ); }
+            C3_TARGET_AVX2 static type mul( const type a, const type b ) { return _mm256_mul_ps( a, b ); }
+            C3_TARGET_AVX2 static type div( const type a, const type b ) { return _mm256_div_ps( a, b ); }
+        };
+
+        // AVX2 int.  Conversions from floating point truncate toward zero, as
+        // C++ conversions do.  There is no vector integer division.
+
+        template<>
+        struct Pack< Avx2, int >
+        {
+            using type = __m256i;
+            static constexpr size_type width = 8;
+            C3_TARGET_AVX2 static type load( const int*    p )
+                { return _mm256_loadu_si256( reinterpret_cast< const __m256i* >( p ) ); }
+            C3_TARGET_AVX2 static type load( const float*  p ) { return _mm256_cvttps_epi32( _mm256_loadu_ps( p ) ); }
+            C3_TARGET_AVX2 static type load( const double* p )
+            {
+                const __m128i lo = _mm256_cvttpd_epi32( _mm256_loadu_pd( p     ) );
+                const __m128i hi = _mm256_cvttpd_epi32( _mm256_loadu_pd( p + 4 ) );
+                return _mm256_inserti128_si256( _mm256_castsi128_si256( lo ), hi, 1 );
+            }
+            C3_TARGET_AVX2 static void store( int* p, const type v )
+                { _mm256_storeu_si256( reinterpret_cast< __m256i* >( p ), v ); }
+            C3_TARGET_AVX2 static type broadcast( const int x ) { return _mm256_set1_epi32( x ); }
+            C3_TARGET_AVX2 static type add( const type a, const type b ) { return _mm256_add_epi32( a, b ); }
+            C3_TARGET_AVX2 static type sub( const type a, const type b ) { return _mm256_sub_epi32( a, b ); }
+            C3_TARGET_AVX2 static type mul( const type a, const type b ) { return _mm256_mullo_epi32( a, b ); }
+        };
+
+        // AVX-512 double.  Conversions and inserts use the zero-masking forms
+        // with every lane selected: the unmasked intrinsics pass an undefined
+        // source through, which GCC reports as maybe uninitialized.
+
+        template<>
+        struct Pack< Avx512, double >
+        {
+            using type = __m512d;
+            static constexpr size_type width = 8;
+            C3_TARGET_AVX512 static type load( const double* p ) { return _mm512_loadu_pd( p ); }
+            C3_TARGET_AVX512 static type load( const float*  p ) { return _mm512_maskz_cvtps_pd( 0xff, _mm256_loadu_ps( p ) ); }
+            C3_TARGET_AVX512 static type load( const int*    p )
+                { return _mm512_maskz_cvtepi32_pd( 0xff, _mm256_loadu_si256( reinterpret_cast< const __m256i* >( p ) ) ); }
+            C3_TARGET_AVX512 static void store( double* p, const type v ) { _mm512_storeu_pd( p, v ); }
+            C3_TARGET_AVX512 static type broadcast( const double x ) { return _mm512_set1_pd( x ); }
+            C3_TARGET_AVX512 static type add( const type a, const type b ) { return _mm512_add_pd( a, b ); }
+            C3_TARGET_AVX512 static type sub( const type a, const type b ) { return _mm512_sub_pd( a, b ); }
+            C3_TARGET_AVX512 static type mul( const type a, const type b ) { return _mm512_mul_pd( a, b ); }
+            C3_TARGET_AVX512 static type div( const type a, const type b ) { return _mm512_div_pd( a, b ); }
+        };
+
+        // AVX-512 float.
+
+        template<>
+        struct Pack< Avx512, float >
+        {
+            using type = __m512;
+            static constexpr size_type width = 16;
+            C3_TARGET_AVX512 static type load( const float*  p ) { return _mm512_loadu_ps( p ); }
+            C3_TARGET_AVX512 static type load( const double* p )
+            {
+                const __m256 lo = _mm512_maskz_cvtpd_ps( 0xff, _mm512_loadu_pd( p     ) );
+                const __m256 hi = _mm512_maskz_cvtpd_ps( 0xff, _mm512_loadu_pd( p + 8 ) );
+                return _mm512_castpd_ps( _mm512_maskz_insertf64x4( 0xff,
+                            _mm512_castpd256_pd512( _mm256_castps_pd( lo ) ), _mm256_castps_pd( hi ), 1 ) );
+            }
+            C3_TARGET_AVX512 static type load( const int*    p )
+                { return _mm512_maskz_cvtepi32_ps( 0xffff, _mm512_loadu_si512( p ) ); }
+            C3_TARGET_AVX512 static void store( float* p, const type v ) { _mm512_storeu_ps( p, v ); }
+            C3_TARGET_AVX512 static type broadcast( const float x ) { return _mm512_set1_ps( x ); }
+            C3_TARGET_AVX512 static type add( const type a, const type b ) { return _mm512_add_ps( a, b ); }
+            C3_TARGET_AVX512 static type sub( const type a, const type b ) { return _mm512_sub_ps( a, b ); }
+            C3_TARGET_AVX512 static type mul( const type a, const type b ) { return _mm512_mul_ps( a, b ); }
+            C3_TARGET_AVX512 static type div( const type a, const type b ) { return _mm512_div_ps( a, b ); }
+        };
+
+        // AVX-512 int.
+
+        template<>
+        struct Pack< Avx512, int >
+        {
+            using type = __m512i;
+            static constexpr size_type width = 16;
+            C3_TARGET_AVX512 static type load( const int*    p ) { return _mm512_loadu_si512( p ); }
+            C3_TARGET_AVX512 static type load( const float*  p )
+                { return _mm512_maskz_cvttps_epi32( 0xffff, _mm512_loadu_ps( p ) ); }
+            C3_TARGET_AVX512 static type load( const double* p )
+            {
+                const __m256i lo = _mm512_maskz_cvttpd_epi32( 0xff, _mm512_loadu_pd( p     ) );
+                const __m256i hi = _mm512_maskz_cvttpd_epi32( 0xff, _mm512_loadu_pd( p + 8 ) );
+                return _mm512_maskz_inserti64x4( 0xff, _mm512_castsi256_si512( lo ), hi, 1 );
+            }
+            C3_TARGET_AVX512 static void store( int* p, const type v ) { _mm512_storeu_si512( p, v ); }
+            C3_TARGET_AVX512 static type broadcast( const int x ) { return _mm512_set1_epi32( x ); }
+            C3_TARGET_AVX512 static type add( const type a, const type b ) { return _mm512_add_epi32( a, b ); }
+            C3_TARGET_AVX512 static type sub( const type a, const type b ) { return _mm512_sub_epi32( a, b ); }
+            C3_TARGET_AVX512 static type mul( const type a, const type b ) { return _mm512_mullo_epi32( a, b ); }
+        };
+
+        /// True if a Pack exists for instruction set Target and value type T, and
+        /// it can load (converting if needed) pixels of value type U.
+
+        template< class Target, class T, class U >
+        struct HasPack
+        {
+            template< class P > static auto _test( int ) -> decltype( P::load( static_cast< const U* >( nullptr ) ), std::true_type() );
+            template< class P > static std::false_type _test( ... );
+            static const bool value = decltype( _test< Pack< Target, T > >( 0 ) )::value;
+        };
+
+        /// True if value type T loading from value type U is vectorized for
+        /// every instruction set kernels may dispatch to.
+
+        template< class T, class U >
+        struct HasPacks
+        {
+            static const bool value = HasPack< Avx2, T, U >::value && HasPack< Avx512, T, U >::value;
+        };
+
+#else
+
+        template< class T, class U >
+        struct HasPacks
+        {
+            static const bool value = false;
+        };
+
+#endif
+
+    }
+
+}
+
+// Most capable instruction set supported by the processor and the operating system.
+
+inline C3::Isa C3::detected_isa()
+{
+    static const C3::Isa isa = C3::detail::_detect_isa();
+    return isa;
+}
+
+// Instruction set kernels currently dispatch to.
+
+inline C3::Isa C3::isa()
+{
+    return C3::detail::_isa();
+}
+
+// Restrict kernels to an instruction set.
+
+inline C3::Isa C3::select_isa( const C3::Isa isa )
+{
+    C3::detail::_isa() = isa < C3::detected_isa() ? isa : C3::detected_isa();
+    return C3::isa();
+}
+
+// Instruction set enum to string.
+
+inline std::string C3::isa_string( const C3::Isa isa )
+{
+    if( isa == C3::Isa::AVX2   ) return "AVX2";
+    if( isa == C3::Isa::AVX512 ) return "AVX512";
+    return "SCALAR";
+}
+
+// Instruction set string to enum.
+
+inline C3::Isa C3::isa_enum( std::string string )
+{
+    for( auto& c : string ) c = toupper( c );
+    if( string == "AVX2"   ) return C3::Isa::AVX2;
+    if( string == "AVX512" ) return C3::Isa::AVX512;
+    return C3::Isa::SCALAR;
+}
+
+// Query CPUID for AVX2 (with FMA) and AVX-512F, and XGETBV to make sure the
+// operating system saves the corresponding register state on context switch.
+
+inline C3::Isa C3::detail::_detect_isa()
+{
+
+#ifdef C3_SIMD_X86
+
+    const unsigned int OSXSAVE  = 1u << 27;    // CPUID.1:ECX
+    const unsigned int AVX      = 1u << 28;    // CPUID.1:ECX
+    const unsigned int FMA      = 1u << 12;    // CPUID.1:ECX
+    const unsigned int AVX2     = 1u <<  5;    // CPUID.(7,0):EBX
+    const unsigned int AVX512F  = 1u << 16;    // CPUID.(7,0):EBX
+    const unsigned int YMM_STATE = 0x06;       // XCR0: SSE and AVX state.
+    const unsigned int ZMM_STATE = 0xe6;       // XCR0: plus opmask and ZMM state.
+
+    unsigned int eax, ebx, ecx, edx;
+    if( __get_cpuid_max( 0, nullptr ) < 7 ) return C3::Isa::SCALAR;
+
+    __cpuid( 1, eax, ebx, ecx, edx );
+    if( ( ecx & ( OSXSAVE | AVX | FMA ) ) != ( OSXSAVE | AVX | FMA ) ) return C3::Isa::SCALAR;
+
+    unsigned int xcr0, xcr0_high;
+    __asm__ __volatile__( "xgetbv" : "=a"( xcr0 ), "=d"( xcr0_high ) : "c"( 0 ) );
+    if( ( xcr0 & YMM_STATE ) != YMM_STATE ) return C3::Isa::SCALAR;
+
+    __cpuid_count( 7, 0, eax, ebx, ecx, edx );
+    if( ! ( ebx & AVX2 ) ) return C3::Isa::SCALAR;
+    if( ( ebx & AVX512F ) && ( xcr0 & ZMM_STATE ) == ZMM_STATE ) return C3::Isa::AVX512;
+    return C3::Isa::AVX2;
+
+#else
+
+    return C3::Isa::SCALAR;
+
+#endif
+
+}
+
+// Instruction set at start-up: the detected one, possibly lowered by the
+// C3_ISA environment variable.
+
+inline C3::Isa C3::detail::_initial_isa()
+{
+    const char* request = getenv( "C3_ISA" );
+    if( ! request ) return C3::detected_isa();
+    auto isa = C3::isa_enum( request );
+    return isa < C3::detected_isa() ? isa : C3::detected_isa();
+}
+
+// Current instruction set selection.
+
+inline C3::Isa& C3::detail::_isa()
+{
+    static C3::Isa isa = C3::detail::_initial_isa();
+    return isa;
+}
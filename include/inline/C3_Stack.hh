@@ -1,19 +1,41 @@
 
+#include <algorithm>
+
 // Constructor.
 
 template< class T >
 inline C3::Stack< T >::Stack( const C3::size_type nframes, const C3::size_type ncolumns, 
-        const C3::size_type nrows ) noexcept : 
-    C3::Block< T >( nframes * ncolumns * nrows ), _nframes( nframes ), _ncolumns( ncolumns ), _nrows( nrows ) 
-{}
+        const C3::size_type nrows, const C3::StackLayout layout ) : 
+    C3::Block< T >( _size_for( nframes, ncolumns, nrows, layout ), typename C3::Block< T >::Untouched() ), 
+    _nframes( nframes ), _ncolumns( ncolumns ), _nrows( nrows ), _layout( layout )
+{
+    _init_layout();
+    if( C3::first_touch() ) _fill( T() );
+    else _clear_padding( 0, nrows );
+}
 
 // Initializing constructor.
 
 template< class T >
 inline C3::Stack< T >::Stack( const C3::size_type nframes, const C3::size_type ncolumns, 
-        const C3::size_type nrows, const T pixel ) noexcept : 
-    C3::Block< T >( nframes * ncolumns * nrows, pixel ), _nframes( nframes ), _ncolumns( ncolumns ), _nrows( nrows ) 
-{}
+        const C3::size_type nrows, const T pixel, const C3::StackLayout layout ) : 
+    C3::Block< T >( _size_for( nframes, ncolumns, nrows, layout ), typename C3::Block< T >::Untouched() ), 
+    _nframes( nframes ), _ncolumns( ncolumns ), _nrows( nrows ), _layout( layout )
+{
+    _init_layout();
+    _fill( pixel );
+}
+
+// Adopting constructor.
+
+template< class T >
+inline C3::Stack< T >::Stack( T* data, const C3::size_type nframes, const C3::size_type ncolumns, 
+        const C3::size_type nrows, const C3::StackLayout layout ) noexcept : 
+    C3::Block< T >( data, _size_for( nframes, ncolumns, nrows, layout ) ), 
+    _nframes( nframes ), _ncolumns( ncolumns ), _nrows( nrows ), _layout( layout )
+{
+    _init_layout();
+}
 
 // Pixel assignment.
 
@@ -23,12 +45,110 @@ inline C3::Stack< T >& C3::Stack< T >::operator = ( const T pixel ) noexcept
     return C3::assign( *this, pixel );
 }
 
+// Expression assignment.
+
+template< class T >
+template< class Node >
+inline C3::Stack< T >& C3::Stack< T >::operator = ( const C3::Expression< Node >& src )
+{
+    return C3::assign( *this, src );
+}
+
 // Value type conversion.
 
 template< class T >
 template< class U >
-inline C3::Stack< T >::operator C3::Stack< U >() const noexcept
+inline C3::Stack< T >::operator C3::Stack< U >() const
 {
-    C3::Stack< U > stack( nframes(), ncolumns(), nrows() );
+    C3::Stack< U > stack( nframes(), ncolumns(), nrows(), layout() );
     return C3::assign( stack, *this );
 }
+
+// Total elements.  Tiled rows round up to whole tiles.
+
+template< class T >
+inline C3::size_type C3::Stack< T >::_size_for( const C3::size_type nframes, const C3::size_type ncolumns, 
+        const C3::size_type nrows, const C3::StackLayout layout )
+{
+    if( layout != C3::StackLayout::TILED ) return nframes * ncolumns * nrows;
+    const auto ntiles = ( ncolumns + C3::stack_tile - 1 ) / C3::stack_tile;
+    return nframes * ntiles * C3::stack_tile * nrows;
+}
+
+// Strides.  Offsets are frame_stride * i + row_stride * k + tile_stride * 
+// ( j >> shift ) + ( j & mask ), which covers all three layouts with a zero 
+// shift and mask for the untiled ones.
+
+template< class T >
+inline void C3::Stack< T >::_init_layout()
+{
+    _shift = 0;
+    _mask  = 0;
+    switch( _layout )
+    {
+        case C3::StackLayout::INTERLEAVED :
+            _run          = 1;
+            _frame_stride = 1;
+            _tile_stride  = _nframes;
+            _row_stride   = _nframes * _ncolumns;
+            break;
+        case C3::StackLayout::PLANAR :
+            _run          = _ncolumns;
+            _frame_stride = _ncolumns * _nrows;
+            _tile_stride  = 1;
+            _row_stride   = _ncolumns;
+            break;
+        case C3::StackLayout::TILED :
+            _run          = C3::stack_tile;
+            _frame_stride = C3::stack_tile;
+            _tile_stride  = _nframes * C3::stack_tile;
+            _row_stride   = _tile_stride * ( ( _ncolumns + C3::stack_tile - 1 ) / C3::stack_tile );
+            while( ( C3::size_type( 1 ) << _shift ) < C3::stack_tile ) ++_shift;
+            _mask         = C3::stack_tile - 1;
+            break;
+    }
+}
+
+// Zero the padding at the end of tiled rows, in the last tile of each frame.
+
+template< class T >
+inline void C3::Stack< T >::_clear_padding( const C3::size_type first, const C3::size_type last )
+{
+    if( _layout != C3::StackLayout::TILED || _ncolumns % C3::stack_tile == 0 ) return;
+    const auto j = _ncolumns & ~_mask;
+    for( auto k = first; k < last; ++k )
+    {
+        for( C3::size_type i = 0; i < _nframes; ++i ) 
+        {
+            const auto tile = this->data() + offset( i, j, k );
+            std::fill( tile + ( _ncolumns - j ), tile + C3::stack_tile, T( 0 ) );
+        }
+    }
+}
+
+// Fill in the same row bands as the assignment kernels, so each thread first
+// touches the pages it works on later.  Interleaved and tiled rows are
+// contiguous; planar rows are one run per frame.
+
+template< class T >
+inline void C3::Stack< T >::_fill( const T pixel )
+{
+    const auto data = this->data();
+    C3::detail::_parallel_for( _nrows, this->size(), 1, 
+        [ & ]( const C3::size_type first, const C3::size_type last )
+        {
+            for( auto k = first; k < last; ++k )
+            {
+                if( _layout != C3::StackLayout::PLANAR ) 
+                {
+                    std::fill( data + _row_stride * k, data + _row_stride * ( k + 1 ), pixel );
+                    continue;
+                }
+                for( C3::size_type i = 0; i < _nframes; ++i ) 
+                {
+                    std::fill( data + offset( i, 0, k ), data + offset( i, 0, k ) + _ncolumns, pixel );
+                }
+            }
+            _clear_padding( first, last );
+        } );
+}
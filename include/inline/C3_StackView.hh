@@ -0,0 +1,39 @@
+
+// Constructor.
+
+template< class T >
+inline C3::StackView< T >::StackView( C3::Stack< T >& stack, const C3::size_type nframes, 
+        const C3::size_type ncolumns, const C3::size_type nrows, const C3::size_type frame_offset, 
+        const C3::size_type column_offset, const C3::size_type row_offset ) noexcept :
+    _stack( &stack ), _nframes( nframes ), _ncolumns( ncolumns ), _nrows( nrows ), 
+    _frame_offset( frame_offset ), _column_offset( column_offset ), _row_offset( row_offset ), 
+    _frame_step( stack.offset( 1, 0, 0 ) )
+{}
+
+// Sub-view constructor.
+
+template< class T >
+inline C3::StackView< T >::StackView( C3::StackView< T >& view, const C3::size_type nframes, 
+        const C3::size_type ncolumns, const C3::size_type nrows, const C3::size_type frame_offset, 
+        const C3::size_type column_offset, const C3::size_type row_offset ) noexcept :
+    _stack( &view.stack() ), _nframes( nframes ), _ncolumns( ncolumns ), _nrows( nrows ), 
+    _frame_offset( view.frame_offset() + frame_offset ), _column_offset( view.column_offset() + column_offset ), 
+    _row_offset( view.row_offset() + row_offset ), _frame_step( view.frame_step() )
+{}
+
+// Pixel assignment.
+
+template< class T >
+inline C3::StackView< T >& C3::StackView< T >::operator = ( const T pixel ) noexcept
+{
+    return C3::assign( *this, pixel );
+}
+
+// Expression assignment.
+
+template< class T >
+template< class Node >
+inline C3::StackView< T >& C3::StackView< T >::operator = ( const C3::Expression< Node >& src )
+{
+    return C3::assign( *this, src );
+}
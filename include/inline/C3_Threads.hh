@@ -0,0 +1,171 @@
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace C3
+{
+
+    namespace detail
+    {
+
+        // Current settings.
+
+        int         _initial_threads();
+        int&        _threads();
+        size_type&  _thread_threshold();
+        bool&       _first_touch();
+
+        // Threads to use for a kernel touching the given number of destination pixels.  One inside an enclosing
+        // parallel region, so kernels called from user threads do not oversubscribe.
+
+        int _threads_for( const size_type work );
+
+        // Half-open range [ first, last ) of count items handled by thread rank out of nthreads.  Range boundaries
+        // fall on multiples of grain items, except at the end.
+
+        std::pair< size_type, size_type > _band( const size_type count, const int rank, const int nthreads,
+                const size_type grain );
+
+        // Split count items into bands over threads and call function( first, last ) on each band.  Work is the
+        // number of destination pixels touched, compared with the threshold.
+
+        template< class Function >
+        void _parallel_for( const size_type count, const size_type work, const size_type grain, Function function );
+
+        // Items of value type T per cache line, so threads never write the same line.
+
+        template< class T >
+        constexpr size_type _grain() { return sizeof( T ) < 64 ? 64 / sizeof( T ) : 1; }
+
+    }
+
+}
+
+// Threads assignment kernels may use.
+
+inline int C3::threads()
+{
+    return C3::detail::_threads();
+}
+
+// Set threads assignment kernels may use.
+
+inline int C3::select_threads( const int nthreads )
+{
+    C3::detail::_threads() = nthreads > 1 ? nthreads : 1;
+    return C3::threads();
+}
+
+// Destination pixels below which assignment kernels stay serial.
+
+inline C3::size_type C3::thread_threshold()
+{
+    return C3::detail::_thread_threshold();
+}
+
+// Set destination pixels below which assignment kernels stay serial.
+
+inline C3::size_type C3::select_thread_threshold( const C3::size_type npixels )
+{
+    C3::detail::_thread_threshold() = npixels;
+    return C3::thread_threshold();
+}
+
+// Whether new containers first-touch their pixels in bands.
+
+inline bool C3::first_touch()
+{
+    return C3::detail::_first_touch();
+}
+
+// Turn first touch on or off.
+
+inline bool C3::select_first_touch( const bool enable )
+{
+    C3::detail::_first_touch() = enable;
+    return C3::first_touch();
+}
+
+// Threads at start-up: one, unless the C3_THREADS environment variable says
+// otherwise.
+
+inline int C3::detail::_initial_threads()
+{
+    const char* request = getenv( "C3_THREADS" );
+    return request ? std::max( 1, atoi( request ) ) : 1;
+}
+
+// Current thread count.
+
+inline int& C3::detail::_threads()
+{
+    static int nthreads = C3::detail::_initial_threads();
+    return nthreads;
+}
+
+// Current threshold.  Below about this many pixels the cost of waking threads
+// exceeds the work.
+
+inline C3::size_type& C3::detail::_thread_threshold()
+{
+    static C3::size_type npixels = 32768;
+    return npixels;
+}
+
+// Current first touch setting, off unless the C3_FIRST_TOUCH environment
+// variable says otherwise.
+
+inline bool& C3::detail::_first_touch()
+{
+    static bool enable = getenv( "C3_FIRST_TOUCH" ) && atoi( getenv( "C3_FIRST_TOUCH" ) ) != 0;
+    return enable;
+}
+
+// Threads to use for a kernel.
+
+inline int C3::detail::_threads_for( const C3::size_type work )
+{
+#ifdef _OPENMP
+    if( C3::threads() < 2 || work < C3::thread_threshold() || omp_in_parallel() ) return 1;
+    return C3::threads();
+#else
+    ( void ) work;
+    return 1;
+#endif
+}
+
+// Band of items for one thread.
+
+inline std::pair< C3::size_type, C3::size_type > C3::detail::_band( const C3::size_type count, const int rank,
+        const int nthreads, const C3::size_type grain )
+{
+    const auto ngrains = ( count + grain - 1 ) / grain;
+    const auto first   = std::min( count, grain * ( ngrains * rank       / nthreads ) );
+    const auto last    = std::min( count, grain * ( ngrains * ( rank + 1 ) / nthreads ) );
+    return std::make_pair( first, last );
+}
+
+// Split items into bands over threads.
+
+template< class Function >
+inline void C3::detail::_parallel_for( const C3::size_type count, const C3::size_type work, const C3::size_type grain,
+        Function function )
+{
+#ifdef _OPENMP
+    const auto nthreads = C3::detail::_threads_for( work );
+    if( nthreads > 1 )
+    {
+        #pragma omp parallel num_threads( nthreads )
+        {
+            const auto band = C3::detail::_band( count, omp_get_thread_num(), omp_get_num_threads(), grain );
+            if( band.first < band.second ) function( band.first, band.second );
+        }
+        return;
+    }
+#endif
+    function( 0, count );
+}
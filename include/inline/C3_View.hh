@@ -13,14 +13,41 @@ inline C3::View< T > C3::View< T >::iraf_style( C3::Frame< T >& frame,
     return C3::View< T >( frame, ncolumns, nrows, column_offset, row_offset );
 }
 
+// IRAF-style sub-section of a view.
+
+template< class T >
+inline C3::View< T > C3::View< T >::iraf_style( C3::View< T >& view, 
+        const size_type first_column, const size_type final_column   , 
+        const size_type first_row   , const size_type final_row      )
+{
+    auto column_offset = first_column - 1;
+    auto row_offset    = first_row    - 1;
+    auto ncolumns = final_column - column_offset;
+    auto nrows    = final_row    - row_offset;
+    return C3::View< T >( view, ncolumns, nrows, column_offset, row_offset );
+}
+
 // Constructor.
 
 template< class T >
 inline C3::View< T >::View( Frame< T >& frame, const size_type ncolumns, const size_type nrows, 
-        const size_type column_offset, const size_type row_offset ) noexcept :
+        const size_type column_offset, const size_type row_offset, 
+        const size_type column_step, const size_type row_step ) noexcept :
     _data( frame.data() ), _ncolumns( ncolumns ), _nrows( nrows ), 
-    _offset( column_offset + frame.ncolumns() * row_offset ), _stride( frame.ncolumns() ),
-    _begin( _data + _offset )
+    _offset( column_offset + frame.pitch() * row_offset ), _stride( frame.pitch() * row_step ), 
+    _step( column_step ), _begin( _data + _offset )
+{}
+
+// Sub-view constructor.  Steps multiply, so a sub-view of a strided view
+// is strided in frame pixels.
+
+template< class T >
+inline C3::View< T >::View( View& view, const size_type ncolumns, const size_type nrows, 
+        const size_type column_offset, const size_type row_offset, 
+        const size_type column_step, const size_type row_step ) noexcept :
+    _data( view.data() ), _ncolumns( ncolumns ), _nrows( nrows ), 
+    _offset( view.offset() + view.step() * column_offset + view.stride() * row_offset ), 
+    _stride( view.stride() * row_step ), _step( view.step() * column_step ), _begin( _data + _offset )
 {}
 
 // Pixel assignment.
@@ -31,3 +58,13 @@ inline C3::View< T >& C3::View< T >::operator = ( const T pixel ) noexcept
     C3::assign( *this, pixel );
     return *this;
 }
+
+// Expression assignment.
+
+template< class T >
+template< class Node >
+inline C3::View< T >& C3::View< T >::operator = ( const C3::Expression< Node >& src )
+{
+    C3::assign( *this, src );
+    return *this;
+}
@@ -0,0 +1,522 @@
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+#include "../C3_MaskedFrame.hh"
+#include "../C3_Math.hh"
+#include "../C3_Simd.hh"
+#include "../C3_Threads.hh"
+
+// Internal declarations
+
+namespace C3
+{
+
+    // Clipping threshold and passes of an operator.  No clipping is an infinite threshold and no passes.
+
+    struct _Clip
+    {
+        double      nsigma;
+        size_type   iterations;
+    };
+
+    _Clip _clip( const WeightedMean& );
+
+    _Clip _clip( const ClippedWeightedMean& op );
+
+    // Pixels, weights and flags of a band of destination pixels, each with the stride from one pixel to the next
+    // of the same destination pixel (across kernels) or from one destination pixel to the next (along kernels).
+
+    template< class U, class W, class F >
+    struct _WeightedSource
+    {
+        const U*    data;
+        const W*    weight;
+        const F*    flags;
+        size_type   data_stride;
+        size_type   weight_stride;
+        size_type   flags_stride;
+    };
+
+    template< class U, class W, class F >
+    _WeightedSource< U, W, F > _weighted_source( const U* data, const W* weight, const F* flags,
+            const size_type data_stride, const size_type weight_stride, const size_type flags_stride );
+
+    // Destination pixels per band of the across kernels.
+
+    const size_type _weighted_tile = 64;
+
+    // Across Kernels
+    // --------------
+    // Weighted means of ncolumns adjacent destination pixels of nsamples pixels each, a tile at a time, with the
+    // sums for the tile side by side and filled a sample at a time, vectorized across destination pixels.  Used
+    // where the pixels of one sample are contiguous: planar and tiled stacks, and columns of frames.  Dispatched
+    // like the expression kernels (see C3_Assign.hh).
+
+    template< class T, class U, class W, class F >
+    void _weighted_across( T* mean, T* invvar, const _WeightedSource< U, W, F >& src, const size_type ncolumns,
+            const size_type nsamples, const _Clip& clip );
+
+    template< class T, class U, class W, class F >
+    C3_NO_FP_CONTRACT void _scalar_weighted_across( T* mean, T* invvar, const _WeightedSource< U, W, F >& src,
+            const size_type ncolumns, const size_type nsamples, const _Clip& clip );
+
+#ifdef C3_SIMD_X86
+
+    template< class T, class U, class W, class F >
+    C3_TARGET_AVX2 void _vector_weighted_across( detail::Avx2, T* mean, T* invvar,
+            const _WeightedSource< U, W, F >& src, const size_type ncolumns, const size_type nsamples,
+            const _Clip& clip );
+
+    template< class T, class U, class W, class F >
+    C3_TARGET_AVX512 void _vector_weighted_across( detail::Avx512, T* mean, T* invvar,
+            const _WeightedSource< U, W, F >& src, const size_type ncolumns, const size_type nsamples,
+            const _Clip& clip );
+
+#endif
+
+    // Across body shared by the scalar and vector versions.
+
+    template< class T, class U, class W, class F >
+    C3_SHARED_BODY void _fold_weighted_across( T* mean, T* invvar, const _WeightedSource< U, W, F >& src,
+            const size_type ncolumns, const size_type nsamples, const _Clip& clip );
+
+    // One pass of the across body over a tile, clipped about center by threshold, the squared number of standard
+    // deviations.
+
+    template< class T, class U, class W, class F >
+    C3_SHARED_BODY void _weighted_pass_across( T* sum, T* weighted, T* count, const T* center, const T threshold,
+            const _WeightedSource< U, W, F >& src, const size_type ncolumns, const size_type nsamples );
+
+    // Along Kernels
+    // -------------
+    // Weighted means of npixels destination pixels of nsamples contiguous pixels each, one destination pixel at a
+    // time, the sums in interleaved lanes vectorized along the samples.  Used for interleaved stacks and rows of
+    // frames.
+
+    const size_type _weighted_lanes = 16;
+
+    template< class T, class U, class W, class F >
+    void _weighted_along( T* mean, T* invvar, const size_type stride, const _WeightedSource< U, W, F >& src,
+            const size_type npixels, const size_type nsamples, const _Clip& clip );
+
+    template< class T, class U, class W, class F >
+    C3_NO_FP_CONTRACT void _scalar_weighted_along( T* mean, T* invvar, const size_type stride,
+            const _WeightedSource< U, W, F >& src, const size_type npixels, const size_type nsamples,
+            const _Clip& clip );
+
+#ifdef C3_SIMD_X86
+
+    template< class T, class U, class W, class F >
+    C3_TARGET_AVX2 void _vector_weighted_along( detail::Avx2, T* mean, T* invvar, const size_type stride,
+            const _WeightedSource< U, W, F >& src, const size_type npixels, const size_type nsamples,
+            const _Clip& clip );
+
+    template< class T, class U, class W, class F >
+    C3_TARGET_AVX512 void _vector_weighted_along( detail::Avx512, T* mean, T* invvar, const size_type stride,
+            const _WeightedSource< U, W, F >& src, const size_type npixels, const size_type nsamples,
+            const _Clip& clip );
+
+#endif
+
+    // Along body shared by the scalar and vector versions.
+
+    template< class T, class U, class W, class F >
+    C3_SHARED_BODY void _fold_weighted_along( T* mean, T* invvar, const size_type stride,
+            const _WeightedSource< U, W, F >& src, const size_type npixels, const size_type nsamples,
+            const _Clip& clip );
+
+    // One pass of the along body over the samples of one destination pixel.
+
+    template< class T, class U, class W, class F >
+    C3_SHARED_BODY void _weighted_pass_along( T& sum, T& weighted, T& count, const T center, const T threshold,
+            const U* data, const W* weight, const F* flags, const size_type nsamples );
+
+    // Pixel kept, and its weight if so.
+
+    template< class T, class U, class W, class F >
+    T _weighted_keep( const U x, const W w, const F f, const T center, const T threshold, T& value );
+
+}
+
+// Clipped weighted mean constructor.
+
+inline C3::ClippedWeightedMean::ClippedWeightedMean( const double nsigma, const C3::size_type iterations ) :
+    nsigma( nsigma ), iterations( iterations )
+{
+    assert( nsigma > 0.0 );
+}
+
+// Stacks to frames: interleaved rows along the frames of each pixel, other
+// layouts across each run of columns, in row bands over threads.
+
+template< class T, class U, class W, class F, class Operator >
+inline void C3::reduce( C3::Frame< T >& mean, C3::Frame< T >& invvar, const C3::Stack< U >& data,
+        const C3::Stack< W >& weight, const C3::Stack< F >& flags, Operator op )
+{
+    assert( data.nframes() == weight.nframes() && data.nframes() == flags.nframes() );
+    assert( data.ncolumns() == weight.ncolumns() && data.ncolumns() == flags.ncolumns() );
+    assert( data.nrows() == weight.nrows() && data.nrows() == flags.nrows() );
+    assert( data.layout() == weight.layout() && data.layout() == flags.layout() );
+    assert( mean.ncolumns() == data.ncolumns() && mean.nrows() == data.nrows() );
+    assert( invvar.ncolumns() == data.ncolumns() && invvar.nrows() == data.nrows() );
+
+    const auto clip     = C3::_clip( op );
+    const auto nframes  = data.nframes();
+    const auto ncolumns = data.ncolumns();
+    const auto nrows    = data.nrows();
+    C3::detail::_parallel_for( nrows, ncolumns * nrows, 1,
+        [ & ]( const C3::size_type first, const C3::size_type last )
+        {
+            for( auto k = first; k < last; ++k )
+            {
+                if( data.layout() == C3::StackLayout::INTERLEAVED )
+                {
+                    const auto offset = data.offset( 0, 0, k );
+                    const auto stride = data.offset( 0, 1, k ) - offset;
+                    C3::_weighted_along( &mean( 0, k ), &invvar( 0, k ), 1,
+                            C3::_weighted_source( data.data() + offset, weight.data() + offset, flags.data() + offset,
+                                stride, stride, stride ), ncolumns, nframes, clip );
+                    continue;
+                }
+                const auto stride = data.offset( 1, 0, 0 ) - data.offset( 0, 0, 0 );
+                for( C3::size_type j = 0; j < ncolumns; j += data.run() )
+                {
+                    const auto offset = data.offset( 0, j, k );
+                    C3::_weighted_across( &mean( j, k ), &invvar( j, k ),
+                            C3::_weighted_source( data.data() + offset, weight.data() + offset, flags.data() + offset,
+                                stride, stride, stride ), std::min( data.run(), ncolumns - j ), nframes, clip );
+                }
+            }
+        } );
+}
+
+// Frames to columns: along each row, in row bands over threads.
+
+template< class T, class U, class W, class F, class Operator >
+inline void C3::reduce( C3::Column< T >& mean, C3::Column< T >& invvar, const C3::Frame< U >& data,
+        const C3::Frame< W >& weight, const C3::Frame< F >& flags, Operator op )
+{
+    assert( data.ncolumns() == weight.ncolumns() && data.ncolumns() == flags.ncolumns() );
+    assert( data.nrows() == weight.nrows() && data.nrows() == flags.nrows() );
+    assert( mean.size() == data.nrows() && invvar.size() == data.nrows() );
+
+    const auto clip = C3::_clip( op );
+    C3::detail::_parallel_for( data.nrows(), data.ncolumns() * data.nrows(), C3::detail::_grain< T >(),
+        [ & ]( const C3::size_type first, const C3::size_type last )
+        {
+            C3::_weighted_along( &mean( first ), &invvar( first ), 1,
+                    C3::_weighted_source( data.data() + data.pitch() * first, weight.data() + weight.pitch() * first,
+                        flags.data() + flags.pitch() * first, data.pitch(), weight.pitch(), flags.pitch() ),
+                    last - first, data.ncolumns(), clip );
+        } );
+}
+
+// Frames to rows: across bands of columns over threads.
+
+template< class T, class U, class W, class F, class Operator >
+inline void C3::reduce( C3::Row< T >& mean, C3::Row< T >& invvar, const C3::Frame< U >& data,
+        const C3::Frame< W >& weight, const C3::Frame< F >& flags, Operator op )
+{
+    assert( data.ncolumns() == weight.ncolumns() && data.ncolumns() == flags.ncolumns() );
+    assert( data.nrows() == weight.nrows() && data.nrows() == flags.nrows() );
+    assert( mean.size() == data.ncolumns() && invvar.size() == data.ncolumns() );
+
+    const auto clip = C3::_clip( op );
+    C3::detail::_parallel_for( data.ncolumns(), data.ncolumns() * data.nrows(), C3::_weighted_tile,
+        [ & ]( const C3::size_type first, const C3::size_type last )
+        {
+            C3::_weighted_across( &mean( first ), &invvar( first ),
+                    C3::_weighted_source( data.data() + first, weight.data() + first, flags.data() + first,
+                        data.pitch(), weight.pitch(), flags.pitch() ), last - first, data.nrows(), clip );
+        } );
+}
+
+// Masked frame to columns.
+
+template< class T, class U, class F, class Operator >
+inline void C3::reduce( C3::Column< T >& mean, C3::Column< T >& invvar, const C3::MaskedFrame< U, F >& src,
+        Operator op )
+{
+    C3::reduce( mean, invvar, src.data(), src.invvar(), src.flags(), op );
+}
+
+// Masked frame to rows.
+
+template< class T, class U, class F, class Operator >
+inline void C3::reduce( C3::Row< T >& mean, C3::Row< T >& invvar, const C3::MaskedFrame< U, F >& src, Operator op )
+{
+    C3::reduce( mean, invvar, src.data(), src.invvar(), src.flags(), op );
+}
+
+// Clipping of operators.
+
+inline C3::_Clip C3::_clip( const C3::WeightedMean& )
+{
+    return C3::_Clip{ std::numeric_limits< double >::infinity(), 0 };
+}
+
+inline C3::_Clip C3::_clip( const C3::ClippedWeightedMean& op )
+{
+    return C3::_Clip{ op.nsigma, op.iterations };
+}
+
+// Source of a band.
+
+template< class U, class W, class F >
+inline C3::_WeightedSource< U, W, F > C3::_weighted_source( const U* data, const W* weight, const F* flags,
+        const C3::size_type data_stride, const C3::size_type weight_stride, const C3::size_type flags_stride )
+{
+    return C3::_WeightedSource< U, W, F >{ data, weight, flags, data_stride, weight_stride, flags_stride };
+}
+
+// Across kernel, dispatched.
+
+template< class T, class U, class W, class F >
+inline void C3::_weighted_across( T* mean, T* invvar, const C3::_WeightedSource< U, W, F >& src,
+        const C3::size_type ncolumns, const C3::size_type nsamples, const C3::_Clip& clip )
+{
+#ifdef C3_SIMD_X86
+    switch( C3::isa() )
+    {
+        case C3::Isa::AVX512 : C3::_vector_weighted_across( C3::detail::Avx512(), mean, invvar, src, ncolumns,
+                                       nsamples, clip );
+                               return;
+        case C3::Isa::AVX2   : C3::_vector_weighted_across( C3::detail::Avx2()  , mean, invvar, src, ncolumns,
+                                       nsamples, clip );
+                               return;
+        default              : break;
+    }
+#endif
+    C3::_scalar_weighted_across( mean, invvar, src, ncolumns, nsamples, clip );
+}
+
+// Across kernels, each compiling the shared body for its instruction set.
+
+template< class T, class U, class W, class F >
+C3_NO_FP_CONTRACT inline void C3::_scalar_weighted_across( T* mean, T* invvar,
+        const C3::_WeightedSource< U, W, F >& src, const C3::size_type ncolumns, const C3::size_type nsamples,
+        const C3::_Clip& clip )
+{
+    C3::_fold_weighted_across( mean, invvar, src, ncolumns, nsamples, clip );
+}
+
+#ifdef C3_SIMD_X86
+
+template< class T, class U, class W, class F >
+C3_TARGET_AVX2 inline void C3::_vector_weighted_across( C3::detail::Avx2, T* mean, T* invvar,
+        const C3::_WeightedSource< U, W, F >& src, const C3::size_type ncolumns, const C3::size_type nsamples,
+        const C3::_Clip& clip )
+{
+    C3::_fold_weighted_across( mean, invvar, src, ncolumns, nsamples, clip );
+}
+
+template< class T, class U, class W, class F >
+C3_TARGET_AVX512 inline void C3::_vector_weighted_across( C3::detail::Avx512, T* mean, T* invvar,
+        const C3::_WeightedSource< U, W, F >& src, const C3::size_type ncolumns, const C3::size_type nsamples,
+        const C3::_Clip& clip )
+{
+    C3::_fold_weighted_across( mean, invvar, src, ncolumns, nsamples, clip );
+}
+
+#endif
+
+// Across body shared by the scalar and vector versions: a first pass
+// unclipped, then passes clipped about the last means until no count changes.
+// A destination pixel with nothing kept keeps its last center.
+
+template< class T, class U, class W, class F >
+C3_SHARED_BODY inline void C3::_fold_weighted_across( T* mean, T* invvar, const C3::_WeightedSource< U, W, F >& src,
+        const C3::size_type ncolumns, const C3::size_type nsamples, const C3::_Clip& clip )
+{
+    const T threshold = static_cast< T >( clip.nsigma * clip.nsigma );
+    for( C3::size_type first = 0; first < ncolumns; first += C3::_weighted_tile )
+    {
+        const auto count = std::min( C3::_weighted_tile, ncolumns - first );
+        const auto tile  = C3::_weighted_source( src.data + first, src.weight + first, src.flags + first,
+                src.data_stride, src.weight_stride, src.flags_stride );
+        T sum[ C3::_weighted_tile ], weighted[ C3::_weighted_tile ], kept[ C3::_weighted_tile ];
+        T center[ C3::_weighted_tile ], previous[ C3::_weighted_tile ];
+        for( C3::size_type j = 0; j < count; ++j ) center[ j ] = T( 0 );
+        C3::_weighted_pass_across( sum, weighted, kept, center, std::numeric_limits< T >::infinity(), tile, count,
+                nsamples );
+        for( C3::size_type iteration = 0; iteration < clip.iterations; ++iteration )
+        {
+            for( C3::size_type j = 0; j < count; ++j )
+            {
+                center[ j ]   = C3::_select( sum[ j ] > T( 0 ), weighted[ j ] / sum[ j ], center[ j ] );
+                previous[ j ] = kept[ j ];
+            }
+            C3::_weighted_pass_across( sum, weighted, kept, center, threshold, tile, count, nsamples );
+            if( std::equal( kept, kept + count, previous ) ) break;
+        }
+        for( C3::size_type j = 0; j < count; ++j )
+        {
+            mean[ first + j ]   = C3::_select( sum[ j ] > T( 0 ), weighted[ j ] / sum[ j ], T( 0 ) );
+            invvar[ first + j ] = sum[ j ];
+        }
+    }
+}
+
+// Across pass, a sample at a time.  Products are statements of their own so
+// that no compiler contracts them with the sums (see C3_Simd.hh).
+
+template< class T, class U, class W, class F >
+C3_SHARED_BODY inline void C3::_weighted_pass_across( T* sum, T* weighted, T* count, const T* center, const T threshold,
+        const C3::_WeightedSource< U, W, F >& src, const C3::size_type ncolumns, const C3::size_type nsamples )
+{
+    for( C3::size_type j = 0; j < ncolumns; ++j ) sum[ j ] = weighted[ j ] = count[ j ] = T( 0 );
+    for( C3::size_type i = 0; i < nsamples; ++i )
+    {
+        const U* data   = src.data   + src.data_stride   * i;
+        const W* weight = src.weight + src.weight_stride * i;
+        const F* flags  = src.flags  + src.flags_stride  * i;
+        for( C3::size_type j = 0; j < ncolumns; ++j )
+        {
+            T value;
+            const T w = C3::_weighted_keep( data[ j ], weight[ j ], flags[ j ], center[ j ], threshold, value );
+            const T product = w * value;
+            sum[ j ]      += w;
+            weighted[ j ] += product;
+            count[ j ]    += C3::_select( w > T( 0 ), T( 1 ), T( 0 ) );
+        }
+    }
+}
+
+// Along kernel, dispatched.
+
+template< class T, class U, class W, class F >
+inline void C3::_weighted_along( T* mean, T* invvar, const C3::size_type stride,
+        const C3::_WeightedSource< U, W, F >& src, const C3::size_type npixels, const C3::size_type nsamples,
+        const C3::_Clip& clip )
+{
+#ifdef C3_SIMD_X86
+    switch( C3::isa() )
+    {
+        case C3::Isa::AVX512 : C3::_vector_weighted_along( C3::detail::Avx512(), mean, invvar, stride, src, npixels,
+                                       nsamples, clip );
+                               return;
+        case C3::Isa::AVX2   : C3::_vector_weighted_along( C3::detail::Avx2()  , mean, invvar, stride, src, npixels,
+                                       nsamples, clip );
+                               return;
+        default              : break;
+    }
+#endif
+    C3::_scalar_weighted_along( mean, invvar, stride, src, npixels, nsamples, clip );
+}
+
+// Along kernels, each compiling the shared body for its instruction set.
+
+template< class T, class U, class W, class F >
+C3_NO_FP_CONTRACT inline void C3::_scalar_weighted_along( T* mean, T* invvar, const C3::size_type stride,
+        const C3::_WeightedSource< U, W, F >& src, const C3::size_type npixels, const C3::size_type nsamples,
+        const C3::_Clip& clip )
+{
+    C3::_fold_weighted_along( mean, invvar, stride, src, npixels, nsamples, clip );
+}
+
+#ifdef C3_SIMD_X86
+
+template< class T, class U, class W, class F >
+C3_TARGET_AVX2 inline void C3::_vector_weighted_along( C3::detail::Avx2, T* mean, T* invvar,
+        const C3::size_type stride, const C3::_WeightedSource< U, W, F >& src, const C3::size_type npixels,
+        const C3::size_type nsamples, const C3::_Clip& clip )
+{
+    C3::_fold_weighted_along( mean, invvar, stride, src, npixels, nsamples, clip );
+}
+
+template< class T, class U, class W, class F >
+C3_TARGET_AVX512 inline void C3::_vector_weighted_along( C3::detail::Avx512, T* mean, T* invvar,
+        const C3::size_type stride, const C3::_WeightedSource< U, W, F >& src, const C3::size_type npixels,
+        const C3::size_type nsamples, const C3::_Clip& clip )
+{
+    C3::_fold_weighted_along( mean, invvar, stride, src, npixels, nsamples, clip );
+}
+
+#endif
+
+// Along body shared by the scalar and vector versions, passes as for the
+// across body.
+
+template< class T, class U, class W, class F >
+C3_SHARED_BODY inline void C3::_fold_weighted_along( T* mean, T* invvar, const C3::size_type stride,
+        const C3::_WeightedSource< U, W, F >& src, const C3::size_type npixels, const C3::size_type nsamples,
+        const C3::_Clip& clip )
+{
+    const T threshold = static_cast< T >( clip.nsigma * clip.nsigma );
+    for( C3::size_type n = 0; n < npixels; ++n )
+    {
+        const U* data   = src.data   + src.data_stride   * n;
+        const W* weight = src.weight + src.weight_stride * n;
+        const F* flags  = src.flags  + src.flags_stride  * n;
+        T sum, weighted, kept, center = T( 0 );
+        C3::_weighted_pass_along( sum, weighted, kept, center, std::numeric_limits< T >::infinity(), data, weight,
+                flags, nsamples );
+        for( C3::size_type iteration = 0; iteration < clip.iterations; ++iteration )
+        {
+            if( sum > T( 0 ) ) center = weighted / sum;
+            const T previous = kept;
+            C3::_weighted_pass_along( sum, weighted, kept, center, threshold, data, weight, flags, nsamples );
+            if( kept == previous ) break;
+        }
+        mean[ stride * n ]   = sum > T( 0 ) ? weighted / sum : T( 0 );
+        invvar[ stride * n ] = sum;
+    }
+}
+
+// Along pass: whole rounds of lanes, what is left over into the first lanes,
+// then lanes summed.
+
+template< class T, class U, class W, class F >
+C3_SHARED_BODY inline void C3::_weighted_pass_along( T& sum, T& weighted, T& count, const T center, const T threshold,
+        const U* data, const W* weight, const F* flags, const C3::size_type nsamples )
+{
+    const auto nlanes = C3::_weighted_lanes;
+    T sums[ nlanes ], weighteds[ nlanes ], counts[ nlanes ];
+    for( C3::size_type l = 0; l < nlanes; ++l ) sums[ l ] = weighteds[ l ] = counts[ l ] = T( 0 );
+    const auto whole = nsamples - nsamples % nlanes;
+    for( C3::size_type i = 0; i < whole; i += nlanes )
+    {
+        for( C3::size_type l = 0; l < nlanes; ++l )
+        {
+            T value;
+            const T w = C3::_weighted_keep( data[ i + l ], weight[ i + l ], flags[ i + l ], center, threshold, value );
+            const T product = w * value;
+            sums[ l ]      += w;
+            weighteds[ l ] += product;
+            counts[ l ]    += C3::_select( w > T( 0 ), T( 1 ), T( 0 ) );
+        }
+    }
+    for( C3::size_type i = whole; i < nsamples; ++i )
+    {
+        T value;
+        const T w = C3::_weighted_keep( data[ i ], weight[ i ], flags[ i ], center, threshold, value );
+        const T product = w * value;
+        sums[ i - whole ]      += w;
+        weighteds[ i - whole ] += product;
+        counts[ i - whole ]    += C3::_select( w > T( 0 ), T( 1 ), T( 0 ) );
+    }
+    sum = weighted = count = T( 0 );
+    for( C3::size_type l = 0; l < nlanes; ++l )
+    {
+        sum      += sums[ l ];
+        weighted += weighteds[ l ];
+        count    += counts[ l ];
+    }
+}
+
+// Pixel kept if unflagged, with positive weight and within threshold of
+// center, comparisons false for NaN.  Gives its weight, or zero if not kept,
+// and the pixel in value.
+
+template< class T, class U, class W, class F >
+inline T C3::_weighted_keep( const U x, const W w, const F f, const T center, const T threshold, T& value )
+{
+    value = static_cast< T >( x );
+    const T weight    = static_cast< T >( w );
+    const T deviation = value - center;
+    const bool keep   = ( f == F( 0 ) ) & ( weight > T( 0 ) ) & ( weight * deviation * deviation <= threshold );
+    value = C3::_select( keep, value, T( 0 ) );
+    return C3::_select( keep, weight, T( 0 ) );
+}
@@ -1,7 +1,10 @@
 
 #include "gtest/gtest.h"
 
+#include <cstdint>
+
 #include "C3_Block.hh"
+#include "C3_Operator.hh"
 
 TEST( BlockTest, Construct )
 {
@@ -216,3 +219,42 @@ TEST( BlockTest, ArraySubscriptAccess )
     EXPECT_EQ( 111221, block[ 4 ] );
 
 }
+
+TEST( BlockTest, Alignment )
+{
+
+    for( C3::size_type size : { 0, 1, 3, 17, 1000 } )
+    {
+        C3::Block< char  > bytes ( size );
+        C3::Block< float > floats( size );
+        EXPECT_EQ( 0, reinterpret_cast< std::uintptr_t >( bytes.data()  ) % C3::alignment );
+        EXPECT_EQ( 0, reinterpret_cast< std::uintptr_t >( floats.data() ) % C3::alignment );
+    }
+
+}
+
+TEST( BlockTest, Adopt )
+{
+
+    int buffer[ 6 ] = { 1, 2, 3, 4, 5, 6 };
+    {
+        C3::Block< int > block( buffer, 6 );
+        EXPECT_FALSE( block.owner() );
+        EXPECT_EQ( buffer, block.data() );
+        EXPECT_EQ( 6, block.size() );
+        block += 10;
+
+        C3::Block< int > copy( block );
+        EXPECT_TRUE( copy.owner() );
+        EXPECT_NE( buffer, copy.data() );
+
+        C3::Block< int > moved( std::move( block ) );
+        EXPECT_FALSE( moved.owner() );
+        EXPECT_EQ( buffer, moved.data() );
+    }
+
+    // Pixels outlive the blocks that wrapped them.
+
+    for( auto i = 0; i < 6; ++i ) EXPECT_EQ( 11 + i, buffer[ i ] );
+
+}
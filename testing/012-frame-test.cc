@@ -1,6 +1,9 @@
 
 #include "gtest/gtest.h"
 
+#include <cstdint>
+#include <vector>
+
 #include "C3_Frame.hh"
 
 TEST( FrameTest, Construct ) 
@@ -93,3 +96,84 @@ TEST( FrameTest, ConvertValueType )
     EXPECT_EQ( 312211, other( 1, 2 ) );
 
 }
+
+TEST( FrameTest, PackedRowPitch ) 
+{
+
+    C3::Frame< double > container( 5, 3 );
+
+    EXPECT_EQ( C3::RowPitch::PACKED, container.row_pitch() );
+    EXPECT_EQ( 5 , container.pitch() );
+    EXPECT_EQ( 15, container.size()  );
+
+}
+
+TEST( FrameTest, AlignedRowPitch ) 
+{
+
+    C3::size_type ncolumns = 2160;
+    C3::size_type nrows    = 3;
+    C3::Frame< double > container( ncolumns, nrows, 1.5, C3::RowPitch::ALIGNED );
+
+    EXPECT_EQ( C3::RowPitch::ALIGNED, container.row_pitch() );
+    EXPECT_EQ( 0, container.pitch() * sizeof( double ) % C3::alignment );
+    EXPECT_LE( ncolumns, container.pitch() );
+    EXPECT_EQ( container.pitch() * nrows, container.size() );
+
+    for( C3::size_type k = 0; k < nrows; ++k )
+    {
+        EXPECT_EQ( 0, reinterpret_cast< std::uintptr_t >( &container( 0, k ) ) % C3::alignment );
+        for( C3::size_type j = 0; j < ncolumns; ++j ) EXPECT_EQ( 1.5, container( j, k ) );
+        for( C3::size_type i = ncolumns; i < container.pitch(); ++i ) EXPECT_EQ( 0.0, container[ i + container.pitch() * k ] );
+    }
+
+}
+
+TEST( FrameTest, AlignedRowPitchConvertValueType ) 
+{
+
+    C3::size_type ncolumns = 7;
+    C3::size_type nrows    = 3;
+    C3::Frame< double > container( ncolumns, nrows, C3::RowPitch::ALIGNED );
+    for( C3::size_type k = 0; k < nrows; ++k )
+    {
+        for( C3::size_type j = 0; j < ncolumns; ++j ) container( j, k ) = j + 10.0 * k;
+    }
+
+    auto other = C3::Frame< int >( container );
+
+    EXPECT_EQ( C3::RowPitch::ALIGNED, other.row_pitch() );
+    EXPECT_EQ( 16, other.pitch() );
+    for( C3::size_type k = 0; k < nrows; ++k )
+    {
+        for( C3::size_type j = 0; j < ncolumns; ++j ) EXPECT_EQ( int( j + 10 * k ), other( j, k ) );
+    }
+
+}
+
+TEST( FrameTest, Adopt ) 
+{
+
+    C3::size_type ncolumns = 5;
+    C3::size_type nrows    = 3;
+    std::vector< float > buffer( 16 * nrows, -1.0f );
+
+    C3::Frame< float > container( buffer.data(), ncolumns, nrows, C3::RowPitch::ALIGNED );
+    EXPECT_FALSE( container.owner() );
+    EXPECT_EQ( 16, container.pitch() );
+    for( C3::size_type k = 0; k < nrows; ++k )
+    {
+        for( C3::size_type j = 0; j < ncolumns; ++j ) container( j, k ) = 2.0f;
+    }
+    container( 4, 2 ) = 3.0f;
+
+    for( C3::size_type k = 0; k < nrows; ++k )
+    {
+        for( C3::size_type i = 0; i < 16; ++i ) 
+        {
+            auto expected = i >= ncolumns ? -1.0f : ( i == 4 && k == 2 ? 3.0f : 2.0f );
+            EXPECT_EQ( expected, buffer[ i + 16 * k ] );
+        }
+    }
+
+}
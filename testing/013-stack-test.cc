@@ -118,3 +118,75 @@ TEST( StackTest, ConvertValueType )
     EXPECT_EQ( 2312211, other( 1, 1, 2 ) );
 
 }
+
+TEST( StackTest, Adopt ) 
+{
+
+    double buffer[ 2 * 3 * 4 ] = {};
+    C3::Stack< double > container( buffer, 2, 3, 4 );
+    EXPECT_FALSE( container.owner() );
+    container = 1.5;
+    container( 1, 2, 3 ) = 4.5;
+
+    EXPECT_EQ( 1.5, buffer[ 0 ] );
+    EXPECT_EQ( 4.5, buffer[ 1 + 2 * ( 2 + 3 * 3 ) ] );
+
+}
+
+// Every layout puts every pixel at its own offset inside the block.
+
+TEST( StackTest, Layouts ) 
+{
+
+    C3::size_type nframes  = 3;
+    C3::size_type ncolumns = 21;
+    C3::size_type nrows    = 2;
+
+    for( auto layout : { C3::StackLayout::INTERLEAVED, C3::StackLayout::PLANAR, C3::StackLayout::TILED } )
+    {
+        C3::Stack< int > container( nframes, ncolumns, nrows, -1, layout );
+        EXPECT_EQ( layout, container.layout() );
+        for( C3::size_type k = 0; k < nrows; ++k )
+        {
+            for( C3::size_type j = 0; j < ncolumns; ++j )
+            {
+                for( C3::size_type i = 0; i < nframes; ++i ) container( i, j, k ) = 1 + i + 10 * j + 1000 * k;
+            }
+        }
+
+        C3::size_type touched = 0;
+        for( auto pixel : container ) touched += pixel > 0;
+        EXPECT_EQ( nframes * ncolumns * nrows, touched );
+
+        auto other = C3::Stack< double >( container );
+        EXPECT_EQ( layout, other.layout() );
+        for( C3::size_type k = 0; k < nrows; ++k )
+        {
+            for( C3::size_type j = 0; j < ncolumns; ++j )
+            {
+                for( C3::size_type i = 0; i < nframes; ++i ) EXPECT_EQ( 1 + i + 10 * j + 1000 * k, other( i, j, k ) );
+            }
+        }
+    }
+
+}
+
+TEST( StackTest, PlanarFramesAreContiguous ) 
+{
+    C3::Stack< float > container( 4, 5, 6, C3::StackLayout::PLANAR );
+    EXPECT_EQ( 5, container.run() );
+    EXPECT_EQ( &container( 0, 0, 0 ) + 5 * 6, &container( 1, 0, 0 ) );
+    EXPECT_EQ( &container( 2, 0, 0 ) + 5    , &container( 2, 0, 1 ) );
+}
+
+TEST( StackTest, TiledPadding ) 
+{
+
+    C3::Stack< float > container( 2, 20, 3, 1.0f, C3::StackLayout::TILED );
+    EXPECT_EQ( C3::stack_tile, container.run() );
+    EXPECT_EQ( 2 * 32 * 3, container.size() );
+    EXPECT_EQ( &container( 0, 0, 0 ) + C3::stack_tile, &container( 1, 0, 0 ) );
+    EXPECT_EQ( 0.0f, *( &container( 1, 19, 2 ) + 1 ) );
+    EXPECT_EQ( 1.0f, container( 1, 19, 2 ) );
+
+}
@@ -1,9 +1,121 @@
 
 #include "gtest/gtest.h"
 
+#include "C3_Operator.hh"
+#include "C3_Row.hh"
+#include "C3_Simd.hh"
 #include "C3_View.hh"
 
 TEST( ViewTest, Constructor )
 {
     EXPECT_EQ( true, true );
 }
+
+TEST( ViewTest, AlignedRowPitch )
+{
+
+    C3::Frame< float > frame( 21, 5, 0.0f, C3::RowPitch::ALIGNED );
+    auto view = C3::View< float >::iraf_style( frame, 3, 10, 2, 4 );
+
+    EXPECT_EQ( 8, view.ncolumns() );
+    EXPECT_EQ( 3, view.nrows()    );
+    EXPECT_EQ( frame.pitch(), view.stride() );
+    EXPECT_EQ( &frame( 2, 1 ), &view( 0, 0 ) );
+    EXPECT_EQ( &frame( 9, 3 ), &view( 7, 2 ) );
+
+    view = 2.0f;
+    for( C3::size_type k = 0; k < frame.nrows(); ++k )
+    {
+        for( C3::size_type j = 0; j < frame.ncolumns(); ++j )
+        {
+            auto inside = j >= 2 && j < 10 && k >= 1 && k < 4;
+            EXPECT_EQ( inside ? 2.0f : 0.0f, frame( j, k ) );
+        }
+    }
+
+}
+
+// Views of views refer to the frame directly.
+
+TEST( ViewTest, SubView )
+{
+
+    C3::Frame< int > frame( 12, 10 );
+    for( C3::size_type k = 0; k < frame.nrows(); ++k )
+    {
+        for( C3::size_type j = 0; j < frame.ncolumns(); ++j ) frame( j, k ) = j + 100 * k;
+    }
+
+    C3::View< int > outer( frame, 8, 7, 2, 1 );
+    C3::View< int > inner( outer, 4, 3, 1, 2 );
+    auto section = C3::View< int >::iraf_style( outer, 2, 5, 3, 5 );
+
+    EXPECT_EQ( 4, inner.ncolumns() );
+    EXPECT_EQ( 3, inner.nrows()    );
+    EXPECT_EQ( frame.data(), inner.data() );
+    EXPECT_EQ( &frame( 3, 3 ), &inner( 0, 0 ) );
+    EXPECT_EQ( &frame( 6, 5 ), &inner( 3, 2 ) );
+    EXPECT_EQ( &inner( 0, 0 ), &section( 0, 0 ) );
+    EXPECT_EQ( &inner( 3, 2 ), &section( 3, 2 ) );
+
+    inner = -1;
+    for( C3::size_type k = 0; k < frame.nrows(); ++k )
+    {
+        for( C3::size_type j = 0; j < frame.ncolumns(); ++j )
+        {
+            auto inside = j >= 3 && j < 7 && k >= 3 && k < 6;
+            EXPECT_EQ( inside ? -1 : int( j + 100 * k ), frame( j, k ) );
+        }
+    }
+
+}
+
+// Every other column and every third row, on either side of assignment and
+// in expressions.
+
+TEST( ViewTest, Strided )
+{
+
+    C3::Frame< double > frame( 11, 9, 0.0 );
+    C3::View< double > strided( frame, 5, 3, 1, 0, 2, 3 );
+
+    EXPECT_EQ( 2, strided.step() );
+    EXPECT_EQ( 3 * frame.pitch(), strided.stride() );
+    EXPECT_EQ( &frame( 9, 6 ), &strided( 4, 2 ) );
+
+    C3::Row< double > row( 5 );
+    for( C3::size_type j = 0; j < row.ncolumns(); ++j ) row( j ) = j;
+    strided = 10.0;
+    strided += row;
+
+    for( C3::size_type k = 0; k < frame.nrows(); ++k )
+    {
+        for( C3::size_type j = 0; j < frame.ncolumns(); ++j )
+        {
+            auto inside = j % 2 == 1 && j < 11 && k % 3 == 0;
+            EXPECT_EQ( inside ? 10.0 + ( j - 1 ) / 2 : 0.0, frame( j, k ) );
+        }
+    }
+
+    C3::Frame< double > small( 5, 3 );
+    C3::assign( small, strided );
+    for( C3::size_type k = 0; k < small.nrows(); ++k )
+    {
+        for( C3::size_type j = 0; j < small.ncolumns(); ++j ) EXPECT_EQ( 10.0 + j, small( j, k ) );
+    }
+
+    C3::View< double > every_other( strided, 3, 3, 0, 0, 2 );
+    EXPECT_EQ( &frame( 9, 6 ), &every_other( 2, 2 ) );
+
+    for( auto isa : { C3::Isa::SCALAR, C3::Isa::AVX2, C3::Isa::AVX512 } )
+    {
+        C3::select_isa( isa );
+        strided = small * 2.0 - strided;
+        for( C3::size_type k = 0; k < small.nrows(); ++k )
+        {
+            for( C3::size_type j = 0; j < small.ncolumns(); ++j ) EXPECT_EQ( small( j, k ), strided( j, k ) );
+        }
+    }
+    C3::select_isa( C3::detected_isa() );
+
+}
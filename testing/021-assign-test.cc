@@ -3,7 +3,9 @@
 
 #include "C3_Block.hh"
 #include "C3_Column.hh"
+#include "C3_Create.hh"
 #include "C3_Frame.hh"
+#include "C3_Operator.hh"
 #include "C3_Row.hh"
 #include "C3_Stack.hh"
 
@@ -153,6 +155,101 @@ TEST( AssignDeathTest, RowToRowMismatchSize )
 
 }
  
+// Frame to frame with different row pitches.
+
+TEST( AssignTest, FrameToFrameRowPitch )
+{
+
+    C3::size_type ncolumns = 5;
+    C3::size_type nrows    = 4;
+    C3::Frame< int    > packed ( ncolumns, nrows );
+    C3::Frame< double > aligned( ncolumns, nrows, C3::RowPitch::ALIGNED );
+
+    for( C3::size_type k = 0; k < nrows; ++k )
+    {
+        for( C3::size_type j = 0; j < ncolumns; ++j ) packed( j, k ) = j + 10 * k;
+    }
+
+    C3::assign( aligned, packed );
+    for( C3::size_type k = 0; k < nrows; ++k )
+    {
+        for( C3::size_type j = 0; j < ncolumns; ++j ) EXPECT_EQ( packed( j, k ), aligned( j, k ) );
+    }
+
+    aligned *= aligned;
+    C3::assign( packed, aligned );
+    for( C3::size_type k = 0; k < nrows; ++k )
+    {
+        for( C3::size_type j = 0; j < ncolumns; ++j ) EXPECT_EQ( int( ( j + 10 * k ) * ( j + 10 * k ) ), packed( j, k ) );
+    }
+
+}
+
+// Row, column, and stack with a padded frame.
+
+TEST( AssignTest, AlignedRowPitchBroadcast )
+{
+
+    C3::size_type nframes  = 3;
+    C3::size_type ncolumns = 5;
+    C3::size_type nrows    = 4;
+    C3::Frame< double > frame( ncolumns, nrows, 0.0, C3::RowPitch::ALIGNED );
+
+    C3::Row< double > row( ncolumns );
+    for( C3::size_type j = 0; j < ncolumns; ++j ) row( j ) = j;
+    C3::Column< double > column( nrows );
+    for( C3::size_type k = 0; k < nrows; ++k ) column( k ) = 10.0 * k;
+
+    frame += row;
+    frame += column;
+
+    C3::Stack< double > stack( nframes, ncolumns, nrows );
+    C3::assign( stack, frame );
+
+    for( C3::size_type k = 0; k < nrows; ++k )
+    {
+        for( C3::size_type j = 0; j < ncolumns; ++j ) 
+        {
+            EXPECT_EQ( j + 10.0 * k, frame( j, k ) );
+            for( C3::size_type i = 0; i < nframes; ++i ) EXPECT_EQ( j + 10.0 * k, stack( i, j, k ) );
+        }
+        for( C3::size_type i = ncolumns; i < frame.pitch(); ++i ) EXPECT_EQ( 0.0, frame[ i + frame.pitch() * k ] );
+    }
+
+}
+
+// Pixels into a padded frame and a tiled stack leave the padding zero.
+
+TEST( AssignTest, PixelPadding )
+{
+
+    C3::size_type nframes  = 3;
+    C3::size_type ncolumns = 5;
+    C3::size_type nrows    = 4;
+
+    C3::Frame< double > frame( ncolumns, nrows, C3::RowPitch::ALIGNED );
+    frame  = 2.0;
+    frame += 1.0;
+    for( C3::size_type k = 0; k < nrows; ++k )
+    {
+        for( C3::size_type j = 0; j < ncolumns; ++j ) EXPECT_EQ( 3.0, frame( j, k ) );
+        for( C3::size_type i = ncolumns; i < frame.pitch(); ++i ) EXPECT_EQ( 0.0, frame[ i + frame.pitch() * k ] );
+    }
+
+    C3::Stack< float > stack( nframes, C3::stack_tile + ncolumns, nrows, C3::StackLayout::TILED );
+    stack  = 2.0f;
+    stack += 1.0f;
+    C3::size_type count = 0;
+    for( C3::size_type n = 0; n < stack.size(); ++n )
+    {
+        if( stack[ n ] == 0.0f ) continue;
+        EXPECT_EQ( 3.0f, stack[ n ] );
+        ++count;
+    }
+    EXPECT_EQ( nframes * stack.ncolumns() * nrows, count );
+
+}
+
 // Frame to frame wrong size.
 
 TEST( AssignDeathTest, FrameToFrameMismatchSize )
@@ -184,3 +281,48 @@ TEST( AssignDeathTest, FrameToFrameMismatchShape )
     EXPECT_DEATH( C3::assign( container2, container1 ), "" );
 
 }
+
+// Frame to stack and stack to stack, every layout.
+
+TEST( AssignTest, StackLayouts )
+{
+
+    C3::size_type nframes  = 3;
+    C3::size_type ncolumns = 37;
+    C3::size_type nrows    = 4;
+
+    C3::Frame< float > frame( ncolumns, nrows, C3::RowPitch::ALIGNED );
+    for( C3::size_type k = 0; k < nrows; ++k )
+    {
+        for( C3::size_type j = 0; j < ncolumns; ++j ) frame( j, k ) = j + 100.0f * k;
+    }
+
+    C3::Stack< double > reference( nframes, ncolumns, nrows, 1.0 );
+    reference += frame;
+
+    for( auto layout : { C3::StackLayout::INTERLEAVED, C3::StackLayout::PLANAR, C3::StackLayout::TILED } )
+    {
+        C3::Stack< double > stack( nframes, ncolumns, nrows, 1.0, layout );
+        stack += frame;
+
+        auto copy = C3::create( stack );
+        EXPECT_EQ( layout, copy.layout() );
+        EXPECT_TRUE( C3::congruent( copy, stack ) );
+        EXPECT_EQ( layout == C3::StackLayout::INTERLEAVED, C3::congruent( reference, stack ) );
+        C3::assign( copy, reference );
+        copy -= stack;
+
+        for( C3::size_type k = 0; k < nrows; ++k )
+        {
+            for( C3::size_type j = 0; j < ncolumns; ++j ) 
+            {
+                for( C3::size_type i = 0; i < nframes; ++i ) 
+                {
+                    EXPECT_EQ( 1.0 + frame( j, k ), stack( i, j, k ) );
+                    EXPECT_EQ( 0.0, copy( i, j, k ) );
+                }
+            }
+        }
+    }
+
+}
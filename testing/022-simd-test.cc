@@ -0,0 +1,155 @@
+#include "gtest/gtest.h"
+
+#include "C3_Block.hh"
+#include "C3_Operator.hh"
+#include "C3_Simd.hh"
+
+// Instruction sets this processor can run, least capable first.
+
+std::vector< C3::Isa > available_isas()
+{
+    std::vector< C3::Isa > isas;
+    for( auto isa : { C3::Isa::SCALAR, C3::Isa::AVX2, C3::Isa::AVX512 } )
+    {
+        if( isa <= C3::detected_isa() ) isas.push_back( isa );
+    }
+    return isas;
+}
+
+// Fill a block with values that exercise sign, fractions, and magnitude.
+
+template< class T >
+void fill_block( C3::Block< T >& block, const double offset )
+{
+    for( C3::size_type i = 0; i < block.size(); ++i ) block[ i ] = static_cast< T >( offset + 1.25 * i - 0.5 * ( i % 7 ) );
+}
+
+// Compare every binary operator against a scalar reference computed in place,
+// for every instruction set.  Size is not a multiple of any vector width.
+
+template< class T, class U >
+void check_kernels()
+{
+
+    C3::size_type size = 37;
+    C3::Block< U > src( size );
+    fill_block( src, 3.0 );
+
+    for( auto isa : available_isas() )
+    {
+
+        C3::select_isa( isa );
+
+        C3::Block< T > dest( size );
+        C3::Block< T > expected( size );
+
+        fill_block( dest, 100.0 );
+        dest = src;
+        for( C3::size_type i = 0; i < size; ++i ) EXPECT_EQ( static_cast< T >( src[ i ] ), dest[ i ] ) << C3::isa_string( isa );
+
+        fill_block( dest, 100.0 );
+        fill_block( expected, 100.0 );
+        dest += src;
+        for( C3::size_type i = 0; i < size; ++i ) expected[ i ] = expected[ i ] + static_cast< T >( src[ i ] );
+        for( C3::size_type i = 0; i < size; ++i ) EXPECT_EQ( expected[ i ], dest[ i ] ) << C3::isa_string( isa );
+
+        dest -= src;
+        for( C3::size_type i = 0; i < size; ++i ) expected[ i ] = expected[ i ] - static_cast< T >( src[ i ] );
+        for( C3::size_type i = 0; i < size; ++i ) EXPECT_EQ( expected[ i ], dest[ i ] ) << C3::isa_string( isa );
+
+        dest *= src;
+        for( C3::size_type i = 0; i < size; ++i ) expected[ i ] = expected[ i ] * static_cast< T >( src[ i ] );
+        for( C3::size_type i = 0; i < size; ++i ) EXPECT_EQ( expected[ i ], dest[ i ] ) << C3::isa_string( isa );
+
+        dest += U( 3 );
+        for( C3::size_type i = 0; i < size; ++i ) expected[ i ] = expected[ i ] + static_cast< T >( U( 3 ) );
+        for( C3::size_type i = 0; i < size; ++i ) EXPECT_EQ( expected[ i ], dest[ i ] ) << C3::isa_string( isa );
+
+        dest = U( 7 );
+        for( C3::size_type i = 0; i < size; ++i ) EXPECT_EQ( static_cast< T >( U( 7 ) ), dest[ i ] ) << C3::isa_string( isa );
+
+    }
+
+    C3::select_isa( C3::detected_isa() );
+
+}
+
+// Division is only checked where the divisor never truncates to zero.
+
+template< class T, class U >
+void check_division()
+{
+
+    C3::size_type size = 41;
+    C3::Block< U > src( size );
+    for( C3::size_type i = 0; i < size; ++i ) src[ i ] = static_cast< U >( 1.5 + i );
+
+    for( auto isa : available_isas() )
+    {
+
+        C3::select_isa( isa );
+
+        C3::Block< T > dest( size );
+        C3::Block< T > expected( size );
+        fill_block( dest, 100.0 );
+        fill_block( expected, 100.0 );
+
+        dest /= src;
+        for( C3::size_type i = 0; i < size; ++i ) expected[ i ] = expected[ i ] / static_cast< T >( src[ i ] );
+        for( C3::size_type i = 0; i < size; ++i ) EXPECT_EQ( expected[ i ], dest[ i ] ) << C3::isa_string( isa );
+
+        dest /= U( 4 );
+        for( C3::size_type i = 0; i < size; ++i ) expected[ i ] = expected[ i ] / static_cast< T >( U( 4 ) );
+        for( C3::size_type i = 0; i < size; ++i ) EXPECT_EQ( expected[ i ], dest[ i ] ) << C3::isa_string( isa );
+
+    }
+
+    C3::select_isa( C3::detected_isa() );
+
+}
+
+TEST( SimdTest, SelectIsaClampsToDetected )
+{
+    EXPECT_EQ( C3::Isa::SCALAR, C3::select_isa( C3::Isa::SCALAR ) );
+    EXPECT_EQ( C3::detected_isa(), C3::select_isa( C3::Isa::AVX512 ) );
+    EXPECT_EQ( C3::detected_isa(), C3::isa() );
+}
+
+TEST( SimdTest, IsaStrings )
+{
+    for( auto isa : { C3::Isa::SCALAR, C3::Isa::AVX2, C3::Isa::AVX512 } )
+    {
+        EXPECT_EQ( isa, C3::isa_enum( C3::isa_string( isa ) ) );
+    }
+    EXPECT_EQ( C3::Isa::AVX2  , C3::isa_enum( "avx2" ) );
+    EXPECT_EQ( C3::Isa::SCALAR, C3::isa_enum( "sse"  ) );
+}
+
+TEST( SimdTest, SameValueType )
+{
+    check_kernels< double, double >();
+    check_kernels< float , float  >();
+    check_kernels< int   , int    >();
+    check_division< double, double >();
+    check_division< float , float  >();
+}
+
+TEST( SimdTest, MixedValueType )
+{
+    check_kernels< double, float  >();
+    check_kernels< double, int    >();
+    check_kernels< float , double >();
+    check_kernels< float , int    >();
+    check_kernels< int   , double >();
+    check_kernels< int   , float  >();
+    check_division< double, float  >();
+    check_division< float , double >();
+    check_division< double, int    >();
+}
+
+TEST( SimdTest, ScalarFallback )
+{
+    check_kernels< unsigned short int, double >();
+    check_kernels< long int, int >();
+    check_division< int, int >();
+}
@@ -0,0 +1,263 @@
+#include "gtest/gtest.h"
+
+#include "C3_Block.hh"
+#include "C3_Column.hh"
+#include "C3_Frame.hh"
+#include "C3_Operator.hh"
+#include "C3_Row.hh"
+#include "C3_Simd.hh"
+#include "C3_Stack.hh"
+#include "C3_View.hh"
+
+// Fill a frame with distinct values.
+
+template< class T >
+void fill_frame( C3::Frame< T >& frame, const double offset )
+{
+    for( C3::size_type k = 0; k < frame.nrows(); ++k )
+    {
+        for( C3::size_type j = 0; j < frame.ncolumns(); ++j ) frame( j, k ) = static_cast< T >( offset + j + 0.5 * k );
+    }
+}
+
+// Block expression, every operator, every instruction set.
+
+TEST( ExpressionTest, Block )
+{
+
+    C3::size_type size = 37;
+    C3::Block< double > a( size );
+    C3::Block< double > b( size );
+    for( C3::size_type i = 0; i < size; ++i ) a[ i ] = 1.0 + i;
+    for( C3::size_type i = 0; i < size; ++i ) b[ i ] = 2.0 + 0.25 * i;
+
+    for( auto isa : { C3::Isa::SCALAR, C3::Isa::AVX2, C3::Isa::AVX512 } )
+    {
+        C3::select_isa( isa );
+        C3::Block< double > dest( size );
+        dest = 2.0 * ( a + b ) - a / b + 1.0;
+        for( C3::size_type i = 0; i < size; ++i ) EXPECT_DOUBLE_EQ( 2.0 * ( a[ i ] + b[ i ] ) - a[ i ] / b[ i ] + 1.0, dest[ i ] );
+        dest = -a * b;
+        for( C3::size_type i = 0; i < size; ++i ) EXPECT_DOUBLE_EQ( -a[ i ] * b[ i ], dest[ i ] );
+    }
+    C3::select_isa( C3::detected_isa() );
+
+}
+
+// Compound assignment of an expression.
+
+TEST( ExpressionTest, CompoundAssignment )
+{
+
+    C3::size_type ncolumns = 5;
+    C3::size_type nrows    = 3;
+    C3::Frame< double > a( ncolumns, nrows );
+    C3::Frame< double > dest( ncolumns, nrows, 1.0 );
+    fill_frame( a, 1.0 );
+
+    dest += a * a;
+    for( C3::size_type k = 0; k < nrows; ++k )
+    {
+        for( C3::size_type j = 0; j < ncolumns; ++j ) EXPECT_DOUBLE_EQ( 1.0 + a( j, k ) * a( j, k ), dest( j, k ) );
+    }
+
+    dest /= a + 1.0;
+    for( C3::size_type k = 0; k < nrows; ++k )
+    {
+        for( C3::size_type j = 0; j < ncolumns; ++j )
+        {
+            EXPECT_DOUBLE_EQ( ( 1.0 + a( j, k ) * a( j, k ) ) / ( a( j, k ) + 1.0 ), dest( j, k ) );
+        }
+    }
+
+}
+
+// Destination may appear in its own expression.
+
+TEST( ExpressionTest, Aliasing )
+{
+
+    C3::size_type size = 11;
+    C3::Block< float > dest( size );
+    for( C3::size_type i = 0; i < size; ++i ) dest[ i ] = 1.0f + i;
+
+    dest = dest * dest - dest;
+    for( C3::size_type i = 0; i < size; ++i ) EXPECT_FLOAT_EQ( ( 1.0f + i ) * ( 1.0f + i ) - ( 1.0f + i ), dest[ i ] );
+
+}
+
+// Overscan-style correction: row and column operands broadcast over a frame.
+
+TEST( ExpressionTest, FrameWithRowAndColumn )
+{
+
+    C3::size_type ncolumns = 7;
+    C3::size_type nrows    = 4;
+    C3::Frame< float > input( ncolumns, nrows );
+    fill_frame( input, 10.0 );
+
+    C3::Column< double > bias( nrows );
+    for( C3::size_type k = 0; k < nrows; ++k ) bias( k ) = 0.5 * k;
+
+    C3::Row< double > gain( ncolumns );
+    for( C3::size_type j = 0; j < ncolumns; ++j ) gain( j ) = 1.0 + 0.1 * j;
+
+    C3::Frame< double > output( ncolumns, nrows );
+    output = gain * ( input - bias );
+
+    for( C3::size_type k = 0; k < nrows; ++k )
+    {
+        for( C3::size_type j = 0; j < ncolumns; ++j )
+        {
+            EXPECT_DOUBLE_EQ( gain( j ) * ( input( j, k ) - bias( k ) ), output( j, k ) );
+        }
+    }
+
+}
+
+// View destination and operands.
+
+TEST( ExpressionTest, View )
+{
+
+    C3::size_type ncolumns = 6;
+    C3::size_type nrows    = 5;
+    C3::Frame< double > frame( ncolumns, nrows, -1.0 );
+    C3::Frame< double > other( ncolumns, nrows );
+    fill_frame( other, 3.0 );
+
+    auto dest = C3::View< double >( frame, 3, 2, 1, 2 );
+    auto src  = C3::View< double >( other, 3, 2, 2, 1 );
+    C3::Frame< double > small( 3, 2 );
+    fill_frame( small, 100.0 );
+
+    dest = src + small;
+
+    for( C3::size_type k = 0; k < nrows; ++k )
+    {
+        for( C3::size_type j = 0; j < ncolumns; ++j )
+        {
+            if( j >= 1 && j < 4 && k >= 2 && k < 4 )
+            {
+                EXPECT_DOUBLE_EQ( other( j + 1, k - 1 ) + small( j - 1, k - 2 ), frame( j, k ) );
+            }
+            else
+            {
+                EXPECT_DOUBLE_EQ( -1.0, frame( j, k ) );
+            }
+        }
+    }
+
+}
+
+// Stack destination with frame, row, and column operands broadcast over frames.
+
+TEST( ExpressionTest, Stack )
+{
+
+    C3::size_type nframes  = 9;
+    C3::size_type ncolumns = 3;
+    C3::size_type nrows    = 2;
+    C3::Stack< double > input( nframes, ncolumns, nrows );
+    for( C3::size_type i = 0; i < input.size(); ++i ) input[ i ] = 0.5 * i;
+
+    C3::Frame< double > flat( ncolumns, nrows );
+    fill_frame( flat, 1.0 );
+
+    C3::Row< int > row( ncolumns );
+    for( C3::size_type j = 0; j < ncolumns; ++j ) row( j ) = j;
+
+    C3::Column< float > column( nrows );
+    for( C3::size_type k = 0; k < nrows; ++k ) column( k ) = 10.0f * k;
+
+    C3::Stack< double > output( nframes, ncolumns, nrows );
+    output = input / flat + row - column;
+
+    for( C3::size_type k = 0; k < nrows; ++k )
+    {
+        for( C3::size_type j = 0; j < ncolumns; ++j )
+        {
+            for( C3::size_type i = 0; i < nframes; ++i )
+            {
+                EXPECT_DOUBLE_EQ( input( i, j, k ) / flat( j, k ) + row( j ) - column( k ), output( i, j, k ) );
+            }
+        }
+    }
+
+}
+
+// Planar and tiled stack destinations go by runs of columns.
+
+TEST( ExpressionTest, StackLayouts )
+{
+
+    C3::size_type nframes  = 5;
+    C3::size_type ncolumns = 35;
+    C3::size_type nrows    = 3;
+
+    C3::Frame< double > flat( ncolumns, nrows );
+    fill_frame( flat, 1.0 );
+
+    C3::Frame< double > bigger( ncolumns + 4, nrows + 1 );
+    fill_frame( bigger, 7.0 );
+    auto view = C3::View< double >( bigger, ncolumns, nrows, 3, 1 );
+
+    C3::Row< int > row( ncolumns );
+    for( C3::size_type j = 0; j < ncolumns; ++j ) row( j ) = j;
+
+    C3::Column< float > column( nrows );
+    for( C3::size_type k = 0; k < nrows; ++k ) column( k ) = 10.0f * k;
+
+    for( auto layout : { C3::StackLayout::PLANAR, C3::StackLayout::TILED } )
+    {
+        C3::Stack< double > input( nframes, ncolumns, nrows, layout );
+        for( C3::size_type i = 0; i < input.size(); ++i ) input[ i ] = 0.5 * i;
+
+        C3::Stack< float > output( nframes, ncolumns, nrows, layout );
+        output = input / flat + row - column * view;
+
+        for( C3::size_type k = 0; k < nrows; ++k )
+        {
+            for( C3::size_type j = 0; j < ncolumns; ++j )
+            {
+                for( C3::size_type i = 0; i < nframes; ++i )
+                {
+                    auto expected = input( i, j, k ) / flat( j, k ) + row( j ) - column( k ) * view( j, k );
+                    EXPECT_FLOAT_EQ( expected, output( i, j, k ) );
+                }
+            }
+        }
+    }
+
+}
+
+// Mixed value types follow the usual arithmetic promotion until assignment.
+
+TEST( ExpressionTest, MixedValueType )
+{
+
+    C3::size_type size = 19;
+    C3::Block< int > a( size );
+    C3::Block< float > b( size );
+    for( C3::size_type i = 0; i < size; ++i ) a[ i ] = i;
+    for( C3::size_type i = 0; i < size; ++i ) b[ i ] = 0.5f;
+
+    C3::Block< double > dest( size );
+    dest = a / 2 + a * b;
+    for( C3::size_type i = 0; i < size; ++i ) EXPECT_DOUBLE_EQ( double( int( i ) / 2 + int( i ) * 0.5f ), dest[ i ] );
+
+    C3::Block< int > truncated( size );
+    truncated = a * b;
+    for( C3::size_type i = 0; i < size; ++i ) EXPECT_EQ( int( i * 0.5f ), truncated[ i ] );
+
+}
+
+// Operands must be congruent with the destination.
+
+TEST( ExpressionDeathTest, Incongruent )
+{
+    C3::Frame< double > dest( 4, 3 );
+    C3::Frame< double > a( 4, 3 );
+    C3::Row< double > row( 5 );
+    EXPECT_DEATH( dest = a + row, "" );
+}
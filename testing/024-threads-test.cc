@@ -0,0 +1,248 @@
+#include "gtest/gtest.h"
+
+#include "C3_Block.hh"
+#include "C3_Column.hh"
+#include "C3_Frame.hh"
+#include "C3_Memory.hh"
+#include "C3_Operator.hh"
+#include "C3_Row.hh"
+#include "C3_Stack.hh"
+#include "C3_Threads.hh"
+#include "C3_View.hh"
+
+// Force threading for any size, restore serial defaults on exit.
+
+class ThreadsTest : public ::testing::Test
+{
+
+    protected :
+
+        void SetUp()
+        {
+            _threads   = C3::threads();
+            _threshold = C3::thread_threshold();
+            C3::select_threads( 4 );
+            C3::select_thread_threshold( 0 );
+        }
+
+        void TearDown()
+        {
+            C3::select_threads( _threads );
+            C3::select_thread_threshold( _threshold );
+        }
+
+        int             _threads;
+        C3::size_type   _threshold;
+
+};
+
+// Fill a frame with distinct values.
+
+template< class T >
+void fill_frame( C3::Frame< T >& frame, const double offset )
+{
+    for( C3::size_type k = 0; k < frame.nrows(); ++k )
+    {
+        for( C3::size_type j = 0; j < frame.ncolumns(); ++j ) frame( j, k ) = static_cast< T >( offset + j + 0.5 * k );
+    }
+}
+
+TEST( ThreadsSettingsTest, SelectThreadsClampsToOne )
+{
+    auto nthreads = C3::threads();
+    EXPECT_EQ( 1, C3::select_threads(  0 ) );
+    EXPECT_EQ( 1, C3::select_threads( -3 ) );
+    EXPECT_EQ( 8, C3::select_threads(  8 ) );
+    C3::select_threads( nthreads );
+}
+
+// Bands cover every item once, in order, on grain boundaries.
+
+TEST( ThreadsSettingsTest, Bands )
+{
+    for( C3::size_type count : { 0, 1, 7, 16, 100, 1001 } )
+    {
+        for( int nthreads : { 1, 2, 3, 8 } )
+        {
+            C3::size_type expected = 0;
+            for( int rank = 0; rank < nthreads; ++rank )
+            {
+                auto band = C3::detail::_band( count, rank, nthreads, 8 );
+                EXPECT_EQ( expected, band.first );
+                EXPECT_LE( band.first, band.second );
+                if( band.second < count )
+                {
+                    EXPECT_EQ( 0, band.second % 8 );
+                }
+                expected = band.second;
+            }
+            EXPECT_EQ( count, expected );
+        }
+    }
+}
+
+TEST_F( ThreadsTest, PixelToContainers )
+{
+
+    C3::Block< double > block( 1001 );
+    block = 2.0;
+    block += 1.5;
+    for( C3::size_type i = 0; i < block.size(); ++i ) EXPECT_EQ( 3.5, block[ i ] );
+
+    C3::Frame< int > frame( 9, 7, 0 );
+    auto view = C3::View< int >( frame, 4, 3, 2, 1 );
+    view = 5;
+    for( C3::size_type k = 0; k < frame.nrows(); ++k )
+    {
+        for( C3::size_type j = 0; j < frame.ncolumns(); ++j )
+        {
+            auto inside = j >= 2 && j < 6 && k >= 1 && k < 4;
+            EXPECT_EQ( inside ? 5 : 0, frame( j, k ) );
+        }
+    }
+
+}
+
+TEST_F( ThreadsTest, SameContainer )
+{
+    C3::Block< float > src( 333 );
+    for( C3::size_type i = 0; i < src.size(); ++i ) src[ i ] = 0.5f * i;
+    C3::Block< double > dest( 333, 1.0 );
+    dest -= src;
+    for( C3::size_type i = 0; i < src.size(); ++i ) EXPECT_EQ( 1.0 - 0.5f * i, dest[ i ] );
+}
+
+TEST_F( ThreadsTest, RowBands )
+{
+
+    C3::size_type ncolumns = 11;
+    C3::size_type nrows    = 13;
+
+    C3::Row< double > row( ncolumns );
+    for( C3::size_type j = 0; j < ncolumns; ++j ) row( j ) = j;
+
+    C3::Column< double > column( nrows );
+    for( C3::size_type k = 0; k < nrows; ++k ) column( k ) = 100.0 * k;
+
+    C3::Frame< double > frame( ncolumns, nrows, 0.0 );
+    frame += row;
+    frame += column;
+    for( C3::size_type k = 0; k < nrows; ++k )
+    {
+        for( C3::size_type j = 0; j < ncolumns; ++j ) EXPECT_EQ( row( j ) + column( k ), frame( j, k ) );
+    }
+
+    C3::Frame< double > other( ncolumns + 3, nrows + 2, -1.0 );
+    auto view = C3::View< double >( other, ncolumns, nrows, 1, 2 );
+    C3::assign( view, frame );
+    view *= 2.0;
+    for( C3::size_type k = 0; k < nrows; ++k )
+    {
+        for( C3::size_type j = 0; j < ncolumns; ++j ) EXPECT_EQ( 2.0 * frame( j, k ), other( j + 1, k + 2 ) );
+    }
+
+    C3::Frame< double > copy( ncolumns, nrows );
+    C3::assign( copy, view );
+    for( C3::size_type k = 0; k < nrows; ++k )
+    {
+        for( C3::size_type j = 0; j < ncolumns; ++j ) EXPECT_EQ( 2.0 * frame( j, k ), copy( j, k ) );
+    }
+
+}
+
+TEST_F( ThreadsTest, Stack )
+{
+
+    C3::size_type nframes  = 5;
+    C3::size_type ncolumns = 6;
+    C3::size_type nrows    = 7;
+
+    C3::Frame< double > frame( ncolumns, nrows );
+    fill_frame( frame, 1.0 );
+
+    C3::Stack< double > stack( nframes, ncolumns, nrows );
+    C3::assign( stack, frame );
+    for( C3::size_type k = 0; k < nrows; ++k )
+    {
+        for( C3::size_type j = 0; j < ncolumns; ++j )
+        {
+            for( C3::size_type i = 0; i < nframes; ++i ) EXPECT_EQ( frame( j, k ), stack( i, j, k ) );
+        }
+    }
+
+    C3::Frame< double > big( ncolumns + 2, nrows + 1 );
+    fill_frame( big, 50.0 );
+    auto view = C3::View< double >( big, ncolumns, nrows, 2, 1 );
+    stack += view;
+    for( C3::size_type k = 0; k < nrows; ++k )
+    {
+        for( C3::size_type j = 0; j < ncolumns; ++j )
+        {
+            for( C3::size_type i = 0; i < nframes; ++i ) EXPECT_EQ( frame( j, k ) + big( j + 2, k + 1 ), stack( i, j, k ) );
+        }
+    }
+
+}
+
+TEST_F( ThreadsTest, Expressions )
+{
+
+    C3::Block< double > a( 517 );
+    for( C3::size_type i = 0; i < a.size(); ++i ) a[ i ] = 1.0 + i;
+    C3::Block< double > b( 517 );
+    b = a * a - 2.0;
+    for( C3::size_type i = 0; i < a.size(); ++i ) EXPECT_EQ( a[ i ] * a[ i ] - 2.0, b[ i ] );
+
+    C3::Frame< double > frame( 9, 10 );
+    fill_frame( frame, 3.0 );
+    C3::Row< double > row( 9, 2.0 );
+    C3::Frame< double > output( 9, 10 );
+    output = frame * row + 1.0;
+    for( C3::size_type k = 0; k < frame.nrows(); ++k )
+    {
+        for( C3::size_type j = 0; j < frame.ncolumns(); ++j ) EXPECT_EQ( frame( j, k ) * 2.0 + 1.0, output( j, k ) );
+    }
+
+}
+
+// First touch fills in the same bands the kernels use, and leaves the same
+// contents as the serial constructors.
+
+TEST_F( ThreadsTest, FirstTouch )
+{
+
+    auto enable = C3::first_touch();
+    EXPECT_TRUE( C3::select_first_touch( true ) );
+
+    C3::Block< double > block( 1000 );
+    for( C3::size_type i = 0; i < block.size(); ++i ) EXPECT_EQ( 0.0, block[ i ] );
+
+    C3::Frame< float > frame( 13, 9, C3::RowPitch::ALIGNED );
+    C3::Frame< float > filled( 13, 9, 2.5f, C3::RowPitch::ALIGNED );
+    for( C3::size_type k = 0; k < frame.nrows(); ++k )
+    {
+        for( C3::size_type i = 0; i < frame.pitch(); ++i ) 
+        {
+            EXPECT_EQ( 0.0f, frame[ i + frame.pitch() * k ] );
+            EXPECT_EQ( i < frame.ncolumns() ? 2.5f : 0.0f, filled[ i + filled.pitch() * k ] );
+        }
+    }
+
+    for( auto layout : { C3::StackLayout::INTERLEAVED, C3::StackLayout::PLANAR, C3::StackLayout::TILED } )
+    {
+        C3::Stack< int > stack( 3, 21, 5, 7, layout );
+        C3::size_type count = 0;
+        for( auto pixel : stack ) count += pixel == 7;
+        EXPECT_EQ( 3 * 21 * 5, count );
+        for( auto pixel : stack ) EXPECT_TRUE( pixel == 7 || pixel == 0 );
+    }
+
+    // Every page of a first-touched frame is placed.
+
+    C3::Frame< double > big( 2048, 512 );
+    auto nodes = C3::page_nodes( big.data(), big.size() * sizeof( double ) );
+    for( auto node : nodes ) EXPECT_LE( 0, node );
+
+    C3::select_first_touch( enable );
+
+}
@@ -0,0 +1,336 @@
+#include <cerrno>
+#include <cstdint>
+#include <new>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "C3_Block.hh"
+#include "C3_Frame.hh"
+#include "C3_Memory.hh"
+#include "C3_Operator.hh"
+#include "C3_Stack.hh"
+#include "C3_Threads.hh"
+
+// Select a pool for the duration of a test.
+
+class MemoryTest : public ::testing::Test
+{
+
+    protected :
+
+        void SetUp()    { C3::select_memory_resource( &_pool ); }
+        void TearDown() { C3::select_memory_resource( nullptr ); }
+
+        C3::BufferPool  _pool;
+
+};
+
+TEST( MemoryResourceTest, DefaultResource )
+{
+    EXPECT_EQ( &C3::default_resource(), &C3::memory_resource() );
+    C3::BufferPool pool;
+    EXPECT_EQ( &C3::default_resource(), &C3::select_memory_resource( &pool ) );
+    EXPECT_EQ( &pool, &C3::memory_resource() );
+    EXPECT_EQ( &pool, &C3::select_memory_resource( nullptr ) );
+    EXPECT_EQ( &C3::default_resource(), &C3::memory_resource() );
+}
+
+TEST_F( MemoryTest, RecycleSameSize )
+{
+
+    const int* first = nullptr;
+    {
+        C3::Block< int > block( 100 );
+        first = block.data();
+    }
+
+    auto statistics = _pool.statistics();
+    EXPECT_EQ( 0  , statistics.hits         );
+    EXPECT_EQ( 1  , statistics.misses       );
+    EXPECT_EQ( 0  , statistics.bytes_in_use );
+    EXPECT_EQ( 400, statistics.bytes_cached );
+
+    // Same size in bytes, different value type: recycled.
+
+    {
+        C3::Block< float > block( 100 );
+        EXPECT_EQ( reinterpret_cast< const void* >( first ), reinterpret_cast< const void* >( block.data() ) );
+        EXPECT_EQ( 400, _pool.statistics().bytes_in_use );
+    }
+
+    // Different size: not recycled.
+
+    {
+        C3::Block< int > block( 101 );
+        EXPECT_EQ( 0, reinterpret_cast< std::uintptr_t >( block.data() ) % C3::alignment );
+    }
+
+    statistics = _pool.statistics();
+    EXPECT_EQ( 1, statistics.hits   );
+    EXPECT_EQ( 2, statistics.misses );
+
+}
+
+// Frames built for every task reach a steady state with no misses.
+
+TEST_F( MemoryTest, SteadyState )
+{
+
+    for( auto task = 0; task < 5; ++task )
+    {
+        C3::Frame< double > input ( 2160, 40 );
+        C3::Frame< double > output( 2048, 40 );
+        C3::Frame< double > invvar( 2048, 40 );
+        C3::Frame< unsigned short > flags( 2048, 40 );
+        output = invvar = 1.0;
+        if( task == 0 ) _pool.reset_statistics();
+    }
+
+    auto statistics = _pool.statistics();
+    EXPECT_EQ( 16, statistics.hits   );
+    EXPECT_EQ( 0 , statistics.misses );
+
+}
+
+// Storage goes back to the resource a block came from.
+
+TEST_F( MemoryTest, MoveAcrossResources )
+{
+
+    C3::select_memory_resource( nullptr );
+    C3::Block< double > outside( 10 );
+    C3::select_memory_resource( &_pool );
+
+    {
+        C3::Block< double > inside( 20 );
+        inside = std::move( outside );
+    }
+
+    auto statistics = _pool.statistics();
+    EXPECT_EQ( 1  , statistics.misses       );
+    EXPECT_EQ( 0  , statistics.bytes_in_use );
+    EXPECT_EQ( 160, statistics.bytes_cached );
+
+    _pool.release();
+    EXPECT_EQ( 0, _pool.statistics().bytes_cached );
+
+}
+
+// Storage the upstream resource fails to give is not counted in use.
+
+TEST( BufferPoolTest, FailedUpstream )
+{
+
+    class Exhausted : public C3::MemoryResource
+    {
+        public :
+            void* allocate( const C3::size_type ) { throw std::bad_alloc(); }
+            void deallocate( void*, const C3::size_type ) {}
+    };
+
+    Exhausted exhausted;
+    C3::BufferPool pool( &exhausted );
+    EXPECT_THROW( pool.allocate( 4096 ), std::bad_alloc );
+
+    auto statistics = pool.statistics();
+    EXPECT_EQ( 0, statistics.misses       );
+    EXPECT_EQ( 0, statistics.bytes_in_use );
+
+}
+
+// Mapped storage behaves like any other.
+
+TEST( MappedResourceTest, Anonymous )
+{
+
+    C3::MappedResource mapped;
+    auto& previous = C3::select_memory_resource( &mapped );
+    C3::Stack< float > stack( 3, 17, 5 );
+    C3::select_memory_resource( &previous );
+
+    EXPECT_EQ( 0, reinterpret_cast< std::uintptr_t >( stack.data() ) % C3::alignment );
+
+    C3::Frame< float > frame( 17, 5 );
+    for( C3::size_type k = 0; k < frame.nrows(); ++k )
+    {
+        for( C3::size_type j = 0; j < frame.ncolumns(); ++j ) frame( j, k ) = j + 100.0f * k;
+    }
+    C3::assign( stack, frame );
+    stack *= 2.0f;
+    for( C3::size_type k = 0; k < frame.nrows(); ++k )
+    {
+        for( C3::size_type j = 0; j < frame.ncolumns(); ++j )
+        {
+            for( C3::size_type i = 0; i < stack.nframes(); ++i ) EXPECT_EQ( 2.0f * frame( j, k ), stack( i, j, k ) );
+        }
+    }
+
+}
+
+TEST( MappedResourceTest, FileBacked )
+{
+
+    C3::MappedResource mapped( "/tmp", C3::MappedResource::RANDOM );
+    EXPECT_EQ( "/tmp", mapped.directory() );
+    EXPECT_EQ( C3::MappedResource::RANDOM, mapped.advice() );
+
+    auto& previous = C3::select_memory_resource( &mapped );
+    C3::Block< double > block( 100000, 1.5 );
+    C3::Block< double > empty( 0 );
+    C3::select_memory_resource( &previous );
+
+    block += 1.0;
+    for( C3::size_type i = 0; i < block.size(); ++i ) EXPECT_EQ( 2.5, block[ i ] );
+    EXPECT_NE( nullptr, empty.data() );
+
+}
+
+// A named file keeps its cube for the next resource, and holds later
+// allocations after it, page by page.
+
+TEST( MappedResourceTest, Named )
+{
+
+    const auto path = "/tmp/C3-named-" + std::to_string( getpid() );
+    const auto page = static_cast< C3::size_type >( sysconf( _SC_PAGESIZE ) );
+    {
+        C3::MappedResource mapped( path, C3::MappedResource::NAMED );
+        EXPECT_EQ( path, mapped.directory() );
+        EXPECT_EQ( C3::MappedResource::NAMED, mapped.backing() );
+
+        auto& previous = C3::select_memory_resource( &mapped );
+        C3::Frame< float > frame( 17, 5 );
+        C3::Block< char > block( 10 );
+        C3::select_memory_resource( &previous );
+        for( C3::size_type k = 0; k < frame.nrows(); ++k )
+        {
+            for( C3::size_type j = 0; j < frame.ncolumns(); ++j ) frame( j, k ) = j + 100.0f * k;
+        }
+    }
+
+    struct stat status;
+    ASSERT_EQ( 0, stat( path.c_str(), &status ) );
+    EXPECT_EQ( ( 17 * 5 * sizeof( float ) + page - 1 ) / page * page + 10, C3::size_type( status.st_size ) );
+    {
+        C3::MappedResource mapped( path, C3::MappedResource::NAMED );
+        auto& previous = C3::select_memory_resource( &mapped );
+        C3::Frame< float > frame( 17, 5 );
+        C3::select_memory_resource( &previous );
+        for( C3::size_type k = 0; k < frame.nrows(); ++k )
+        {
+            for( C3::size_type j = 0; j < frame.ncolumns(); ++j ) EXPECT_EQ( j + 100.0f * k, frame( j, k ) );
+        }
+    }
+    unlink( path.c_str() );
+
+    EXPECT_THROW( C3::MappedResource( "", C3::MappedResource::NAMED ), C3::Exception );
+    C3::MappedResource missing( "/nonexistent/C3/cube", C3::MappedResource::NAMED );
+    EXPECT_THROW( missing.allocate( 64 ), C3::Exception );
+
+}
+
+TEST( MappedResourceTest, BadDirectory )
+{
+    C3::MappedResource mapped( "/nonexistent/C3" );
+    EXPECT_THROW( mapped.allocate( 64 ), C3::Exception );
+
+    // Containers let the error through to the caller.
+
+    auto& previous = C3::select_memory_resource( &mapped );
+    EXPECT_THROW( C3::Frame< float >( 64, 64 ), C3::Exception );
+    EXPECT_THROW( C3::Stack< float >( 2, 64, 64, 1.0f ), C3::Exception );
+    C3::select_memory_resource( &previous );
+}
+
+// Fresh pages are not placed until touched.
+
+TEST( PageNodesTest, Placement )
+{
+
+    C3::MappedResource mapped;
+    auto& previous = C3::select_memory_resource( &mapped );
+    auto enable = C3::first_touch();
+    C3::select_first_touch( false );
+    C3::Block< char > block( 1 << 20 );
+    C3::select_first_touch( enable );
+    C3::select_memory_resource( &previous );
+
+    auto nodes = C3::page_nodes( block.data(), block.size() );
+    if( nodes.empty() ) return; // No move_pages() here.
+
+    EXPECT_EQ( ( 1 << 20 ) / sysconf( _SC_PAGESIZE ), nodes.size() );
+    for( auto node : nodes ) EXPECT_EQ( -ENOENT, node );
+
+    block[ 0 ] = 1;
+    nodes = C3::page_nodes( block.data(), block.size() );
+    EXPECT_LE( 0, nodes.front() );
+    EXPECT_EQ( -ENOENT, nodes.back() );
+
+}
+
+// Large blocks sit on whole, aligned huge pages however they are backed.
+
+TEST( HugePageResourceTest, Modes )
+{
+
+    for( auto mode : { C3::HugePageResource::TRANSPARENT, C3::HugePageResource::RESERVED } )
+    {
+        C3::HugePageResource huge( mode );
+        EXPECT_EQ( mode, huge.mode() );
+
+        auto& previous = C3::select_memory_resource( &huge );
+        C3::Frame< double > large( 2160, 200, 1.0 );
+        C3::Block< double > small( 100 );
+        C3::select_memory_resource( &previous );
+
+        EXPECT_EQ( 0, reinterpret_cast< std::uintptr_t >( large.data() ) % C3::huge_page_size );
+        EXPECT_EQ( 0, reinterpret_cast< std::uintptr_t >( small.data() ) % C3::alignment );
+
+        auto statistics = huge.statistics();
+        EXPECT_EQ( 1, statistics.reserved + statistics.transparent + statistics.fallbacks );
+        if( mode == C3::HugePageResource::TRANSPARENT )
+        {
+            EXPECT_EQ( 0, statistics.reserved );
+        }
+
+        large += 1.0;
+        for( C3::size_type i = 0; i < large.size(); ++i ) EXPECT_EQ( 2.0, large[ i ] );
+    }
+
+}
+
+// A pool in front of huge pages maps each size once.
+
+TEST( HugePageResourceTest, Upstream )
+{
+
+    C3::HugePageResource huge;
+    C3::BufferPool pool( &huge );
+    auto& previous = C3::select_memory_resource( &pool );
+    for( auto task = 0; task < 3; ++task ) C3::Block< float > block( C3::huge_page_size );
+    C3::select_memory_resource( &previous );
+
+    auto statistics = huge.statistics();
+    EXPECT_EQ( 1, statistics.transparent + statistics.fallbacks );
+    EXPECT_EQ( 2, pool.statistics().hits );
+
+}
+
+// Context pools for each huge_pages setting.
+
+TEST( HugePageResourceTest, ContextPool )
+{
+
+    std::unique_ptr< C3::HugePageResource > huge;
+    auto pool = C3::context_pool( "off", huge );
+    EXPECT_TRUE( pool != nullptr );
+    EXPECT_TRUE( huge == nullptr );
+
+    pool = C3::context_pool( "reserved", huge );
+    ASSERT_TRUE( huge != nullptr );
+    EXPECT_EQ( C3::HugePageResource::RESERVED, huge->mode() );
+
+    EXPECT_THROW( C3::context_pool( "always", huge ), C3::Exception );
+
+}
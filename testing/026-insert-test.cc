@@ -0,0 +1,103 @@
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "C3_Frame.hh"
+#include "C3_Insert.hh"
+#include "C3_Simd.hh"
+#include "C3_Stack.hh"
+#include "C3_View.hh"
+
+// Frames with distinct values per frame.
+
+template< class T >
+std::vector< C3::Frame< T > > make_frames( const C3::size_type nframes, const C3::size_type ncolumns, 
+        const C3::size_type nrows, const C3::RowPitch row_pitch = C3::RowPitch::PACKED )
+{
+    std::vector< C3::Frame< T > > frames;
+    for( C3::size_type i = 0; i < nframes; ++i )
+    {
+        frames.emplace_back( ncolumns, nrows, row_pitch );
+        for( C3::size_type k = 0; k < nrows; ++k )
+        {
+            for( C3::size_type j = 0; j < ncolumns; ++j ) frames.back()( j, k ) = static_cast< T >( i + 100 * j + 10000 * k );
+        }
+    }
+    return frames;
+}
+
+// Every value type path, with frame and column counts that are not multiples
+// of the vector blocks, under every instruction set.
+
+template< class T, class U >
+void check_insert( const C3::StackLayout layout )
+{
+
+    C3::size_type nframes  = 19;
+    C3::size_type ncolumns = 45;
+    C3::size_type nrows    = 3;
+    auto frames = make_frames< U >( nframes, ncolumns, nrows, C3::RowPitch::ALIGNED );
+
+    for( auto isa : { C3::Isa::SCALAR, C3::Isa::AVX2, C3::Isa::AVX512 } )
+    {
+        C3::select_isa( isa );
+        C3::Stack< T > stack( nframes + 2, ncolumns, nrows, T( -1 ), layout );
+        C3::insert( stack, frames, 1 );
+        for( C3::size_type k = 0; k < nrows; ++k )
+        {
+            for( C3::size_type j = 0; j < ncolumns; ++j )
+            {
+                EXPECT_EQ( T( -1 ), stack( 0, j, k ) );
+                EXPECT_EQ( T( -1 ), stack( nframes + 1, j, k ) );
+                for( C3::size_type i = 0; i < nframes; ++i ) EXPECT_EQ( static_cast< T >( frames[ i ]( j, k ) ), stack( i + 1, j, k ) );
+            }
+        }
+    }
+    C3::select_isa( C3::detected_isa() );
+
+}
+
+TEST( InsertTest, Float )
+{
+    check_insert< float, float >( C3::StackLayout::INTERLEAVED );
+}
+
+TEST( InsertTest, Double )
+{
+    check_insert< double, double >( C3::StackLayout::INTERLEAVED );
+}
+
+TEST( InsertTest, Conversion )
+{
+    check_insert< double, int >( C3::StackLayout::INTERLEAVED );
+    check_insert< int, unsigned short >( C3::StackLayout::INTERLEAVED );
+}
+
+TEST( InsertTest, PlanarAndTiled )
+{
+    check_insert< float, float >( C3::StackLayout::PLANAR );
+    check_insert< float, double >( C3::StackLayout::TILED );
+}
+
+// Views by pointer.
+
+TEST( InsertTest, Views )
+{
+
+    auto frames = make_frames< float >( 10, 30, 4 );
+    std::vector< C3::View< float > > views;
+    for( auto& frame : frames ) views.emplace_back( frame, 20, 2, 5, 1 );
+    std::vector< const C3::View< float >* > pointers;
+    for( auto& view : views ) pointers.push_back( &view );
+
+    C3::Stack< float > stack( 10, 20, 2 );
+    C3::insert( stack, pointers );
+    for( C3::size_type k = 0; k < 2; ++k )
+    {
+        for( C3::size_type j = 0; j < 20; ++j )
+        {
+            for( C3::size_type i = 0; i < 10; ++i ) EXPECT_EQ( frames[ i ]( j + 5, k + 1 ), stack( i, j, k ) );
+        }
+    }
+
+}
@@ -0,0 +1,184 @@
+#include "gtest/gtest.h"
+
+#include "C3_Create.hh"
+#include "C3_Frame.hh"
+#include "C3_Operator.hh"
+#include "C3_Row.hh"
+#include "C3_Simd.hh"
+#include "C3_StackView.hh"
+#include "C3_View.hh"
+
+// Fill a stack with distinct values.
+
+template< class T >
+void fill_stack( C3::Stack< T >& stack )
+{
+    for( C3::size_type k = 0; k < stack.nrows(); ++k )
+    {
+        for( C3::size_type j = 0; j < stack.ncolumns(); ++j )
+        {
+            for( C3::size_type i = 0; i < stack.nframes(); ++i ) stack( i, j, k ) = i + 100 * j + 10000 * k;
+        }
+    }
+}
+
+TEST( StackViewTest, Constructor )
+{
+
+    C3::Stack< int > stack( 6, 40, 5, C3::StackLayout::TILED );
+    fill_stack( stack );
+
+    C3::StackView< int > view( stack, 3, 20, 2, 1, 10, 2 );
+    EXPECT_EQ( 3 , view.nframes()  );
+    EXPECT_EQ( 20, view.ncolumns() );
+    EXPECT_EQ( 2 , view.nrows()    );
+    EXPECT_EQ( C3::StackLayout::TILED, view.layout() );
+    EXPECT_EQ( &stack( 1, 10, 2 ), &view( 0, 0, 0 ) );
+    EXPECT_EQ( &stack( 3, 29, 3 ), &view( 2, 19, 1 ) );
+
+    C3::StackView< int > sub( view, 2, 5, 1, 1, 4, 1 );
+    EXPECT_EQ( &stack, &sub.stack() );
+    EXPECT_EQ( &stack( 2, 14, 3 ), &sub( 0, 0, 0 ) );
+    EXPECT_EQ( &stack( 3, 18, 3 ), &sub( 1, 4, 0 ) );
+
+}
+
+// Assignment into a section leaves the rest of the stack alone, every layout.
+
+TEST( StackViewTest, Assign )
+{
+
+    C3::size_type nframes  = 5;
+    C3::size_type ncolumns = 37;
+    C3::size_type nrows    = 4;
+
+    C3::Frame< double > frame( 20, 2 );
+    for( C3::size_type k = 0; k < frame.nrows(); ++k )
+    {
+        for( C3::size_type j = 0; j < frame.ncolumns(); ++j ) frame( j, k ) = 0.5 * j + k;
+    }
+
+    for( auto layout : { C3::StackLayout::INTERLEAVED, C3::StackLayout::PLANAR, C3::StackLayout::TILED } )
+    {
+        C3::Stack< double > stack( nframes, ncolumns, nrows, layout );
+        fill_stack( stack );
+        auto reference = C3::create( stack );
+        reference = stack;
+
+        C3::StackView< double > view( stack, 3, 20, 2, 1, 9, 1 );
+        view += frame;
+
+        for( C3::size_type k = 0; k < nrows; ++k )
+        {
+            for( C3::size_type j = 0; j < ncolumns; ++j )
+            {
+                for( C3::size_type i = 0; i < nframes; ++i )
+                {
+                    auto inside = i >= 1 && i < 4 && j >= 9 && j < 29 && k >= 1 && k < 3;
+                    auto expected = reference( i, j, k ) + ( inside ? frame( j - 9, k - 1 ) : 0.0 );
+                    EXPECT_EQ( expected, stack( i, j, k ) );
+                }
+            }
+        }
+
+        view = 1.0;
+        C3::StackView< double > corner( stack, 3, 20, 2, 0, 0, 0 );
+        C3::assign( corner, view );
+        for( C3::size_type k = 0; k < 2; ++k )
+        {
+            for( C3::size_type j = 0; j < 20; ++j )
+            {
+                for( C3::size_type i = 0; i < 3; ++i ) EXPECT_EQ( 1.0, corner( i, j, k ) );
+            }
+        }
+    }
+
+}
+
+// Sections of stacks of any layout copy into stacks of any layout, and
+// C3::create() makes a stack, not a view.
+
+TEST( StackViewTest, Materialize )
+{
+
+    C3::Stack< float > stack( 4, 35, 3, C3::StackLayout::TILED );
+    fill_stack( stack );
+    C3::StackView< float > view( stack, 2, 17, 2, 2, 3, 1 );
+
+    auto copy = C3::create( view );
+    EXPECT_EQ( C3::StackLayout::TILED, copy.layout() );
+    EXPECT_TRUE( C3::congruent( copy, view ) );
+
+    C3::Stack< double > interleaved( 2, 17, 2 );
+    C3::Stack< double > planar( 2, 17, 2, C3::StackLayout::PLANAR );
+    C3::assign( copy, view );
+    C3::assign( interleaved, view );
+    C3::assign( planar, view );
+
+    for( C3::size_type k = 0; k < 2; ++k )
+    {
+        for( C3::size_type j = 0; j < 17; ++j )
+        {
+            for( C3::size_type i = 0; i < 2; ++i )
+            {
+                EXPECT_EQ( stack( i + 2, j + 3, k + 1 ), copy( i, j, k ) );
+                EXPECT_EQ( stack( i + 2, j + 3, k + 1 ), interleaved( i, j, k ) );
+                EXPECT_EQ( stack( i + 2, j + 3, k + 1 ), planar( i, j, k ) );
+            }
+        }
+    }
+
+}
+
+// Stack views as expression destinations and operands.
+
+TEST( StackViewTest, Expression )
+{
+
+    C3::Stack< double > input( 6, 24, 4, C3::StackLayout::PLANAR );
+    fill_stack( input );
+    C3::StackView< double > section( input, 4, 16, 3, 1, 8, 1 );
+
+    C3::Frame< double > flat( 16, 3, 2.0 );
+    C3::Row< double > row( 16, 1.0 );
+
+    for( auto isa : { C3::Isa::SCALAR, C3::Isa::AVX2, C3::Isa::AVX512 } )
+    {
+        C3::select_isa( isa );
+
+        C3::Stack< double > output( 6, 24, 4, 0.0 );
+        C3::StackView< double > target( output, 4, 16, 3, 2, 0, 0 );
+        target = section / flat + row;
+
+        C3::Stack< double > dense( 4, 16, 3, C3::StackLayout::TILED );
+        dense = section * 2.0 - target;
+
+        for( C3::size_type k = 0; k < 3; ++k )
+        {
+            for( C3::size_type j = 0; j < 16; ++j )
+            {
+                for( C3::size_type i = 0; i < 4; ++i )
+                {
+                    auto expected = input( i + 1, j + 8, k + 1 ) / 2.0 + 1.0;
+                    EXPECT_EQ( expected, output( i + 2, j, k ) );
+                    EXPECT_EQ( input( i + 1, j + 8, k + 1 ) * 2.0 - expected, dense( i, j, k ) );
+                }
+            }
+        }
+        EXPECT_EQ( 0.0, output( 0, 0, 0 ) );
+        EXPECT_EQ( 0.0, output( 2, 16, 0 ) );
+    }
+    C3::select_isa( C3::detected_isa() );
+
+}
+
+// Shapes must match, layouts need not.
+
+TEST( StackViewDeathTest, Incongruent )
+{
+    ::testing::FLAGS_gtest_death_test_style = "threadsafe";
+    C3::Stack< double > stack( 4, 8, 3 );
+    C3::StackView< double > view( stack, 2, 8, 3, 0, 0, 0 );
+    C3::Stack< double > other( 3, 8, 3, C3::StackLayout::PLANAR );
+    EXPECT_DEATH( C3::assign( view, other ), "" );
+}
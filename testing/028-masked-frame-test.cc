@@ -0,0 +1,158 @@
+#include "gtest/gtest.h"
+
+#include "C3_Column.hh"
+#include "C3_MaskedFrame.hh"
+#include "C3_Operator.hh"
+#include "C3_Row.hh"
+#include "C3_Simd.hh"
+
+// Fill a masked frame with distinct values, and flags one bit per row.
+
+template< class T, class F >
+void fill_masked( C3::MaskedFrame< T, F >& frame, const T scale, const T invvar )
+{
+    for( C3::size_type k = 0; k < frame.nrows(); ++k )
+    {
+        for( C3::size_type j = 0; j < frame.ncolumns(); ++j )
+        {
+            frame.data()  ( j, k ) = scale * ( 1 + j + 10 * k );
+            frame.invvar()( j, k ) = invvar * ( 1 + j % 3 );
+            frame.flags() ( j, k ) = F( 1 ) << ( k % 8 );
+        }
+    }
+}
+
+TEST( MaskedFrameTest, Constructor )
+{
+
+    C3::MaskedFrame< float, unsigned short > frame( 13, 7, 1.5f, 4.0f, 2, C3::RowPitch::ALIGNED );
+    EXPECT_EQ( 13, frame.ncolumns() );
+    EXPECT_EQ( 7 , frame.nrows()    );
+    EXPECT_EQ( 13, frame.flags().ncolumns() );
+    EXPECT_EQ( 7 , frame.invvar().nrows()   );
+    EXPECT_EQ( C3::RowPitch::ALIGNED, frame.data().row_pitch() );
+
+    for( C3::size_type k = 0; k < frame.nrows(); ++k )
+    {
+        for( C3::size_type j = 0; j < frame.ncolumns(); ++j )
+        {
+            EXPECT_EQ( 1.5f, frame.data()  ( j, k ) );
+            EXPECT_EQ( 4.0f, frame.invvar()( j, k ) );
+            EXPECT_EQ( 2   , frame.flags() ( j, k ) );
+        }
+    }
+
+}
+
+// Masked operands: variances propagate to first order and flags OR, under
+// every instruction set.
+
+TEST( MaskedFrameTest, Masked )
+{
+
+    C3::size_type ncolumns = 37;
+    C3::size_type nrows    = 5;
+
+    for( auto isa : { C3::Isa::SCALAR, C3::Isa::AVX2, C3::Isa::AVX512 } )
+    {
+
+        C3::select_isa( isa );
+
+        C3::MaskedFrame< double, unsigned short > lhs( ncolumns, nrows );
+        C3::MaskedFrame< double, unsigned short > rhs( ncolumns, nrows );
+        fill_masked( lhs, 1.0, 2.0 );
+        fill_masked( rhs, 0.5, 8.0 );
+        rhs.flags()( 3, 2 ) = 0x100;
+        rhs.invvar()( 4, 1 ) = 0.0;
+        lhs.invvar()( 4, 1 ) = 0.0;
+
+        auto sum = lhs;
+        sum += rhs;
+        auto difference = lhs;
+        difference -= rhs;
+        auto product = lhs;
+        product *= rhs;
+        auto quotient = lhs;
+        quotient /= rhs;
+
+        for( C3::size_type k = 0; k < nrows; ++k )
+        {
+            for( C3::size_type j = 0; j < ncolumns; ++j )
+            {
+                const double x  = lhs.data()( j, k ), y  = rhs.data()( j, k );
+                const double a  = lhs.invvar()( j, k ), b = rhs.invvar()( j, k );
+                const auto flags = lhs.flags()( j, k ) | rhs.flags()( j, k );
+
+                EXPECT_DOUBLE_EQ( x + y, sum.data()( j, k ) );
+                EXPECT_DOUBLE_EQ( x - y, difference.data()( j, k ) );
+                EXPECT_DOUBLE_EQ( x * y, product.data()( j, k ) );
+                EXPECT_DOUBLE_EQ( x / y, quotient.data()( j, k ) );
+                EXPECT_EQ( flags, sum.flags()( j, k ) );
+                EXPECT_EQ( flags, quotient.flags()( j, k ) );
+
+                if( a == 0.0 )
+                {
+                    EXPECT_EQ( 0.0, sum.invvar()( j, k ) );
+                    EXPECT_EQ( 0.0, product.invvar()( j, k ) );
+                    EXPECT_EQ( 0.0, quotient.invvar()( j, k ) );
+                    continue;
+                }
+                EXPECT_DOUBLE_EQ( 1.0 / ( 1.0 / a + 1.0 / b ), sum.invvar()( j, k ) );
+                EXPECT_DOUBLE_EQ( 1.0 / ( 1.0 / a + 1.0 / b ), difference.invvar()( j, k ) );
+                EXPECT_DOUBLE_EQ( 1.0 / ( y * y / a + x * x / b ), product.invvar()( j, k ) );
+                EXPECT_DOUBLE_EQ( 1.0 / ( 1.0 / ( a * y * y ) + x * x / ( b * y * y * y * y ) ),
+                        quotient.invvar()( j, k ) );
+            }
+        }
+
+        EXPECT_EQ( 0x100 | 1 << 2, sum.flags()( 3, 2 ) );
+
+    }
+
+    C3::select_isa( C3::detected_isa() );
+
+}
+
+// Exact operands scale inverse variance and leave flags alone.
+
+TEST( MaskedFrameTest, Exact )
+{
+
+    C3::size_type ncolumns = 21;
+    C3::size_type nrows    = 6;
+
+    C3::Row< double > gain( ncolumns );
+    for( C3::size_type j = 0; j < ncolumns; ++j ) gain( j ) = 1.0 + 0.25 * j;
+    C3::Column< double > bias( nrows );
+    for( C3::size_type k = 0; k < nrows; ++k ) bias( k ) = 3.0 * k;
+
+    for( auto isa : { C3::Isa::SCALAR, C3::Isa::AVX2, C3::Isa::AVX512 } )
+    {
+
+        C3::select_isa( isa );
+
+        C3::MaskedFrame< double, unsigned char > frame( ncolumns, nrows, C3::RowPitch::ALIGNED );
+        fill_masked( frame, 2.0, 4.0 );
+        const auto original = frame;
+
+        frame -= bias;
+        frame *= gain * 2.0;
+        frame /= 4.0;
+        frame += 1.0;
+
+        for( C3::size_type k = 0; k < nrows; ++k )
+        {
+            for( C3::size_type j = 0; j < ncolumns; ++j )
+            {
+                const double scale = gain( j ) * 2.0 / 4.0;
+                EXPECT_DOUBLE_EQ( ( original.data()( j, k ) - bias( k ) ) * scale + 1.0, frame.data()( j, k ) );
+                EXPECT_DOUBLE_EQ( original.invvar()( j, k ) / ( scale * scale ), frame.invvar()( j, k ) );
+                EXPECT_EQ( original.flags()( j, k ), frame.flags()( j, k ) );
+            }
+        }
+
+    }
+
+    C3::select_isa( C3::detected_isa() );
+
+}
@@ -0,0 +1,110 @@
+#include "gtest/gtest.h"
+
+#include "C3_Column.hh"
+#include "C3_ForEach.hh"
+#include "C3_Frame.hh"
+#include "C3_Row.hh"
+#include "C3_Simd.hh"
+#include "C3_View.hh"
+
+// One line: a Row, Column and Block of one size.
+
+TEST( ForEachTest, Flat )
+{
+
+    C3::size_type size = 1000;
+
+    C3::Row< double > row( size );
+    C3::Column< float > column( size );
+    C3::Block< int > block( size );
+    for( C3::size_type j = 0; j < size; ++j ) row( j ) = 0.5 * j;
+
+    C3::for_each( []( const double x, float& y, int& n )
+        {
+            y = x * 2.0;
+            n = x > 100.0;
+        }, row, column, block );
+
+    for( C3::size_type j = 0; j < size; ++j )
+    {
+        EXPECT_EQ( float( j ), column( j ) );
+        EXPECT_EQ( j > 200, block[ j ] );
+    }
+
+}
+
+// Several outputs from one pass over a padded frame, a strided view of
+// another frame and broadcast rows and columns, under every instruction set.
+
+TEST( ForEachTest, Frames )
+{
+
+    C3::size_type ncolumns = 37;
+    C3::size_type nrows    = 6;
+
+    C3::Frame< double > input( 2 * ncolumns, nrows + 3 );
+    for( C3::size_type k = 0; k < input.nrows(); ++k )
+    {
+        for( C3::size_type j = 0; j < input.ncolumns(); ++j ) input( j, k ) = j + 100.0 * k;
+    }
+    const C3::View< double > view( input, ncolumns, nrows, 1, 2, 2 );
+
+    C3::Row< double > gain( ncolumns );
+    for( C3::size_type j = 0; j < ncolumns; ++j ) gain( j ) = 1.0 + j;
+    C3::Column< double > bias( nrows );
+    for( C3::size_type k = 0; k < nrows; ++k ) bias( k ) = 0.5 * k;
+
+    for( auto isa : { C3::Isa::SCALAR, C3::Isa::AVX2, C3::Isa::AVX512 } )
+    {
+
+        C3::select_isa( isa );
+
+        C3::Frame< double > output( ncolumns, nrows, C3::RowPitch::ALIGNED );
+        C3::Frame< float > invvar( ncolumns, nrows );
+        C3::Frame< unsigned short > flags( ncolumns, nrows, C3::RowPitch::ALIGNED );
+
+        C3::for_each( []( double& output, float& invvar, unsigned short& flags, const double input, const double gain,
+                    const double bias )
+            {
+                output = gain * ( input - bias );
+                invvar = 1.0 / gain;
+                flags  = input > 300.0 ? 4 : 0;
+            }, output, invvar, flags, view, gain, bias );
+
+        for( C3::size_type k = 0; k < nrows; ++k )
+        {
+            for( C3::size_type j = 0; j < ncolumns; ++j )
+            {
+                const double pixel = input( 1 + 2 * j, 2 + k );
+                EXPECT_EQ( gain( j ) * ( pixel - bias( k ) ), output( j, k ) );
+                EXPECT_EQ( float( 1.0 / gain( j ) ), invvar( j, k ) );
+                EXPECT_EQ( pixel > 300.0 ? 4 : 0, flags( j, k ) );
+            }
+        }
+
+    }
+
+    C3::select_isa( C3::detected_isa() );
+
+}
+
+// Writes through a view leave the rest of its frame alone.
+
+TEST( ForEachTest, View )
+{
+
+    C3::Frame< int > frame( 10, 8, 1 );
+    C3::View< int > view( frame, 4, 3, 2, 5 );
+
+    C3::for_each( []( int& pixel ) { pixel *= 7; }, view );
+
+    for( C3::size_type k = 0; k < frame.nrows(); ++k )
+    {
+        for( C3::size_type j = 0; j < frame.ncolumns(); ++j )
+        {
+            const bool inside = j >= 2 && j < 6 && k >= 5;
+            EXPECT_EQ( inside ? 7 : 1, frame( j, k ) );
+        }
+    }
+
+}
@@ -0,0 +1,148 @@
+#include "gtest/gtest.h"
+
+#include <limits>
+
+#include "C3_Block.hh"
+#include "C3_Convert.hh"
+#include "C3_Frame.hh"
+#include "C3_Simd.hh"
+
+// Raw pixels spanning the range of a value type, with both signs where it has them.
+
+template< class T >
+C3::Block< T > raw_pixels( const C3::size_type size )
+{
+    const double low  = std::numeric_limits< T >::min();
+    const double high = std::numeric_limits< T >::max();
+    C3::Block< T > block( size );
+    for( C3::size_type i = 0; i < size; ++i ) block[ i ] = static_cast< T >( low + ( high - low ) * i / ( size - 1 ) );
+    return block;
+}
+
+// Unscaled and scaled conversions against a scalar reference in double, for
+// every instruction set.  Size is not a multiple of any vector width.
+
+template< class T, class U >
+void check_conversions( const double scale, const double zero )
+{
+
+    const C3::size_type size = 101;
+    const auto src = raw_pixels< U >( size );
+
+    for( auto isa : { C3::Isa::SCALAR, C3::Isa::AVX2, C3::Isa::AVX512 } )
+    {
+
+        C3::select_isa( isa );
+
+        C3::Block< T > dest( size );
+
+        C3::convert( dest.data(), src.data(), size );
+        for( C3::size_type i = 0; i < size; ++i )
+        {
+            EXPECT_EQ( static_cast< T >( src[ i ] ), dest[ i ] ) << C3::isa_string( isa );
+        }
+
+        C3::convert( dest.data(), src.data(), size, scale, zero );
+        for( C3::size_type i = 0; i < size; ++i )
+        {
+            EXPECT_DOUBLE_EQ( static_cast< T >( src[ i ] * scale + zero ), dest[ i ] ) << C3::isa_string( isa );
+        }
+
+    }
+
+    C3::select_isa( C3::detected_isa() );
+
+}
+
+TEST( ConvertTest, IntegersToFloatingPoint )
+{
+    check_conversions< float , short          >( 2.0, 32768.0 );
+    check_conversions< float , unsigned short >( 0.5, -100.0  );
+    check_conversions< double, short          >( 2.0, 32768.0 );
+    check_conversions< double, unsigned short >( 0.5, -100.0  );
+    check_conversions< double, int            >( 1.5, 7.0     );
+}
+
+// Scaled conversion to integers rounds half away from zero and saturates.
+
+TEST( ConvertTest, FloatingPointToIntegers )
+{
+
+    C3::Block< double > src( 11 );
+    const double values[] = { -1.0e12, -32768.6, -2.5, -1.5, -0.4, 0.0, 0.4, 1.5, 2.5, 32767.6, 1.0e12 };
+    std::copy( values, values + 11, src.data() );
+
+    for( auto isa : { C3::Isa::SCALAR, C3::Isa::AVX2, C3::Isa::AVX512 } )
+    {
+
+        C3::select_isa( isa );
+
+        C3::Block< short > shorts( 11 );
+        C3::convert( shorts.data(), src.data(), 11, 1.0, 0.0 );
+        const short expected_shorts[] = { -32768, -32768, -3, -2, 0, 0, 0, 2, 3, 32767, 32767 };
+        for( C3::size_type i = 0; i < 11; ++i ) EXPECT_EQ( expected_shorts[ i ], shorts[ i ] ) << C3::isa_string( isa );
+
+        C3::Block< unsigned short > ushorts( 11 );
+        C3::convert( ushorts.data(), src.data(), 11, 1.0, 32768.0 );
+        const unsigned short expected_ushorts[] = { 0, 0, 32766, 32767, 32768, 32768, 32768, 32770, 32771, 65535,
+                65535 };
+        for( C3::size_type i = 0; i < 11; ++i ) EXPECT_EQ( expected_ushorts[ i ], ushorts[ i ] ) << C3::isa_string( isa );
+
+        C3::Block< int > ints( 11 );
+        C3::convert( ints.data(), src.data(), 11, 1.0, 0.0 );
+        const int expected_ints[] = { std::numeric_limits< int >::min(), -32769, -3, -2, 0, 0, 0, 2, 3, 32768,
+                std::numeric_limits< int >::max() };
+        for( C3::size_type i = 0; i < 11; ++i ) EXPECT_EQ( expected_ints[ i ], ints[ i ] ) << C3::isa_string( isa );
+
+        C3::Block< float > floats( 11 );
+        C3::convert( floats.data(), src.data(), 11, 2.0, 1.0 );
+        for( C3::size_type i = 0; i < 11; ++i ) EXPECT_EQ( float( 2.0 * values[ i ] + 1.0 ), floats[ i ] );
+
+    }
+
+    C3::select_isa( C3::detected_isa() );
+
+}
+
+// Raw values recovered from physical ones with the inverse scale.
+
+TEST( ConvertTest, RoundTrip )
+{
+
+    const auto raw = raw_pixels< short >( 1000 );
+    C3::Block< float > physical( raw.size() );
+    C3::Block< short > recovered( raw.size() );
+
+    C3::convert( physical.data(), raw.data(), raw.size(), 4.0, 100.0 );
+    C3::convert( recovered.data(), physical.data(), raw.size(), 0.25, -25.0 );
+
+    for( C3::size_type i = 0; i < raw.size(); ++i ) EXPECT_EQ( raw[ i ], recovered[ i ] );
+
+}
+
+// Container conversion between integer and floating-point value types, with
+// padding left alone.
+
+TEST( ConvertTest, Frames )
+{
+
+    C3::Frame< short > raw( 13, 4 );
+    for( C3::size_type k = 0; k < raw.nrows(); ++k )
+    {
+        for( C3::size_type j = 0; j < raw.ncolumns(); ++j ) raw( j, k ) = short( 1000 * k - 7 * j );
+    }
+
+    auto physical = C3::Frame< double >( raw );
+    C3::Frame< unsigned short > flags( 13, 4, C3::RowPitch::ALIGNED );
+    flags = raw;
+
+    for( C3::size_type k = 0; k < raw.nrows(); ++k )
+    {
+        for( C3::size_type j = 0; j < raw.ncolumns(); ++j )
+        {
+            EXPECT_EQ( double( raw( j, k ) ), physical( j, k ) );
+            EXPECT_EQ( static_cast< unsigned short >( raw( j, k ) ), flags( j, k ) );
+        }
+    }
+
+}
@@ -0,0 +1,196 @@
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <limits>
+
+#include "C3_Block.hh"
+#include "C3_Frame.hh"
+#include "C3_Math.hh"
+#include "C3_Simd.hh"
+#include "C3_Stack.hh"
+#include "C3_View.hh"
+
+// Distance between two values in units in the last place of the second.
+
+template< class T >
+double ulps( const T value, const T expected )
+{
+    if( value == expected || ( std::isnan( value ) && std::isnan( expected ) ) ) return 0.0;
+    if( ! std::isfinite( value ) || ! std::isfinite( expected ) ) return std::numeric_limits< double >::infinity();
+    const T magnitude = std::fabs( expected );
+    const T ulp = std::max( std::nextafter( magnitude, std::numeric_limits< T >::infinity() ) - magnitude,
+            std::numeric_limits< T >::denorm_min() );
+    return std::fabs( double( value ) - double( expected ) ) / ulp;
+}
+
+// Pixels spread evenly in logarithm over [low, high], or linearly.
+
+template< class T >
+C3::Block< T > spread( const C3::size_type size, const double low, const double high, const bool logarithmic )
+{
+    C3::Block< T > block( size );
+    for( C3::size_type i = 0; i < size; ++i )
+    {
+        const double t = double( i ) / ( size - 1 );
+        block[ i ] = T( logarithmic ? std::exp( std::log( low ) + t * ( std::log( high ) - std::log( low ) ) )
+                                    : low + t * ( high - low ) );
+    }
+    return block;
+}
+
+// Largest error of a function over pixels against its std:: counterpart,
+// for every instruction set.
+
+template< class T, class Function, class Reference >
+void check_accuracy( Function function, Reference reference, const C3::Block< T >& src, const double tolerance )
+{
+    for( auto isa : { C3::Isa::SCALAR, C3::Isa::AVX2, C3::Isa::AVX512 } )
+    {
+        C3::select_isa( isa );
+        C3::Block< T > dest( src.size() );
+        dest = function( src );
+        double worst = 0.0;
+        for( C3::size_type i = 0; i < src.size(); ++i ) worst = std::max( worst, ulps( dest[ i ], reference( src[ i ] ) ) );
+        EXPECT_LE( worst, tolerance ) << C3::isa_string( isa );
+    }
+    C3::select_isa( C3::detected_isa() );
+}
+
+template< class T >
+void check_accuracy()
+{
+
+    using L = std::numeric_limits< T >;
+    const C3::size_type size = 100003;
+
+    const auto positive = spread< T >( size, L::denorm_min(), L::max(), true );
+    const auto unit     = spread< T >( size, 0.25, 4.0, false );
+    const auto exponent = spread< T >( size, std::log( L::denorm_min() ), std::log( L::max() ), false );
+
+    auto sqrt = []( const C3::Block< T >& src ) { return C3::sqrt( src ); };
+    auto log  = []( const C3::Block< T >& src ) { return C3::log( src ); };
+    auto exp  = []( const C3::Block< T >& src ) { return C3::exp( src ); };
+
+    check_accuracy( sqrt, []( const T x ) { return std::sqrt( x ); }, positive, 1.0 );
+    check_accuracy( log , []( const T x ) { return std::log ( x ); }, positive, 2.0 );
+    check_accuracy( log , []( const T x ) { return std::log ( x ); }, unit    , 2.0 );
+    check_accuracy( exp , []( const T x ) { return std::exp ( x ); }, exponent, 2.0 );
+    check_accuracy( exp , []( const T x ) { return std::exp ( x ); }, unit    , 2.0 );
+
+}
+
+TEST( MathTest, AccuracyFloat )
+{
+    check_accuracy< float >();
+}
+
+TEST( MathTest, AccuracyDouble )
+{
+    check_accuracy< double >();
+}
+
+// Zeros, infinities and NaN as in the std:: functions.
+
+template< class T >
+void check_special_values()
+{
+
+    using L = std::numeric_limits< T >;
+    const T values[] = { T( 0 ), -T( 0 ), T( 1 ), T( -1 ), L::infinity(), -L::infinity(), L::quiet_NaN(),
+        L::denorm_min(), L::min(), L::max() };
+    const C3::size_type size = sizeof( values ) / sizeof( T );
+
+    C3::Block< T > src( size );
+    std::copy( values, values + size, src.data() );
+
+    for( auto isa : { C3::Isa::SCALAR, C3::Isa::AVX2, C3::Isa::AVX512 } )
+    {
+        C3::select_isa( isa );
+        C3::Block< T > sqrt( size ), log( size ), exp( size );
+        sqrt = C3::sqrt( src );
+        log  = C3::log( src );
+        exp  = C3::exp( src );
+        for( C3::size_type i = 0; i < size; ++i )
+        {
+            EXPECT_LE( ulps( sqrt[ i ], std::sqrt( values[ i ] ) ), 1.0 ) << values[ i ];
+            if( values[ i ] == T( 0 ) )
+            {
+                EXPECT_EQ( std::signbit( values[ i ] ), std::signbit( sqrt[ i ] ) );
+            }
+            EXPECT_LE( ulps( log[ i ], std::log( values[ i ] ) ), 2.0 ) << values[ i ];
+            EXPECT_LE( ulps( exp[ i ], std::exp( values[ i ] ) ), 2.0 ) << values[ i ];
+        }
+    }
+    C3::select_isa( C3::detected_isa() );
+
+}
+
+TEST( MathTest, SpecialValues )
+{
+    check_special_values< float  >();
+    check_special_values< double >();
+}
+
+// The rest, fused with arithmetic over frames, views and stacks.
+
+TEST( MathTest, Frames )
+{
+
+    C3::size_type ncolumns = 21;
+    C3::size_type nrows    = 5;
+
+    C3::Frame< double > variance( ncolumns, nrows );
+    C3::Frame< short > counts( ncolumns, nrows, C3::RowPitch::ALIGNED );
+    for( C3::size_type k = 0; k < nrows; ++k )
+    {
+        for( C3::size_type j = 0; j < ncolumns; ++j )
+        {
+            variance( j, k ) = 0.25 * ( 1 + j + ncolumns * k );
+            counts( j, k )   = short( 10 * j - 7 * k - 50 );
+        }
+    }
+
+    C3::Frame< double > output( ncolumns, nrows );
+
+    output = C3::reciprocal( C3::sqrt( variance ) ) + C3::abs( counts );
+    for( C3::size_type k = 0; k < nrows; ++k )
+    {
+        for( C3::size_type j = 0; j < ncolumns; ++j )
+        {
+            EXPECT_DOUBLE_EQ( 1.0 / std::sqrt( variance( j, k ) ) + std::abs( counts( j, k ) ), output( j, k ) );
+        }
+    }
+
+    output = C3::clamp( counts, -20, 30.5 ) + C3::max( variance, 2.0 ) - C3::min( 2.0, variance );
+    for( C3::size_type k = 0; k < nrows; ++k )
+    {
+        for( C3::size_type j = 0; j < ncolumns; ++j )
+        {
+            const double clamped = std::min( std::max( double( counts( j, k ) ), -20.0 ), 30.5 );
+            EXPECT_EQ( clamped + std::max( variance( j, k ), 2.0 ) - std::min( 2.0, variance( j, k ) ),
+                    output( j, k ) );
+        }
+    }
+
+    C3::View< double > view( output, 4, 3, 2, 1, 3 );
+    view = C3::pow( variance( 0, 0 ) + C3::log( C3::exp( C3::View< double >( variance, 4, 3, 2, 1, 3 ) ) ), 1.5 );
+    for( C3::size_type k = 0; k < 3; ++k )
+    {
+        for( C3::size_type j = 0; j < 4; ++j )
+        {
+            const double expected = std::pow( variance( 0, 0 ) + variance( 2 + 3 * j, 1 + k ), 1.5 );
+            EXPECT_NEAR( expected, view( j, k ), 1.0e-14 * expected );
+        }
+    }
+
+    C3::Stack< float > stack( 3, ncolumns, nrows, 4.0f );
+    stack = C3::sqrt( stack ) * C3::min( variance, 1.0 );
+    for( C3::size_type k = 0; k < nrows; ++k )
+    {
+        for( C3::size_type j = 0; j < ncolumns; ++j )
+        {
+            EXPECT_FLOAT_EQ( float( 2.0 * std::min( variance( j, k ), 1.0 ) ), stack( 2, j, k ) );
+        }
+    }
+
+}
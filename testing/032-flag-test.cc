@@ -0,0 +1,160 @@
+#include "gtest/gtest.h"
+
+#include "C3_BitFrame.hh"
+#include "C3_Flag.hh"
+#include "C3_Frame.hh"
+#include "C3_Math.hh"
+#include "C3_Row.hh"
+#include "C3_Simd.hh"
+#include "C3_Stack.hh"
+#include "C3_View.hh"
+
+// Comparisons against a pixel and against containers OR bits into flags and
+// leave other bits alone, for every instruction set.  Rows are not a
+// multiple of any vector width.
+
+TEST( FlagTest, Frames )
+{
+
+    const C3::size_type ncolumns = 37;
+    const C3::size_type nrows    = 5;
+
+    C3::Frame< float > input( ncolumns, nrows );
+    C3::Frame< float > threshold( ncolumns, nrows );
+    C3::Row< double > limit( ncolumns );
+    for( C3::size_type j = 0; j < ncolumns; ++j ) limit( j ) = 2.0 * j;
+    for( C3::size_type k = 0; k < nrows; ++k )
+    {
+        for( C3::size_type j = 0; j < ncolumns; ++j )
+        {
+            input( j, k )     = float( 3 * j ) - float( 17 * k );
+            threshold( j, k ) = float( j + k );
+        }
+    }
+
+    for( auto isa : { C3::Isa::SCALAR, C3::Isa::AVX2, C3::Isa::AVX512 } )
+    {
+
+        C3::select_isa( isa );
+
+        C3::Frame< unsigned short > flags( ncolumns, nrows, 0x100, C3::RowPitch::ALIGNED );
+        C3::flag( flags, 0x1, C3::greater_equal( input, 40.0f ) );
+        C3::flag( flags, 0x2, C3::less( input, threshold ) );
+        C3::flag( flags, 0x4, C3::equal( C3::abs( input ), limit ) );
+        C3::flag( flags, 0x8, C3::not_equal( input, input ) );
+
+        for( C3::size_type k = 0; k < nrows; ++k )
+        {
+            for( C3::size_type j = 0; j < ncolumns; ++j )
+            {
+                const float x = input( j, k );
+                const unsigned short expected = 0x100 | ( x >= 40.0f ? 0x1 : 0 ) | ( x < threshold( j, k ) ? 0x2 : 0 )
+                    | ( std::fabs( x ) == limit( j ) ? 0x4 : 0 );
+                EXPECT_EQ( expected, flags( j, k ) ) << C3::isa_string( isa ) << " " << j << " " << k;
+            }
+        }
+
+    }
+
+    C3::select_isa( C3::detected_isa() );
+
+}
+
+// A plain container is a condition wherever its pixels are not zero, and
+// views and stacks take flags too.
+
+TEST( FlagTest, Containers )
+{
+
+    C3::Frame< int > mask( 6, 4 );
+    for( C3::size_type k = 0; k < 4; ++k )
+    {
+        for( C3::size_type j = 0; j < 6; ++j ) mask( j, k ) = ( j + k ) % 3 == 0 ? -5 : 0;
+    }
+
+    C3::Frame< unsigned char > flags( 6, 4, 0 );
+    C3::flag( flags, 0x80, mask );
+
+    C3::Frame< unsigned short > plane( 10, 8, 0 );
+    C3::View< unsigned short > view( plane, 6, 4, 2, 3 );
+    C3::flag( view, 0x10, mask );
+
+    for( C3::size_type k = 0; k < 4; ++k )
+    {
+        for( C3::size_type j = 0; j < 6; ++j )
+        {
+            EXPECT_EQ( mask( j, k ) ? 0x80 : 0, flags( j, k ) );
+            EXPECT_EQ( mask( j, k ) ? 0x10 : 0, plane( j + 2, k + 3 ) );
+        }
+    }
+
+    C3::Stack< unsigned int > stack( 3, 6, 4, 1u );
+    C3::flag( stack, 0x40000000u, C3::greater( mask, -1 ) );
+    for( C3::size_type k = 0; k < 4; ++k )
+    {
+        for( C3::size_type j = 0; j < 6; ++j )
+        {
+            EXPECT_EQ( mask( j, k ) ? 1u : 0x40000001u, stack( 2, j, k ) );
+        }
+    }
+
+}
+
+// Bits packed from flags and unpacked back, across word boundaries.
+
+TEST( FlagTest, BitFrame )
+{
+
+    const C3::size_type ncolumns = 150;
+    const C3::size_type nrows    = 3;
+
+    C3::Frame< unsigned short > flags( ncolumns, nrows, C3::RowPitch::ALIGNED );
+    for( C3::size_type k = 0; k < nrows; ++k )
+    {
+        for( C3::size_type j = 0; j < ncolumns; ++j ) flags( j, k ) = ( j * 7 + k ) % 5 == 0 ? 0x4 : 0x1;
+    }
+
+    for( auto isa : { C3::Isa::SCALAR, C3::Isa::AVX2, C3::Isa::AVX512 } )
+    {
+
+        C3::select_isa( isa );
+
+        C3::BitFrame bits( ncolumns, nrows );
+        EXPECT_EQ( 3u, bits.pitch() );
+        C3::pack( bits, flags, ( unsigned short )( 0x4 | 0x8 ) );
+
+        C3::size_type expected_count = 0;
+        for( C3::size_type k = 0; k < nrows; ++k )
+        {
+            for( C3::size_type j = 0; j < ncolumns; ++j )
+            {
+                EXPECT_EQ( flags( j, k ) == 0x4, bits( j, k ) ) << C3::isa_string( isa );
+                expected_count += flags( j, k ) == 0x4;
+            }
+        }
+        EXPECT_EQ( expected_count, bits.count() );
+
+        C3::Frame< unsigned short > unpacked( ncolumns, nrows, 0x2 );
+        C3::unpack( unpacked, bits, ( unsigned short )( 0x20 ) );
+        for( C3::size_type k = 0; k < nrows; ++k )
+        {
+            for( C3::size_type j = 0; j < ncolumns; ++j )
+            {
+                EXPECT_EQ( flags( j, k ) == 0x4 ? 0x22 : 0x2, unpacked( j, k ) ) << C3::isa_string( isa );
+            }
+        }
+
+    }
+
+    C3::select_isa( C3::detected_isa() );
+
+    C3::BitFrame all( 70, 2, true );
+    EXPECT_EQ( 140u, all.count() );
+    all.reset( 69, 1 );
+    all.reset( 0, 0 );
+    EXPECT_FALSE( all( 69, 1 ) );
+    EXPECT_TRUE( all( 68, 1 ) );
+    all.set( 0, 0 );
+    EXPECT_EQ( 139u, all.count() );
+
+}
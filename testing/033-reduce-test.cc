@@ -0,0 +1,311 @@
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <vector>
+
+#include "C3_Block.hh"
+#include "C3_Column.hh"
+#include "C3_Frame.hh"
+#include "C3_Reduce.hh"
+#include "C3_Row.hh"
+#include "C3_Simd.hh"
+#include "C3_Stack.hh"
+#include "C3_Threads.hh"
+#include "C3_View.hh"
+
+// Pixels with exact sums in any order, so reductions along every axis can be
+// compared exactly with plain loops.
+
+template< class T >
+T value( const C3::size_type i, const C3::size_type j, const C3::size_type k )
+{
+    return static_cast< T >( ( 7 * i + 3 * j + 5 * k ) % 23 ) - T( 11 );
+}
+
+TEST( ReduceTest, FrameToColumnAndRow )
+{
+
+    C3::Frame< float > frame( 37, 1100, C3::RowPitch::ALIGNED );
+    for( C3::size_type k = 0; k < frame.nrows(); ++k )
+    {
+        for( C3::size_type j = 0; j < frame.ncolumns(); ++j ) frame( j, k ) = value< float >( 0, j, k );
+    }
+
+    auto column = C3::reduce< C3::Column >( frame, C3::Sum() );
+    auto row    = C3::reduce< C3::Row, double >( frame, C3::Sum() );
+    auto small  = C3::reduce< C3::Row >( frame, C3::Min() );
+    auto large  = C3::reduce< C3::Column >( frame, C3::Max() );
+
+    for( C3::size_type k = 0; k < frame.nrows(); ++k )
+    {
+        float sum = 0.0f, maximum = frame( 0, k );
+        for( C3::size_type j = 0; j < frame.ncolumns(); ++j )
+        {
+            sum += frame( j, k );
+            maximum = std::max( maximum, frame( j, k ) );
+        }
+        EXPECT_EQ( sum, column( k ) );
+        EXPECT_EQ( maximum, large( k ) );
+    }
+
+    for( C3::size_type j = 0; j < frame.ncolumns(); ++j )
+    {
+        double sum = 0.0;
+        float minimum = frame( j, 0 );
+        for( C3::size_type k = 0; k < frame.nrows(); ++k )
+        {
+            sum += frame( j, k );
+            minimum = std::min( minimum, frame( j, k ) );
+        }
+        EXPECT_EQ( sum, row( j ) );
+        EXPECT_EQ( minimum, small( j ) );
+    }
+
+    EXPECT_EQ( C3::reduce( column, C3::Sum() ), C3::reduce( frame, C3::Sum() ) );
+
+}
+
+TEST( ReduceTest, ViewToColumnRowAndPixel )
+{
+
+    C3::Frame< short > frame( 40, 30 );
+    for( C3::size_type k = 0; k < frame.nrows(); ++k )
+    {
+        for( C3::size_type j = 0; j < frame.ncolumns(); ++j ) frame( j, k ) = value< short >( 0, j, k );
+    }
+
+    for( C3::size_type step = 1; step <= 2; ++step )
+    {
+
+        C3::View< short > view( frame, 15, 20, 3, 5, step );
+
+        C3::Column< double > column( view.nrows() );
+        C3::reduce( column, view, C3::Mean() );
+        C3::Row< int > row( view.ncolumns() );
+        C3::reduce( row, view, C3::Sum() );
+
+        for( C3::size_type k = 0; k < view.nrows(); ++k )
+        {
+            double sum = 0.0;
+            for( C3::size_type j = 0; j < view.ncolumns(); ++j ) sum += view( j, k );
+            EXPECT_DOUBLE_EQ( sum / view.ncolumns(), column( k ) );
+        }
+
+        int total = 0;
+        for( C3::size_type j = 0; j < view.ncolumns(); ++j )
+        {
+            int sum = 0;
+            for( C3::size_type k = 0; k < view.nrows(); ++k ) sum += view( j, k );
+            EXPECT_EQ( sum, row( j ) );
+            total += sum;
+        }
+
+        EXPECT_EQ( total, C3::reduce< int >( view, C3::Sum() ) );
+
+    }
+
+}
+
+TEST( ReduceTest, StackToFrameAndView )
+{
+
+    const C3::size_type nframes = 9, ncolumns = 70, nrows = 6;
+
+    for( auto layout : { C3::StackLayout::INTERLEAVED, C3::StackLayout::PLANAR, C3::StackLayout::TILED } )
+    {
+
+        C3::Stack< float > stack( nframes, ncolumns, nrows, layout );
+        for( C3::size_type k = 0; k < nrows; ++k )
+        {
+            for( C3::size_type j = 0; j < ncolumns; ++j )
+            {
+                for( C3::size_type i = 0; i < nframes; ++i ) stack( i, j, k ) = value< float >( i, j, k );
+            }
+        }
+
+        auto mean = C3::reduce< C3::Frame, double >( stack, C3::Mean() );
+        auto variance = C3::reduce< C3::Frame >( stack, C3::Variance() );
+
+        C3::Frame< float > frame( ncolumns + 4, nrows + 2, -1.0f );
+        C3::View< float > view( frame, ncolumns, nrows, 2, 1 );
+        C3::reduce( view, stack, C3::Max() );
+
+        double total = 0.0;
+        for( C3::size_type k = 0; k < nrows; ++k )
+        {
+            for( C3::size_type j = 0; j < ncolumns; ++j )
+            {
+                double sum = 0.0, squares = 0.0;
+                float maximum = stack( 0, j, k );
+                for( C3::size_type i = 0; i < nframes; ++i )
+                {
+                    sum += stack( i, j, k );
+                    maximum = std::max( maximum, stack( i, j, k ) );
+                }
+                for( C3::size_type i = 0; i < nframes; ++i )
+                {
+                    squares += ( stack( i, j, k ) - sum / nframes ) * ( stack( i, j, k ) - sum / nframes );
+                }
+                EXPECT_DOUBLE_EQ( sum / nframes, mean( j, k ) );
+                EXPECT_FLOAT_EQ( float( squares / ( nframes - 1 ) ), variance( j, k ) );
+                EXPECT_EQ( maximum, view( j, k ) );
+                total += sum;
+            }
+        }
+        EXPECT_EQ( -1.0f, frame( 0, 0 ) );
+        EXPECT_EQ( total, C3::reduce< double >( stack, C3::Sum() ) );
+
+    }
+
+}
+
+// Long ranges are split over threads, yet give bitwise the same result for
+// any number of threads and any instruction set.
+
+TEST( ReduceTest, Reproducible )
+{
+
+    C3::Block< float > block( 1000003 );
+    for( C3::size_type i = 0; i < block.size(); ++i ) block[ i ] = float( std::sin( 0.001 * i ) * 1.0e4 + 1.0e-3 * i );
+
+    double reference = 0.0;
+    for( C3::size_type i = 0; i < block.size(); ++i ) reference += block[ i ];
+
+    const auto threads   = C3::threads();
+    const auto threshold = C3::select_thread_threshold( 0 );
+    C3::select_thread_threshold( 0 );
+
+    C3::select_threads( 1 );
+    C3::select_isa( C3::Isa::SCALAR );
+    const auto sum  = C3::reduce( block, C3::Sum() );
+    const auto mean = C3::reduce< double >( block, C3::Mean() );
+    EXPECT_NEAR( reference, sum, 1.0e-6 * std::fabs( reference ) );
+    EXPECT_NEAR( reference / block.size(), mean, 1.0e-12 * std::fabs( reference / block.size() ) );
+
+    for( int nthreads : { 1, 2, 3, 4, 7 } )
+    {
+        C3::select_threads( nthreads );
+        for( auto isa : { C3::Isa::SCALAR, C3::Isa::AVX2, C3::Isa::AVX512 } )
+        {
+            C3::select_isa( isa );
+            EXPECT_EQ( sum , C3::reduce( block, C3::Sum() ) ) << nthreads << " " << C3::isa_string( isa );
+            EXPECT_EQ( mean, C3::reduce< double >( block, C3::Mean() ) ) << nthreads << " " << C3::isa_string( isa );
+        }
+    }
+
+    C3::select_isa( C3::detected_isa() );
+    C3::select_threads( threads );
+    C3::select_thread_threshold( threshold );
+
+}
+
+// Variance multiplies before it adds, yet gives bitwise the same result for
+// every instruction set, along rows and columns longer than a block.
+
+TEST( ReduceTest, VarianceAcrossIsas )
+{
+
+    C3::Frame< float > frame( 1000, 600 );
+    for( C3::size_type k = 0; k < frame.nrows(); ++k )
+    {
+        for( C3::size_type j = 0; j < frame.ncolumns(); ++j )
+        {
+            frame( j, k ) = float( std::sin( 0.01 * j + 0.3 * k ) * 1.0e3 + 0.1 * k );
+        }
+    }
+
+    C3::select_isa( C3::Isa::SCALAR );
+    const auto along         = C3::reduce< C3::Column >( frame, C3::Variance() );
+    const auto double_along  = C3::reduce< C3::Column, double >( frame, C3::Variance() );
+    const auto across        = C3::reduce< C3::Row >( frame, C3::Variance() );
+    const auto double_across = C3::reduce< C3::Row, double >( frame, C3::Variance() );
+
+    for( auto isa : { C3::Isa::AVX2, C3::Isa::AVX512 } )
+    {
+        C3::select_isa( isa );
+        const auto isa_along         = C3::reduce< C3::Column >( frame, C3::Variance() );
+        const auto isa_double_along  = C3::reduce< C3::Column, double >( frame, C3::Variance() );
+        const auto isa_across        = C3::reduce< C3::Row >( frame, C3::Variance() );
+        const auto isa_double_across = C3::reduce< C3::Row, double >( frame, C3::Variance() );
+        for( C3::size_type k = 0; k < frame.nrows(); ++k )
+        {
+            EXPECT_EQ( along( k ), isa_along( k ) ) << k << " " << C3::isa_string( isa );
+            EXPECT_EQ( double_along( k ), isa_double_along( k ) ) << k << " " << C3::isa_string( isa );
+        }
+        for( C3::size_type j = 0; j < frame.ncolumns(); ++j )
+        {
+            EXPECT_EQ( across( j ), isa_across( j ) ) << j << " " << C3::isa_string( isa );
+            EXPECT_EQ( double_across( j ), isa_double_across( j ) ) << j << " " << C3::isa_string( isa );
+        }
+    }
+    C3::select_isa( C3::detected_isa() );
+
+}
+
+// Columns reduced into rows a band at a time give bitwise the same result as
+// each column gathered and reduced on its own, including long columns split
+// into blocks, views and partial tiles.
+
+TEST( ReduceTest, ColumnBands )
+{
+
+    C3::Frame< float > frame( 150, 1300, C3::RowPitch::ALIGNED );
+    for( C3::size_type k = 0; k < frame.nrows(); ++k )
+    {
+        for( C3::size_type j = 0; j < frame.ncolumns(); ++j )
+        {
+            frame( j, k ) = float( std::sin( 0.01 * j + 0.003 * k ) * 1.0e3 + 1.0e-2 * k );
+        }
+    }
+
+    const auto threads   = C3::threads();
+    const auto threshold = C3::select_thread_threshold( 0 );
+    C3::select_thread_threshold( 0 );
+    for( int nthreads : { 1, 3 } )
+    {
+        C3::select_threads( nthreads );
+        for( auto isa : { C3::Isa::SCALAR, C3::Isa::AVX2, C3::Isa::AVX512 } )
+        {
+            C3::select_isa( isa );
+            for( C3::size_type step = 1; step <= 2; ++step )
+            {
+                C3::View< float > view( frame, 70, 1100, 5, 100, step );
+                auto sum      = C3::reduce< C3::Row, double >( frame, C3::Sum() );
+                auto mean     = C3::reduce< C3::Row >( view, C3::Mean() );
+                auto variance = C3::reduce< C3::Row, double >( view, C3::Variance() );
+                auto minimum  = C3::reduce< C3::Row >( frame, C3::Min() );
+                auto maximum  = C3::reduce< C3::Row >( view, C3::Max() );
+
+                std::vector< float > column( frame.nrows() );
+                for( C3::size_type j = 0; j < frame.ncolumns(); ++j )
+                {
+                    for( C3::size_type k = 0; k < frame.nrows(); ++k ) column[ k ] = frame( j, k );
+                    double expected_sum;
+                    float expected_minimum;
+                    C3::Sum()( expected_sum, column.data(), column.data() + column.size() );
+                    C3::Min()( expected_minimum, column.data(), column.data() + column.size() );
+                    EXPECT_EQ( expected_sum, sum( j ) ) << j << " " << C3::isa_string( isa );
+                    EXPECT_EQ( expected_minimum, minimum( j ) ) << j << " " << C3::isa_string( isa );
+                }
+
+                column.resize( view.nrows() );
+                for( C3::size_type j = 0; j < view.ncolumns(); ++j )
+                {
+                    for( C3::size_type k = 0; k < view.nrows(); ++k ) column[ k ] = view( j, k );
+                    float expected_mean, expected_maximum;
+                    double expected_variance;
+                    C3::Mean()( expected_mean, column.data(), column.data() + column.size() );
+                    C3::Variance()( expected_variance, column.data(), column.data() + column.size() );
+                    C3::Max()( expected_maximum, column.data(), column.data() + column.size() );
+                    EXPECT_EQ( expected_mean, mean( j ) ) << j << " " << step << " " << C3::isa_string( isa );
+                    EXPECT_EQ( expected_variance, variance( j ) ) << j << " " << step << " " << C3::isa_string( isa );
+                    EXPECT_EQ( expected_maximum, maximum( j ) ) << j << " " << step << " " << C3::isa_string( isa );
+                }
+            }
+        }
+    }
+    C3::select_isa( C3::detected_isa() );
+    C3::select_threads( threads );
+    C3::select_thread_threshold( threshold );
+
+}
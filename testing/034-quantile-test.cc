@@ -0,0 +1,152 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "C3_Block.hh"
+#include "C3_Frame.hh"
+#include "C3_Quantile.hh"
+#include "C3_Simd.hh"
+#include "C3_Stack.hh"
+#include "C3_View.hh"
+
+// Quantile by sorting, interpolated like C3::Quantile, with no multiply-add
+// contracted.
+
+template< class T, class U >
+C3_NO_FP_CONTRACT T reference( std::vector< U > pixels, const double q )
+{
+    std::sort( pixels.begin(), pixels.end() );
+    const double position = q * ( pixels.size() - 1 );
+    const auto lower = static_cast< C3::size_type >( position );
+    const auto upper = std::min< C3::size_type >( lower + 1, pixels.size() - 1 );
+    using R = typename C3::_Real< T >::type;
+    const R fraction = static_cast< R >( position - lower );
+    const R low = static_cast< R >( pixels[ lower ] );
+    const R step = fraction * ( static_cast< R >( pixels[ upper ] ) - low );
+    return static_cast< T >( fraction > 0 ? low + step : low );
+}
+
+// Every small number of frames goes through the sorting network, for every
+// layout and instruction set, and past it through selection.
+
+TEST( QuantileTest, StackToFrame )
+{
+
+    const C3::size_type ncolumns = 37, nrows = 5;
+
+    for( auto isa : { C3::Isa::SCALAR, C3::Isa::AVX2, C3::Isa::AVX512 } )
+    {
+        C3::select_isa( isa );
+        for( auto layout : { C3::StackLayout::INTERLEAVED, C3::StackLayout::PLANAR, C3::StackLayout::TILED } )
+        {
+            for( C3::size_type nframes = 1; nframes <= 20; ++nframes )
+            {
+
+                C3::Stack< float > stack( nframes, ncolumns, nrows, layout );
+                for( C3::size_type k = 0; k < nrows; ++k )
+                {
+                    for( C3::size_type j = 0; j < ncolumns; ++j )
+                    {
+                        for( C3::size_type i = 0; i < nframes; ++i )
+                        {
+                            stack( i, j, k ) = float( ( 13 * i + 7 * j + 3 * k ) % 17 ) * 0.37f - 0.1f * i;
+                        }
+                    }
+                }
+
+                auto median = C3::reduce< C3::Frame >( stack, C3::Median() );
+                auto upper  = C3::reduce< C3::Frame, double >( stack, C3::Quantile( 0.8 ) );
+
+                for( C3::size_type k = 0; k < nrows; ++k )
+                {
+                    for( C3::size_type j = 0; j < ncolumns; ++j )
+                    {
+                        std::vector< float > pixels;
+                        for( C3::size_type i = 0; i < nframes; ++i ) pixels.push_back( stack( i, j, k ) );
+                        EXPECT_EQ( reference< float >( pixels, 0.5 ), median( j, k ) ) << nframes;
+                        EXPECT_EQ( reference< double >( pixels, 0.8 ), upper( j, k ) ) << nframes;
+                    }
+                }
+
+            }
+        }
+    }
+    C3::select_isa( C3::detected_isa() );
+
+}
+
+// Integer pixels of two bytes are counted, and integers of other sizes are
+// selected, giving the same order statistics.
+
+TEST( QuantileTest, IntegerToPixel )
+{
+
+    C3::Frame< short > frame( 300, 41 );
+    C3::Frame< int >   wide( 300, 41 );
+    for( C3::size_type k = 0; k < frame.nrows(); ++k )
+    {
+        for( C3::size_type j = 0; j < frame.ncolumns(); ++j )
+        {
+            frame( j, k ) = static_cast< short >( ( 7919 * j + 104729 * k ) % 65521 - 32000 );
+            wide( j, k )  = frame( j, k );
+        }
+    }
+
+    std::vector< short > pixels( frame.data(), frame.data() + frame.size() );
+    for( double q : { 0.0, 0.1, 0.5, 0.75, 1.0 } )
+    {
+        EXPECT_EQ( reference< double >( pixels, q ), C3::reduce< double >( frame, C3::Quantile( q ) ) ) << q;
+        EXPECT_EQ( reference< double >( pixels, q ), C3::reduce< double >( wide, C3::Quantile( q ) ) ) << q;
+    }
+
+    C3::View< short > view( frame, 100, 40, 10, 1 );
+    std::vector< short > subset;
+    for( C3::size_type k = 0; k < view.nrows(); ++k )
+    {
+        for( C3::size_type j = 0; j < view.ncolumns(); ++j ) subset.push_back( view( j, k ) );
+    }
+    EXPECT_EQ( reference< short >( subset, 0.5 ), C3::reduce( view, C3::Median() ) );
+
+    C3::Block< unsigned char > bytes( 5000 );
+    for( C3::size_type i = 0; i < bytes.size(); ++i ) bytes[ i ] = static_cast< unsigned char >( ( 31 * i ) % 251 );
+    std::vector< unsigned char > values( bytes.data(), bytes.data() + bytes.size() );
+    EXPECT_EQ( reference< unsigned char >( values, 0.5 ), C3::reduce( bytes, C3::Median() ) );
+
+}
+
+// Columns reduced into rows, through the sorting network and past it.
+
+TEST( QuantileTest, FrameToRow )
+{
+
+    for( C3::size_type nrows : { C3::size_type( 7 ), C3::size_type( 300 ) } )
+    {
+        C3::Frame< float > frame( 45, nrows );
+        for( C3::size_type k = 0; k < frame.nrows(); ++k )
+        {
+            for( C3::size_type j = 0; j < frame.ncolumns(); ++j )
+            {
+                frame( j, k ) = float( ( 7919 * j + 104729 * k ) % 1009 );
+            }
+        }
+
+        C3::View< float > view( frame, 30, nrows - 2, 10, 1 );
+        auto median = C3::reduce< C3::Row >( frame, C3::Median() );
+        auto upper  = C3::reduce< C3::Row, double >( view, C3::Quantile( 0.9 ) );
+
+        for( C3::size_type j = 0; j < frame.ncolumns(); ++j )
+        {
+            std::vector< float > pixels;
+            for( C3::size_type k = 0; k < frame.nrows(); ++k ) pixels.push_back( frame( j, k ) );
+            EXPECT_EQ( reference< float >( pixels, 0.5 ), median( j ) ) << nrows << " " << j;
+        }
+        for( C3::size_type j = 0; j < view.ncolumns(); ++j )
+        {
+            std::vector< float > pixels;
+            for( C3::size_type k = 0; k < view.nrows(); ++k ) pixels.push_back( view( j, k ) );
+            EXPECT_EQ( reference< double >( pixels, 0.9 ), upper( j ) ) << nrows << " " << j;
+        }
+    }
+
+}
@@ -0,0 +1,151 @@
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <limits>
+
+#include "C3_Accumulator.hh"
+#include "C3_Frame.hh"
+#include "C3_MaskedFrame.hh"
+#include "C3_Quantile.hh"
+#include "C3_QuantileSketch.hh"
+#include "C3_Reduce.hh"
+#include "C3_Stack.hh"
+
+// Frames added one at a time give the statistics of the whole stack.
+
+TEST( AccumulatorTest, MatchesStack )
+{
+
+    const C3::size_type nframes = 12, ncolumns = 33, nrows = 17;
+
+    C3::Stack< float > stack( nframes, ncolumns, nrows );
+    C3::Accumulator< double > accumulator( ncolumns, nrows );
+    C3::Frame< float > frame( ncolumns, nrows, C3::RowPitch::ALIGNED );
+    for( C3::size_type i = 0; i < nframes; ++i )
+    {
+        for( C3::size_type k = 0; k < nrows; ++k )
+        {
+            for( C3::size_type j = 0; j < ncolumns; ++j )
+            {
+                frame( j, k ) = stack( i, j, k ) = 1.0e4f + float( ( 7 * i + 3 * j + 5 * k ) % 19 ) - 0.5f * i;
+            }
+        }
+        accumulator.add( frame );
+    }
+
+    auto mean     = C3::reduce< C3::Frame, double >( stack, C3::Mean() );
+    auto variance = C3::reduce< C3::Frame, double >( stack, C3::Variance() );
+    auto minimum  = C3::reduce< C3::Frame >( stack, C3::Min() );
+    auto maximum  = C3::reduce< C3::Frame >( stack, C3::Max() );
+    auto spread   = accumulator.variance();
+
+    EXPECT_EQ( nframes, accumulator.nframes() );
+    for( C3::size_type k = 0; k < nrows; ++k )
+    {
+        for( C3::size_type j = 0; j < ncolumns; ++j )
+        {
+            EXPECT_EQ( double( nframes ), accumulator.count()( j, k ) );
+            EXPECT_NEAR( mean( j, k ), accumulator.mean()( j, k ), 1.0e-9 );
+            EXPECT_NEAR( mean( j, k ), accumulator.weighted_mean()( j, k ), 1.0e-9 );
+            EXPECT_NEAR( variance( j, k ), spread( j, k ), 1.0e-9 * variance( j, k ) );
+            EXPECT_EQ( minimum( j, k ), accumulator.min()( j, k ) );
+            EXPECT_EQ( maximum( j, k ), accumulator.max()( j, k ) );
+            EXPECT_EQ( double( nframes ), accumulator.weight()( j, k ) );
+        }
+    }
+
+}
+
+// Flagged pixels and pixels without inverse variance are left out, and the
+// rest are weighted by inverse variance.
+
+TEST( AccumulatorTest, Masked )
+{
+
+    C3::Accumulator< double > accumulator( 4, 3 );
+    C3::MaskedFrame< float, unsigned short > frame( 4, 3 );
+
+    const float pixels[] = { 1.0f, 2.0f, 4.0f, 100.0f };
+    const float weights[] = { 1.0f, 3.0f, 4.0f, 0.0f };
+    for( C3::size_type i = 0; i < 4; ++i )
+    {
+        frame.data()   = pixels[ i ];
+        frame.invvar() = weights[ i ];
+        frame.flags()  = 0;
+        frame.flags()( 1, 1 ) = 1;
+        accumulator.add( frame );
+    }
+
+    EXPECT_EQ( 3.0, accumulator.count()( 0, 0 ) );
+    EXPECT_DOUBLE_EQ( 7.0 / 3.0, accumulator.mean()( 0, 0 ) );
+    EXPECT_DOUBLE_EQ( 7.0 / 3.0, accumulator.variance()( 0, 0 ) );
+    EXPECT_DOUBLE_EQ( ( 1.0 + 6.0 + 16.0 ) / 8.0, accumulator.weighted_mean()( 0, 0 ) );
+    EXPECT_EQ( 8.0, accumulator.weight()( 0, 0 ) );
+    EXPECT_EQ( 1.0, accumulator.min()( 0, 0 ) );
+    EXPECT_EQ( 4.0, accumulator.max()( 0, 0 ) );
+
+    EXPECT_EQ( 0.0, accumulator.count()( 1, 1 ) );
+    EXPECT_EQ( 0.0, accumulator.weighted_mean()( 1, 1 ) );
+    EXPECT_TRUE( std::isnan( accumulator.variance()( 1, 1 ) ) );
+    EXPECT_EQ( std::numeric_limits< double >::infinity(), accumulator.min()( 1, 1 ) );
+
+}
+
+// Sketches are exact up to five pixels and close after that.
+
+TEST( AccumulatorTest, QuantileSketch )
+{
+
+    const C3::size_type nframes = 401, ncolumns = 8, nrows = 5;
+
+    C3::Stack< float > stack( nframes, ncolumns, nrows );
+    C3::QuantileSketch< double > median( ncolumns, nrows );
+    C3::QuantileSketch< double > upper( ncolumns, nrows, 0.9 );
+    C3::Frame< float > frame( ncolumns, nrows );
+    for( C3::size_type i = 0; i < nframes; ++i )
+    {
+        for( C3::size_type k = 0; k < nrows; ++k )
+        {
+            for( C3::size_type j = 0; j < ncolumns; ++j )
+            {
+                frame( j, k ) = stack( i, j, k ) = float( ( 7919 * i + 31 * j + 17 * k ) % 1000 );
+            }
+        }
+        median.add( frame );
+        upper.add( frame );
+
+        if( i + 1 == 3 || i + 1 == 5 )
+        {
+            C3::Stack< float > first( i + 1, ncolumns, nrows );
+            for( C3::size_type k = 0; k < nrows; ++k )
+            {
+                for( C3::size_type j = 0; j < ncolumns; ++j )
+                {
+                    for( C3::size_type f = 0; f <= i; ++f ) first( f, j, k ) = stack( f, j, k );
+                }
+            }
+            auto exact = C3::reduce< C3::Frame, double >( first, C3::Quantile( 0.9 ) );
+            auto estimate = upper.estimate();
+            for( C3::size_type k = 0; k < nrows; ++k )
+            {
+                for( C3::size_type j = 0; j < ncolumns; ++j ) EXPECT_DOUBLE_EQ( exact( j, k ), estimate( j, k ) );
+            }
+        }
+    }
+
+    auto exact_median = C3::reduce< C3::Frame, double >( stack, C3::Median() );
+    auto exact_upper  = C3::reduce< C3::Frame, double >( stack, C3::Quantile( 0.9 ) );
+    auto estimate_median = median.estimate();
+    auto estimate_upper  = upper.estimate();
+    for( C3::size_type k = 0; k < nrows; ++k )
+    {
+        for( C3::size_type j = 0; j < ncolumns; ++j )
+        {
+            EXPECT_NEAR( exact_median( j, k ), estimate_median( j, k ), 20.0 );
+            EXPECT_NEAR( exact_upper( j, k ), estimate_upper( j, k ), 20.0 );
+        }
+    }
+
+    EXPECT_TRUE( std::isnan( C3::QuantileSketch< float >( 2, 2 ).estimate()( 1, 1 ) ) );
+
+}
@@ -0,0 +1,103 @@
+#include "gtest/gtest.h"
+
+#include <stdexcept>
+
+#include "C3_Combine.hh"
+#include "C3_Frame.hh"
+#include "C3_Quantile.hh"
+#include "C3_Reduce.hh"
+#include "C3_Stack.hh"
+
+namespace
+{
+
+    float pixel( const C3::size_type i, const C3::size_type j, const C3::size_type k )
+    {
+        return float( ( 7919 * i + 31 * j + 17 * k ) % 101 ) - 0.5f * i;
+    }
+
+}
+
+// Bands combine to what the whole stack reduces to, whatever the band height.
+
+TEST( CombineTest, MatchesStack )
+{
+
+    const C3::size_type nframes = 21, ncolumns = 45, nrows = 23;
+
+    C3::Stack< float > stack( nframes, ncolumns, nrows );
+    for( C3::size_type k = 0; k < nrows; ++k )
+    {
+        for( C3::size_type j = 0; j < ncolumns; ++j )
+        {
+            for( C3::size_type i = 0; i < nframes; ++i ) stack( i, j, k ) = pixel( i, j, k );
+        }
+    }
+    auto median = C3::reduce< C3::Frame >( stack, C3::Median() );
+    auto mean   = C3::reduce< C3::Frame, double >( stack, C3::Mean() );
+
+    auto load = [ & ]( C3::Frame< float >& rows, const C3::size_type i, const C3::size_type first_row )
+        {
+            EXPECT_EQ( ncolumns, rows.ncolumns() );
+            for( C3::size_type k = 0; k < rows.nrows(); ++k )
+            {
+                for( C3::size_type j = 0; j < ncolumns; ++j ) rows( j, k ) = pixel( i, j, first_row + k );
+            }
+        };
+
+    const C3::size_type row_bytes = ( 2 * nframes + 16 ) * ncolumns * sizeof( float ) + ncolumns * sizeof( double );
+    EXPECT_EQ( 1, ( C3::combine_rows< double, float >( nframes, ncolumns, nrows, 0 ) ) );
+    EXPECT_EQ( 5, ( C3::combine_rows< double, float >( nframes, ncolumns, nrows, 5 * row_bytes + 1 ) ) );
+    EXPECT_EQ( nrows, ( C3::combine_rows< double, float >( nframes, ncolumns, nrows, 1000 * row_bytes ) ) );
+
+    for( C3::size_type band : { 1, 5, 23 } )
+    {
+        C3::Frame< float > combined( ncolumns, nrows, -1.0f );
+        C3::size_type stored = 0;
+        C3::combine< float, float >( nframes, ncolumns, nrows, band * row_bytes, load,
+            [ & ]( C3::Frame< float >& rows, const C3::size_type first_row )
+            {
+                EXPECT_EQ( stored, first_row );
+                for( C3::size_type k = 0; k < rows.nrows(); ++k )
+                {
+                    for( C3::size_type j = 0; j < ncolumns; ++j ) combined( j, first_row + k ) = rows( j, k );
+                }
+                stored += rows.nrows();
+            }, C3::Median() );
+        EXPECT_EQ( nrows, stored );
+
+        C3::Frame< double > averaged( ncolumns, nrows, -1.0 );
+        C3::combine< double, float >( nframes, ncolumns, nrows, band * row_bytes, load,
+            [ & ]( C3::Frame< double >& rows, const C3::size_type first_row )
+            {
+                for( C3::size_type k = 0; k < rows.nrows(); ++k )
+                {
+                    for( C3::size_type j = 0; j < ncolumns; ++j ) averaged( j, first_row + k ) = rows( j, k );
+                }
+            }, C3::Mean() );
+
+        for( C3::size_type k = 0; k < nrows; ++k )
+        {
+            for( C3::size_type j = 0; j < ncolumns; ++j )
+            {
+                EXPECT_EQ( median( j, k ), combined( j, k ) ) << band;
+                EXPECT_EQ( mean( j, k ), averaged( j, k ) ) << band;
+            }
+        }
+    }
+
+}
+
+// Errors loading come back to the caller.
+
+TEST( CombineTest, LoadError )
+{
+
+    EXPECT_THROW( ( C3::combine< float, float >( 3, 4, 4, 0,
+        []( C3::Frame< float >&, const C3::size_type i, const C3::size_type first_row )
+        {
+            if( i == 2 && first_row == 2 ) throw std::runtime_error( "Can't read." );
+        },
+        []( C3::Frame< float >&, const C3::size_type ) {}, C3::Median() ) ), std::runtime_error );
+
+}
@@ -0,0 +1,195 @@
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <vector>
+
+#include "C3_Column.hh"
+#include "C3_Frame.hh"
+#include "C3_MaskedFrame.hh"
+#include "C3_Row.hh"
+#include "C3_Simd.hh"
+#include "C3_Stack.hh"
+#include "C3_Threads.hh"
+#include "C3_WeightedMean.hh"
+
+namespace
+{
+
+    // Weighted mean and inverse variance by plain loops, clipped about the
+    // last mean like C3::ClippedWeightedMean.
+
+    void reference( double& mean, double& invvar, const std::vector< float >& x, const std::vector< float >& w,
+            const std::vector< unsigned short >& f, const double nsigma, const int iterations )
+    {
+        double center = 0.0, threshold = INFINITY;
+        int kept = -1;
+        for( int iteration = 0; iteration <= iterations; ++iteration )
+        {
+            double sum = 0.0, weighted = 0.0;
+            int count = 0;
+            for( std::size_t i = 0; i < x.size(); ++i )
+            {
+                if( f[ i ] || w[ i ] <= 0.0f || w[ i ] * ( x[ i ] - center ) * ( x[ i ] - center ) > threshold ) continue;
+                sum += w[ i ];
+                weighted += w[ i ] * x[ i ];
+                ++count;
+            }
+            mean   = sum > 0.0 ? weighted / sum : 0.0;
+            invvar = sum;
+            if( count == kept ) break;
+            kept = count;
+            if( sum > 0.0 ) center = mean;
+            threshold = nsigma * nsigma;
+        }
+    }
+
+    // Pixels near 100 with a few far outliers, weights from 0 to 4 and one
+    // pixel in eleven flagged.
+
+    float pixel( const C3::size_type i, const C3::size_type j, const C3::size_type k )
+    {
+        const auto n = 7 * i + 3 * j + 5 * k;
+        return n % 13 == 0 ? 1000.0f : 100.0f + 0.25f * float( n % 9 ) - 1.0f;
+    }
+
+    float weight( const C3::size_type i, const C3::size_type j, const C3::size_type k )
+    {
+        return 0.5f * float( ( i + 2 * j + 3 * k ) % 9 );
+    }
+
+    unsigned short flag( const C3::size_type i, const C3::size_type j, const C3::size_type k )
+    {
+        return ( 5 * i + j + 7 * k ) % 11 == 0 ? 4 : 0;
+    }
+
+}
+
+// Stacks to frames, for every layout and instruction set.
+
+TEST( WeightedMeanTest, StackToFrame )
+{
+
+    const C3::size_type nframes = 23, ncolumns = 70, nrows = 5;
+
+    for( auto layout : { C3::StackLayout::INTERLEAVED, C3::StackLayout::PLANAR, C3::StackLayout::TILED } )
+    {
+
+        C3::Stack< float > data( nframes, ncolumns, nrows, layout ), weights( nframes, ncolumns, nrows, layout );
+        C3::Stack< unsigned short > flags( nframes, ncolumns, nrows, layout );
+        for( C3::size_type k = 0; k < nrows; ++k )
+        {
+            for( C3::size_type j = 0; j < ncolumns; ++j )
+            {
+                for( C3::size_type i = 0; i < nframes; ++i )
+                {
+                    data( i, j, k )    = pixel( i, j, k );
+                    weights( i, j, k ) = weight( i, j, k );
+                    flags( i, j, k )   = flag( i, j, k );
+                }
+            }
+        }
+
+        for( auto isa : { C3::Isa::SCALAR, C3::Isa::AVX2, C3::Isa::AVX512 } )
+        {
+            C3::select_isa( isa );
+            C3::Frame< double > mean( ncolumns, nrows ), invvar( ncolumns, nrows );
+            C3::Frame< double > clipped( ncolumns, nrows ), clipped_invvar( ncolumns, nrows );
+            C3::reduce( mean, invvar, data, weights, flags, C3::WeightedMean() );
+            C3::reduce( clipped, clipped_invvar, data, weights, flags, C3::ClippedWeightedMean( 3.0, 10 ) );
+
+            for( C3::size_type k = 0; k < nrows; ++k )
+            {
+                for( C3::size_type j = 0; j < ncolumns; ++j )
+                {
+                    std::vector< float > x, w;
+                    std::vector< unsigned short > f;
+                    for( C3::size_type i = 0; i < nframes; ++i )
+                    {
+                        x.push_back( data( i, j, k ) );
+                        w.push_back( weights( i, j, k ) );
+                        f.push_back( flags( i, j, k ) );
+                    }
+                    double expected, expected_invvar;
+                    reference( expected, expected_invvar, x, w, f, 3.0, 0 );
+                    EXPECT_NEAR( expected, mean( j, k ), 1.0e-9 * expected );
+                    EXPECT_DOUBLE_EQ( expected_invvar, invvar( j, k ) );
+                    reference( expected, expected_invvar, x, w, f, 3.0, 10 );
+                    EXPECT_NEAR( expected, clipped( j, k ), 1.0e-9 * expected );
+                    EXPECT_DOUBLE_EQ( expected_invvar, clipped_invvar( j, k ) );
+                    EXPECT_LT( clipped( j, k ), 101.0 );
+                }
+            }
+        }
+        C3::select_isa( C3::detected_isa() );
+
+    }
+
+}
+
+// Masked frames to columns and rows, over threads, and destination pixels
+// with nothing left.
+
+TEST( WeightedMeanTest, FrameToColumnAndRow )
+{
+
+    C3::MaskedFrame< float, unsigned short > frame( 150, 90, C3::RowPitch::ALIGNED );
+    for( C3::size_type k = 0; k < frame.nrows(); ++k )
+    {
+        for( C3::size_type j = 0; j < frame.ncolumns(); ++j )
+        {
+            frame.data()( j, k )   = pixel( 0, j, k );
+            frame.invvar()( j, k ) = weight( 0, j, k );
+            frame.flags()( j, k )  = j == 3 || k == 4 ? 1 : flag( 0, j, k );
+        }
+    }
+
+    const auto threads   = C3::threads();
+    const auto threshold = C3::select_thread_threshold( 0 );
+    C3::select_thread_threshold( 0 );
+    C3::select_threads( 3 );
+
+    C3::Column< double > column( frame.nrows() ), column_invvar( frame.nrows() );
+    C3::Row< float > row( frame.ncolumns() ), row_invvar( frame.ncolumns() );
+    C3::reduce( column, column_invvar, frame, C3::ClippedWeightedMean() );
+    C3::reduce( row, row_invvar, frame, C3::WeightedMean() );
+
+    C3::select_threads( threads );
+    C3::select_thread_threshold( threshold );
+
+    for( C3::size_type k = 0; k < frame.nrows(); ++k )
+    {
+        std::vector< float > x, w;
+        std::vector< unsigned short > f;
+        for( C3::size_type j = 0; j < frame.ncolumns(); ++j )
+        {
+            x.push_back( frame.data()( j, k ) );
+            w.push_back( frame.invvar()( j, k ) );
+            f.push_back( frame.flags()( j, k ) );
+        }
+        double expected, expected_invvar;
+        reference( expected, expected_invvar, x, w, f, 3.0, 5 );
+        EXPECT_NEAR( expected, column( k ), 1.0e-9 * std::fabs( expected ) + 1.0e-300 );
+        EXPECT_DOUBLE_EQ( expected_invvar, column_invvar( k ) );
+    }
+    EXPECT_EQ( 0.0, column( 4 ) );
+    EXPECT_EQ( 0.0, column_invvar( 4 ) );
+
+    for( C3::size_type j = 0; j < frame.ncolumns(); ++j )
+    {
+        std::vector< float > x, w;
+        std::vector< unsigned short > f;
+        for( C3::size_type k = 0; k < frame.nrows(); ++k )
+        {
+            x.push_back( frame.data()( j, k ) );
+            w.push_back( frame.invvar()( j, k ) );
+            f.push_back( frame.flags()( j, k ) );
+        }
+        double expected, expected_invvar;
+        reference( expected, expected_invvar, x, w, f, 3.0, 0 );
+        EXPECT_NEAR( expected, row( j ), 1.0e-5 * std::fabs( expected ) );
+        EXPECT_FLOAT_EQ( float( expected_invvar ), row_invvar( j ) );
+    }
+    EXPECT_EQ( 0.0f, row( 3 ) );
+    EXPECT_EQ( 0.0f, row_invvar( 3 ) );
+
+}
@@ -0,0 +1,152 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "C3_Column.hh"
+#include "C3_Frame.hh"
+#include "C3_Reduce.hh"
+#include "C3_SigmaClip.hh"
+#include "C3_Stack.hh"
+
+namespace
+{
+
+    // Sigma clipping by sorting the pixels kept and summing them again every
+    // pass.
+
+    void reference( double& mean, double& median, std::vector< double > kept, const double nsigma,
+            const int iterations )
+    {
+        for( int iteration = 0; ; ++iteration )
+        {
+            std::sort( kept.begin(), kept.end() );
+            const auto n = kept.size();
+            median = n % 2 ? kept[ n / 2 ] : 0.5 * ( kept[ n / 2 - 1 ] + kept[ n / 2 ] );
+            double sum = 0.0;
+            for( auto x : kept ) sum += x;
+            mean = sum / n;
+            if( iteration == iterations || n < 2 ) return;
+            double squares = 0.0;
+            for( auto x : kept ) squares += ( x - mean ) * ( x - mean );
+            const double sigma = std::sqrt( squares / ( n - 1 ) );
+            std::vector< double > next;
+            for( auto x : kept ) if( std::fabs( x - median ) <= nsigma * sigma ) next.push_back( x );
+            if( next.size() == n ) return;
+            kept = next;
+        }
+    }
+
+    // Noise-like pixels near 1000 with outliers on both sides, some far.
+
+    float pixel( const C3::size_type j, const C3::size_type k )
+    {
+        const auto n = ( 7919 * j + 104729 * k ) % 1009;
+        if( n % 37 == 0 ) return 5000.0f + float( n );
+        if( n % 53 == 0 ) return 900.0f - 0.1f * float( n );
+        return 1000.0f + 0.01f * float( n % 101 ) - 0.5f;
+    }
+
+}
+
+// Rows of a frame, against clipping by sorting, to a few passes and to
+// convergence.
+
+TEST( SigmaClipTest, FrameToColumn )
+{
+
+    C3::Frame< float > frame( 257, 40 );
+    for( C3::size_type k = 0; k < frame.nrows(); ++k )
+    {
+        for( C3::size_type j = 0; j < frame.ncolumns(); ++j ) frame( j, k ) = pixel( j, k );
+    }
+
+    for( int iterations : { 1, 2, 10 } )
+    {
+        auto mean   = C3::reduce< C3::Column, double >( frame, C3::ClippedMean( 3.0, iterations ) );
+        auto median = C3::reduce< C3::Column, double >( frame, C3::ClippedMedian( 2.0, iterations ) );
+        for( C3::size_type k = 0; k < frame.nrows(); ++k )
+        {
+            std::vector< double > pixels;
+            for( C3::size_type j = 0; j < frame.ncolumns(); ++j ) pixels.push_back( frame( j, k ) );
+            double expected_mean, expected_median;
+            reference( expected_mean, expected_median, pixels, 3.0, iterations );
+            EXPECT_NEAR( expected_mean, mean( k ), 1.0e-9 * expected_mean ) << iterations << " " << k;
+            reference( expected_mean, expected_median, pixels, 2.0, iterations );
+            EXPECT_EQ( expected_median, median( k ) ) << iterations << " " << k;
+            if( iterations == 10 )
+            {
+                EXPECT_LT( std::fabs( mean( k ) - 1000.0 ), 1.0 );
+            }
+        }
+    }
+
+}
+
+// Stack pixels, small ones included, and ranges with nothing to clip.
+
+TEST( SigmaClipTest, StackToFrame )
+{
+
+    const C3::size_type nframes = 6, ncolumns = 30, nrows = 4;
+    C3::Stack< short > stack( nframes, ncolumns, nrows, C3::StackLayout::PLANAR );
+    for( C3::size_type k = 0; k < nrows; ++k )
+    {
+        for( C3::size_type j = 0; j < ncolumns; ++j )
+        {
+            for( C3::size_type i = 0; i < nframes; ++i )
+            {
+                stack( i, j, k ) = static_cast< short >( 100 + ( 3 * i + j + k ) % 4 + ( i == j % nframes ? 500 : 0 ) );
+            }
+        }
+    }
+
+    auto mean   = C3::reduce< C3::Frame, double >( stack, C3::ClippedMean( 1.5 ) );
+    auto median = C3::reduce< C3::Frame, double >( stack, C3::ClippedMedian( 1.5 ) );
+    for( C3::size_type k = 0; k < nrows; ++k )
+    {
+        for( C3::size_type j = 0; j < ncolumns; ++j )
+        {
+            std::vector< double > pixels;
+            for( C3::size_type i = 0; i < nframes; ++i ) pixels.push_back( stack( i, j, k ) );
+            double expected_mean, expected_median;
+            reference( expected_mean, expected_median, pixels, 1.5, 10 );
+            EXPECT_DOUBLE_EQ( expected_mean, mean( j, k ) );
+            EXPECT_EQ( expected_median, median( j, k ) );
+            EXPECT_LT( mean( j, k ), 104.0 );
+        }
+    }
+
+    const float same[] = { 2.0f, 2.0f, 2.0f };
+    float result;
+    C3::ClippedMean()( result, same, same + 3 );
+    EXPECT_EQ( 2.0f, result );
+    C3::ClippedMedian()( result, same + 1, same + 2 );
+    EXPECT_EQ( 2.0f, result );
+
+}
+
+// Float pixels with one saturated outlier, whose removal from float sums
+// would leave mostly rounding error.
+
+TEST( SigmaClipTest, FarOutlier )
+{
+
+    std::mt19937 engine( 12345 );
+    std::normal_distribution< float > noise( 100.0f, 1.0f );
+    C3::Column< float > pixels( 101 );
+    for( C3::size_type k = 0; k < 100; ++k ) pixels( k ) = noise( engine );
+
+    for( float outlier : { 1.0e5f, 1.0e6f, 1.0e7f, 1.0e8f } )
+    {
+        pixels( 100 ) = outlier;
+        std::vector< double > kept( pixels.begin(), pixels.end() );
+        double expected_mean, expected_median;
+        reference( expected_mean, expected_median, kept, 3.0, 10 );
+        EXPECT_NEAR( expected_mean, C3::reduce( pixels, C3::ClippedMean() ), 1.0e-4 ) << outlier;
+        EXPECT_NEAR( expected_mean, C3::reduce< double >( pixels, C3::ClippedMean() ), 1.0e-9 ) << outlier;
+    }
+
+}
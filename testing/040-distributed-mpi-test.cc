@@ -0,0 +1,242 @@
+#include "gtest/gtest.h"
+
+#include <stdexcept>
+#include <vector>
+
+#include <mpi.h>
+
+#include "C3_Communicator.hh"
+#include "C3_Distributed.hh"
+#include "C3_Frame.hh"
+#include "C3_MaskedFrame.hh"
+#include "C3_Quantile.hh"
+
+namespace
+{
+
+    // Pixel of process r, exact in float whatever the order of additions.
+
+    float pixel( const int r, const C3::size_type j, const C3::size_type k )
+    {
+        return float( ( 31 * j + 17 * k ) % 101 ) + 0.5f * r;
+    }
+
+    // Pixel of process r, with one process far off for each pixel.
+
+    float spread( const int r, const int size, const C3::size_type j, const C3::size_type k )
+    {
+        return pixel( r, j, k ) + ( ( j + k ) % size == C3::size_type( r ) ? 1000.0f : 0.0f );
+    }
+
+    void fill( C3::Frame< float >& frame, const int r )
+    {
+        for( C3::size_type k = 0; k < frame.nrows(); ++k )
+        {
+            for( C3::size_type j = 0; j < frame.ncolumns(); ++j ) frame( j, k ) = pixel( r, j, k );
+        }
+    }
+
+}
+
+// Sums and means of ALIGNED frames, whose rows are padded, onto every
+// process and onto the last.
+
+TEST( DistributedTest, AllreduceAligned )
+{
+
+    const C3::Communicator comm( MPI_COMM_WORLD );
+    const int size = comm.size();
+    C3::Frame< float > frame( 13, 5, C3::RowPitch::ALIGNED );
+
+    fill( frame, comm.rank() );
+    C3::mpi_allreduce( frame, comm, C3::Sum() );
+    for( C3::size_type k = 0; k < frame.nrows(); ++k )
+    {
+        for( C3::size_type j = 0; j < frame.ncolumns(); ++j )
+        {
+            float expected = 0.0f;
+            for( int r = 0; r < size; ++r ) expected += pixel( r, j, k );
+            EXPECT_EQ( expected, frame( j, k ) ) << j << " " << k;
+        }
+    }
+
+    fill( frame, comm.rank() );
+    C3::mpi_reduce( frame, comm, size - 1, C3::Mean() );
+    for( C3::size_type k = 0; k < frame.nrows(); ++k )
+    {
+        for( C3::size_type j = 0; j < frame.ncolumns(); ++j )
+        {
+            float expected = 0.0f;
+            for( int r = 0; r < size; ++r ) expected += pixel( r, j, k );
+            expected = comm.rank() == size - 1 ? expected / size : pixel( comm.rank(), j, k );
+            EXPECT_EQ( expected, frame( j, k ) ) << j << " " << k;
+        }
+    }
+
+}
+
+// Medians of frames by redistribution, one process off in every pixel.
+
+TEST( DistributedTest, MedianCombine )
+{
+
+    const C3::Communicator comm( MPI_COMM_WORLD );
+    const int size = comm.size();
+    C3::Frame< float > frame( 9, 11, C3::RowPitch::ALIGNED );
+    for( C3::size_type k = 0; k < frame.nrows(); ++k )
+    {
+        for( C3::size_type j = 0; j < frame.ncolumns(); ++j ) frame( j, k ) = spread( comm.rank(), size, j, k );
+    }
+
+    C3::mpi_combine( frame, comm, C3::Median() );
+    for( C3::size_type k = 0; k < frame.nrows(); ++k )
+    {
+        for( C3::size_type j = 0; j < frame.ncolumns(); ++j )
+        {
+            std::vector< float > pixels;
+            for( int r = 0; r < size; ++r ) pixels.push_back( spread( r, size, j, k ) );
+            float expected;
+            C3::Median()( expected, pixels.data(), pixels.data() + size );
+            EXPECT_EQ( expected, frame( j, k ) ) << j << " " << k;
+        }
+    }
+
+}
+
+// Frames with fewer rows than processes, which leave some bands empty.
+
+TEST( DistributedTest, FewerRowsThanRanks )
+{
+
+    const C3::Communicator comm( MPI_COMM_WORLD );
+    const int size = comm.size();
+    for( C3::size_type nrows : { 1, 2 } )
+    {
+        C3::Frame< float > frame( 7, nrows );
+        fill( frame, comm.rank() );
+        C3::mpi_combine( frame, comm, C3::Mean() );
+        for( C3::size_type k = 0; k < nrows; ++k )
+        {
+            for( C3::size_type j = 0; j < frame.ncolumns(); ++j )
+            {
+                EXPECT_EQ( pixel( 0, j, k ) + 0.25f * ( size - 1 ), frame( j, k ) ) << j << " " << k;
+            }
+        }
+
+        fill( frame, comm.rank() );
+        C3::mpi_allreduce( frame, comm, C3::Mean() );
+        for( C3::size_type k = 0; k < nrows; ++k )
+        {
+            for( C3::size_type j = 0; j < frame.ncolumns(); ++j )
+            {
+                EXPECT_EQ( pixel( 0, j, k ) + 0.25f * ( size - 1 ), frame( j, k ) ) << j << " " << k;
+            }
+        }
+    }
+
+}
+
+// Weighted means of masked frames.  Each pixel is flagged on one process and
+// has no inverse variance on another, and the first column is flagged on
+// every process, so that its flag survives.
+
+TEST( DistributedTest, WeightedMeanFlags )
+{
+
+    const C3::Communicator comm( MPI_COMM_WORLD );
+    const int size = comm.size();
+    const C3::size_type ncolumns = 6, nrows = 4;
+    auto value  = [ & ]( const int r, const C3::size_type j, const C3::size_type k ) { return 10.0 * r + j + k; };
+    auto invvar = [ & ]( const int r, const C3::size_type j, const C3::size_type k )
+    {
+        return ( j + 2 * k + 1 ) % size == C3::size_type( r ) && size > 1 ? 0.0 : 1.0 + r;
+    };
+    auto flags  = [ & ]( const int r, const C3::size_type j, const C3::size_type k )
+    {
+        return static_cast< unsigned short >( ( ( j + k ) % size == C3::size_type( r ) ? 1 : 0 ) | ( j == 0 ? 4 : 0 ) );
+    };
+
+    for( bool all : { true, false } )
+    {
+        C3::MaskedFrame< double, unsigned short > frame( ncolumns, nrows );
+        for( C3::size_type k = 0; k < nrows; ++k )
+        {
+            for( C3::size_type j = 0; j < ncolumns; ++j )
+            {
+                frame.data()( j, k )   = value( comm.rank(), j, k );
+                frame.invvar()( j, k ) = invvar( comm.rank(), j, k );
+                frame.flags()( j, k )  = flags( comm.rank(), j, k );
+            }
+        }
+
+        if( all ) C3::mpi_allreduce( frame, comm, C3::WeightedMean() );
+        else C3::mpi_reduce( frame, comm, 0, C3::WeightedMean() );
+        if( ! all && ! comm.root() ) continue;
+
+        for( C3::size_type k = 0; k < nrows; ++k )
+        {
+            for( C3::size_type j = 0; j < ncolumns; ++j )
+            {
+                double sum = 0.0, weighted = 0.0;
+                unsigned short expected_flags = 0xffff;
+                for( int r = 0; r < size; ++r )
+                {
+                    expected_flags &= flags( r, j, k );
+                    if( flags( r, j, k ) || invvar( r, j, k ) <= 0.0 ) continue;
+                    sum      += invvar( r, j, k );
+                    weighted += invvar( r, j, k ) * value( r, j, k );
+                }
+                EXPECT_NEAR( sum > 0.0 ? weighted / sum : 0.0, frame.data()( j, k ), 1.0e-12 ) << j << " " << k;
+                EXPECT_EQ( sum, frame.invvar()( j, k ) ) << j << " " << k;
+                EXPECT_EQ( expected_flags, frame.flags()( j, k ) ) << j << " " << k;
+            }
+        }
+    }
+
+}
+
+// Requests dropped before completing, by going out of scope, by being
+// assigned over and by an exception, leave their frames alone and nothing
+// in progress to get in the way of the next reduction.
+
+TEST( DistributedTest, DroppedRequest )
+{
+
+    const C3::Communicator comm( MPI_COMM_WORLD );
+    C3::Frame< float > frame( 8, 5 );
+    C3::MaskedFrame< float, unsigned short > masked( 8, 5, 1.0f, 1.0f, 0 );
+
+    fill( frame, comm.rank() );
+    {
+        auto request = C3::mpi_icombine( frame, comm, C3::Median() );
+        auto weighted = C3::mpi_iallreduce( masked, comm, C3::WeightedMean() );
+        EXPECT_TRUE( request.pending() );
+    }
+    {
+        auto request = C3::mpi_iallreduce( frame, comm, C3::Sum() );
+        request = C3::MpiRequest();
+        EXPECT_FALSE( request.pending() );
+    }
+    try
+    {
+        auto request = C3::mpi_icombine( frame, comm, C3::Mean() );
+        throw std::runtime_error( "unwinding" );
+    }
+    catch( const std::runtime_error& ) {}
+
+    for( C3::size_type k = 0; k < frame.nrows(); ++k )
+    {
+        for( C3::size_type j = 0; j < frame.ncolumns(); ++j ) EXPECT_EQ( pixel( comm.rank(), j, k ), frame( j, k ) );
+    }
+    EXPECT_EQ( 1.0f, masked.invvar()( 0, 0 ) );
+
+    C3::mpi_combine( frame, comm, C3::Mean() );
+    for( C3::size_type k = 0; k < frame.nrows(); ++k )
+    {
+        for( C3::size_type j = 0; j < frame.ncolumns(); ++j )
+        {
+            EXPECT_EQ( pixel( 0, j, k ) + 0.25f * ( comm.size() - 1 ), frame( j, k ) );
+        }
+    }
+
+}
@@ -0,0 +1,24 @@
+
+#include <mpi.h>
+
+#include "gtest/gtest.h"
+
+// Run the MPI tests on every process, reporting from the first.  The exit
+// status is a failure if any process failed.
+
+int main( int argc, char* argv[] )
+{
+    MPI_Init( &argc, &argv );
+    ::testing::InitGoogleTest( &argc, argv );
+    int rank;
+    MPI_Comm_rank( MPI_COMM_WORLD, &rank );
+    if( rank != 0 )
+    {
+        auto& listeners = ::testing::UnitTest::GetInstance()->listeners();
+        delete listeners.Release( listeners.default_result_printer() );
+    }
+    int failed = RUN_ALL_TESTS();
+    MPI_Allreduce( MPI_IN_PLACE, &failed, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD );
+    MPI_Finalize();
+    return failed;
+}